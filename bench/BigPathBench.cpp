@@ -8,6 +8,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPath.h"
+#include "src/core/SkScan.h"
 #include "tools/ToolUtils.h"
 
 enum Align {
@@ -18,19 +19,35 @@ enum Align {
 
 const char* gAlignName[] = { "left", "middle", "right" };
 
+// Sets gSkUseSparseStripsAA while in scope, then puts back whatever it was.
+class AutoSparseStripsAA {
+public:
+    explicit AutoSparseStripsAA(bool enabled)
+        : fPrevEnabled(gSkUseSparseStripsAA.exchange(enabled)) {}
+    ~AutoSparseStripsAA() { gSkUseSparseStripsAA = fPrevEnabled; }
+
+private:
+    bool fPrevEnabled;
+};
+
 // Inspired by crbug.com/455429
 class BigPathBench : public Benchmark {
     SkPath      fPath;
     SkString    fName;
     Align       fAlign;
     bool        fRound;
+    bool        fSparseStrips;
 
 public:
-    BigPathBench(Align align, bool round) : fAlign(align), fRound(round) {
+    BigPathBench(Align align, bool round, bool sparseStrips = false)
+        : fAlign(align), fRound(round), fSparseStrips(sparseStrips) {
         fName.printf("bigpath_%s", gAlignName[fAlign]);
         if (round) {
             fName.append("_round");
         }
+        if (sparseStrips) {
+            fName.append("_sparse");
+        }
     }
 
 protected:
@@ -45,6 +62,9 @@ protected:
     void onDelayedSetup() override { fPath = ToolUtils::make_big_path(); }
 
     void onDraw(int loops, SkCanvas* canvas) override {
+        // The stroked outline has thousands of points, so with gSkUseSparseStripsAA set it is
+        // filled with sparse strips.
+        AutoSparseStripsAA sparseStrips(fSparseStrips);
         SkPaint paint;
         paint.setAntiAlias(true);
         paint.setStyle(SkPaint::kStroke_Style);
@@ -82,3 +102,7 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+DEF_BENCH( return new BigPathBench(kLeft_Align,     false, true); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   false, true); )
+DEF_BENCH( return new BigPathBench(kRight_Align,    false, true); )
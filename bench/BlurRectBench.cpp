@@ -7,11 +7,14 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkBlurMask.h"
+#include "src/core/SkBlurPriv.h"
 
 #define SMALL   SkIntToScalar(2)
 #define REAL    1.5f
@@ -182,6 +185,66 @@ private:
     using INHERITED = BlurRectSeparableBench;
 };
 
+// Sets gSkUseAnalyticBlurRRect while in scope, then puts back whatever it was.
+class AutoAnalyticBlurRRect {
+public:
+    explicit AutoAnalyticBlurRRect(bool enabled)
+        : fPrevEnabled(gSkUseAnalyticBlurRRect.exchange(enabled)) {}
+    ~AutoAnalyticBlurRRect() { gSkUseAnalyticBlurRRect = fPrevEnabled; }
+
+private:
+    bool fPrevEnabled;
+};
+
+// Draws blurred round rect "cards" of assorted sizes through the canvas. Cards that are small
+// relative to the blur can't use a nine patch; they're either evaluated analytically or drawn by
+// blurring a full-size mask.
+class BlurRRectDrawBench : public Benchmark {
+public:
+    BlurRRectDrawBench(SkScalar sigma, bool analytic) : fSigma(sigma), fAnalytic(analytic) {
+        fName.printf("blurrrect_draw_%s_%d", analytic ? "analytic" : "mask",
+                     SkScalarRoundToInt(sigma));
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        AutoAnalyticBlurRRect analytic(fAnalytic);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(0x40000000);
+        paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, fSigma));
+
+        for (int i = 0; i < loops; i++) {
+            SkRandom rand;
+            for (int j = 0; j < 50; j++) {
+                SkRect r = SkRect::MakeXYWH(rand.nextRangeScalar(0, 400),
+                                            rand.nextRangeScalar(0, 400),
+                                            rand.nextRangeScalar(40, 240),
+                                            rand.nextRangeScalar(40, 160));
+                canvas->drawRRect(SkRRect::MakeRectXY(r, 8, 8), paint);
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    SkScalar fSigma;
+    bool     fAnalytic;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new BlurRRectDrawBench(SkIntToScalar(2), true);)
+DEF_BENCH(return new BlurRRectDrawBench(SkIntToScalar(2), false);)
+DEF_BENCH(return new BlurRRectDrawBench(SkIntToScalar(8), true);)
+DEF_BENCH(return new BlurRRectDrawBench(SkIntToScalar(8), false);)
+DEF_BENCH(return new BlurRRectDrawBench(SkIntToScalar(24), true);)
+DEF_BENCH(return new BlurRRectDrawBench(SkIntToScalar(24), false);)
+
 DEF_BENCH(return new BlurRectBoxFilterBench(SMALL);)
 DEF_BENCH(return new BlurRectBoxFilterBench(BIG);)
 DEF_BENCH(return new BlurRectBoxFilterBench(REALBIG);)
@@ -10,6 +10,7 @@
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkString.h"
 
@@ -78,3 +79,42 @@ DEF_BENCH(return new BlurRectsNinePatchBench(SkRect::MakeXYWH(10, 10, 100, 100),
 DEF_BENCH(return new BlurRectsNonNinePatchBench(SkRect::MakeXYWH(10, 10, 100, 100),
                                                 SkRect::MakeXYWH(50, 50, 10, 10),
                                                 4.3f);)
+
+// Draws blurred nested round rects whose size changes every frame, as when animating a card's
+// border. The nine patch for them depends only on the blur, radii and insets, so it is cached
+// once and stretched.
+class BlurDRRectsAnimatedBench : public Benchmark {
+public:
+    BlurDRRectsAnimatedBench(SkScalar sigma) : fSigma(sigma) {
+        fName.printf("blurdrrects_animated_%g", sigma);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, fSigma));
+
+        const SkVector radii[4] = {{16, 16}, {16, 16}, {4, 4}, {4, 4}};
+        for (int i = 0; i < loops; i++) {
+            SkScalar t = SkIntToScalar(i % 100);
+            SkRRect outer, inner;
+            outer.setRectRadii(SkRect::MakeXYWH(10, 10, 200 + t, 150 + t), radii);
+            outer.inset(6, 6, &inner);
+            canvas->drawDRRect(outer, inner, paint);
+        }
+    }
+
+private:
+    SkString    fName;
+    SkScalar    fSigma;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new BlurDRRectsAnimatedBench(2.3f);)
+DEF_BENCH(return new BlurDRRectsAnimatedBench(8);)
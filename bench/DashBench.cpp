@@ -368,6 +368,55 @@ private:
     using INHERITED = Benchmark;
 };
 
+// A long, densely dashed polyline, like a route drawn on a map. Aliased, opaque paints are dashed,
+// stroked and filled a batch of dashes at a time, and dashes outside the clip are skipped;
+// translucent ones still build the whole dashed path. Zoomed in, most of the route is offscreen.
+class DashedPolylineBench : public Benchmark {
+    SkString fName;
+    SkPath   fPath;
+    bool     fOpaque;
+    bool     fZoomed;
+
+public:
+    DashedPolylineBench(bool opaque, bool zoomed) : fOpaque(opaque), fZoomed(zoomed) {
+        fName.printf("dashpolyline_%s_%s", opaque ? "opaque" : "translucent",
+                     zoomed ? "zoomed" : "full");
+        SkRandom rand;
+        SkPoint pt = {320, 240};
+        fPath.moveTo(pt);
+        for (int i = 0; i < 20000; ++i) {
+            pt.offset(rand.nextRangeScalar(-8, 8), rand.nextRangeScalar(-8, 8));
+            pt.set(SkTPin(pt.fX, 0.f, 640.f), SkTPin(pt.fY, 0.f, 480.f));
+            fPath.lineTo(pt);
+        }
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint p;
+        p.setStyle(SkPaint::kStroke_Style);
+        p.setStrokeWidth(2);
+        p.setAlpha(fOpaque ? 0xFF : 0xFE);
+        const SkScalar intervals[] = { 4, 3 };
+        p.setPathEffect(SkDashPathEffect::Make(intervals, SK_ARRAY_COUNT(intervals), 0));
+
+        if (fZoomed) {
+            canvas->scale(8, 8);
+            canvas->translate(-300, -220);
+        }
+        for (int i = 0; i < loops; i++) {
+            canvas->drawPath(fPath, p);
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
 // Want to test how we draw a dashed grid (like what is used in spreadsheets) of many
 // small dashed lines switching back and forth between horizontal and vertical
 class DashGridBench : public Benchmark {
@@ -481,4 +530,9 @@ DEF_BENCH( return new DashGridBench(1, 1, true); )
 DEF_BENCH( return new DashGridBench(1, 1, false); )
 DEF_BENCH( return new DashGridBench(3, 1, true); )
 DEF_BENCH( return new DashGridBench(3, 1, false); )
+
+DEF_BENCH( return new DashedPolylineBench(true, false); )
+DEF_BENCH( return new DashedPolylineBench(false, false); )
+DEF_BENCH( return new DashedPolylineBench(true, true); )
+DEF_BENCH( return new DashedPolylineBench(false, true); )
 #endif
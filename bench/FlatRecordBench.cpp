@@ -0,0 +1,140 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRRect.h"
+#include "include/utils/SkNoDrawCanvas.h"
+#include "include/utils/SkRandom.h"
+#include "src/core/SkFlatRecord.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecorder.h"
+
+// Compares SkFlatRecord with SkPicture's serialization, on content both can hold: serializing,
+// deserializing (and for SkFlatRecord, validating), and playing back what was deserialized. Playback
+// goes to an SkNoDrawCanvas, so it times reading the ops rather than rasterizing them.
+class FlatRecordBench : public Benchmark {
+public:
+    enum Format { kPicture, kFlat };
+    enum Stage  { kSerialize, kDeserialize, kPlayback };
+
+    FlatRecordBench(Format format, Stage stage) : fFormat(format), fStage(stage) {
+        static const char* kStages[] = {"serialize", "deserialize", "playback"};
+        fName.printf("flat_record_%s_%s", kStages[stage], format == kFlat ? "flat" : "skp");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return {kSize, kSize}; }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        const SkRect cull = SkRect::MakeWH(kSize, kSize);
+        if (fFormat == kPicture) {
+            SkPictureRecorder recorder;
+            draw_content(recorder.beginRecording(cull));
+            fPicture = recorder.finishRecordingAsPicture();
+            fData = fPicture->serialize();
+            fPicture = SkPicture::MakeFromData(fData.get());
+        } else {
+            fRecord = sk_make_sp<SkRecord>();
+            SkRecorder recorder(fRecord.get(), cull);
+            draw_content(&recorder);
+            fData = SkFlatRecord::Serialize(*fRecord, cull);
+            fFlat = SkFlatRecord::Make(fData);
+        }
+        SkASSERT(fFormat == kPicture ? SkToBool(fPicture) : SkToBool(fFlat));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkRect cull = SkRect::MakeWH(kSize, kSize);
+        SkNoDrawCanvas canvas(kSize, kSize);
+        for (int i = 0; i < loops; i++) {
+            switch (fStage) {
+                case kSerialize:
+                    if (fFormat == kPicture) {
+                        fPicture->serialize();
+                    } else {
+                        SkFlatRecord::Serialize(*fRecord, cull);
+                    }
+                    break;
+                case kDeserialize:
+                    if (fFormat == kPicture) {
+                        SkPicture::MakeFromData(fData.get());
+                    } else {
+                        SkFlatRecord::Make(fData);
+                    }
+                    break;
+                case kPlayback:
+                    if (fFormat == kPicture) {
+                        fPicture->playback(&canvas);
+                    } else {
+                        fFlat->playback(&canvas);
+                    }
+                    break;
+            }
+        }
+    }
+
+private:
+    static constexpr int kSize = 512;
+
+    // Small rects, round rects and paths, as in UI content, in nested saves and clips.
+    static void draw_content(SkCanvas* canvas) {
+        SkRandom rand;
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int group = 0; group < 200; group++) {
+            canvas->save();
+            canvas->translate(rand.nextRangeScalar(0, kSize - 64),
+                              rand.nextRangeScalar(0, kSize - 64));
+            canvas->clipRect(SkRect::MakeWH(64, 64));
+            for (int i = 0; i < 10; i++) {
+                paint.setColor(rand.nextU() | 0xFF000000);
+                paint.setStyle(rand.nextBool() ? SkPaint::kFill_Style : SkPaint::kStroke_Style);
+                SkRect r = SkRect::MakeXYWH(rand.nextRangeScalar(0, 48),
+                                            rand.nextRangeScalar(0, 48),
+                                            rand.nextRangeScalar(1, 16),
+                                            rand.nextRangeScalar(1, 16));
+                switch (i % 3) {
+                    case 0: canvas->drawRect(r, paint); break;
+                    case 1: canvas->drawRRect(SkRRect::MakeRectXY(r, 3, 3), paint); break;
+                    case 2: {
+                        SkPath path;
+                        path.moveTo(r.fLeft, r.fTop);
+                        path.quadTo(r.fRight, r.fTop, r.fRight, r.fBottom);
+                        path.lineTo(r.fLeft, r.fBottom);
+                        path.close();
+                        canvas->drawPath(path, paint);
+                    } break;
+                }
+            }
+            canvas->restore();
+        }
+    }
+
+    Format              fFormat;
+    Stage               fStage;
+    SkString            fName;
+    sk_sp<SkData>       fData;
+    sk_sp<SkPicture>    fPicture;
+    sk_sp<SkRecord>     fRecord;
+    sk_sp<SkFlatRecord> fFlat;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new FlatRecordBench(FlatRecordBench::kPicture, FlatRecordBench::kSerialize); )
+DEF_BENCH( return new FlatRecordBench(FlatRecordBench::kFlat,    FlatRecordBench::kSerialize); )
+DEF_BENCH( return new FlatRecordBench(FlatRecordBench::kPicture, FlatRecordBench::kDeserialize); )
+DEF_BENCH( return new FlatRecordBench(FlatRecordBench::kFlat,    FlatRecordBench::kDeserialize); )
+DEF_BENCH( return new FlatRecordBench(FlatRecordBench::kPicture, FlatRecordBench::kPlayback); )
+DEF_BENCH( return new FlatRecordBench(FlatRecordBench::kFlat,    FlatRecordBench::kPlayback); )
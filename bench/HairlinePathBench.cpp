@@ -110,6 +110,27 @@ private:
     using INHERITED = HairlinePathBench;
 };
 
+// A line chart's series: many short segments, left to right.
+class ChartPathBench : public HairlinePathBench {
+public:
+    ChartPathBench(Flags flags) : INHERITED(flags) {}
+
+    void appendName(SkString* name) override {
+        name->append("chart");
+    }
+    void makePath(SkPath* path) override {
+        SkRandom rand;
+        SkScalar y = 30;
+        path->moveTo(0, y);
+        for (int i = 1; i < 5000; ++i) {
+            y = SkTPin(y + rand.nextRangeScalar(-4, 4), 0.f, 60.f);
+            path->lineTo(i * 0.04f, y);
+        }
+    }
+private:
+    using INHERITED = HairlinePathBench;
+};
+
 class QuadPathBench : public HairlinePathBench {
 public:
     QuadPathBench(Flags flags) : INHERITED(flags) {}
@@ -223,6 +244,9 @@ DEF_BENCH( return new LinePathBench(FLAGS01); )
 DEF_BENCH( return new LinePathBench(FLAGS10); )
 DEF_BENCH( return new LinePathBench(FLAGS11); )
 
+DEF_BENCH( return new ChartPathBench(FLAGS10); )
+DEF_BENCH( return new ChartPathBench(FLAGS11); )
+
 DEF_BENCH( return new QuadPathBench(FLAGS00); )
 DEF_BENCH( return new QuadPathBench(FLAGS01); )
 DEF_BENCH( return new QuadPathBench(FLAGS10); )
@@ -7,6 +7,8 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/effects/SkImageFilters.h"
 #include "include/gpu/GrDirectContext.h"
@@ -103,6 +105,61 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Installs an image filter executor for its lifetime and then restores the previous one.
+class AutoImageFilterExecutor {
+public:
+    explicit AutoImageFilterExecutor(SkExecutor* executor)
+        : fPrevExecutor(SkGraphics::SetImageFilterExecutor(executor)) {}
+    ~AutoImageFilterExecutor() { SkGraphics::SetImageFilterExecutor(fPrevExecutor); }
+
+private:
+    SkExecutor* fPrevExecutor;
+};
+
+// Exercise a large raster blur -> dilate -> displacement DAG, either on the calling thread or
+// split into tiles that are filtered concurrently on a thread pool.
+class ImageFilterTiledDAGBench : public Benchmark {
+public:
+    ImageFilterTiledDAGBench(int threads) : fThreads(threads) {
+        fName.printf("image_filter_dag_tiled_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return kRaster_Backend == backend; }
+
+    SkIPoint onGetSize() override { return SkIPoint::Make(2048, 2048); }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fThreadPool = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        sk_sp<SkImageFilter> blur(SkImageFilters::Blur(12.0f, 12.0f, nullptr));
+        sk_sp<SkImageFilter> dilate(SkImageFilters::Dilate(4.0f, 4.0f, blur));
+        fFilter = SkImageFilters::DisplacementMap(SkColorChannel::kR, SkColorChannel::kG, 8.0f,
+                                                  blur, dilate);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        AutoImageFilterExecutor executor(fThreadPool.get());
+        SkPaint paint;
+        paint.setColor(SK_ColorMAGENTA);
+        paint.setImageFilter(fFilter);
+        for (int j = 0; j < loops; j++) {
+            canvas->drawCircle(1024.0f, 1024.0f, 900.0f, paint);
+        }
+    }
+
+private:
+    int                         fThreads;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fThreadPool;
+    sk_sp<SkImageFilter>        fFilter;
+
+    using INHERITED = Benchmark;
+};
+
 // Exercise a blur filter connected to both inputs of an SkDisplacementMapEffect.
 
 class ImageFilterDisplacedBlur : public Benchmark {
@@ -166,5 +223,8 @@ private:
 
 DEF_BENCH(return new ImageFilterDAGBench;)
 DEF_BENCH(return new ImageMakeWithFilterDAGBench;)
+DEF_BENCH(return new ImageFilterTiledDAGBench(0);)
+DEF_BENCH(return new ImageFilterTiledDAGBench(4);)
+DEF_BENCH(return new ImageFilterTiledDAGBench(8);)
 DEF_BENCH(return new ImageFilterDisplacedBlur;)
 DEF_BENCH(return new ImageFilterXfermodeIn;)
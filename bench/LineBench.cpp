@@ -19,22 +19,43 @@
 class LineBench : public Benchmark {
     SkScalar    fStrokeWidth;
     bool        fDoAA;
+    SkCanvas::PointMode fMode;
     SkString    fName;
-    enum {
-        PTS = 500,
-    };
-    SkPoint fPts[PTS];
+    SkTArray<SkPoint> fPts;
 
 public:
-    LineBench(SkScalar width, bool doAA)  {
+    // A nonzero maxLength keeps the lines short, scattered across the canvas.
+    LineBench(SkScalar width, bool doAA, int count = 500,
+              SkCanvas::PointMode mode = SkCanvas::kLines_PointMode, SkScalar maxLength = 0)  {
         fStrokeWidth = width;
         fDoAA = doAA;
-        fName.printf("lines_%g_%s", width, doAA ? "AA" : "BW");
+        fMode = mode;
+        fName.printf("%s_%g_%s", mode == SkCanvas::kLines_PointMode ? "lines" : "polyline",
+                     width, doAA ? "AA" : "BW");
+        if (count != 500) {
+            fName.appendf("_%d", count);
+        }
+        if (maxLength > 0) {
+            fName.appendf("_short_%g", maxLength);
+        }
 
         SkRandom rand;
-        for (int i = 0; i < PTS; ++i) {
+        fPts.reset(count);
+        for (int i = 0; i < count; ++i) {
             fPts[i].set(rand.nextUScalar1() * 640, rand.nextUScalar1() * 480);
         }
+        if (mode == SkCanvas::kPolygon_PointMode) {
+            // A chart-like series: left to right, with noisy values.
+            for (int i = 0; i < count; ++i) {
+                fPts[i].fX = 640.0f * i / count;
+            }
+        }
+        if (maxLength > 0) {
+            for (int i = 0; i + 1 < count; i += 2) {
+                fPts[i + 1] = fPts[i] + SkVector{rand.nextRangeScalar(-maxLength, maxLength),
+                                                 rand.nextRangeScalar(-maxLength, maxLength)};
+            }
+        }
     }
 
 protected:
@@ -51,7 +72,7 @@ protected:
         paint.setStrokeWidth(fStrokeWidth);
 
         for (int i = 0; i < loops; i++) {
-            canvas->drawPoints(SkCanvas::kLines_PointMode, PTS, fPts, paint);
+            canvas->drawPoints(fMode, fPts.count(), fPts.begin(), paint);
         }
     }
 
@@ -64,3 +85,6 @@ DEF_BENCH(return new LineBench(SK_Scalar1,   false);)
 DEF_BENCH(return new LineBench(0,            true);)
 DEF_BENCH(return new LineBench(SK_Scalar1/2, true);)
 DEF_BENCH(return new LineBench(SK_Scalar1,   true);)
+DEF_BENCH(return new LineBench(0,            true, 100000);)
+DEF_BENCH(return new LineBench(0,            true, 100000, SkCanvas::kPolygon_PointMode);)
+DEF_BENCH(return new LineBench(0,            true, 16, SkCanvas::kLines_PointMode, 10);)
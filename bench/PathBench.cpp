@@ -706,6 +706,74 @@ private:
 };
 
 
+// Draws the same small path (a map marker) at many places, as maps and icon grids do. Only the
+// translation changes between draws, so with gSkUsePathMaskCache set non-volatile paths can reuse
+// cached coverage masks.
+class IconsBench : public Benchmark {
+    SkString                fName;
+    Flags                   fFlags;
+    bool                    fVolatile;
+    SkPath                  fIcon;
+    SkAutoTArray<SkPoint>   fPositions;
+
+    static constexpr int kIconCount = 10000;
+
+public:
+    IconsBench(Flags flags, bool isVolatile)
+        : fFlags(flags), fVolatile(isVolatile), fPositions(kIconCount) {
+        fName.printf("icons_%s%s", fFlags & kStroke_Flag ? "stroke" : "fill",
+                     fVolatile ? "_volatile" : "");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    SkIPoint onGetSize() override {
+        return SkIPoint::Make(640, 480);
+    }
+
+    void onDelayedSetup() override {
+        // A teardrop with a round hole, 20 pixels wide.
+        fIcon.moveTo(10, 30);
+        fIcon.cubicTo(4, 22, 0, 16, 0, 10);
+        fIcon.arcTo(SkRect::MakeWH(20, 20), 180, 180, false);
+        fIcon.cubicTo(20, 16, 16, 22, 10, 30);
+        fIcon.close();
+        fIcon.addCircle(10, 10, 4, SkPathDirection::kCCW);
+        fIcon.setIsVolatile(fVolatile);
+
+        SkRandom rand;
+        for (int i = 0; i < kIconCount; ++i) {
+            fPositions[i] = {rand.nextRangeScalar(-10, 630), rand.nextRangeScalar(-10, 470)};
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkAutoPathMaskCacheOverride pathMaskCache(true);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        if (fFlags & kStroke_Flag) {
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(1.5f);
+        }
+
+        for (int i = 0; i < loops; ++i) {
+            for (int j = 0; j < kIconCount; ++j) {
+                canvas->save();
+                canvas->translate(fPositions[j].fX, fPositions[j].fY);
+                canvas->drawPath(fIcon, paint);
+                canvas->restore();
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
+
 // Chrome creates its own round rects with each corner possibly being different.
 // In its "zero radius" incarnation it creates degenerate round rects.
 // Note: PathTest::test_arb_round_rect_is_convex and
@@ -1206,6 +1274,10 @@ DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kReversePathTo_Ad
 
 DEF_BENCH( return new CirclesBench(FLAGS00); )
 DEF_BENCH( return new CirclesBench(FLAGS01); )
+DEF_BENCH( return new IconsBench(FLAGS00, false); )
+DEF_BENCH( return new IconsBench(FLAGS00, true); )
+DEF_BENCH( return new IconsBench(FLAGS01, false); )
+DEF_BENCH( return new IconsBench(FLAGS01, true); )
 DEF_BENCH( return new ArbRoundRectBench(false); )
 DEF_BENCH( return new ArbRoundRectBench(true); )
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kRect_Type); )
@@ -1279,3 +1351,67 @@ DEF_BENCH( return new CommonConvexBench(200, 16, false, false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, false, true); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  true); )
+
+#include "src/core/SkPackedPath.h"
+
+// Iterates over many small paths, held as SkPaths or packed into single allocations.
+class PackedPathIterBench : public RandomPathBench {
+public:
+    enum class Storage { kSkPath, kPackedFloat, kPackedQuantized };
+
+    PackedPathIterBench(Storage storage) : fStorage(storage) {
+        static const char* gNames[] = { "skpath", "packed", "packed_quantized" };
+        fName.printf("path_iter_storage_%s", gNames[(int)storage]);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        this->createData(10, 100);
+        for (int i = 0; i < kPathCnt; ++i) {
+            SkPath path;
+            this->makePath(&path);
+            if (Storage::kSkPath == fStorage) {
+                fPaths.push_back(path);
+            } else {
+                fPacked.push_back(SkPackedPath::Make(path, Storage::kPackedQuantized == fStorage
+                                                     ? SkPackedPath::Precision::kQuantized16
+                                                     : SkPackedPath::Precision::kFloat));
+            }
+        }
+        this->finishedMakingPaths();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTDArray<SkPoint> storage;
+        SkScalar sum = 0;
+        for (int i = 0; i < loops; ++i) {
+            for (int j = 0; j < kPathCnt; ++j) {
+                SkPathView view = Storage::kSkPath == fStorage ? fPaths[j].view()
+                                                               : fPacked[j]->view(&storage);
+                for (auto [verb, pts, w] : SkPathPriv::Iterate(view)) {
+                    sum += pts[0].fX + (int)verb;
+                }
+            }
+        }
+        fSum = sum;
+    }
+
+private:
+    static constexpr int kPathCnt = 1 << 12;
+
+    Storage                          fStorage;
+    SkString                         fName;
+    SkTArray<SkPath>                 fPaths;
+    SkTArray<sk_sp<SkPackedPath>>    fPacked;
+    SkScalar                         fSum = 0;
+
+    using INHERITED = RandomPathBench;
+};
+
+DEF_BENCH( return new PackedPathIterBench(PackedPathIterBench::Storage::kSkPath); )
+DEF_BENCH( return new PackedPathIterBench(PackedPathIterBench::Storage::kPackedFloat); )
+DEF_BENCH( return new PackedPathIterBench(PackedPathIterBench::Storage::kPackedQuantized); )
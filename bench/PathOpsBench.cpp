@@ -6,12 +6,14 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/pathops/SkPathOps.h"
 #include "include/private/SkTArray.h"
 #include "include/utils/SkRandom.h"
+#include "src/pathops/SkPathOpsCommon.h"
 
 class PathOpsBench : public Benchmark {
     SkString    fName;
@@ -81,6 +83,59 @@ private:
 DEF_BENCH( return new PathOpsBench("sect", kIntersect_SkPathOp); )
 DEF_BENCH( return new PathOpsBench("join", kUnion_SkPathOp); )
 
+// Ops on polygons: two 64-sided circles, and two 31-pointed stars whose edges cross each other.
+// With 'general', they go through the same code as paths with curves.
+class PathOpsPolygonBench : public Benchmark {
+    SkString    fName;
+    SkPath      fPath1, fPath2;
+    SkPathOp    fOp;
+    bool        fGeneral;
+
+public:
+    PathOpsPolygonBench(const char suffix[], SkPathOp op, bool stars, bool general)
+            : fOp(op), fGeneral(general) {
+        fName.printf("pathops_polygon_%s_%s%s", stars ? "stars" : "circles", suffix,
+                     general ? "_general" : "");
+        const int points = stars ? 31 : 64;
+        const int step = stars ? 15 : 1;
+        for (int i = 0; i < points; ++i) {
+            SkScalar angle = 2 * SK_ScalarPI * i * step / points;
+            SkPoint pt1 = {40 * SkScalarCos(angle), 40 * SkScalarSin(angle)},
+                    pt2 = {pt1.fX + 25, pt1.fY + 10};
+            i ? fPath1.lineTo(pt1) : fPath1.moveTo(pt1);
+            i ? fPath2.lineTo(pt2) : fPath2.moveTo(pt2);
+        }
+        fPath1.close();
+        fPath2.close();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkAutoPathOpsPolygonOpOverride usePolygonOp(!fGeneral);
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < 100; ++j) {
+                SkPath result;
+                Op(fPath1, fPath2, fOp, &result);
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsPolygonBench("sect", kIntersect_SkPathOp, false, false); )
+DEF_BENCH( return new PathOpsPolygonBench("sect", kIntersect_SkPathOp, false, true); )
+DEF_BENCH( return new PathOpsPolygonBench("xor", kXOR_SkPathOp, true, false); )
+DEF_BENCH( return new PathOpsPolygonBench("xor", kXOR_SkPathOp, true, true); )
+
 static SkPath makerects() {
     SkRandom rand;
     SkPath path;
@@ -94,6 +149,74 @@ static SkPath makerects() {
 }
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
 
+// Unions a few thousand building footprints, as a map would: rows of rects and L-shapes, each
+// overlapping or touching its neighbor, scattered so that most rows don't touch each other.
+class PathOpsBuilderBench : public Benchmark {
+    SkString                    fName;
+    SkTArray<SkPath>            fPaths;
+    std::unique_ptr<SkExecutor> fExecutor;
+    bool                        fThreaded;
+
+public:
+    PathOpsBuilderBench(bool threaded) : fThreaded(threaded) {
+        fName.printf("pathops_builder_footprints%s", threaded ? "_threaded" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        while (fPaths.count() < 2000) {
+            SkScalar x = rand.nextRangeScalar(0, 4000),
+                     y = rand.nextRangeScalar(0, 4000);
+            for (int count = 1 + rand.nextULessThan(12); count > 0; --count) {
+                SkScalar w = rand.nextRangeScalar(6, 20),
+                         h = rand.nextRangeScalar(8, 25);
+                SkPath& path = fPaths.push_back();
+                if (rand.nextBool()) {
+                    path.addRect(x, y, x + w, y + h);
+                } else {
+                    path.moveTo(x, y);
+                    path.lineTo(x + w, y);
+                    path.lineTo(x + w, y + h * 0.6f);
+                    path.lineTo(x + w * 0.5f, y + h * 0.6f);
+                    path.lineTo(x + w * 0.5f, y + h);
+                    path.lineTo(x, y + h);
+                    path.close();
+                }
+                x += w - rand.nextRangeScalar(-3, 2);
+            }
+        }
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            builder.setExecutor(fExecutor.get());
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result);
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsBuilderBench(false); )
+DEF_BENCH( return new PathOpsBuilderBench(true); )
+
 #include "include/core/SkPathBuilder.h"
 
 template <size_t N> struct ArrayPath {
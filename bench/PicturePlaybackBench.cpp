@@ -16,6 +16,9 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkString.h"
 #include "include/utils/SkRandom.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecordDraw.h"
 
 // This is designed to emulate about 4 screens of textual content
 
@@ -97,3 +100,70 @@ DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kTiled ); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kTiled ); )
+
+// Plays back small viewports into a large picture, e.g. a map or a long document scrolled into
+// view a screen at a time.  Compares a BBH recorded with the picture, the one built lazily on
+// first playback of a picture recorded without one, and visiting every op.
+enum Index { kRecorded, kLazy, kUnindexed };
+class ViewportPlaybackBench : public Benchmark {
+public:
+    ViewportPlaybackBench(Index index) : fIndex(index), fName("viewport_playback") {
+        switch (fIndex) {
+            case kRecorded:  fName.append("_rtree"    ); break;
+            case kLazy:      fName.append("_lazy"     ); break;
+            case kUnindexed: fName.append("_unindexed"); break;
+        }
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return SkIPoint::Make(256,256); }
+
+    void onDelayedSetup() override {
+        SkRTreeFactory factory;
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(kPictureSize, kPictureSize,
+                                                   fIndex == kRecorded ? &factory : nullptr);
+            SkRandom rand;
+            for (int i = 0; i < 100000; i++) {
+                SkScalar x = rand.nextRangeScalar(0, kPictureSize),
+                         y = rand.nextRangeScalar(0, kPictureSize),
+                         w = rand.nextRangeScalar(0, 64),
+                         h = rand.nextRangeScalar(0, 64);
+                SkPaint paint;
+                paint.setColor(rand.nextU());
+                paint.setAlpha(0xFF);
+                canvas->drawRect(SkRect::MakeXYWH(x,y,w,h), paint);
+            }
+        fPic = recorder.finishRecordingAsPicture();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(fPic);
+        SkASSERT(big);
+        for (int i = 0; i < loops; i++) {
+            SkRandom rand;
+            for (int j = 0; j < 10; j++) {
+                SkAutoCanvasRestore ar(canvas, true/*save now*/);
+                canvas->clipRect(SkRect::MakeWH(256, 256));
+                canvas->translate(-rand.nextRangeScalar(0, kPictureSize - 256),
+                                  -rand.nextRangeScalar(0, kPictureSize - 256));
+                if (fIndex == kUnindexed) {
+                    SkRecordDraw(*big->record(), canvas, nullptr, nullptr, 0, nullptr, nullptr);
+                } else {
+                    fPic->playback(canvas);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr SkScalar kPictureSize = 8192;
+
+    Index               fIndex;
+    SkString            fName;
+    sk_sp<SkPicture>    fPic;
+};
+
+DEF_BENCH( return new ViewportPlaybackBench(kRecorded ); )
+DEF_BENCH( return new ViewportPlaybackBench(kLazy     ); )
+DEF_BENCH( return new ViewportPlaybackBench(kUnindexed); )
@@ -10,6 +10,7 @@
 #include "include/core/SkString.h"
 #include "include/private/SkTemplates.h"
 #include "include/utils/SkRandom.h"
+#include "src/core/SkFlatRTree.h"
 #include "src/core/SkRTree.h"
 
 // confine rectangles to a smallish area, so queries generally hit something, and overlap occurs:
@@ -20,11 +21,16 @@ static const int GRID_WIDTH = 100;
 
 typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 
+template <typename Tree> static const char* tree_name();
+template <> const char* tree_name<SkRTree>()     { return "rtree"; }
+template <> const char* tree_name<SkFlatRTree>() { return "flatrtree"; }
+
 // Time how long it takes to build an R-Tree.
+template <typename Tree>
 class RTreeBuildBench : public Benchmark {
 public:
     RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
-        fName.printf("rtree_%s_build", name);
+        fName.printf("%s_%s_build", tree_name<Tree>(), name);
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -43,7 +49,7 @@ protected:
         }
 
         for (int i = 0; i < loops; ++i) {
-            SkRTree tree;
+            Tree tree;
             tree.insert(rects.get(), NUM_BUILD_RECTS);
             SkASSERT(rects != nullptr);  // It'd break this bench if the tree took ownership of rects.
         }
@@ -55,10 +61,11 @@ private:
 };
 
 // Time how long it takes to perform queries on an R-Tree.
+template <typename Tree>
 class RTreeQueryBench : public Benchmark {
 public:
     RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
-        fName.printf("rtree_%s_query", name);
+        fName.printf("%s_%s_query", tree_name<Tree>(), name);
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -90,7 +97,7 @@ protected:
         }
     }
 private:
-    SkRTree fTree;
+    Tree fTree;
     MakeRectProc fProc;
     SkString fName;
     using INHERITED = Benchmark;
@@ -126,14 +133,101 @@ static inline SkRect make_concentric_rects(SkRandom&, int index, int numRects) {
     return SkRect::MakeWH(SkIntToScalar(index+1), SkIntToScalar(index+1));
 }
 
-///////////////////////////////////////////////////////////////////////////////
+// Time how long it takes to find the ops for each 256x256 tile of a frame in a picture with
+// about a million ops, recorded in rows like a long page of content.
+template <typename Tree>
+class RTreeTileQueryBench : public Benchmark {
+public:
+    RTreeTileQueryBench(bool batched) : fBatched(batched) {
+        fName.printf("%s_tiles_1M_query%s", tree_name<Tree>(), batched ? "_batched" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    static constexpr int kRects = 1 << 20,
+                         kPageWidth = 2048,
+                         kTiles = 32;  // A 2048x1024 frame.
 
-DEF_BENCH(return new RTreeBuildBench("XY", &make_XYordered_rects));
-DEF_BENCH(return new RTreeBuildBench("YX", &make_YXordered_rects));
-DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects));
-DEF_BENCH(return new RTreeBuildBench("concentric", &make_concentric_rects));
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkAutoTMalloc<SkRect> rects(kRects);
+        for (int i = 0; i < kRects; ++i) {
+            // Rows of 256 ops, 8px apart.
+            SkScalar x = (i % 256) * (kPageWidth / 256.0f) + rand.nextRangeF(0, 4),
+                     y = (i / 256) * 8.0f;
+            rects[i] = SkRect::MakeXYWH(x, y, rand.nextRangeF(1, 16), rand.nextRangeF(1, 12));
+        }
+        fTree.insert(rects.get(), kRects);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkRandom rand;
+        for (int i = 0; i < loops; ++i) {
+            const SkScalar top = rand.nextRangeF(0, (kRects / 256) * 8.0f - 1024);
+            SkRect tiles[kTiles];
+            for (int t = 0; t < kTiles; ++t) {
+                tiles[t] = SkRect::MakeXYWH((t % 8) * 256.0f, top + (t / 8) * 256.0f, 256, 256);
+            }
+            this->search(tiles);
+        }
+    }
+
+private:
+    void search(const SkRect tiles[]);
+
+    Tree fTree;
+    bool fBatched;
+    SkString fName;
+    using INHERITED = Benchmark;
+};
+
+template <> void RTreeTileQueryBench<SkRTree>::search(const SkRect tiles[]) {
+    for (int t = 0; t < kTiles; ++t) {
+        std::vector<int> hits;
+        fTree.search(tiles[t], &hits);
+    }
+}
+
+template <> void RTreeTileQueryBench<SkFlatRTree>::search(const SkRect tiles[]) {
+    if (fBatched) {
+        std::vector<int> hits[kTiles];
+        fTree.search(tiles, kTiles, hits);
+    } else {
+        for (int t = 0; t < kTiles; ++t) {
+            std::vector<int> hits;
+            fTree.search(tiles[t], &hits);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
 
-DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
-DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
-DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
-DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("XY", &make_XYordered_rects));
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("YX", &make_YXordered_rects));
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("random", &make_random_rects));
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("XY", &make_XYordered_rects));
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("YX", &make_YXordered_rects));
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("random", &make_random_rects));
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeBuildBench<SkFlatRTree>("XY", &make_XYordered_rects));
+DEF_BENCH(return new RTreeBuildBench<SkFlatRTree>("YX", &make_YXordered_rects));
+DEF_BENCH(return new RTreeBuildBench<SkFlatRTree>("random", &make_random_rects));
+DEF_BENCH(return new RTreeBuildBench<SkFlatRTree>("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeQueryBench<SkFlatRTree>("XY", &make_XYordered_rects));
+DEF_BENCH(return new RTreeQueryBench<SkFlatRTree>("YX", &make_YXordered_rects));
+DEF_BENCH(return new RTreeQueryBench<SkFlatRTree>("random", &make_random_rects));
+DEF_BENCH(return new RTreeQueryBench<SkFlatRTree>("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeTileQueryBench<SkRTree>(false));
+DEF_BENCH(return new RTreeTileQueryBench<SkFlatRTree>(false));
+DEF_BENCH(return new RTreeTileQueryBench<SkFlatRTree>(true));
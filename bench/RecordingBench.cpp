@@ -7,6 +7,7 @@
 
 #include "bench/RecordingBench.h"
 #include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkPictureRecorder.h"
 
 PictureCentricBench::PictureCentricBench(const char* name, const SkPicture* pic) : fName(name) {
@@ -71,3 +72,37 @@ void DeserializePictureBench::onDraw(int loops, SkCanvas*) {
         SkPicture::MakeFromData(fEncodedPicture.get());
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+FirstPixelBench::FirstPixelBench(const char* name, sk_sp<SkData> data, bool lazy)
+    : fName(SkStringPrintf("first_pixel_%s%s", lazy ? "lazy_" : "", name))
+    , fEncodedPicture(std::move(data))
+    , fLazy(lazy)
+{}
+
+const char* FirstPixelBench::onGetName() {
+    return fName.c_str();
+}
+
+bool FirstPixelBench::isSuitableFor(Backend backend) {
+    return backend == kNonRendering_Backend;
+}
+
+SkIPoint FirstPixelBench::onGetSize() {
+    return SkIPoint::Make(256, 256);
+}
+
+void FirstPixelBench::onDelayedSetup() {
+    fSurface = SkSurface::MakeRasterN32Premul(256, 256);
+}
+
+void FirstPixelBench::onDraw(int loops, SkCanvas*) {
+    for (int i = 0; i < loops; ++i) {
+        sk_sp<SkPicture> picture = fLazy ? SkPicture::MakeLazyFromData(fEncodedPicture)
+                                         : SkPicture::MakeFromData(fEncodedPicture.get());
+        if (picture) {
+            fSurface->getCanvas()->drawPicture(picture);
+        }
+    }
+}
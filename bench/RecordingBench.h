@@ -10,6 +10,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkSurface.h"
 
 class PictureCentricBench : public Benchmark {
 public:
@@ -57,4 +58,26 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Reads a serialized picture, completely or lazily, and draws its top left corner, as a viewer
+// would before anything else.
+class FirstPixelBench : public Benchmark {
+public:
+    FirstPixelBench(const char* name, sk_sp<SkData> encodedPicture, bool lazy);
+
+protected:
+    const char* onGetName() override;
+    bool isSuitableFor(Backend) override;
+    SkIPoint onGetSize() override;
+    void onDelayedSetup() override;
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    SkString         fName;
+    sk_sp<SkData>    fEncodedPicture;
+    bool             fLazy;
+    sk_sp<SkSurface> fSurface;
+
+    using INHERITED = Benchmark;
+};
+
 #endif//RecordingBench_DEFINED
@@ -74,4 +74,63 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
+#ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+namespace {
+// Shapes each line of a text as its own paragraph, many times over, the way a long document is
+// laid out; with the word cache on, the words repeated across lines are shaped once.
+struct ShaperWordCacheBench : public Benchmark {
+    ShaperWordCacheBench(const char* r, const char* n, int cacheLimit)
+        : fResource(r), fName(n), fCacheLimit(cacheLimit) {}
+    std::unique_ptr<SkShaper> fShaper;
+    sk_sp<SkData> fData;
+    const char* fResource;
+    const char* fName;
+    int fCacheLimit;
+    int fPreviousLimit = 0;
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        fShaper = SkShaper::MakeShapeThenWrap();
+        fData = GetResourceAsData(fResource);
+    }
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        fPreviousLimit = SkShaper::SetHarfBuzzWordCacheLimit(fCacheLimit);
+    }
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        SkShaper::SetHarfBuzzWordCacheLimit(fPreviousLimit);
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData || !fShaper) { return; }
+        SkFont font;
+        const char* text = (const char*)fData->data();
+        size_t len = fData->size();
+        while (loops-- > 0) {
+            for (int copy = 0; copy < 10; ++copy) {
+                size_t start = 0;
+                for (size_t i = 0; i <= len; ++i) {
+                    if (i < len && text[i] != '\n') {
+                        continue;
+                    }
+                    if (i > start) {
+                        SkTextBlobBuilderRunHandler rh(text + start, {0, 0});
+                        fShaper->shape(text + start, i - start, font, true, 500, &rh);
+                        (void)rh.makeBlob();
+                    }
+                    start = i + 1;
+                }
+            }
+        }
+    }
+};
+}  // namespace
+
+#define SHAPER_WORD_CACHE_BENCH(X) \
+    DEF_BENCH(return new ShaperWordCacheBench("text/" #X ".txt", "shaper_lines_" #X, 0);) \
+    DEF_BENCH(return new ShaperWordCacheBench("text/" #X ".txt", "shaper_lines_word_cache_" #X, \
+                                              10000);)
+SHAPER_WORD_CACHE_BENCH(english)
+SHAPER_WORD_CACHE_BENCH(han_simplified)
+#undef SHAPER_WORD_CACHE_BENCH
+#endif
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
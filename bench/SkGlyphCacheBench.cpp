@@ -9,7 +9,10 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "src/core/SkRemoteGlyphCache.h"
 #include "src/core/SkStrikeCache.h"
@@ -112,10 +115,127 @@ private:
     SkString fName;
 };
 
+// Rasterizes glyphs of many different sizes on a cold cache, split across a pool of threads.
+// The total work is the same for every pool size, so this should speed up with the number of
+// threads until it runs out of cores.
+class SkGlyphCacheColdThreaded : public Benchmark {
+public:
+    explicit SkGlyphCacheColdThreaded(int threads) : fThreads(threads) {
+        fName.printf("SkGlyphCacheColdThreaded_%d", fThreads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        fTypeface = SkTypeface::MakeDefault();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        constexpr int kTasks = 32;
+        for (int work = 0; work < loops; work++) {
+            SkGraphics::PurgeFontCache();
+            SkTaskGroup(*fExecutor).batch(kTasks, [&](int task) {
+                SkFont font(fTypeface, 9 + task * 0.75f);
+                font.setEdging(SkFont::Edging::kAntiAlias);
+                SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                        font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                        SkScalerContextFlags::kNone, SkMatrix::I());
+                SkPackedGlyphID glyphs['z'];
+                for (int c = ' '; c < 'z'; c++) {
+                    glyphs[c] = SkPackedGlyphID{font.unicharToGlyph(c)};
+                }
+                SkBulkGlyphMetricsAndImages images{strikeSpec};
+                (void)images.glyphs({&glyphs[SkTo<int>(' ')], 'z' - ' '});
+            });
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+    const int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<SkTypeface> fTypeface;
+};
+
+// Draws a page of text on a cold cache, optionally preloading the cache from a snapshot taken
+// after drawing the same page, as a worker process would at startup.
+class SkGlyphCacheFirstPage : public Benchmark {
+public:
+    explicit SkGlyphCacheFirstPage(bool preload) : fPreload(preload) {
+        fName.printf("SkGlyphCacheFirstPage_%s", fPreload ? "preloaded" : "cold");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fTypeface = SkTypeface::MakeDefault();
+        fSurface = SkSurface::MakeRasterN32Premul(800, 1000);
+        SkGraphics::PurgeFontCache();
+        this->drawPage();
+        fSnapshot = SkStrikeCacheSnapshot::Make();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int work = 0; work < loops; work++) {
+            SkGraphics::PurgeFontCache();
+            if (fPreload) {
+                SkStrikeCacheSnapshot::Preload(fSnapshot->data(), fSnapshot->size(), {fTypeface});
+            }
+            this->drawPage();
+        }
+    }
+
+private:
+    void drawPage() {
+        static constexpr char kLine[] = "The quick brown fox jumps over the lazy dog, 0123456789!";
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        SkScalar y = 0;
+        // A heading, subheadings and body text, in the sizes a page typically uses.
+        for (SkScalar size : {32, 20, 14, 11, 11, 11, 9}) {
+            SkFont font(fTypeface, size);
+            font.setSubpixel(true);
+            for (int line = 0; line < 6; line++) {
+                y += size * 1.2f;
+                canvas->drawSimpleText(kLine, sizeof(kLine) - 1, SkTextEncoding::kUTF8,
+                                       10, y, font, paint);
+            }
+        }
+    }
+
+    using INHERITED = Benchmark;
+    const bool fPreload;
+    SkString fName;
+    sk_sp<SkTypeface> fTypeface;
+    sk_sp<SkSurface> fSurface;
+    sk_sp<SkData> fSnapshot;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheColdThreaded(1); )
+DEF_BENCH( return new SkGlyphCacheColdThreaded(4); )
+DEF_BENCH( return new SkGlyphCacheColdThreaded(16); )
+DEF_BENCH( return new SkGlyphCacheFirstPage(false); )
+DEF_BENCH( return new SkGlyphCacheFirstPage(true); )
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
@@ -243,8 +363,61 @@ public:
     DiffCanvasBench(SkString n, std::function<std::unique_ptr<SkStreamAsset>()> f)
         : fBenchName(std::move(n)), fDataProvider(std::move(f)) {}
 };
+
+// Several clients, each with its own server on its own thread, record the same text and write
+// their strike data, as a glyph process serving many renderers does. With shared strikes each
+// glyph is made once, instead of once per client.
+class StrikeServerClientsBench : public Benchmark {
+    static constexpr int kClients = 8;
+
+    SkString fBenchName;
+    const bool fShareStrikes;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<sk_sp<SkTextBlob>> fBlobs;
+
+    const char* onGetName() override { return fBenchName.c_str(); }
+
+    bool isSuitableFor(Backend b) override { return b == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(kClients);
+        sk_sp<SkTypeface> typeface = SkTypeface::MakeDefault();
+        static constexpr char kText[] = "The quick brown fox jumps over the lazy dog, 0123456789!";
+        for (SkScalar size = 9; size < 30; size++) {
+            SkFont font(typeface, size);
+            font.setSubpixel(true);
+            fBlobs.push_back(SkTextBlob::MakeFromText(kText, sizeof(kText) - 1, font));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkSurfaceProps props(SkSurfaceProps::kLegacyFontHost_InitType);
+        for (int work = 0; work < loops; work++) {
+            SkStrikeCache sharedStrikes;
+            SkTaskGroup(*fExecutor).batch(kClients, [&](int) {
+                sk_sp<DiscardableManager> manager = sk_make_sp<DiscardableManager>();
+                SkStrikeServer server(manager.get(), fShareStrikes ? &sharedStrikes : nullptr);
+                SkTextBlobCacheDiffCanvas canvas{1024, 1024, props, &server};
+                for (const sk_sp<SkTextBlob>& blob : fBlobs) {
+                    canvas.drawTextBlob(blob.get(), 0, 100, SkPaint());
+                }
+                std::vector<uint8_t> strikeData;
+                server.writeStrikeData(&strikeData);
+            });
+        }
+    }
+
+public:
+    explicit StrikeServerClientsBench(bool shareStrikes) : fShareStrikes(shareStrikes) {
+        fBenchName.printf("SkStrikeServer_%dclients_%s", kClients,
+                          shareStrikes ? "shared" : "unshared");
+    }
+};
 }  // namespace
 
+DEF_BENCH( return new StrikeServerClientsBench(false); )
+DEF_BENCH( return new StrikeServerClientsBench(true); )
+
 Benchmark* CreateDiffCanvasBench(
         SkString name, std::function<std::unique_ptr<SkStreamAsset>()> dataSrc) {
     return new DiffCanvasBench(std::move(name), std::move(dataSrc));
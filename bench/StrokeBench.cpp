@@ -6,10 +6,15 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkString.h"
+#include "include/private/SkTArray.h"
 #include "include/utils/SkRandom.h"
+#include "src/core/SkStroke.h"
+#include "src/core/SkTaskGroup.h"
 
 class StrokeBench : public Benchmark {
 public:
@@ -117,3 +122,99 @@ DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_.25", .
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_.25", .25f);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_.25", .25f);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_.25", .25f);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Strokes a long wandering polyline, like live ink: all at once, in chunks of verbs on a thread
+// pool, or as it grows, either restroking all of it or only the verbs appended since last time.
+class LongPolylineStrokeBench : public Benchmark {
+public:
+    enum class Mode { kWhole, kThreadedChunks, kRestrokeOnAppend, kStrokeAppended };
+
+    LongPolylineStrokeBench(Mode mode, int points) : fMode(mode), fPoints(points) {
+        static const char* gNames[] = { "whole", "threaded_chunks", "restroke_on_append",
+                                        "stroke_appended" };
+        fName.printf("build_stroke_long_polyline_%d_%s", points, gNames[(int)mode]);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkPoint pt = {0, 0};
+        SkVector dir = {1, 0};
+        fPath.moveTo(pt);
+        for (int i = 1; i < fPoints; ++i) {
+            dir = SkMatrix::RotateDeg(rand.nextRangeScalar(-40, 40)).mapVector(dir.fX, dir.fY);
+            pt += dir * rand.nextRangeScalar(1, 4);
+            fPath.lineTo(pt);
+        }
+        fPaint.setStyle(SkPaint::kStroke_Style);
+        fPaint.setStrokeWidth(3);
+        fPaint.setStrokeJoin(SkPaint::kRound_Join);
+        fPaint.setStrokeCap(SkPaint::kRound_Cap);
+        if (Mode::kThreadedChunks == fMode) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(4);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkStroke stroke(fPaint);
+        const int verbCount = fPath.countVerbs();
+        for (int i = 0; i < loops; ++i) {
+            SkPath result;
+            switch (fMode) {
+                case Mode::kWhole:
+                    stroke.strokePath(fPath, &result);
+                    break;
+                case Mode::kThreadedChunks: {
+                    constexpr int kChunks = 16;
+                    SkPath chunks[kChunks];
+                    SkTaskGroup(*fExecutor).batch(kChunks, [&](int chunk) {
+                        stroke.strokePathRange(fPath, verbCount * chunk / kChunks,
+                                               verbCount * (chunk + 1) / kChunks, &chunks[chunk]);
+                    });
+                    for (const SkPath& chunk : chunks) {
+                        result.addPath(chunk);
+                    }
+                } break;
+                case Mode::kRestrokeOnAppend:
+                case Mode::kStrokeAppended: {
+                    // The path grows by kAppended verbs at a time, and is stroked after each.
+                    constexpr int kAppended = 16;
+                    SkPath tail;
+                    for (int end = kAppended; end < verbCount + kAppended; end += kAppended) {
+                        if (Mode::kRestrokeOnAppend == fMode) {
+                            stroke.strokePathRange(fPath, 0, end, &result);
+                        } else {
+                            stroke.strokePathRange(fPath, end - kAppended, end, &tail);
+                            result.addPath(tail);
+                        }
+                    }
+                } break;
+            }
+        }
+    }
+
+private:
+    Mode                        fMode;
+    int                         fPoints;
+    SkString                    fName;
+    SkPath                      fPath;
+    SkPaint                     fPaint;
+    std::unique_ptr<SkExecutor> fExecutor;
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new LongPolylineStrokeBench(LongPolylineStrokeBench::Mode::kWhole, 100000);)
+DEF_BENCH(return new LongPolylineStrokeBench(LongPolylineStrokeBench::Mode::kThreadedChunks,
+                                             100000);)
+DEF_BENCH(return new LongPolylineStrokeBench(LongPolylineStrokeBench::Mode::kRestrokeOnAppend,
+                                             4000);)
+DEF_BENCH(return new LongPolylineStrokeBench(LongPolylineStrokeBench::Mode::kStrokeAppended,
+                                             4000);)
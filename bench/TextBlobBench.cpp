@@ -11,8 +11,11 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
+#include "include/effects/SkGradientShader.h"
 #include "include/private/SkTemplates.h"
 #include "include/utils/SkRandom.h"
 #include "tools/Resources.h"
@@ -109,3 +112,133 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+/*
+ * A paragraph of small, densely set text in one run, as a page of body text would draw.
+ */
+class TextBlobDenseParagraphBench : public Benchmark {
+public:
+    TextBlobDenseParagraphBench(SkFont::Edging edging, bool gradient)
+            : fEdging(edging), fGradient(gradient) {
+        fName.printf("TextBlobDenseParagraph_%s%s",
+                     edging == SkFont::Edging::kSubpixelAntiAlias ? "lcd" : "aa",
+                     gradient ? "_gradient" : "");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 9);
+        font.setSubpixel(true);
+        font.setEdging(fEdging);
+
+        const char* text = "Keep your sentences short, but not overly so. ";
+        const int count = font.countText(text, strlen(text), SkTextEncoding::kUTF8);
+        SkAutoTArray<SkGlyphID> glyphs(count);
+        SkAutoTArray<SkScalar> widths(count);
+        font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8, glyphs.get(), count);
+        font.getWidths(glyphs.get(), count, widths.get());
+
+        // 60 lines of about 100 glyphs, set 11 pixels apart.
+        constexpr int kLines = 60, kGlyphsPerLine = 100;
+        SkTextBlobBuilder builder;
+        const auto& run = builder.allocRunPos(font, kLines * kGlyphsPerLine);
+        for (int line = 0, i = 0; line < kLines; line++) {
+            SkScalar x = 10;
+            for (int g = 0; g < kGlyphsPerLine; g++, i++) {
+                run.glyphs[i] = glyphs[i % count];
+                run.points()[i] = {x, 20.0f + line * 11};
+                x += widths[i % count];
+            }
+        }
+        fBlob = builder.make();
+
+        if (fGradient) {
+            SkPoint pts[] = {{0, 0}, {500, 680}};
+            SkColor colors[] = {SK_ColorBLACK, SK_ColorBLUE};
+            fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                          SkTileMode::kClamp));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            canvas->drawTextBlob(fBlob, 0, 0, fPaint);
+        }
+    }
+
+private:
+    SkFont::Edging    fEdging;
+    bool              fGradient;
+    SkString          fName;
+    sk_sp<SkTextBlob> fBlob;
+    SkPaint           fPaint;
+
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new TextBlobDenseParagraphBench(SkFont::Edging::kAntiAlias, false); )
+DEF_BENCH( return new TextBlobDenseParagraphBench(SkFont::Edging::kAntiAlias, true); )
+DEF_BENCH( return new TextBlobDenseParagraphBench(SkFont::Edging::kSubpixelAntiAlias, false); )
+
+/*
+ * A paragraph redrawn at a slightly different scale each time, as a pinch zoom would draw it, on
+ * a raster surface that asks for distance field text or not. Masks are rasterized anew for every
+ * scale, while distance fields are rendered once per size bucket.
+ */
+class TextBlobZoomBench : public Benchmark {
+public:
+    explicit TextBlobZoomBench(bool distanceFields) : fDistanceFields(distanceFields) {
+        fName.printf("TextBlobZoom_%s", distanceFields ? "sdf" : "mask");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 20);
+        font.setEdging(SkFont::Edging::kAntiAlias);
+
+        SkTextBlobBuilder builder;
+        const char* text = "Keep your sentences short, but not overly so.";
+        for (int line = 0; line < 10; line++) {
+            const int count = font.countText(text, strlen(text), SkTextEncoding::kUTF8);
+            const auto& run = builder.allocRun(font, count, 10, 30.0f + line * 24);
+            font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8, run.glyphs, count);
+        }
+        fBlob = builder.make();
+
+        const SkSurfaceProps props(
+                fDistanceFields ? SkSurfaceProps::kUseDeviceIndependentFonts_Flag : 0,
+                kUnknown_SkPixelGeometry);
+        fSurface = SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(640, 480), &props);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas* canvas = fSurface->getCanvas();
+        for (int i = 0; i < loops; i++) {
+            // Zoom from 1x to 1.5x, and back, a frame at a time.
+            int step = fStep++ % 2000;
+            SkScalar scale = 1 + 0.0005f * (step < 1000 ? step : 2000 - step);
+            canvas->save();
+            canvas->scale(scale, scale);
+            canvas->drawTextBlob(fBlob, 0, 0, SkPaint());
+            canvas->restore();
+        }
+    }
+
+private:
+    bool              fDistanceFields;
+    SkString          fName;
+    sk_sp<SkTextBlob> fBlob;
+    sk_sp<SkSurface>  fSurface;
+    int               fStep = 0;
+
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new TextBlobZoomBench(false); )
+DEF_BENCH( return new TextBlobZoomBench(true); )
@@ -806,6 +806,22 @@ public:
             return new DeserializePictureBench(name.c_str(), std::move(data));
         }
 
+        // And as FirstPixelBenches, reading each completely and then lazily.
+        while (fCurrentFirstPixel < 2 * fSKPs.count()) {
+            const bool lazy = fCurrentFirstPixel % 2;
+            const SkString& path = fSKPs[fCurrentFirstPixel++ / 2];
+            sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+            if (!data) {
+                continue;
+            }
+            SkString name = SkOSPath::Basename(path.c_str());
+            fSourceType = "skp";
+            fBenchType  = "deserial";
+            fSKPBytes = static_cast<double>(data->size());
+            fSKPOps   = 0;
+            return new FirstPixelBench(name.c_str(), std::move(data), lazy);
+        }
+
         // Then once each for each scale as SKPBenches (playback).
         while (fCurrentScale < fScales.count()) {
             while (fCurrentSKP < fSKPs.count()) {
@@ -1114,6 +1130,7 @@ private:
     const char* fBenchType;   // How we bench it: micro, recording, playback, ...
     int fCurrentRecording = 0;
     int fCurrentDeserialPicture = 0;
+    int fCurrentFirstPixel = 0;
     int fCurrentScale = 0;
     int fCurrentSKP = 0;
     int fCurrentSVG = 0;
@@ -11,6 +11,7 @@
 #include "include/core/SkRefCnt.h"
 
 class SkData;
+class SkExecutor;
 class SkImageGenerator;
 class SkTraceMemoryDump;
 
@@ -172,6 +173,33 @@ public:
      *  Call early in main() to allow Skia to use a JIT to accelerate CPU-bound operations.
      */
     static void AllowJIT();
+
+    /**
+     *  Raster image filters that support it will split large outputs into tiles and filter them
+     *  concurrently on this executor. The executor is not owned and must outlive all drawing that
+     *  may use it. Passing NULL (the default) filters on the calling thread.
+     *
+     *  Returns the previous executor (which could be NULL).
+     */
+    static SkExecutor* SetImageFilterExecutor(SkExecutor*);
+
+    /**
+     *  These functions get/set the memory usage limit for the raster image filter cache, which
+     *  holds intermediate and final filter results. Entries are purged when the memory usage
+     *  exceeds this limit.
+     */
+    static size_t GetImageFilterCacheByteLimit();
+    static size_t SetImageFilterCacheByteLimit(size_t newLimit);
+
+    /**
+     *  By default cached image filter results are only reused by the filter object that produced
+     *  them. When this is enabled, results are keyed by the filters' serialized parameters, so a
+     *  filter DAG that is rebuilt with the same parameters (e.g. every frame) reuses the results
+     *  of the previous one. Such results are kept until evicted by the cache's byte limit.
+     *
+     *  Returns the previous setting.
+     */
+    static bool SetImageFilterCacheStructuralKeys(bool enabled);
 };
 
 class SkAutoGraphics {
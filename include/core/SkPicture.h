@@ -80,6 +80,23 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Recreates SkPicture that was serialized into data, like MakeFromData(), but reads the
+        paths, images and sub-pictures it draws only when they are first drawn. The picture
+        keeps a ref on data, so data from SkData::MakeFromFileName() stays mapped instead of
+        being read into memory. Pictures serialized before offset tables were added to the
+        format are read completely, as by MakeFromData().
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders, copied; may be nullptr. Any context they
+                      refer to must outlive the returned SkPicture. They are called in the
+                      order things are drawn, possibly from several threads, so decoders that
+                      depend on being called in serialization order (like those of
+                      SkSharingDeserialContext) can't be used.
+        @return       SkPicture constructed from data
+    */
+    static sk_sp<SkPicture> MakeLazyFromData(sk_sp<SkData> data,
+                                             const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -236,6 +253,7 @@ private:
     SkPicture();
     friend class SkBigPicture;
     friend class SkEmptyPicture;
+    friend class SkLazyPicture;
     friend class SkPicturePriv;
     template <typename> friend class SkMiniPicture;
 
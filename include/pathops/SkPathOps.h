@@ -11,6 +11,7 @@
 #include "include/private/SkTArray.h"
 #include "include/private/SkTDArray.h"
 
+class SkExecutor;
 class SkPath;
 struct SkRect;
 
@@ -101,9 +102,19 @@ public:
       */
     bool resolve(SkPath* result);
 
+    /** When every operand is a union, resolve() splits the paths into groups whose bounds
+        don't touch, and resolves those groups independently. With an executor, it resolves
+        them (and the pairwise unions within them) on the executor's threads.
+
+        @param executor Runs resolve()'s work, or nullptr to do it all on the calling thread.
+                        It must outlive any calls to resolve().
+     */
+    void setExecutor(SkExecutor* executor) { fExecutor = executor; }
+
 private:
     SkTArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
+    SkExecutor* fExecutor = nullptr;
 
     static bool FixWinding(SkPath* path);
     static void ReversePath(SkPath* path);
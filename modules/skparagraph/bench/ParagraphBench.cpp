@@ -12,6 +12,7 @@
 #include "tools/Resources.h"
 
 #include <cfloat>
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
@@ -61,4 +62,136 @@ struct ParagraphBench : public Benchmark {
 PARAGRAPH_BENCH(english)
 #undef PARAGRAPH_BENCH
 
+namespace {
+// Measures the latency of one edit of a long paragraph: each loop types a character into the middle
+// of ~5000 words (or deletes it again), or changes the width, and lays the paragraph out again.
+struct ParagraphEditBench : public Benchmark {
+    enum class Edit { kKeystroke, kKeystrokeReshapeAll, kWidth };
+
+    ParagraphEditBench(Edit edit, const char* name) : fEdit(edit), fName(name) {}
+
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+        // Join the lines into one paragraph and repeat it to get about 5000 words
+        const char* chars = (const char*)data->data();
+        SkString text;
+        for (int i = 0; i < 40; ++i) {
+            for (size_t j = 0; j < data->size(); ++j) {
+                text.append(chars[j] == '\n' ? " " : chars + j, 1);
+            }
+        }
+
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+        fontCollection->getParagraphCache()->turnOn(false);
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.addText(text.c_str(), text.size());
+        fParagraph = builder.Build();
+        fParagraph->layout(kWidth);
+        fPosition = text.size() / 2;
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fParagraph) {
+            return;
+        }
+
+        for (int i = 0; i < loops; ++i) {
+            bool odd = i % 2 == 1;
+            if (fEdit == Edit::kWidth) {
+                fParagraph->layout(odd ? kWidth : kWidth - 50);
+                continue;
+            }
+            if (odd) {
+                fParagraph->replaceText(fPosition, fPosition + 1, SkString());
+            } else {
+                fParagraph->replaceText(fPosition, fPosition, SkString("e"));
+            }
+            if (fEdit == Edit::kKeystrokeReshapeAll) {
+                fParagraph->markDirty();
+            }
+            fParagraph->layout(kWidth);
+        }
+    }
+
+    static constexpr SkScalar kWidth = 1000;
+    Edit fEdit;
+    const char* fName;
+    std::unique_ptr<Paragraph> fParagraph;
+    size_t fPosition = 0;
+};
+}  // namespace
+
+DEF_BENCH(return new ParagraphEditBench(ParagraphEditBench::Edit::kKeystroke,
+                                        "paragraph_edit_keystroke");)
+DEF_BENCH(return new ParagraphEditBench(ParagraphEditBench::Edit::kKeystrokeReshapeAll,
+                                        "paragraph_edit_keystroke_reshape_all");)
+DEF_BENCH(return new ParagraphEditBench(ParagraphEditBench::Edit::kWidth,
+                                        "paragraph_edit_width");)
+
+namespace {
+// Lays out a few hundred short paragraphs (each line of the text, many times over) from scratch,
+// on this thread or on a thread pool with a thread per core.
+struct ParagraphLayoutAllBench : public Benchmark {
+    ParagraphLayoutAllBench(bool threaded, const char* name) : fThreaded(threaded), fName(name) {}
+
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+        fontCollection->getParagraphCache()->turnOn(false);
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        const char* chars = (const char*)data->data();
+        for (int i = 0; i < 20; ++i) {
+            size_t start = 0;
+            for (size_t j = 0; j <= data->size(); ++j) {
+                if (j < data->size() && chars[j] != '\n') {
+                    continue;
+                }
+                if (j > start) {
+                    ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+                    builder.addText(chars + start, j - start);
+                    fParagraphs.push_back(builder.Build());
+                    fBatch.push_back(fParagraphs.back().get());
+                }
+                start = j + 1;
+            }
+        }
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            for (auto paragraph : fBatch) {
+                paragraph->markDirty();
+            }
+            Paragraph::LayoutAll(fExecutor.get(), fBatch.data(), (int)fBatch.size(), 500);
+        }
+    }
+
+    bool fThreaded;
+    const char* fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<std::unique_ptr<Paragraph>> fParagraphs;
+    std::vector<Paragraph*> fBatch;
+};
+}  // namespace
+
+DEF_BENCH(return new ParagraphLayoutAllBench(false, "paragraph_layout_all_serial");)
+DEF_BENCH(return new ParagraphLayoutAllBench(true, "paragraph_layout_all_threaded");)
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
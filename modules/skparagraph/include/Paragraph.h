@@ -8,6 +8,7 @@
 #include "modules/skparagraph/include/TextStyle.h"
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -37,6 +38,10 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    // Lays out the paragraphs to the same width on the executor's threads (on this thread
+    // without one) and returns when they are all done; they may share a FontCollection
+    static void LayoutAll(SkExecutor* executor, Paragraph* paragraphs[], int count, SkScalar width);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     // Returns a vector of bounding boxes that enclose all text between
@@ -69,6 +74,9 @@ public:
     // Experimental API that allows fast way to update "immutable" paragraph
     virtual void updateTextAlign(TextAlign textAlign) = 0;
     virtual void updateText(size_t from, SkString text) = 0;
+    // Replaces the text in [from:to) (UTF-8 indices); the next layout shapes again only the text
+    // around the edit when it can
+    virtual void replaceText(size_t from, size_t to, SkString text) = 0;
     virtual void updateFontSize(size_t from, size_t to, SkScalar fontSize) = 0;
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
@@ -2,9 +2,10 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
-#include "include/private/SkMutex.h"
-#include "src/core/SkLRUCache.h"
+#include "include/core/SkTypes.h"
+#include <atomic>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -27,6 +28,10 @@ class ParagraphCacheValue;
 
 bool operator==(const ParagraphCacheKey& a, const ParagraphCacheKey& b);
 
+// Shaped paragraphs (runs and ICU results) by text and styles, shared by all the paragraphs of
+// a FontCollection. The entries are split between shards with their own locks, so paragraphs laid
+// out on several threads rarely wait for each other, and the least recently used entries of a
+// shard are purged when it goes over its part of the byte budget.
 class ParagraphCache {
 public:
     ParagraphCache();
@@ -43,31 +48,49 @@ public:
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
+
+    // The memory the entries may use; entries larger than a shard's part of it are not cached
+    static constexpr size_t kDefaultBudget = 16 * 1024 * 1024;
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return fBudget; }
+
+    struct Stats {
+        int    fRequests = 0;    // findParagraph calls while the cache is on
+        int    fHits = 0;
+        int    fMisses = 0;
+        int    fPurged = 0;      // entries purged to stay within the budget
+        int    fEntries = 0;
+        size_t fBytesUsed = 0;
+    };
+    Stats getStats();
 
  private:
 
     struct Entry;
-    void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
+    struct Shard;
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    Shard& shardFor(uint32_t hash);
+    void purgeAsNeeded(Shard* shard);
 
-     mutable SkMutex fParagraphMutex;
      std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
-    static const int kMaxEntries = 128;
+    static constexpr int kShards = 16;
 
     struct KeyHash {
         uint32_t mix(uint32_t hash, uint32_t data) const;
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
+    std::unique_ptr<Shard[]> fShards;
+    std::atomic<size_t> fBudget;
     bool fCacheIsOn;
 
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fTotalRequests;
+    std::atomic<int> fCacheMisses;
+    std::atomic<int> fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fPurged;
 #endif
 };
 
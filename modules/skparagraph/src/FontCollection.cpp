@@ -70,9 +70,12 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::getFontManagerOrder() const {
 std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<SkString>& familyNames, SkFontStyle fontStyle) {
     // Look inside the font collections cache first
     FamilyKey familyKey(familyNames, fontStyle);
-    auto found = fTypefaces.find(familyKey);
-    if (found) {
-        return *found;
+    {
+        SkAutoMutexExclusive lock(fTypefacesMutex);
+        auto found = fTypefaces.find(familyKey);
+        if (found) {
+            return *found;
+        }
     }
 
     std::vector<sk_sp<SkTypeface>> typefaces;
@@ -98,6 +101,7 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
         }
     }
 
+    SkAutoMutexExclusive lock(fTypefacesMutex);
     fTypefaces.set(familyKey, typefaces);
     return typefaces;
 }
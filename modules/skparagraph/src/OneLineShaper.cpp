@@ -542,96 +542,110 @@ bool OneLineShaper::shape() {
 
     // The text can be broken into many shaping sequences
     // (by place holders, possibly, by hard line breaks or tabs, too)
-    auto limitlessWidth = std::numeric_limits<SkScalar>::max();
-
     auto result = iterateThroughShapingRegions(
-            [this, limitlessWidth]
+            [this]
             (TextRange textRange, SkSpan<Block> styleSpan, SkScalar& advanceX, TextIndex textStart, uint8_t defaultBidiLevel) {
+        return this->shapeRegion(textRange, styleSpan, advanceX, defaultBidiLevel);
+    });
 
-        // Set up the shaper and shape the next
-        auto shaper = SkShaper::MakeShapeDontWrapOrReorder();
-        if (shaper == nullptr) {
-            // For instance, loadICU does not work. We have to stop the process
-            return false;
-        }
+    return result;
+}
 
-        iterateThroughFontStyles(textRange, styleSpan,
-                [this, &shaper, defaultBidiLevel, limitlessWidth, &advanceX]
-                (Block block, SkTArray<SkShaper::Feature> features) {
-            auto blockSpan = SkSpan<Block>(&block, 1);
-
-            // Start from the beginning (hoping that it's a simple case one block - one run)
-            fHeight = block.fStyle.getHeightOverride() ? block.fStyle.getHeight() : 0;
-            fAdvance = SkVector::Make(advanceX, 0);
-            fCurrentText = block.fRange;
-            fUnresolvedBlocks.emplace_back(RunBlock(block.fRange));
-
-            matchResolvedFonts(block.fStyle, [&](sk_sp<SkTypeface> typeface) {
-
-                // Create one more font to try
-                SkFont font(std::move(typeface), block.fStyle.getFontSize());
-                font.setEdging(SkFont::Edging::kAntiAlias);
-                font.setHinting(SkFontHinting::kSlight);
-                font.setSubpixel(true);
-
-                // Apply fake bold and/or italic settings to the font if the
-                // typeface's attributes do not match the intended font style.
-                int wantedWeight = block.fStyle.getFontStyle().weight();
-                bool fakeBold =
-                    wantedWeight >= SkFontStyle::kSemiBold_Weight &&
-                    wantedWeight - font.getTypeface()->fontStyle().weight() >= 200;
-                bool fakeItalic =
-                    block.fStyle.getFontStyle().slant() == SkFontStyle::kItalic_Slant &&
-                    font.getTypeface()->fontStyle().slant() != SkFontStyle::kItalic_Slant;
-                font.setEmbolden(fakeBold);
-                font.setSkewX(fakeItalic ? -SK_Scalar1 / 4 : 0);
-
-                // Walk through all the currently unresolved blocks
-                // (ignoring those that appear later)
-                auto resolvedCount = fResolvedBlocks.size();
-                auto unresolvedCount = fUnresolvedBlocks.size();
-                while (unresolvedCount-- > 0) {
-                    auto unresolvedRange = fUnresolvedBlocks.front().fText;
-                    if (unresolvedRange == EMPTY_TEXT) {
-                        // Duplicate blocks should be ignored
-                        fUnresolvedBlocks.pop_front();
-                        continue;
-                    }
-                    auto unresolvedText = fParagraph->text(unresolvedRange);
-
-                    SkShaper::TrivialFontRunIterator fontIter(font, unresolvedText.size());
-                    LangIterator langIter(unresolvedText, blockSpan,
-                                      fParagraph->paragraphStyle().getTextStyle());
-                    SkShaper::TrivialBiDiRunIterator bidiIter(defaultBidiLevel, unresolvedText.size());
-                    auto scriptIter = SkShaper::MakeHbIcuScriptRunIterator
-                                     (unresolvedText.begin(), unresolvedText.size());
-                    fCurrentText = unresolvedRange;
-                    shaper->shape(unresolvedText.begin(), unresolvedText.size(),
-                            fontIter, bidiIter,*scriptIter, langIter,
-                            features.data(), features.size(),
-                            limitlessWidth, this);
-
-                    // Take off the queue the block we tried to resolved -
-                    // whatever happened, we have now smaller pieces of it to deal with
-                    fUnresolvedBlocks.pop_front();
-                }
+bool OneLineShaper::shape(TextRange textRange, uint8_t bidiLevel, SkScalar& advanceX) {
+    auto blockRange = fParagraph->findAllBlocks(textRange);
+    if (blockRange.start == EMPTY_BLOCK) {
+        return false;
+    }
+    return this->shapeRegion(textRange, fParagraph->blocks(blockRange), advanceX, bidiLevel);
+}
 
-                if (fUnresolvedBlocks.empty()) {
-                    return Resolved::Everything;
-                } else if (resolvedCount < fResolvedBlocks.size()) {
-                    return Resolved::Something;
-                } else {
-                    return Resolved::Nothing;
+bool OneLineShaper::shapeRegion(TextRange textRange,
+                                SkSpan<Block> styleSpan,
+                                SkScalar& advanceX,
+                                uint8_t defaultBidiLevel) {
+    auto limitlessWidth = std::numeric_limits<SkScalar>::max();
+
+    // Set up the shaper and shape the next
+    auto shaper = SkShaper::MakeShapeDontWrapOrReorder();
+    if (shaper == nullptr) {
+        // For instance, loadICU does not work. We have to stop the process
+        return false;
+    }
+
+    iterateThroughFontStyles(textRange, styleSpan,
+            [this, &shaper, defaultBidiLevel, limitlessWidth, &advanceX]
+            (Block block, SkTArray<SkShaper::Feature> features) {
+        auto blockSpan = SkSpan<Block>(&block, 1);
+
+        // Start from the beginning (hoping that it's a simple case one block - one run)
+        fHeight = block.fStyle.getHeightOverride() ? block.fStyle.getHeight() : 0;
+        fAdvance = SkVector::Make(advanceX, 0);
+        fCurrentText = block.fRange;
+        fUnresolvedBlocks.emplace_back(RunBlock(block.fRange));
+
+        matchResolvedFonts(block.fStyle, [&](sk_sp<SkTypeface> typeface) {
+
+            // Create one more font to try
+            SkFont font(std::move(typeface), block.fStyle.getFontSize());
+            font.setEdging(SkFont::Edging::kAntiAlias);
+            font.setHinting(SkFontHinting::kSlight);
+            font.setSubpixel(true);
+
+            // Apply fake bold and/or italic settings to the font if the
+            // typeface's attributes do not match the intended font style.
+            int wantedWeight = block.fStyle.getFontStyle().weight();
+            bool fakeBold =
+                wantedWeight >= SkFontStyle::kSemiBold_Weight &&
+                wantedWeight - font.getTypeface()->fontStyle().weight() >= 200;
+            bool fakeItalic =
+                block.fStyle.getFontStyle().slant() == SkFontStyle::kItalic_Slant &&
+                font.getTypeface()->fontStyle().slant() != SkFontStyle::kItalic_Slant;
+            font.setEmbolden(fakeBold);
+            font.setSkewX(fakeItalic ? -SK_Scalar1 / 4 : 0);
+
+            // Walk through all the currently unresolved blocks
+            // (ignoring those that appear later)
+            auto resolvedCount = fResolvedBlocks.size();
+            auto unresolvedCount = fUnresolvedBlocks.size();
+            while (unresolvedCount-- > 0) {
+                auto unresolvedRange = fUnresolvedBlocks.front().fText;
+                if (unresolvedRange == EMPTY_TEXT) {
+                    // Duplicate blocks should be ignored
+                    fUnresolvedBlocks.pop_front();
+                    continue;
                 }
-            });
+                auto unresolvedText = fParagraph->text(unresolvedRange);
+
+                SkShaper::TrivialFontRunIterator fontIter(font, unresolvedText.size());
+                LangIterator langIter(unresolvedText, blockSpan,
+                                  fParagraph->paragraphStyle().getTextStyle());
+                SkShaper::TrivialBiDiRunIterator bidiIter(defaultBidiLevel, unresolvedText.size());
+                auto scriptIter = SkShaper::MakeHbIcuScriptRunIterator
+                                 (unresolvedText.begin(), unresolvedText.size());
+                fCurrentText = unresolvedRange;
+                shaper->shape(unresolvedText.begin(), unresolvedText.size(),
+                        fontIter, bidiIter,*scriptIter, langIter,
+                        features.data(), features.size(),
+                        limitlessWidth, this);
+
+                // Take off the queue the block we tried to resolved -
+                // whatever happened, we have now smaller pieces of it to deal with
+                fUnresolvedBlocks.pop_front();
+            }
 
-            this->finish(block.fRange, fHeight, advanceX);
+            if (fUnresolvedBlocks.empty()) {
+                return Resolved::Everything;
+            } else if (resolvedCount < fResolvedBlocks.size()) {
+                return Resolved::Something;
+            } else {
+                return Resolved::Nothing;
+            }
         });
 
-        return true;
+        this->finish(block.fRange, fHeight, advanceX);
     });
 
-    return result;
+    return true;
 }
 
 // When we extend TextRange to the grapheme edges, we also extend glyphs range
@@ -24,6 +24,10 @@ public:
 
     bool shape();
 
+    // Shapes only the text range (as one bidi region, with no placeholders) starting at advanceX,
+    // for patching the runs of an edited paragraph
+    bool shape(TextRange textRange, uint8_t bidiLevel, SkScalar& advanceX);
+
     size_t unresolvedGlyphs() { return fUnresolvedGlyphs; }
 
 private:
@@ -54,6 +58,7 @@ private:
     using ShapeVisitor =
             std::function<SkScalar(TextRange textRange, SkSpan<Block>, SkScalar&, TextIndex, uint8_t)>;
     bool iterateThroughShapingRegions(const ShapeVisitor& shape);
+    bool shapeRegion(TextRange textRange, SkSpan<Block> styleSpan, SkScalar& advanceX, uint8_t defaultBidiLevel);
 
     using ShapeSingleFontVisitor = std::function<void(Block, SkTArray<SkShaper::Feature>)>;
     void iterateThroughFontStyles(TextRange textRange, SkSpan<Block> styleSpan, const ShapeSingleFontVisitor& visitor);
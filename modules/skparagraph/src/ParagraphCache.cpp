@@ -1,8 +1,11 @@
 // Copyright 2019 Google LLC.
+#include <limits>
 #include <memory>
 
+#include "include/private/SkMutex.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
+#include "src/core/SkLRUCache.h"
 
 namespace skia {
 namespace textlayout {
@@ -27,6 +30,11 @@ public:
         , fTextStyles(paragraph->fTextStyles)
         , fParagraphStyle(paragraph->paragraphStyle()) { }
 
+    size_t bytesUsed() const {
+        return sizeof(ParagraphCacheKey) + fText.size() +
+               fPlaceholders.size() * sizeof(Placeholder) + fTextStyles.size() * sizeof(Block);
+    }
+
     SkString fText;
     SkTArray<Placeholder, true> fPlaceholders;
     SkTArray<Block, true> fTextStyles;
@@ -42,7 +50,26 @@ public:
         , fWords(paragraph->fWords)
         , fBidiRegions(paragraph->fBidiRegions)
         , fUTF8IndexForUTF16Index(paragraph->fUTF8IndexForUTF16Index)
-        , fUTF16IndexForUTF8Index(paragraph->fUTF16IndexForUTF8Index) { }
+        , fUTF16IndexForUTF8Index(paragraph->fUTF16IndexForUTF8Index)
+        , fFontSwitches(paragraph->fFontSwitches)
+        , fUnresolvedGlyphs(paragraph->fUnresolvedGlyphs) { }
+
+    // Approximately: the glyph arrays of the runs and the arrays indexed by the text
+    size_t bytesUsed() const {
+        size_t bytes = sizeof(ParagraphCacheValue) + fKey.bytesUsed();
+        for (auto& run : fRuns) {
+            bytes += sizeof(Run) + (run.size() + 1) * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) +
+                                                       sizeof(uint32_t) + sizeof(SkRect) +
+                                                       sizeof(SkScalar));
+        }
+        bytes += fCodeUnitProperties.size() * sizeof(CodeUnitFlags);
+        bytes += fWords.size() * sizeof(size_t);
+        bytes += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        bytes += fUTF8IndexForUTF16Index.size() * sizeof(TextIndex);
+        bytes += fUTF16IndexForUTF8Index.size() * sizeof(size_t);
+        bytes += fFontSwitches.size() * sizeof(ResolvedFontDescriptor);
+        return bytes;
+    }
 
     // Input == key
     ParagraphCacheKey fKey;
@@ -55,6 +82,9 @@ public:
     std::vector<SkUnicode::BidiRegion> fBidiRegions;
     SkTArray<TextIndex, true> fUTF8IndexForUTF16Index;
     SkTArray<size_t, true> fUTF16IndexForUTF8Index;
+    // Font resolution
+    SkTArray<ResolvedFontDescriptor> fFontSwitches;
+    size_t fUnresolvedGlyphs;
 };
 
 uint32_t ParagraphCache::KeyHash::mix(uint32_t hash, uint32_t data) const {
@@ -183,25 +213,50 @@ bool operator==(const ParagraphCacheKey& a, const ParagraphCacheKey& b) {
     return true;
 }
 
+// Each entry counts its bytes against its shard for as long as it lives
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value, size_t* shardBytes)
+        : fValue(value)
+        , fBytes(value->bytesUsed())
+        , fShardBytes(shardBytes) {
+        *fShardBytes += fBytes;
+    }
+    ~Entry() { *fShardBytes -= fBytes; }
+
     std::unique_ptr<ParagraphCacheValue> fValue;
+    size_t fBytes;
+    size_t* fShardBytes;
+};
+
+struct ParagraphCache::Shard {
+    Shard() : fBytesUsed(0), fLRUCacheMap(std::numeric_limits<int>::max()) { }
+
+    SkMutex fParagraphMutex;
+    size_t fBytesUsed;  // Outlives the entries
+    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
 };
 
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fShards(new Shard[kShards])
+    , fBudget(kDefaultBudget)
     , fCacheIsOn(true)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
     , fHashMisses(0)
+    , fPurged(0)
 #endif
 { }
 
 ParagraphCache::~ParagraphCache() { }
 
+ParagraphCache::Shard& ParagraphCache::shardFor(uint32_t hash) {
+    // The low bits of the hash pick the bucket inside the shard's table
+    return fShards[(hash >> 24) % kShards];
+}
+
 void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
     paragraph->fRuns.reset();
@@ -211,37 +266,83 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
     paragraph->fBidiRegions = entry->fValue->fBidiRegions;
     paragraph->fUTF8IndexForUTF16Index = entry->fValue->fUTF8IndexForUTF16Index;
     paragraph->fUTF16IndexForUTF8Index = entry->fValue->fUTF16IndexForUTF8Index;
+    paragraph->fFontSwitches = entry->fValue->fFontSwitches;
+    paragraph->fUnresolvedGlyphs = entry->fValue->fUnresolvedGlyphs;
     for (auto& run : paragraph->fRuns) {
       run.setOwner(paragraph);
     }
 }
 
 void ParagraphCache::printStatistics() {
+    auto stats = this->getStats();
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Total requests: %d\n", stats.fRequests);
+    SkDebugf("Cache misses: %d\n", stats.fMisses);
+    SkDebugf("Cache miss %%: %f\n", (stats.fRequests > 0) ? 100.f * stats.fMisses / stats.fRequests : 0.f);
+    SkDebugf("Entries: %d, bytes used: %zu of %zu, purged: %d\n",
+             stats.fEntries, stats.fBytesUsed, this->getBudget(), stats.fPurged);
     SkDebugf("---------------------\n");
 }
 
-void ParagraphCache::abandon() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
-    fLRUCacheMap.foreach([](ParagraphCacheKey*, std::unique_ptr<Entry>* e) {
-    });
+ParagraphCache::Stats ParagraphCache::getStats() {
+    Stats stats;
+#ifdef PARAGRAPH_CACHE_STATS
+    stats.fRequests = fTotalRequests;
+    stats.fMisses = fCacheMisses;
+    stats.fHits = stats.fRequests - stats.fMisses;
+    stats.fPurged = fPurged;
+#endif
+    for (int i = 0; i < kShards; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fParagraphMutex);
+        stats.fEntries += fShards[i].fLRUCacheMap.count();
+        stats.fBytesUsed += fShards[i].fBytesUsed;
+    }
+    return stats;
+}
+
+int ParagraphCache::count() {
+    int count = 0;
+    for (int i = 0; i < kShards; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fParagraphMutex);
+        count += fShards[i].fLRUCacheMap.count();
+    }
+    return count;
+}
+
+void ParagraphCache::setBudget(size_t bytes) {
+    fBudget = bytes;
+    for (int i = 0; i < kShards; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fParagraphMutex);
+        this->purgeAsNeeded(&fShards[i]);
+    }
+}
 
+// Must be called with the shard locked
+void ParagraphCache::purgeAsNeeded(Shard* shard) {
+    auto shardBudget = fBudget / kShards;
+    while (shard->fBytesUsed > shardBudget && shard->fLRUCacheMap.count() > 0) {
+        shard->fLRUCacheMap.removeLeastRecentlyUsed();
+#ifdef PARAGRAPH_CACHE_STATS
+        ++fPurged;
+#endif
+    }
+}
+
+void ParagraphCache::abandon() {
     this->reset();
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
     fTotalRequests = 0;
     fCacheMisses = 0;
     fHashMisses = 0;
+    fPurged = 0;
 #endif
-    fLRUCacheMap.reset();
+    for (int i = 0; i < kShards; ++i) {
+        SkAutoMutexExclusive lock(fShards[i].fParagraphMutex);
+        fShards[i].fLRUCacheMap.reset();
+    }
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -251,9 +352,10 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(KeyHash()(key));
+    SkAutoMutexExclusive lock(shard.fParagraphMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
 
     if (!entry) {
         // We have a cache miss
@@ -272,15 +374,18 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    // The value is copied before taking the lock; most of the time nobody else has added it
+    std::unique_ptr<ParagraphCacheValue> value(new ParagraphCacheValue(paragraph));
+    if (value->bytesUsed() > fBudget / kShards) {
+        return false;
+    }
+    Shard& shard = this->shardFor(KeyHash()(key));
+    SkAutoMutexExclusive lock(shard.fParagraphMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
     if (!entry) {
-        ParagraphCacheValue* value = new ParagraphCacheValue(paragraph);
-        fLRUCacheMap.insert(key, std::make_unique<Entry>(value));
+        shard.fLRUCacheMap.insert(key, std::make_unique<Entry>(value.release(), &shard.fBytesUsed));
+        this->purgeAsNeeded(&shard);
         fChecker(paragraph, "addedParagraph", true);
         return true;
     } else {
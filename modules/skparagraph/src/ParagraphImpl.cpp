@@ -17,6 +17,7 @@
 #include "modules/skparagraph/src/TextLine.h"
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "src/core/SkSpan.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkUTF.h"
 #include <math.h>
 #include <algorithm>
@@ -61,6 +62,19 @@ Paragraph::Paragraph(ParagraphStyle style, sk_sp<FontCollection> fonts)
             , fExceededMaxLines(0)
 { }
 
+void Paragraph::LayoutAll(SkExecutor* executor, Paragraph* paragraphs[], int count,
+                          SkScalar width) {
+    if (executor == nullptr) {
+        for (int i = 0; i < count; ++i) {
+            paragraphs[i]->layout(width);
+        }
+        return;
+    }
+    SkTaskGroup group(*executor);
+    group.batch(count, [&](int i) { paragraphs[i]->layout(width); });
+    group.wait();
+}
+
 ParagraphImpl::ParagraphImpl(const SkString& text,
                              ParagraphStyle style,
                              SkTArray<Block, true> blocks,
@@ -72,6 +86,9 @@ ParagraphImpl::ParagraphImpl(const SkString& text,
         , fPlaceholders(std::move(placeholders))
         , fText(text)
         , fState(kUnknown)
+        , fReplacedText(EMPTY_RANGE)
+        , fReplacementText(EMPTY_RANGE)
+        , fPatchedLayouts(0)
         , fUnresolvedGlyphs(0)
         , fPicture(nullptr)
         , fStrutMetrics(false)
@@ -122,8 +139,12 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         fWidth = floorWidth;
         fState = kMarked;
     } else if (fState >= kLineBroken && fOldWidth != floorWidth) {
-        // We can use the results from SkShaper but have to do EVERYTHING ELSE again
-        fState = kShaped;
+        // We can use the results from SkShaper and the clusters (with letter and word spacing);
+        // only the lines and the justification depend on the width
+        for (auto& run : fRuns) {
+            run.resetJustificationShifts();
+        }
+        fState = kMarked;
     } else {
         // Nothing changed case: we can reuse the data from the last layout
     }
@@ -135,8 +156,7 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         this->fBidiRegions.clear();
         this->fUTF8IndexForUTF16Index.reset();
         this->fUTF16IndexForUTF8Index.reset();
-        this->fRuns.reset();
-        if (!this->shapeTextIntoEndlessLine()) {
+        if (!this->shapeEditedText() && !this->shapeTextIntoEndlessLine()) {
             this->resetContext();
             // TODO: merge the two next calls - they always come together
             this->resolveStrut();
@@ -409,6 +429,202 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
     }
 }
 
+// Patches the runs shaped before the last edit: only the text between the line breaks around the
+// edit is shaped again, the runs before it are kept, and the runs after it are moved along.
+// Returns false (with no runs) if all the text has to be shaped instead.
+bool ParagraphImpl::shapeEditedText() {
+    auto replaced = fReplacedText;
+    auto replacement = fReplacementText;
+    fReplacedText = fReplacementText = EMPTY_RANGE;
+
+    SkTArray<Run, false> oldRuns(std::move(fRuns));
+    fRuns.reset();
+    if (replaced == EMPTY_RANGE || oldRuns.empty() || fText.isEmpty()) {
+        return false;
+    }
+
+    auto shapeEverything = [this]() {
+        this->fRuns.reset();
+        this->fCodeUnitProperties.reset();
+        this->fCodeUnitProperties.push_back_n(fText.size() + 1, CodeUnitFlags::kNoCodeUnitFlag);
+        this->fBidiRegions.clear();
+        return false;
+    };
+
+    if (!this->computeCodeUnitProperties()) {
+        return shapeEverything();
+    }
+    // The runs we keep were shaped left to right in one bidi region; so must be the new ones
+    if (fBidiRegions.size() != 1 || fBidiRegions.front().level % 2 != 0) {
+        return shapeEverything();
+    }
+
+    // Shaping (almost) never reaches over a line break opportunity, so the text is shaped again
+    // from the last one before the edit to the first one after it, within the edited style
+    auto isLineBreak = [this](TextIndex index) {
+        return this->codeUnitHasProperty(index, CodeUnitFlags::kSoftLineBreakBefore) ||
+               this->codeUnitHasProperty(index, CodeUnitFlags::kHardLineBreakBefore);
+    };
+    TextIndex start = replacement.start;
+    while (start > 0 && !isLineBreak(--start)) { }
+    TextIndex end = replacement.end;
+    while (end < fText.size() && !isLineBreak(++end)) { }
+
+    const Block* edited = nullptr;
+    for (auto& block : fTextStyles) {
+        if (block.fRange.start <= replacement.start && replacement.end <= block.fRange.end &&
+            block.fRange.width() > 0) {
+            edited = &block;
+            break;
+        }
+    }
+    if (edited == nullptr) {
+        return shapeEverything();
+    }
+    start = std::max(start, edited->fRange.start);
+    end = std::min(end, edited->fRange.end);
+
+    // The same range in the text before the edit, and the glyphs it starts and ends with
+    const ptrdiff_t textShift = (ptrdiff_t)replacement.width() - (ptrdiff_t)replaced.width();
+    const TextIndex oldEnd = end - textShift;
+    auto findGlyph = [](const Run& run, TextIndex text) -> GlyphIndex {
+        auto begin = run.fClusterIndexes.begin();
+        GlyphIndex glyph = std::lower_bound(begin, begin + run.size(), text - run.fClusterStart) - begin;
+        return run.globalClusterIndex(glyph) == text ? glyph : EMPTY_INDEX;
+    };
+    RunIndex firstRun = EMPTY_RUN, lastRun = EMPTY_RUN;
+    GlyphIndex startGlyph = EMPTY_INDEX, endGlyph = EMPTY_INDEX;
+    for (RunIndex i = 0; i < oldRuns.size(); ++i) {
+        const Run& run = oldRuns[i];
+        if (run.isPlaceholder() || !run.leftToRight()) {
+            return shapeEverything();
+        }
+        if (run.fTextRange.start <= start && start < run.fTextRange.end) {
+            firstRun = i;
+            startGlyph = findGlyph(run, start);
+        }
+        if (run.fTextRange.start < oldEnd && oldEnd <= run.fTextRange.end) {
+            lastRun = i;
+            endGlyph = findGlyph(run, oldEnd);
+        }
+    }
+    if (startGlyph == EMPTY_INDEX || endGlyph == EMPTY_INDEX || firstRun > lastRun) {
+        return shapeEverything();
+    }
+
+    auto oldFontSwitches = std::move(fFontSwitches);
+    fFontSwitches.reset();
+    auto advanceX = oldRuns[firstRun].posX(startGlyph);
+    OneLineShaper oneLineShaper(this);
+    if (!oneLineShaper.shape(TextRange(start, end), fBidiRegions.front().level, advanceX)) {
+        fFontSwitches = std::move(oldFontSwitches);
+        return shapeEverything();
+    }
+    fUnresolvedGlyphs = oneLineShaper.unresolvedGlyphs();
+
+    // Put the runs together, joining the new ones with what is left of the runs they replace
+    SkTArray<Run, false> shapedRuns(std::move(fRuns));
+    fRuns.reset();
+    for (RunIndex i = 0; i < firstRun; ++i) {
+        fRuns.emplace_back(std::move(oldRuns[i]));
+    }
+    const Run& before = oldRuns[firstRun];
+    this->appendRunPiece(before, GlyphRange(0, startGlyph), 0, 0, false);
+    for (auto& run : shapedRuns) {
+        this->appendRunPiece(run, GlyphRange(0, run.size()), 0, 0, true);
+    }
+    // The runs after the edit move to where the new ones end
+    const Run& after = oldRuns[lastRun];
+    auto shift = (fRuns.empty() ? advanceX : fRuns.back().posX(fRuns.back().size())) -
+                 after.posX(endGlyph);
+    this->appendRunPiece(after, GlyphRange(endGlyph, after.size()), shift, textShift, true);
+    for (RunIndex i = lastRun + 1; i < oldRuns.size(); ++i) {
+        this->appendRunPiece(oldRuns[i], GlyphRange(0, oldRuns[i].size()), shift, textShift, false);
+    }
+
+    auto shapedFontSwitches = std::move(fFontSwitches);
+    fFontSwitches.reset();
+    for (auto& fontSwitch : oldFontSwitches) {
+        if (fontSwitch.fTextStart < start) {
+            fFontSwitches.push_back(fontSwitch);
+        }
+    }
+    for (auto& fontSwitch : shapedFontSwitches) {
+        fFontSwitches.push_back(fontSwitch);
+    }
+    if (endGlyph < after.size()) {
+        fFontSwitches.emplace_back(end, after.fFont);
+    }
+    for (auto& fontSwitch : oldFontSwitches) {
+        if (fontSwitch.fTextStart > oldEnd) {
+            fFontSwitches.emplace_back(fontSwitch.fTextStart + textShift, fontSwitch.fFont);
+        }
+    }
+
+    ++fPatchedLayouts;
+    return true;
+}
+
+// Appends the glyphs of the run (moved by the shifts) to the paragraph, as a new run, or joined
+// to the last run if they continue it in the same font
+void ParagraphImpl::appendRunPiece(const Run& run, GlyphRange glyphs, SkScalar shift,
+                                   ptrdiff_t textShift, bool join) {
+    if (glyphs.width() == 0) {
+        return;
+    }
+
+    TextRange text(run.globalClusterIndex(glyphs.start) + textShift,
+                   run.globalClusterIndex(glyphs.end) + textShift);
+    size_t clusterStart = run.fClusterStart + textShift;
+    auto advance = SkVector::Make(run.posX(glyphs.end) - run.posX(glyphs.start), run.fAdvance.fY);
+
+    Run* piece;
+    GlyphIndex first;
+    if (join && !fRuns.empty() &&
+        fRuns.back().fFont == run.fFont &&
+        fRuns.back().fBidiLevel == run.fBidiLevel &&
+        fRuns.back().fHeightMultiplier == run.fHeightMultiplier &&
+        fRuns.back().fTextRange.end == text.start) {
+        // The end of the last run becomes the position of the first new glyph
+        piece = &fRuns.back();
+        first = piece->size();
+        piece->fGlyphs.push_back_n(glyphs.width());
+        piece->fBounds.push_back_n(glyphs.width());
+        piece->fPositions.push_back_n(glyphs.width());
+        piece->fClusterIndexes.push_back_n(glyphs.width());
+        piece->fShifts.push_back_n(glyphs.width(), 0.0);
+        piece->fAdvance.fX += advance.fX;
+        piece->fTextRange.end = text.end;
+        piece->fUtf8Range = SkShaper::RunHandler::Range(
+                piece->fTextRange.start - piece->fClusterStart, piece->fTextRange.width());
+    } else {
+        const SkShaper::RunHandler::RunInfo info = {
+                run.fFont,
+                run.fBidiLevel,
+                advance,
+                glyphs.width(),
+                SkShaper::RunHandler::Range(text.start - clusterStart, text.width())
+        };
+        piece = &fRuns.emplace_back(this,
+                                    info,
+                                    clusterStart,
+                                    run.fHeightMultiplier,
+                                    fRuns.count(),
+                                    run.posX(glyphs.start) + shift);
+        first = 0;
+    }
+
+    for (size_t i = glyphs.start; i <= glyphs.end; ++i) {
+        auto index = first + i - glyphs.start;
+        if (i < glyphs.end) {
+            piece->fGlyphs[index] = run.fGlyphs[i];
+            piece->fBounds[index] = run.fBounds[i];
+        }
+        piece->fClusterIndexes[index] = clusterStart + run.fClusterIndexes[i] - piece->fClusterStart;
+        piece->fPositions[index] = run.fPositions[i] + SkVector::Make(shift, 0);
+    }
+}
+
 void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
     TextWrapper textWrapper;
     textWrapper.breakTextIntoLines(
@@ -780,6 +996,7 @@ void ParagraphImpl::setState(InternalState state) {
     switch (fState) {
         case kUnknown:
             fRuns.reset();
+            fReplacedText = fReplacementText = EMPTY_RANGE;
             fCodeUnitProperties.reset();
             fCodeUnitProperties.push_back_n(fText.size() + 1, kNoCodeUnitFlag);
             fWords.clear();
@@ -848,11 +1065,60 @@ SkString ParagraphImpl::getEllipsis() const {
 }
 
 void ParagraphImpl::updateText(size_t from, SkString text) {
-  fText.remove(from, from + text.size());
-  fText.insert(from, text);
-  fState = kUnknown;
-  fOldWidth = 0;
-  fOldHeight = 0;
+    auto to = std::min(from + text.size(), fText.size());
+    this->replaceText(from, to, std::move(text));
+}
+
+// Where a position in the text ends up after [from:to) is replaced with 'length' code units
+// (the text inserted at a style boundary goes with the style before it)
+static size_t position_after_edit(size_t pos, size_t from, size_t to, size_t length) {
+    if (pos == EMPTY_INDEX || pos == 0 || pos < from) {
+        return pos;
+    }
+    return pos >= to ? pos - (to - from) + length : from + length;
+}
+
+void ParagraphImpl::replaceText(size_t from, size_t to, SkString text) {
+    SkASSERT(from <= to && to <= fText.size());
+
+    // The runs can be patched after one edit of a paragraph that was shaped left to right
+    // in one piece, with no placeholders and all the glyphs resolved. Letter and word spacing
+    // are added to the runs after shaping, so the runs we'd keep already have theirs.
+    auto hasSpacing = [](const Block& block) {
+        return block.fStyle.getLetterSpacing() != 0 || block.fStyle.getWordSpacing() != 0;
+    };
+    bool patchRuns = fState >= kShaped &&
+                     fReplacedText == EMPTY_RANGE &&
+                     fPlaceholders.size() == 1 &&
+                     fUnresolvedGlyphs == 0 &&
+                     fBidiRegions.size() == 1 && fBidiRegions.front().level % 2 == 0 &&
+                     std::none_of(fTextStyles.begin(), fTextStyles.end(), hasSpacing);
+
+    fText.remove(from, to - from);
+    fText.insert(from, text);
+
+    // Move the styles and the placeholders along with their text
+    auto moveRange = [&](TextRange range) {
+        return TextRange(position_after_edit(range.start, from, to, text.size()),
+                         position_after_edit(range.end, from, to, text.size()));
+    };
+    for (auto& block : fTextStyles) {
+        block.fRange = moveRange(block.fRange);
+    }
+    for (auto& placeholder : fPlaceholders) {
+        placeholder.fRange = moveRange(placeholder.fRange);
+        placeholder.fTextBefore = moveRange(placeholder.fTextBefore);
+    }
+
+    if (patchRuns) {
+        fReplacedText = TextRange(from, to);
+        fReplacementText = TextRange(from, from + text.size());
+    } else {
+        fReplacedText = fReplacementText = EMPTY_RANGE;
+    }
+    fState = kUnknown;
+    fOldWidth = 0;
+    fOldHeight = 0;
 }
 
 void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
@@ -867,6 +1133,7 @@ void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
   }
 
   fState = kUnknown;
+  fReplacedText = fReplacementText = EMPTY_RANGE;
   fOldWidth = 0;
   fOldHeight = 0;
 }
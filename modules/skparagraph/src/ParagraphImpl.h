@@ -176,8 +176,13 @@ public:
     SkSpan<Block> blocks(BlockRange blockRange);
     Block& block(BlockIndex blockIndex);
     SkTArray<ResolvedFontDescriptor> resolvedFonts() const { return fFontSwitches; }
+    // How many layouts patched the runs after an edit rather than shaping all the text
+    int patchedLayouts() const { return fPatchedLayouts; }
 
-    void markDirty() override { fState = kUnknown; }
+    void markDirty() override {
+        fState = kUnknown;
+        fReplacedText = fReplacementText = EMPTY_RANGE;
+    }
 
     int32_t unresolvedGlyphs() override;
 
@@ -194,12 +199,14 @@ public:
     void buildClusterTable();
     void spaceGlyphs();
     bool shapeTextIntoEndlessLine();
+    bool shapeEditedText();
     void breakShapedTextIntoLines(SkScalar maxWidth);
     void paintLinesIntoPicture(SkScalar x, SkScalar y);
     void paintLines(SkCanvas* canvas, SkScalar x, SkScalar y);
 
     void updateTextAlign(TextAlign textAlign) override;
     void updateText(size_t from, SkString text) override;
+    void replaceText(size_t from, size_t to, SkString text) override;
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
@@ -234,6 +241,7 @@ private:
     friend class OneLineShaper;
 
     void computeEmptyMetrics();
+    void appendRunPiece(const Run& run, GlyphRange glyphs, SkScalar shift, ptrdiff_t textShift, bool join);
 
     // Input
     SkTArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
@@ -249,6 +257,11 @@ private:
     // Internal structures
     InternalState fState;
     SkTArray<Run, false> fRuns;         // kShaped
+    // The text replaced by the last edit and its replacement, as long as the runs shaped before
+    // the edit can be patched instead of shaping all the text again (EMPTY_RANGE otherwise)
+    TextRange fReplacedText;
+    TextRange fReplacementText;
+    int fPatchedLayouts;
     SkTArray<Cluster, true> fClusters;  // kClusterized (cached: text, word spacing, letter spacing, resolved fonts)
     SkTArray<CodeUnitFlags> fCodeUnitProperties;
     SkTArray<size_t> fClustersIndexFromCodeUnit;
@@ -3,6 +3,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkImageEncoder.h"
@@ -5517,3 +5518,241 @@ DEF_TEST(SkParagraph_FontResolutionInLTR, reporter) {
     REPORTER_ASSERT(reporter, impl->runs()[1].textRange().width() == 5); // "{unresolved} {unresolved}"
     REPORTER_ASSERT(reporter, impl->runs()[2].textRange().width() == 4); // " def"
 }
+
+DEF_TEST(SkParagraph_IncrementalRelayout, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>(true);
+    if (!fontCollection->fontsFound()) return;
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    paragraph_style.setTextAlign(TextAlign::kJustify);
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    // The text after 'split' is larger, so the runs before an edit there are kept as they are
+    size_t split = 0;
+    auto build = [&](const std::string& text) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), split);
+        TextStyle larger = text_style;
+        larger.setFontSize(24);
+        builder.pushStyle(larger);
+        builder.addText(text.c_str() + split, text.size() - split);
+        builder.pop();
+        builder.pop();
+        return builder.Build();
+    };
+
+    // Compares the glyphs, clusters and positions across all the runs, and the lines
+    auto check = [&](Paragraph* edited, const std::string& text, SkScalar width) {
+        auto fresh = build(text);
+        fresh->layout(width);
+        auto a = static_cast<ParagraphImpl*>(edited);
+        auto b = static_cast<ParagraphImpl*>(fresh.get());
+        REPORTER_ASSERT(reporter, a->text().size() == b->text().size());
+        REPORTER_ASSERT(reporter, a->lineNumber() == b->lineNumber());
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a->getHeight(), b->getHeight()));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a->getMaxIntrinsicWidth(),
+                                                      b->getMaxIntrinsicWidth(), 0.01f));
+
+        std::vector<SkGlyphID> glyphsA, glyphsB;
+        std::vector<size_t> clustersA, clustersB;
+        std::vector<SkScalar> positionsA, positionsB;
+        SkScalar advanceA = 0, advanceB = 0;
+        auto collect = [](ParagraphImpl* paragraph, std::vector<SkGlyphID>& glyphs,
+                          std::vector<size_t>& clusters, std::vector<SkScalar>& positions,
+                          SkScalar* advance) {
+            for (auto& run : paragraph->runs()) {
+                for (size_t i = 0; i < run.size(); ++i) {
+                    glyphs.push_back(run.glyphs()[i]);
+                    clusters.push_back(run.globalClusterIndex(i));
+                    positions.push_back(run.posX(i) - run.posX(0));
+                }
+                *advance += run.advance().fX;
+            }
+        };
+        collect(a, glyphsA, clustersA, positionsA, &advanceA);
+        collect(b, glyphsB, clustersB, positionsB, &advanceB);
+        REPORTER_ASSERT(reporter, glyphsA == glyphsB);
+        REPORTER_ASSERT(reporter, clustersA == clustersB);
+        // The runs may start at different offsets (the shaper doesn't carry the advance of fully
+        // resolved runs over to the next style block), but their glyphs are spaced the same
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(advanceA, advanceB, 0.01f),
+                        "%g %g", advanceA, advanceB);
+        if (positionsA.size() == positionsB.size()) {
+            for (size_t i = 0; i < positionsA.size(); ++i) {
+                REPORTER_ASSERT(reporter, SkScalarNearlyEqual(positionsA[i], positionsB[i], 0.01f));
+            }
+        }
+        if (a->lineNumber() == b->lineNumber()) {
+            for (size_t i = 0; i < a->lineNumber(); ++i) {
+                auto& lineA = a->lines()[i];
+                auto& lineB = b->lines()[i];
+                REPORTER_ASSERT(reporter, lineA.textWithSpaces() == lineB.textWithSpaces());
+                REPORTER_ASSERT(reporter, SkScalarNearlyEqual(lineA.width(), lineB.width(), 0.01f));
+                REPORTER_ASSERT(reporter, SkScalarNearlyEqual(lineA.offset().fY, lineB.offset().fY));
+            }
+        }
+    };
+
+    std::string original;
+    for (int i = 0; i < 20; ++i) {
+        original += "The quick brown fox jumps over the lazy dog. ";
+    }
+
+    // Letter and word spacing are added after shaping, so those paragraphs are shaped whole
+    for (bool spacing : {false, true}) {
+        text_style.setLetterSpacing(spacing ? 1.5f : 0);
+        text_style.setWordSpacing(spacing ? 4 : 0);
+        std::string text = original;
+        split = text.size() / 2;
+        auto paragraph = build(text);
+        paragraph->layout(TestCanvasWidth);
+        auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+        int patched = impl->patchedLayouts();
+        auto edit = [&](size_t from, size_t to, const char* replacement) {
+            paragraph->replaceText(from, to, SkString(replacement));
+            text.replace(from, to - from, replacement);
+            if (to <= split) {
+                split = split - (to - from) + strlen(replacement);
+            }
+            paragraph->layout(TestCanvasWidth);
+            REPORTER_ASSERT(reporter, impl->patchedLayouts() == patched + (spacing ? 0 : 1),
+                            "spacing %d, edit [%zu:%zu)", spacing, from, to);
+            patched = impl->patchedLayouts();
+            check(paragraph.get(), text, TestCanvasWidth);
+        };
+
+        // A keystroke in the middle of a word, then the same word deleted
+        edit(102, 102, "e");
+        edit(96, 104, "");
+
+        // A keystroke after the style change, where the runs before it are kept
+        edit(split + 102, split + 102, "e");
+
+        // Replacing text at the start and at the end
+        edit(0, 3, "A");
+        edit(text.size() - 5, text.size(), "cat!");
+
+        // Only the lines change with the width
+        paragraph->layout(TestCanvasWidth / 3);
+        REPORTER_ASSERT(reporter, impl->patchedLayouts() == patched);
+        check(paragraph.get(), text, TestCanvasWidth / 3);
+    }
+}
+
+DEF_TEST(SkParagraph_LayoutAll, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>(true);
+    if (!fontCollection->fontsFound()) return;
+    sk_sp<ResourceFontCollection> serialCollection = sk_make_sp<ResourceFontCollection>(true);
+    serialCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    // Every text comes up a few times, so some of the paragraphs are found in the cache
+    auto build = [&](sk_sp<FontCollection> collection, int i) {
+        std::string text;
+        for (int j = 0; j <= i % 7; ++j) {
+            text += "Paragraph " + std::to_string(i % 7) + " of many, laid out side by side. ";
+        }
+        ParagraphBuilderImpl builder(paragraph_style, collection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    static constexpr int kCount = 64;
+    std::vector<std::unique_ptr<Paragraph>> paragraphs, expected;
+    std::vector<Paragraph*> batch;
+    for (int i = 0; i < kCount; ++i) {
+        paragraphs.push_back(build(fontCollection, i));
+        batch.push_back(paragraphs.back().get());
+        expected.push_back(build(serialCollection, i));
+        expected.back()->layout(TestCanvasWidth / 2);
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    Paragraph::LayoutAll(executor.get(), batch.data(), kCount, TestCanvasWidth / 2);
+
+    for (int i = 0; i < kCount; ++i) {
+        auto impl = static_cast<ParagraphImpl*>(paragraphs[i].get());
+        auto expectedImpl = static_cast<ParagraphImpl*>(expected[i].get());
+        REPORTER_ASSERT(reporter, impl->lineNumber() == expectedImpl->lineNumber());
+        REPORTER_ASSERT(reporter, impl->getHeight() == expectedImpl->getHeight());
+        REPORTER_ASSERT(reporter, impl->getLongestLine() == expectedImpl->getLongestLine());
+        REPORTER_ASSERT(reporter, impl->runs().size() == expectedImpl->runs().size());
+        if (impl->runs().size() == expectedImpl->runs().size()) {
+            for (size_t r = 0; r < impl->runs().size(); ++r) {
+                auto glyphs = impl->runs()[r].glyphs();
+                auto expectedGlyphs = expectedImpl->runs()[r].glyphs();
+                REPORTER_ASSERT(reporter, std::equal(glyphs.begin(), glyphs.end(),
+                                                     expectedGlyphs.begin(), expectedGlyphs.end()));
+            }
+        }
+    }
+
+    auto stats = fontCollection->getParagraphCache()->getStats();
+    REPORTER_ASSERT(reporter, stats.fRequests == kCount);
+    REPORTER_ASSERT(reporter, stats.fHits + stats.fMisses == kCount);
+    REPORTER_ASSERT(reporter, stats.fMisses >= 7);
+    REPORTER_ASSERT(reporter, stats.fEntries == 7);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed > 0);
+}
+
+DEF_TEST(SkParagraph_CacheBudget, reporter) {
+    ParagraphCache cache;
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto add = [&](const std::string& text) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        auto paragraph = builder.Build();
+        cache.updateParagraph(static_cast<ParagraphImpl*>(paragraph.get()));
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        add("text " + std::to_string(i));
+    }
+    auto stats = cache.getStats();
+    REPORTER_ASSERT(reporter, stats.fEntries == 100);
+    REPORTER_ASSERT(reporter, stats.fPurged == 0);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed <= cache.getBudget());
+
+    // Shrinking the budget purges the entries over it
+    cache.setBudget(stats.fBytesUsed / 4);
+    stats = cache.getStats();
+    REPORTER_ASSERT(reporter, stats.fEntries < 100);
+    REPORTER_ASSERT(reporter, stats.fPurged == 100 - stats.fEntries);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed <= cache.getBudget());
+
+    // And the budget holds as more are added
+    for (int i = 100; i < 200; ++i) {
+        add("text " + std::to_string(i));
+    }
+    stats = cache.getStats();
+    REPORTER_ASSERT(reporter, stats.fBytesUsed <= cache.getBudget());
+
+    cache.reset();
+    stats = cache.getStats();
+    REPORTER_ASSERT(reporter, stats.fEntries == 0);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed == 0);
+}
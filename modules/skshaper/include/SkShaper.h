@@ -54,6 +54,26 @@ public:
     static std::unique_ptr<SkShaper> MakeShaperDrivenWrapper(sk_sp<SkFontMgr> = nullptr);
     static std::unique_ptr<SkShaper> MakeShapeThenWrap(sk_sp<SkFontMgr> = nullptr);
     static std::unique_ptr<SkShaper> MakeShapeDontWrapOrReorder(sk_sp<SkFontMgr> = nullptr);
+
+    /**
+     *  The HarfBuzz shapers can shape text one word at a time and keep the glyphs of up to
+     *  'words' words to reuse wherever the same word comes up in the same font, script, language
+     *  and features. Only text that shapes the same either way is shaped by words: left to right,
+     *  in scripts such as Latin, Cyrillic or Hangul, in fonts whose lookups don't involve the
+     *  space. Han and kana, where each character is a word, only in fonts with no lookups at all.
+     *  0 (the default) turns this off and empties the cache. Returns the previous limit.
+     */
+    static int SetHarfBuzzWordCacheLimit(int words);
+
+    /** Counts of the shaping done on the calling thread, and the size of the shared cache. */
+    struct HarfBuzzStats {
+        int fShapeCalls;        // hb_shape() calls, for runs or words
+        int fShapedCodePoints;  // in those calls, not counting the context
+        int fWordHits;
+        int fWordMisses;
+        int fCachedWords;
+    };
+    static HarfBuzzStats GetHarfBuzzStats();
     #endif
     #ifdef SK_SHAPER_CORETEXT_AVAILABLE
     static std::unique_ptr<SkShaper> MakeCoreText();
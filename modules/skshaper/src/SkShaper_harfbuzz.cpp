@@ -19,10 +19,12 @@
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkBitmaskEnum.h"
+#include "include/private/SkChecksum.h"
 #include "include/private/SkMalloc.h"
 #include "include/private/SkMutex.h"
 #include "include/private/SkTArray.h"
 #include "include/private/SkTFitsIn.h"
+#include "include/private/SkTHash.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "modules/skshaper/include/SkShaper.h"
@@ -36,6 +38,7 @@
 #include <hb-icu.h>
 #include <hb-ot.h>
 #include <unicode/ubrk.h>
+#include <unicode/uchar.h>
 #include <unicode/umachine.h>
 #include <unicode/urename.h>
 #include <unicode/uscript.h>
@@ -43,6 +46,7 @@
 #include <unicode/utext.h>
 #include <unicode/utypes.h>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <type_traits>
@@ -667,6 +671,16 @@ protected:
                     const ScriptRunIterator&,
                     const FontRunIterator&,
                     const Feature*, size_t featuresSize) const;
+    // Shapes a left to right run one word at a time, with the words in the cache.
+    ShapedRun shapeWords(const char* utf8,
+                         const char* utf8Start,
+                         const char* utf8End,
+                         SkBidiIterator::Level,
+                         const SkFont&,
+                         hb_font_t*,
+                         hb_script_t,
+                         hb_language_t,
+                         const SkSTArray<32, hb_feature_t>& features) const;
 private:
     std::unique_ptr<SkUnicode> fUnicode = SkUnicode::Make();
     const sk_sp<SkFontMgr> fFontMgr;
@@ -1298,21 +1312,20 @@ void ShapeDontWrapOrReorder::wrap(char const * const utf8, size_t utf8Bytes,
     handler->commitLine();
 }
 
-ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
-                                  size_t const utf8Bytes,
-                                  char const * const utf8Start,
-                                  char const * const utf8End,
-                                  const BiDiRunIterator& bidi,
-                                  const LanguageRunIterator& language,
-                                  const ScriptRunIterator& script,
-                                  const FontRunIterator& font,
-                                  Feature const * const features, size_t const featuresSize) const
-{
-    size_t utf8runLength = utf8End - utf8Start;
-    ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
-                  font.currentFont(), bidi.currentLevel(), nullptr, 0);
-
-    hb_buffer_t* buffer = fBuffer.get();
+// Counts for SkShaper::GetHarfBuzzStats(), per thread so concurrent shapers don't disturb them.
+thread_local int gShapeCalls = 0;
+thread_local int gShapedCodePoints = 0;
+thread_local int gWordHits = 0;
+thread_local int gWordMisses = 0;
+
+// Shapes utf8[utf8Start:utf8End) with the rest of utf8 as context into glyphs whose clusters are
+// indexes into utf8. Returns the number of glyphs.
+size_t shape_with_harfbuzz(hb_buffer_t* buffer, hb_font_t* hbFont, const SkFont& font,
+                           const char* utf8, size_t utf8Bytes,
+                           const char* utf8Start, const char* utf8End,
+                           hb_direction_t direction, hb_script_t script, hb_language_t language,
+                           const hb_feature_t* features, size_t featuresSize,
+                           std::unique_ptr<ShapedGlyph[]>* glyphs, SkVector* advance) {
     SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
     hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
     hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
@@ -1336,9 +1349,282 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // Add postcontext.
     hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
 
-    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
     hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
+    hb_buffer_set_script(buffer, script);
+    hb_buffer_set_language(buffer, language);
+    hb_buffer_guess_segment_properties(buffer);
+
+    gShapeCalls++;
+    gShapedCodePoints += hb_buffer_get_length(buffer);
+    hb_shape(hbFont, buffer, features, featuresSize);
+    unsigned len = hb_buffer_get_length(buffer);
+    if (len == 0) {
+        return 0;
+    }
+
+    if (direction == HB_DIRECTION_RTL) {
+        // Put the clusters back in logical order.
+        // Note that the advances remain ltr.
+        hb_buffer_reverse(buffer);
+    }
+    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
+    hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
+
+    glyphs->reset(new ShapedGlyph[len]);
+    int scaleX, scaleY;
+    hb_font_get_scale(hbFont, &scaleX, &scaleY);
+    double textSizeY = font.getSize() / scaleY;
+    double textSizeX = font.getSize() / scaleX * font.getScaleX();
+    SkVector runAdvance = { 0, 0 };
+    for (unsigned i = 0; i < len; i++) {
+        ShapedGlyph& glyph = (*glyphs)[i];
+        glyph.fID = info[i].codepoint;
+        glyph.fCluster = info[i].cluster;
+        glyph.fOffset.fX = pos[i].x_offset * textSizeX;
+        glyph.fOffset.fY = -(pos[i].y_offset * textSizeY); // HarfBuzz y-up, Skia y-down
+        glyph.fAdvance.fX = pos[i].x_advance * textSizeX;
+        glyph.fAdvance.fY = -(pos[i].y_advance * textSizeY); // HarfBuzz y-up, Skia y-down
+
+        SkRect bounds;
+        SkScalar advance;
+        SkPaint p;
+        font.getWidthsBounds(&glyph.fID, 1, &advance, &bounds, &p);
+        glyph.fHasVisual = !bounds.isEmpty(); //!font->currentTypeface()->glyphBoundsAreZero(glyph.fID);
+#if SK_HB_VERSION_CHECK(1, 5, 0)
+        glyph.fUnsafeToBreak = info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK;
+#else
+        glyph.fUnsafeToBreak = false;
+#endif
+        glyph.fMustLineBreakBefore = false;
+
+        runAdvance += glyph.fAdvance;
+    }
+    *advance = runAdvance;
+    return len;
+}
+
+// The glyphs of words shaped on their own, to be reused wherever the same word comes up in the
+// same font, script, language and features. A word is the text up to and including the spaces
+// after it, or one CJK ideograph or kana; either way with the marks and variation selectors that
+// follow it. This gives the same glyphs as shaping the whole run only where nothing is shaped
+// across words: left to right scripts that are shaped one word at a time (not Arabic, Indic or
+// Thai, say), in fonts whose lookups never involve the space glyph. Ideographs and kana are only
+// split up in fonts with no lookups at all, since any lookup could kern or ligate them.
+struct ShapedWordKey {
+    SkFont fFont;
+    hb_script_t fScript;
+    hb_language_t fLanguage;
+    SkSTArray<4, hb_feature_t, true> fFeatures;  // All global
+    SkString fText;
+
+    bool operator==(const ShapedWordKey& that) const {
+        if (fText != that.fText || !(fFont == that.fFont) || fScript != that.fScript ||
+            fLanguage != that.fLanguage || fFeatures.count() != that.fFeatures.count()) {
+            return false;
+        }
+        for (int i = 0; i < fFeatures.count(); ++i) {
+            if (fFeatures[i].tag != that.fFeatures[i].tag ||
+                fFeatures[i].value != that.fFeatures[i].value) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct Hash {
+        uint32_t operator()(const ShapedWordKey& key) const {
+            uint32_t hash = SkGoodHash()(key.fText);
+            hash = SkChecksum::Mix(hash ^ key.fFont.getTypeface()->uniqueID());
+            hash = SkChecksum::Mix(hash ^ SkGoodHash()(key.fFont.getSize()));
+            hash = SkChecksum::Mix(hash ^ (uint32_t)key.fScript);
+            for (const hb_feature_t& feature : key.fFeatures) {
+                hash = SkChecksum::Mix(hash ^ feature.tag ^ feature.value);
+            }
+            return hash;
+        }
+    };
+};
+
+struct ShapedWord {
+    std::unique_ptr<ShapedGlyph[]> fGlyphs;  // Clusters are indexes into the word
+    size_t fNumGlyphs = 0;
+    SkVector fAdvance = { 0, 0 };
+};
+
+SkMutex gWordCacheMutex;
+int gWordCacheLimit = 0;
+SkLRUCache<ShapedWordKey, ShapedWord, ShapedWordKey::Hash>* gWordCache = nullptr;
+// What the GSUB, GPOS or kern lookups of a typeface (by unique id) may shape across
+enum class ShapesAcross {
+    kNothing,     // there are no lookups
+    kCharacters,  // but never the space glyph
+    kSpaces,
+};
+SkTHashMap<SkFontID, ShapesAcross>* gTypefaceShapesAcross = nullptr;
+
+// Appends the glyphs of the word starting at utf8[offset] if it's cached. The lock is only held
+// to copy the glyphs, so shapers on other threads can use the cache in the meantime.
+bool find_word(const ShapedWordKey& key, uint32_t offset,
+               SkTArray<ShapedGlyph, true>* glyphs, SkVector* advance) {
+    SkAutoMutexExclusive lock(gWordCacheMutex);
+    ShapedWord* word = gWordCache ? gWordCache->find(key) : nullptr;
+    if (!word) {
+        return false;
+    }
+    for (size_t i = 0; i < word->fNumGlyphs; ++i) {
+        glyphs->push_back(word->fGlyphs[i]).fCluster += offset;
+    }
+    *advance += word->fAdvance;
+    return true;
+}
+
+void add_word(const ShapedWordKey& key, ShapedWord word) {
+    SkAutoMutexExclusive lock(gWordCacheMutex);
+    if (gWordCache && !gWordCache->find(key)) {
+        gWordCache->insert(key, std::move(word));
+    }
+}
+
+ShapesAcross font_shapes_across_uncached(hb_font_t* hbFont) {
+    hb_face_t* face = hb_font_get_face(hbFont);
+    if (!hb_ot_layout_has_positioning(face)) {
+        // HarfBuzz kerns with the old kern table only without GPOS; don't look inside it.
+        HBBlob kern(hb_face_reference_table(face, HB_TAG('k','e','r','n')));
+        if (hb_blob_get_length(kern.get()) > 0) {
+            return ShapesAcross::kSpaces;
+        }
+    }
+    hb_codepoint_t space;
+    bool hasSpace = hb_font_get_nominal_glyph(hbFont, ' ', &space);
+    ShapesAcross shapesAcross = ShapesAcross::kNothing;
+    using HBSet = resource<hb_set_t, decltype(hb_set_destroy), hb_set_destroy>;
+    HBSet glyphs(hb_set_create());
+    for (hb_tag_t table : { HB_OT_TAG_GSUB, HB_OT_TAG_GPOS }) {
+        unsigned lookups = hb_ot_layout_table_get_lookup_count(face, table);
+        for (unsigned i = 0; i < lookups; ++i) {
+            shapesAcross = ShapesAcross::kCharacters;
+            if (!hasSpace) {
+                break;
+            }
+            hb_set_clear(glyphs.get());
+            hb_ot_layout_lookup_collect_glyphs(face, table, i, glyphs.get(), glyphs.get(),
+                                               glyphs.get(), nullptr);
+            if (hb_set_has(glyphs.get(), space)) {
+                return ShapesAcross::kSpaces;
+            }
+        }
+    }
+    return shapesAcross;
+}
+
+// Whether every word of a run is an ideograph or kana (with its marks) and spaces.
+bool script_has_character_words(hb_script_t script) {
+    return script == HB_SCRIPT_HAN || script == HB_SCRIPT_HIRAGANA || script == HB_SCRIPT_KATAKANA;
+}
+
+// Returns false when the word cache is off.
+bool font_can_be_shaped_by_words(const SkFont& font, hb_font_t* hbFont, hb_script_t script) {
+    auto canBeShapedByWords = [script](ShapesAcross shapesAcross) {
+        return shapesAcross == ShapesAcross::kNothing ||
+               (shapesAcross == ShapesAcross::kCharacters && !script_has_character_words(script));
+    };
+    SkFontID typefaceID = font.getTypeface()->uniqueID();
+    {
+        SkAutoMutexExclusive lock(gWordCacheMutex);
+        if (!gWordCache) {
+            return false;
+        }
+        if (ShapesAcross* shapesAcross = gTypefaceShapesAcross->find(typefaceID)) {
+            return canBeShapedByWords(*shapesAcross);
+        }
+    }
+    ShapesAcross shapesAcross = font_shapes_across_uncached(hbFont);
+    SkAutoMutexExclusive lock(gWordCacheMutex);
+    if (gTypefaceShapesAcross) {
+        gTypefaceShapesAcross->set(typefaceID, shapesAcross);
+    }
+    return canBeShapedByWords(shapesAcross);
+}
+
+bool script_shapes_words_alone(hb_script_t script) {
+    switch (script) {
+        case HB_SCRIPT_COMMON:
+        case HB_SCRIPT_LATIN:
+        case HB_SCRIPT_GREEK:
+        case HB_SCRIPT_CYRILLIC:
+        case HB_SCRIPT_ARMENIAN:
+        case HB_SCRIPT_GEORGIAN:
+        case HB_SCRIPT_CHEROKEE:
+        case HB_SCRIPT_HAN:
+        case HB_SCRIPT_HIRAGANA:
+        case HB_SCRIPT_KATAKANA:
+        case HB_SCRIPT_BOPOMOFO:
+        case HB_SCRIPT_HANGUL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool is_cjk_word(SkUnichar u) {
+    UErrorCode status = U_ZERO_ERROR;
+    UScriptCode script = uscript_getScript(u, &status);
+    return U_SUCCESS(status) &&
+           (script == USCRIPT_HAN || script == USCRIPT_HIRAGANA || script == USCRIPT_KATAKANA);
+}
+
+// Whether u is shaped with the character before it: a combining mark (like the kana voicing
+// marks), a variation selector or a joiner.
+bool extends_cluster(SkUnichar u) {
+    switch (u_getIntPropertyValue(u, UCHAR_GRAPHEME_CLUSTER_BREAK)) {
+        case U_GCB_EXTEND:
+        case U_GCB_SPACING_MARK:
+        case U_GCB_ZWJ:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the end of the word starting at utf8Start.
+const char* next_word_end(const char* utf8Start, const char* utf8End) {
+    const char* current = utf8Start;
+    SkUnichar u = utf8_next(&current, utf8End);
+    bool cjk = is_cjk_word(u);
+    bool spaces = u == ' ';
+    while (current < utf8End) {
+        const char* next = current;
+        SkUnichar v = utf8_next(&next, utf8End);
+        // A joiner also keeps the character after it.
+        if (!extends_cluster(v) && u != 0x200D) {
+            if (v == ' ') {
+                spaces = true;
+            } else if (spaces || cjk || is_cjk_word(v)) {
+                break;
+            }
+        }
+        u = v;
+        current = next;
+    }
+    return current;
+}
+
+ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
+                                  size_t const utf8Bytes,
+                                  char const * const utf8Start,
+                                  char const * const utf8End,
+                                  const BiDiRunIterator& bidi,
+                                  const LanguageRunIterator& language,
+                                  const ScriptRunIterator& script,
+                                  const FontRunIterator& font,
+                                  Feature const * const features, size_t const featuresSize) const
+{
+    size_t utf8runLength = utf8End - utf8Start;
+    ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
+                  font.currentFont(), bidi.currentLevel(), nullptr, 0);
+
+    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
+    hb_script_t hbScript = hb_script_from_iso15924_tag((hb_tag_t)script.currentScript());
     // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
     // The user must provide a language, but may provide data hb_language_from_string cannot use.
     // Use "und" for the undefined language in this case (RFC5646 4.1 5).
@@ -1346,8 +1632,6 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     if (hbLanguage == HB_LANGUAGE_INVALID) {
         hbLanguage = fUndefinedLanguage;
     }
-    hb_buffer_set_language(buffer, hbLanguage);
-    hb_buffer_guess_segment_properties(buffer);
 
     // TODO: better cache HBFace (data) / hbfont (typeface)
     // An HBFace is expensive (it sanitizes the bits).
@@ -1372,6 +1656,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
 
     SkSTArray<32, hb_feature_t> hbFeatures;
+    bool featuresAreGlobal = true;
     for (const auto& feature : SkMakeSpan(features, featuresSize)) {
         if (feature.end < SkTo<size_t>(utf8Start - utf8) ||
                           SkTo<size_t>(utf8End   - utf8)  <= feature.start)
@@ -1386,61 +1671,113 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         } else {
             hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
                                    SkTo<unsigned>(feature.start), SkTo<unsigned>(feature.end)});
+            featuresAreGlobal = false;
         }
     }
 
-    hb_shape(hbFont.get(), buffer, hbFeatures.data(), hbFeatures.size());
-    unsigned len = hb_buffer_get_length(buffer);
+    if (direction == HB_DIRECTION_LTR && featuresAreGlobal &&
+        script_shapes_words_alone(hbScript) &&
+        font_can_be_shaped_by_words(font.currentFont(), hbFont.get(), hbScript))
+    {
+        return this->shapeWords(utf8, utf8Start, utf8End, bidi.currentLevel(), font.currentFont(),
+                                hbFont.get(), hbScript, hbLanguage, hbFeatures);
+    }
+
+    std::unique_ptr<ShapedGlyph[]> glyphs;
+    SkVector advance;
+    size_t len = shape_with_harfbuzz(fBuffer.get(), hbFont.get(), font.currentFont(),
+                                     utf8, utf8Bytes, utf8Start, utf8End,
+                                     direction, hbScript, hbLanguage,
+                                     hbFeatures.data(), hbFeatures.size(), &glyphs, &advance);
     if (len == 0) {
         return run;
     }
+    return ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
+                     font.currentFont(), bidi.currentLevel(), std::move(glyphs), len, advance);
+}
 
-    if (direction == HB_DIRECTION_RTL) {
-        // Put the clusters back in logical order.
-        // Note that the advances remain ltr.
-        hb_buffer_reverse(buffer);
-    }
-    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
-    hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
+ShapedRun ShaperHarfBuzz::shapeWords(char const * const utf8,
+                                     char const * const utf8Start,
+                                     char const * const utf8End,
+                                     SkBidiIterator::Level level,
+                                     const SkFont& font,
+                                     hb_font_t* hbFont,
+                                     hb_script_t script,
+                                     hb_language_t language,
+                                     const SkSTArray<32, hb_feature_t>& features) const
+{
+    ShapedWordKey key;
+    key.fFont = font;
+    key.fScript = script;
+    key.fLanguage = language;
+    key.fFeatures.push_back_n(features.count(), features.begin());
 
-    run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
-                    font.currentFont(), bidi.currentLevel(),
-                    std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len);
-    int scaleX, scaleY;
-    hb_font_get_scale(hbFont.get(), &scaleX, &scaleY);
-    double textSizeY = run.fFont.getSize() / scaleY;
-    double textSizeX = run.fFont.getSize() / scaleX * run.fFont.getScaleX();
+    SkSTArray<64, ShapedGlyph, true> glyphs;
     SkVector runAdvance = { 0, 0 };
-    for (unsigned i = 0; i < len; i++) {
-        ShapedGlyph& glyph = run.fGlyphs[i];
-        glyph.fID = info[i].codepoint;
-        glyph.fCluster = info[i].cluster;
-        glyph.fOffset.fX = pos[i].x_offset * textSizeX;
-        glyph.fOffset.fY = -(pos[i].y_offset * textSizeY); // HarfBuzz y-up, Skia y-down
-        glyph.fAdvance.fX = pos[i].x_advance * textSizeX;
-        glyph.fAdvance.fY = -(pos[i].y_advance * textSizeY); // HarfBuzz y-up, Skia y-down
-
-        SkRect bounds;
-        SkScalar advance;
-        SkPaint p;
-        run.fFont.getWidthsBounds(&glyph.fID, 1, &advance, &bounds, &p);
-        glyph.fHasVisual = !bounds.isEmpty(); //!font->currentTypeface()->glyphBoundsAreZero(glyph.fID);
-#if SK_HB_VERSION_CHECK(1, 5, 0)
-        glyph.fUnsafeToBreak = info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK;
-#else
-        glyph.fUnsafeToBreak = false;
-#endif
-        glyph.fMustLineBreakBefore = false;
+    for (const char* wordStart = utf8Start; wordStart < utf8End; ) {
+        const char* wordEnd = next_word_end(wordStart, utf8End);
+        key.fText.set(wordStart, wordEnd - wordStart);
 
-        runAdvance += glyph.fAdvance;
+        uint32_t wordOffset = SkToU32(wordStart - utf8);
+        if (find_word(key, wordOffset, &glyphs, &runAdvance)) {
+            gWordHits++;
+        } else {
+            gWordMisses++;
+            ShapedWord word;
+            word.fNumGlyphs = shape_with_harfbuzz(fBuffer.get(), hbFont, font,
+                                                  wordStart, wordEnd - wordStart,
+                                                  wordStart, wordEnd,
+                                                  HB_DIRECTION_LTR, script, language,
+                                                  features.data(), features.size(),
+                                                  &word.fGlyphs, &word.fAdvance);
+            for (size_t i = 0; i < word.fNumGlyphs; ++i) {
+                glyphs.push_back(word.fGlyphs[i]).fCluster += wordOffset;
+            }
+            runAdvance += word.fAdvance;
+            add_word(key, std::move(word));
+        }
+        wordStart = wordEnd;
     }
-    run.fAdvance = runAdvance;
 
+    size_t len = glyphs.count();
+    ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8End - utf8Start), font, level,
+                  len ? std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]) : nullptr, len,
+                  runAdvance);
+    std::copy(glyphs.begin(), glyphs.end(), run.fGlyphs.get());
     return run;
 }
 
 }  // namespace
 
+int SkShaper::SetHarfBuzzWordCacheLimit(int words) {
+    SkAutoMutexExclusive lock(gWordCacheMutex);
+    int previous = gWordCacheLimit;
+    gWordCacheLimit = std::max(words, 0);
+    if (gWordCacheLimit != previous) {
+        delete gWordCache;
+        delete gTypefaceShapesAcross;
+        gWordCache = nullptr;
+        gTypefaceShapesAcross = nullptr;
+        if (gWordCacheLimit > 0) {
+            gWordCache = new SkLRUCache<ShapedWordKey, ShapedWord, ShapedWordKey::Hash>(
+                    gWordCacheLimit);
+            gTypefaceShapesAcross = new SkTHashMap<SkFontID, ShapesAcross>;
+        }
+    }
+    return previous;
+}
+
+SkShaper::HarfBuzzStats SkShaper::GetHarfBuzzStats() {
+    SkAutoMutexExclusive lock(gWordCacheMutex);
+    HarfBuzzStats stats;
+    stats.fShapeCalls = gShapeCalls;
+    stats.fShapedCodePoints = gShapedCodePoints;
+    stats.fWordHits = gWordHits;
+    stats.fWordMisses = gWordMisses;
+    stats.fCachedWords = gWordCache ? gWordCache->count() : 0;
+    return stats;
+}
+
 std::unique_ptr<SkShaper::BiDiRunIterator>
 SkShaper::MakeIcuBiDiRunIterator(const char* utf8, size_t utf8Bytes, uint8_t bidiLevel) {
     auto unicode = SkUnicode::Make();
@@ -0,0 +1,130 @@
+// Copyright 2020 Google LLC.
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "tests/Test.h"
+
+#ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+
+#include "include/core/SkData.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkTypeface.h"
+#include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkPointPriv.h"
+#include "tools/Resources.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+// Collects the glyphs, positions and clusters of all the runs.
+struct CollectingRunHandler final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        size_t runStart = fGlyphs.size();
+        fGlyphs.resize(runStart + info.glyphCount);
+        fPositions.resize(runStart + info.glyphCount);
+        fClusters.resize(runStart + info.glyphCount);
+        return {fGlyphs.data() + runStart, fPositions.data() + runStart, nullptr,
+                fClusters.data() + runStart, {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override {}
+};
+
+void check_same(skiatest::Reporter* r, const CollectingRunHandler& shaped,
+                const CollectingRunHandler& expected, const char* name, int shaper) {
+    REPORTER_ASSERT(r, shaped.fGlyphs == expected.fGlyphs, "%s %d", name, shaper);
+    REPORTER_ASSERT(r, shaped.fClusters == expected.fClusters, "%s %d", name, shaper);
+    REPORTER_ASSERT(r, shaped.fPositions.size() == expected.fPositions.size(),
+                    "%s %d", name, shaper);
+    size_t count = std::min(shaped.fPositions.size(), expected.fPositions.size());
+    for (size_t i = 0; i < count; ++i) {
+        // A run shaped by words sums the advances of the words rather than of the glyphs.
+        if (!SkPointPriv::EqualsWithinTolerance(shaped.fPositions[i], expected.fPositions[i])) {
+            ERRORF(r, "%s %d: glyph %zu at (%g, %g), expected (%g, %g)", name, shaper, i,
+                   shaped.fPositions[i].fX, shaped.fPositions[i].fY,
+                   expected.fPositions[i].fX, expected.fPositions[i].fY);
+            return;
+        }
+    }
+}
+}  // namespace
+
+// Shapes the same text with the word cache off and on; the glyphs must not change.
+DEF_TEST(SkShaper_WordCache, r) {
+    static constexpr struct {
+        const char* fName;
+        const char* fText;  // or nullptr to read the resource fName
+        bool fAllWords;     // every run can be shaped by words
+    } kTexts[] = {
+        { "text/english.txt",        nullptr, true  },
+        // Fonts with any lookups shape the runs of ideographs and kana whole.
+        { "text/han_simplified.txt", nullptr, false },
+        // Only the runs of digits can come from the cache; the right to left runs are shaped whole.
+        { "text/arabic.txt",         nullptr, false },
+        // The marks stay with the letters before them, even after a space.
+        { "combining marks",
+          "cafe\u0301 na\u0308ive re\u0301sume\u0301 \u0301x a\u0301\u0323", true },
+        // Ideographic variation sequences, variation selectors and kana voicing marks.
+        { "variation selectors",
+          "\u845B\U000E0100\u98FE\u533A \u8FBB\U000E0101\u8FBB\u8FBB\uFE00 "
+          "\u304B\u3099\u304B\u3099\u3063\u3053\u3046\u309A \u30AB\u3099", false },
+    };
+    std::unique_ptr<SkShaper> shapers[] = {
+        SkShaper::MakeShaperDrivenWrapper(),
+        SkShaper::MakeShapeThenWrap(),
+        SkShaper::MakeShapeDontWrapOrReorder(),
+    };
+    SkFont font(SkTypeface::MakeDefault());
+
+    // Only this test changes the limit, the stats are counted per thread.
+    int previousLimit = SkShaper::SetHarfBuzzWordCacheLimit(0);
+    for (const auto& text : kTexts) {
+        sk_sp<SkData> data = text.fText ? SkData::MakeWithoutCopy(text.fText, strlen(text.fText))
+                                        : GetResourceAsData(text.fName);
+        if (!data) {
+            continue;
+        }
+        const char* utf8 = (const char*)data->data();
+        for (int i = 0; i < (int)SK_ARRAY_COUNT(shapers); ++i) {
+            if (!shapers[i]) {
+                continue;
+            }
+            SkShaper::SetHarfBuzzWordCacheLimit(0);
+            CollectingRunHandler expected;
+            shapers[i]->shape(utf8, data->size(), font, true, 400, &expected);
+
+            SkShaper::SetHarfBuzzWordCacheLimit(1000);
+            for (int pass = 0; pass < 2; ++pass) {
+                SkShaper::HarfBuzzStats before = SkShaper::GetHarfBuzzStats();
+                CollectingRunHandler shaped;
+                shapers[i]->shape(utf8, data->size(), font, true, 400, &shaped);
+                SkShaper::HarfBuzzStats after = SkShaper::GetHarfBuzzStats();
+
+                check_same(r, shaped, expected, text.fName, i);
+                if (pass == 1 && text.fAllWords) {
+                    // The words were all shaped the first time around.
+                    REPORTER_ASSERT(r, after.fShapeCalls == before.fShapeCalls,
+                                    "%s %d", text.fName, i);
+                    REPORTER_ASSERT(r, after.fWordMisses == before.fWordMisses,
+                                    "%s %d", text.fName, i);
+                    REPORTER_ASSERT(r, after.fWordHits > before.fWordHits,
+                                    "%s %d", text.fName, i);
+                }
+            }
+        }
+    }
+    SkShaper::SetHarfBuzzWordCacheLimit(previousLimit);
+}
+
+#endif  // SK_SHAPER_HARFBUZZ_AVAILABLE
@@ -7,6 +7,7 @@
 
 #include "include/core/SkBBHFactory.h"
 #include "src/core/SkBigPicture.h"
+#include "src/core/SkFlatRTree.h"
 #include "src/core/SkPictureCommon.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecordDraw.h"
@@ -35,10 +36,31 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  this->drawablePicts(),
                  nullptr,
                  this->drawableCount(),
-                 useBBH ? fBBH.get() : nullptr,
+                 useBBH ? this->playbackBBH() : nullptr,
                  callback);
 }
 
+const SkBBoxHierarchy* SkBigPicture::playbackBBH() const {
+    // Below this many ops, searching an R-tree costs about as much as visiting every op.
+    static constexpr int kMinOpsForLazyBBH = 64;
+
+    if (fBBH || fRecord->count() < kMinOpsForLazyBBH) {
+        return fBBH.get();
+    }
+    fLazyBBHOnce([this] {
+        TRACE_EVENT0("skia", "SkBigPicture::buildLazyBBH");
+        const int count = fRecord->count();
+        SkAutoTMalloc<SkRect> bounds(count);
+        SkAutoTMalloc<SkBBoxHierarchy::Metadata> meta(count);
+        SkRecordFillBounds(fCullRect, *fRecord, bounds, meta);
+
+        sk_sp<SkBBoxHierarchy> bbh = sk_make_sp<SkFlatRTree>();
+        bbh->insert(bounds, meta, count);
+        fLazyBBH = std::move(bbh);
+    });
+    return fLazyBBH.get();
+}
+
 void SkBigPicture::partialPlayback(SkCanvas* canvas,
                                    int start,
                                    int stop,
@@ -55,6 +55,10 @@ public:
                          const SkMatrix& initialCTM) const;
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
+    // Returns the BBH to cull playback with: the one recorded with the picture if there is one,
+    // otherwise one built (once, thread-safely) from the ops' bounds.  Returns nullptr for
+    // pictures too small to be worth indexing.
+    const SkBBoxHierarchy* playbackBBH() const;
     const SkRecord*     record() const { return fRecord.get(); }
 
 private:
@@ -66,6 +70,10 @@ private:
     sk_sp<const SkRecord>                fRecord;
     std::unique_ptr<const SnapshotArray> fDrawablePicts;
     sk_sp<const SkBBoxHierarchy>         fBBH;
+
+    // Pictures recorded without a BBH get one built on their first culled playback.
+    mutable SkOnce                       fLazyBBHOnce;
+    mutable sk_sp<const SkBBoxHierarchy> fLazyBBH;
 };
 
 #endif//SkBigPicture_DEFINED
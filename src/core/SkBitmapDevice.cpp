@@ -381,6 +381,15 @@ void SkBitmapDevice::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
 #endif
 }
 
+void SkBitmapDevice::drawDRRect(const SkRRect& outer, const SkRRect& inner,
+                                const SkPaint& paint) {
+#ifdef SK_IGNORE_BLURRED_RRECT_OPT
+    this->INHERITED::drawDRRect(outer, inner, paint);
+#else
+    LOOP_TILER( drawDRRect(outer, inner, paint), Bounder(outer.getBounds(), paint))
+#endif
+}
+
 void SkBitmapDevice::drawPath(const SkPath& path,
                               const SkPaint& paint,
                               bool pathIsMutable) {
@@ -12,6 +12,7 @@
 #include "include/core/SkString.h"
 #include "include/private/SkColorData.h"
 #include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkAntiRun.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkMask.h"
@@ -618,6 +619,152 @@ const SkPixmap* SkRgnClipBlitter::justAnOpaqueColor(uint32_t* value) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Larger batches are drawn directly, rather than buffering more than 4MB of coverage.
+static constexpr int64_t kMaxCoverageBatchPixels = 1 << 22;
+
+SkCoverageBatchBlitter::~SkCoverageBatchBlitter() {
+    this->flush();
+}
+
+bool SkCoverageBatchBlitter::init(SkBlitter* blitter, const SkIRect& bounds) {
+    SkASSERT(!fBlitter);
+    if (bounds.isEmpty() || (int64_t)bounds.width() * bounds.height() > kMaxCoverageBatchPixels) {
+        return false;
+    }
+    fBlitter = blitter;
+    fMask.fBounds = bounds;
+    fMask.fFormat = SkMask::kA8_Format;
+    fMask.fRowBytes = bounds.width();
+    fStorage.reset(fMask.computeImageSize());
+    fMask.fImage = fStorage.get();
+    sk_bzero(fMask.fImage, fMask.computeImageSize());
+    return true;
+}
+
+void SkCoverageBatchBlitter::flush() {
+    if (!fBlitter) {
+        return;
+    }
+    // Each row is blitted as runs of coverage, split wherever there's a long enough gap that
+    // shading it would cost more than another blitMask() call. Clearing the mask as we go leaves
+    // it ready for more hairlines.
+    constexpr int kMinGap = 16;
+    const SkIRect& bounds = fMask.fBounds;
+    const int width = bounds.width();
+    for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+        uint8_t* row = fMask.getAddr8(bounds.fLeft, y);
+        int x = 0;
+        while (x < width) {
+            // Skip empty coverage a word at a time.
+            while (x + 8 <= width && !sk_unaligned_load<uint64_t>(row + x)) {
+                x += 8;
+            }
+            while (x < width && !row[x]) {
+                x++;
+            }
+            if (x == width) {
+                break;
+            }
+            int start = x,
+                stop = ++x;
+            for (int zeros = 0; x < width && zeros < kMinGap; ++x) {
+                if (row[x]) {
+                    stop = x + 1;
+                    zeros = 0;
+                } else {
+                    zeros++;
+                }
+            }
+            fBlitter->blitMask(fMask, SkIRect::MakeLTRB(bounds.fLeft + start, y,
+                                                        bounds.fLeft + stop, y + 1));
+            sk_bzero(row + start, stop - start);
+        }
+    }
+}
+
+bool SkCoverageBatchBlitter::clipSpan(int* x, int* width, int y) const {
+    const SkIRect& bounds = fMask.fBounds;
+    if (y < bounds.fTop || y >= bounds.fBottom) {
+        return false;
+    }
+    int left = std::max(*x, bounds.fLeft),
+        right = std::min(*x + *width, bounds.fRight);
+    *x = left;
+    *width = right - left;
+    return left < right;
+}
+
+void SkCoverageBatchBlitter::blitH(int x, int y, int width) {
+    if (this->clipSpan(&x, &width, y)) {
+        memset(fMask.getAddr8(x, y), 0xFF, width);
+    }
+}
+
+void SkCoverageBatchBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
+    for (int n = runs[0]; n > 0; x += n, aa += n, runs += n, n = runs[0]) {
+        int left = x,
+            width = n;
+        if (aa[0] && this->clipSpan(&left, &width, y)) {
+            uint8_t* dst = fMask.getAddr8(left, y);
+            for (int i = 0; i < width; ++i) {
+                dst[i] = Accumulate(dst[i], aa[0]);
+            }
+        }
+    }
+}
+
+void SkCoverageBatchBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
+    for (int i = 0; i < height; ++i) {
+        int left = x,
+            width = 1;
+        if (this->clipSpan(&left, &width, y + i)) {
+            uint8_t* dst = fMask.getAddr8(x, y + i);
+            *dst = Accumulate(*dst, alpha);
+        }
+    }
+}
+
+void SkCoverageBatchBlitter::blitRect(int x, int y, int width, int height) {
+    for (int i = 0; i < height; ++i) {
+        this->blitH(x, y + i, width);
+    }
+}
+
+void SkCoverageBatchBlitter::blitMask(const SkMask& mask, const SkIRect& clip) {
+    if (mask.fFormat != SkMask::kA8_Format) {
+        // BW masks come back through blitH(); LCD coverage can't be kept in an A8 mask.
+        SkASSERT(mask.fFormat != SkMask::kLCD16_Format);
+        this->INHERITED::blitMask(mask, clip);
+        return;
+    }
+
+    SkIRect r;
+    if (!r.intersect(clip, fMask.fBounds)) {
+        return;
+    }
+    using U8  = skvx::Vec<16, uint8_t>;
+    using U16 = skvx::Vec<16, uint16_t>;
+    const int width = r.width();
+    for (int y = r.fTop; y < r.fBottom; ++y) {
+        const uint8_t* src = mask.getAddr8(r.fLeft, y);
+        uint8_t* dst = fMask.getAddr8(r.fLeft, y);
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            U8 s = U8::Load(src + x),
+               d = U8::Load(dst + x);
+            // Same as Accumulate(): div255() rounds exactly like SkMulDiv255Round(), and d + s
+            // may wrap, but the difference can't.
+            U16 ds = skvx::cast<uint16_t>(d) * skvx::cast<uint16_t>(s);
+            (d + s - skvx::div255(ds)).store(dst + x);
+        }
+        for (; x < width; ++x) {
+            dst[x] = Accumulate(dst[x], src[x]);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 SkBlitter* SkBlitterClipper::apply(SkBlitter* blitter, const SkRegion* clip,
                                    const SkIRect* ir) {
     if (clip) {
@@ -9,19 +9,22 @@
 #define SkBlitter_DEFINED
 
 #include "include/core/SkColor.h"
+#include "include/core/SkMath.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRegion.h"
+#include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkMask.h"
 #include "src/shaders/SkShaderBase.h"
 
+class SkCoverageBatchBlitter;
 class SkArenaAlloc;
 class SkMatrix;
 class SkMatrixProvider;
 class SkPaint;
 class SkPixmap;
-struct SkMask;
 
 /** SkBlitter and its subclasses are responsible for actually writing pixels
     into memory. Besides efficiency, they handle clipping and antialiasing.
@@ -113,6 +116,13 @@ public:
      */
     virtual bool isNullBlitter() const;
 
+    /**
+     *  Special method to identify a blitter that accumulates coverage in a mask, so hairlines
+     *  that lie within its bounds can be stepped straight into the mask. Default impl returns
+     *  nullptr.
+     */
+    virtual SkCoverageBatchBlitter* asCoverageBatch() { return nullptr; }
+
     /**
      * Special methods for blitters that can blit more than one row at a time.
      * This function returns the number of rows that this blitter could optimally
@@ -241,6 +251,71 @@ private:
     const SkRegion* fRgn;
 };
 
+/** Accumulates the coverage of many anti-aliased hairlines, or glyph masks, in an A8 mask, then
+    blits the mask to the real blitter in flush() (or the destructor), a run of covered pixels at
+    a time. Where they overlap, their coverage combines as a + b - ab, just as it would if each
+    were blitted in turn with an opaque color, so only wrap blitters that draw an opaque src-over
+    color. Coverage outside the batch's bounds is dropped, and so are LCD masks.
+*/
+class SkCoverageBatchBlitter final : public SkBlitter {
+public:
+    ~SkCoverageBatchBlitter() override;
+
+    /**
+     *  Returns false, and leaves the batch unusable, if the bounds are empty or cover too many
+     *  pixels to buffer.
+     */
+    bool init(SkBlitter* blitter, const SkIRect& bounds);
+
+    void flush();
+
+    const SkIRect& bounds() const { return fMask.fBounds; }
+
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha[], const int16_t runs[]) override;
+    void blitV(int x, int y, int height, SkAlpha alpha) override;
+    void blitRect(int x, int y, int width, int height) override;
+    void blitMask(const SkMask&, const SkIRect& clip) override;
+
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        if (fMask.fBounds.fLeft <= x && x + 1 < fMask.fBounds.fRight &&
+            (unsigned)(y - fMask.fBounds.fTop) < (unsigned)fMask.fBounds.height()) {
+            uint8_t* row = fMask.getAddr8(x, y);
+            row[0] = Accumulate(row[0], a0);
+            row[1] = Accumulate(row[1], a1);
+        } else {
+            this->INHERITED::blitAntiH2(x, y, a0, a1);
+        }
+    }
+
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        if ((unsigned)(x - fMask.fBounds.fLeft) < (unsigned)fMask.fBounds.width() &&
+            fMask.fBounds.fTop <= y && y + 1 < fMask.fBounds.fBottom) {
+            uint8_t* pixel = fMask.getAddr8(x, y);
+            pixel[0] = Accumulate(pixel[0], a0);
+            pixel[fMask.fRowBytes] = Accumulate(pixel[fMask.fRowBytes], a1);
+        } else {
+            this->INHERITED::blitAntiV2(x, y, a0, a1);
+        }
+    }
+
+    SkCoverageBatchBlitter* asCoverageBatch() override { return this; }
+
+private:
+    static uint8_t Accumulate(unsigned dst, unsigned src) {
+        return SkToU8(dst + src - SkMulDiv255Round(dst, src));
+    }
+
+    // Clips the span to the bounds, returning false if nothing is left.
+    bool clipSpan(int* x, int* width, int y) const;
+
+    SkBlitter*            fBlitter = nullptr;
+    SkMask                fMask;
+    SkAutoTMalloc<uint8_t> fStorage;
+
+    using INHERITED = SkBlitter;
+};
+
 #ifdef SK_DEBUG
 class SkRectClipCheckBlitter : public SkBlitter {
 public:
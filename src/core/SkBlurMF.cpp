@@ -10,6 +10,9 @@
 #include "include/core/SkRRect.h"
 #include "include/core/SkStrokeRec.h"
 #include "include/core/SkVertices.h"
+#include "include/private/SkNx.h"
+#include "src/core/SkAutoMalloc.h"
+#include "src/core/SkBlitter.h"
 #include "src/core/SkBlurMask.h"
 #include "src/core/SkBlurPriv.h"
 #include "src/core/SkGpuBlurUtils.h"
@@ -17,6 +20,7 @@
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkRRectPriv.h"
+#include "src/core/SkRasterClip.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkStringUtils.h"
 #include "src/core/SkWriteBuffer.h"
@@ -83,6 +87,13 @@ protected:
                                    const SkIRect& clipBounds,
                                    NinePatch*) const override;
 
+    FilterReturn filterDRRectToNine(const SkRRect& outer, const SkRRect& inner,
+                                    const SkMatrix&, const SkIRect& clipBounds,
+                                    NinePatch*) const override;
+
+    FilterReturn filterRRectDirect(const SkRRect&, const SkMatrix&,
+                                   const SkRasterClip&, SkBlitter*) const override;
+
     bool filterRectMask(SkMask* dstM, const SkRect& r, const SkMatrix& matrix,
                         SkIPoint* margin, SkMask::CreateMode createMode) const;
     bool filterRRectMask(SkMask* dstM, const SkRRect& r, const SkMatrix& matrix,
@@ -313,6 +324,24 @@ static bool draw_rrect_into_mask(const SkRRect rrect, SkMask* mask) {
     return true;
 }
 
+static bool draw_drrect_into_mask(const SkRRect& outer, const SkRRect& inner, SkMask* mask) {
+    if (!prepare_to_draw_into_mask(outer.rect(), mask)) {
+        return false;
+    }
+
+    SkBitmap bitmap;
+    bitmap.installMaskPixels(*mask);
+
+    SkCanvas canvas(bitmap);
+    canvas.translate(-SkIntToScalar(mask->fBounds.left()),
+                     -SkIntToScalar(mask->fBounds.top()));
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    canvas.drawDRRect(outer, inner, paint);
+    return true;
+}
+
 static bool draw_rects_into_mask(const SkRect rects[], int count, SkMask* mask) {
     if (!prepare_to_draw_into_mask(rects[0], mask)) {
         return false;
@@ -377,6 +406,20 @@ static SkCachedData* add_cached_rrect(SkMask* mask, SkScalar sigma, SkBlurStyle
     return cache;
 }
 
+static SkCachedData* find_cached_drrect(SkMask* mask, SkScalar sigma, SkBlurStyle style,
+                                        const SkRRect& outer, const SkRRect& inner) {
+    return SkMaskCache::FindAndRef(sigma, style, outer, inner, mask);
+}
+
+static SkCachedData* add_cached_drrect(SkMask* mask, SkScalar sigma, SkBlurStyle style,
+                                       const SkRRect& outer, const SkRRect& inner) {
+    SkCachedData* cache = copy_mask_to_cacheddata(mask);
+    if (cache) {
+        SkMaskCache::Add(sigma, style, outer, inner, *mask, cache);
+    }
+    return cache;
+}
+
 static SkCachedData* find_cached_rects(SkMask* mask, SkScalar sigma, SkBlurStyle style,
                                        const SkRect rects[], int count) {
     return SkMaskCache::FindAndRef(sigma, style, rects, count, mask);
@@ -526,6 +569,432 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
     return kTrue_FilterReturn;
 }
 
+SkMaskFilterBase::FilterReturn
+SkBlurMaskFilterImpl::filterDRRectToNine(const SkRRect& outer, const SkRRect& inner,
+                                         const SkMatrix& matrix,
+                                         const SkIRect& clipBounds,
+                                         NinePatch* patch) const {
+    // As with nested rects, the inner and outer styles would need an inset the size of the
+    // blur-radius.
+    if (kInner_SkBlurStyle == fBlurStyle || kOuter_SkBlurStyle == fBlurStyle) {
+        return kUnimplemented_FilterReturn;
+    }
+
+    const SkRect& outerR = outer.rect();
+    const SkRect& innerR = inner.rect();
+    if (outer.isEmpty() || inner.isEmpty() || !outerR.contains(innerR)) {
+        return kUnimplemented_FilterReturn;
+    }
+
+    // TODO: take clipBounds into account to limit our coordinates up front
+    // for now, just skip too-large src rects (to take the old code path).
+    if (rect_exceeds(outerR, SkIntToScalar(32767))) {
+        return kUnimplemented_FilterReturn;
+    }
+
+    SkIPoint margin;
+    SkMask  srcM, dstM;
+    srcM.fBounds = outerR.roundOut();
+    srcM.fFormat = SkMask::kA8_Format;
+    srcM.fRowBytes = 0;
+
+    if (!this->filterMask(&dstM, srcM, matrix, &margin)) {
+        return kFalse_FilterReturn;
+    }
+
+    // As in filterRRectToNine, the unstretched parts must cover the corners of both round rects
+    // plus the blur on either side of them. For the inner round rect that is measured from the
+    // outer edge, so only the insets between the two (not their sizes) end up in the cache key.
+    auto unstretched = [&](SkRRect::Corner c0, SkRRect::Corner c1, bool isX, SkScalar inset) {
+        auto radius = [&](const SkRRect& rr) {
+            const SkVector& r0 = rr.radii(c0);
+            const SkVector& r1 = rr.radii(c1);
+            return isX ? std::max(r0.fX, r1.fX) : std::max(r0.fY, r1.fY);
+        };
+        return std::max(radius(outer), inset + radius(inner)) +
+               SkIntToScalar(2 * (isX ? margin.fX : margin.fY));
+    };
+    const SkScalar leftUnstretched = unstretched(SkRRect::kUpperLeft_Corner,
+                                                 SkRRect::kLowerLeft_Corner, true,
+                                                 innerR.fLeft - outerR.fLeft);
+    const SkScalar rightUnstretched = unstretched(SkRRect::kUpperRight_Corner,
+                                                  SkRRect::kLowerRight_Corner, true,
+                                                  outerR.fRight - innerR.fRight);
+    const SkScalar topUnstretched = unstretched(SkRRect::kUpperLeft_Corner,
+                                                SkRRect::kUpperRight_Corner, false,
+                                                innerR.fTop - outerR.fTop);
+    const SkScalar bottomUnstretched = unstretched(SkRRect::kLowerLeft_Corner,
+                                                   SkRRect::kLowerRight_Corner, false,
+                                                   outerR.fBottom - innerR.fBottom);
+
+    // Extra space in the middle to ensure an unchanging piece for stretching.
+    const SkScalar stretchSize = SkIntToScalar(3);
+
+    const SkScalar totalSmallWidth = leftUnstretched + rightUnstretched + stretchSize;
+    const SkScalar totalSmallHeight = topUnstretched + bottomUnstretched + stretchSize;
+    if (totalSmallWidth >= outerR.width() || totalSmallHeight >= outerR.height()) {
+        // There is no valid piece to stretch.
+        return kUnimplemented_FilterReturn;
+    }
+
+    // Shrink both round rects by the same amount, moving them next to the origin. Both are
+    // integral so we don't change any fractional phase of their edges.
+    const SkScalar dx = SkScalarFloorToScalar(outerR.width() - totalSmallWidth);
+    const SkScalar dy = SkScalarFloorToScalar(outerR.height() - totalSmallHeight);
+    const SkScalar tx = SkScalarFloorToScalar(outerR.fLeft);
+    const SkScalar ty = SkScalarFloorToScalar(outerR.fTop);
+    auto shrink = [&](const SkRRect& rr) {
+        SkVector radii[4];
+        for (int i = 0; i < 4; ++i) {
+            radii[i] = rr.radii((SkRRect::Corner)i);
+        }
+        const SkRect& r = rr.rect();
+        SkRRect smallRR;
+        smallRR.setRectRadii(SkRect::MakeLTRB(r.fLeft - tx, r.fTop - ty,
+                                              r.fRight - tx - dx, r.fBottom - ty - dy),
+                             radii);
+        return smallRR;
+    };
+    const SkRRect smallOuter = shrink(outer);
+    const SkRRect smallInner = shrink(inner);
+
+    const SkScalar sigma = this->computeXformedSigma(matrix);
+    SkCachedData* cache = find_cached_drrect(&patch->fMask, sigma, fBlurStyle,
+                                             smallOuter, smallInner);
+    if (!cache) {
+        if (!draw_drrect_into_mask(smallOuter, smallInner, &srcM)) {
+            return kFalse_FilterReturn;
+        }
+
+        SkAutoMaskFreeImage amf(srcM.fImage);
+
+        if (!this->filterMask(&patch->fMask, srcM, matrix, &margin)) {
+            return kFalse_FilterReturn;
+        }
+        cache = add_cached_drrect(&patch->fMask, sigma, fBlurStyle, smallOuter, smallInner);
+    }
+
+    patch->fMask.fBounds.offsetTo(0, 0);
+    patch->fOuterRect = dstM.fBounds;
+    patch->fCenter.fX = SkScalarCeilToInt(outerR.fLeft - tx + leftUnstretched) + 1;
+    patch->fCenter.fY = SkScalarCeilToInt(outerR.fTop - ty + topUnstretched) + 1;
+    SkASSERT(nullptr == patch->fCache);
+    patch->fCache = cache;  // transfer ownership to patch
+    return kTrue_FilterReturn;
+}
+
+std::atomic<bool> gSkUseAnalyticBlurRRect{true};
+
+namespace {
+
+// The standard normal CDF, with erf approximated by Abramowitz & Stegun 7.1.27. Its error (below
+// 5e-4) is invisible in 8-bit coverage, and it needs nothing but arithmetic.
+static Sk4f normal_cdf(const Sk4f& t) {
+    Sk4f x = t.abs() * SK_ScalarRoot2Over2;
+    Sk4f p = 1.0f + x * (0.278393f + x * (0.230389f + x * (0.000972f + x * 0.078108f)));
+    p = p * p;
+    p = p * p;
+    Sk4f halfErf = 0.5f - 0.5f / p;
+    return (t < 0.0f).thenElse(0.5f - halfErf, 0.5f + halfErf);
+}
+
+static float normal_cdf(float t) {
+    return normal_cdf(Sk4f(t))[0];
+}
+
+// How far in from the rect's edge an elliptical corner's edge is, in units of the corner's
+// horizontal radius, at 'd' (in units of its vertical radius) from the corner's center row.
+static float ellipse_inset(float d) {
+    return 1.0f - sqrtf(std::max(0.0f, 1.0f - d * d));
+}
+
+// Evaluates the coverage of a round rect convolved with a Gaussian, one row at a time, without
+// rendering the round rect.
+//
+// The blurred coverage at p is the integral over y of G(y - p.y) times the blurred coverage of
+// the round rect's span [left(y), right(y)] at p.x, and the latter is a difference of normal
+// CDFs. The middle band, where the span is the full width of the rect, is integrated exactly. The
+// bands with corners are split into sub-bands of at most sigma rows, each using the span at its
+// middle row. Everything beyond 3 sigma is ignored.
+class BlurredRRectEvaluator {
+public:
+    BlurredRRectEvaluator(const SkRRect& rrect, SkScalar sigma)
+            : fRect(rrect.rect())
+            , fInvSigma(1.0f / sigma)
+            , fExtent(3.0f * sigma) {
+        for (int i = 0; i < 4; ++i) {
+            fRadii[i] = rrect.radii((SkRRect::Corner)i);
+        }
+        const SkVector& ul = fRadii[SkRRect::kUpperLeft_Corner];
+        const SkVector& ur = fRadii[SkRRect::kUpperRight_Corner];
+        const SkVector& lr = fRadii[SkRRect::kLowerRight_Corner];
+        const SkVector& ll = fRadii[SkRRect::kLowerLeft_Corner];
+        fTopBand = fRect.fTop + std::max(ul.fY, ur.fY);
+        fBottomBand = fRect.fBottom - std::max(ll.fY, lr.fY);
+        if (fTopBand > fBottomBand) {
+            // Skewed corners, say a tall upper left and lower right, can share rows. Then there's
+            // no middle band, and the corner bands meet halfway so no row is counted twice.
+            // leftAt() and rightAt() find the right corner on either side of any row.
+            fTopBand = fBottomBand = SkScalarHalf(fTopBand + fBottomBand);
+        }
+    }
+
+    SkIRect bounds() const {
+        return fRect.makeOutset(fExtent, fExtent).roundOut();
+    }
+
+    // Prepares to evaluate row 'y'. Returns the coverage of the row's interior, the columns
+    // [*interiorL, *interiorR) that are too far from the left and right edges to be affected by
+    // them.
+    uint8_t setRow(int y, int* interiorL, int* interiorR) {
+        const float py = y + 0.5f;
+        const float lo = py - fExtent,
+                    hi = py + fExtent;
+
+        fSampleCount = 0;
+        if (fBottomBand > fTopBand) {
+            float weight = normal_cdf((fBottomBand - py) * fInvSigma) -
+                           normal_cdf((fTopBand - py) * fInvSigma);
+            this->addSample(weight, fRect.fLeft, fRect.fRight);
+        }
+        this->addCornerBand(std::max(fRect.fTop, lo), std::min(fTopBand, hi), py);
+        this->addCornerBand(std::max(fBottomBand, lo), std::min(fRect.fBottom, hi), py);
+
+        fMaxLeft = fRect.fLeft * fInvSigma;
+        fMinRight = fRect.fRight * fInvSigma;
+        for (int i = 0; i < fSampleCount; ++i) {
+            fMaxLeft = std::max(fMaxLeft, fSamples[i].fLeft);
+            fMinRight = std::min(fMinRight, fSamples[i].fRight);
+        }
+
+        // Pixel centers in [l, r] are at least 3 sigma away from every span's ends.
+        float l = fMaxLeft / fInvSigma + fExtent,
+              r = fMinRight / fInvSigma - fExtent;
+        *interiorL = SkScalarCeilToInt(l - 0.5f);
+        *interiorR = std::max(*interiorL, SkScalarFloorToInt(r - 0.5f) + 1);
+
+        fRowCoverage = normal_cdf((fRect.fBottom - py) * fInvSigma) -
+                       normal_cdf((fRect.fTop - py) * fInvSigma);
+        return to_alpha(Sk4f(fRowCoverage))[0];
+    }
+
+    // True if the current row is only affected by the middle band, so its coverage is the
+    // row's coverage times the (row independent) horizontal profile; see evalProfile().
+    bool rowIsSeparable() const {
+        return fSampleCount == 1 && fSamples[0].fLeft == fRect.fLeft * fInvSigma &&
+                                    fSamples[0].fRight == fRect.fRight * fInvSigma;
+    }
+
+    // Writes the blurred coverage of the rect's horizontal extent for columns [x, x + count).
+    void evalProfile(int x, int count, float profile[]) const {
+        const Sk4f l(fRect.fLeft * fInvSigma),
+                   r(fRect.fRight * fInvSigma);
+        Sk4f px = (Sk4f(x + 0.5f) + Sk4f(0, 1, 2, 3)) * fInvSigma;
+        const Sk4f step(4 * fInvSigma);
+        for (int i = 0; i < count; i += 4, px = px + step) {
+            float p[4];
+            (normal_cdf(r - px) - normal_cdf(l - px)).store(p);
+            memcpy(profile + i, p, std::min(4, count - i) * sizeof(float));
+        }
+    }
+
+    // Writes the coverage of pixels [x, x + count) of the current (separable) row to
+    // alpha[0..count), given the profile for those columns.
+    void evalSeparableSpan(const float profile[], int count, uint8_t alpha[]) const {
+        SkASSERT(this->rowIsSeparable());
+        const Sk4f weight(fRowCoverage);
+        for (int i = 0; i < count; i += 4) {
+            float p[4];
+            uint8_t a[4];
+            int n = std::min(4, count - i);
+            memcpy(p, profile + i, n * sizeof(float));
+            to_alpha(weight * Sk4f::Load(p)).store(a);
+            memcpy(alpha + i, a, n);
+        }
+    }
+
+    // Writes the coverage of pixels [x, x + count) of the current row to alpha[0..count).
+    void evalSpan(int x, int count, uint8_t alpha[]) const {
+        Sk4f px = (Sk4f(x + 0.5f) + Sk4f(0, 1, 2, 3)) * fInvSigma;
+        const Sk4f step(4 * fInvSigma);
+        for (int i = 0; i < count; i += 4, px = px + step) {
+            // Spans' ends that are more than 3 sigma away from all four pixels don't matter.
+            const bool needLeft = px[0] < fMaxLeft + 3.0f,
+                       needRight = px[3] > fMinRight - 3.0f;
+            Sk4f coverage(0.0f);
+            for (int j = 0; j < fSampleCount; ++j) {
+                const Sample& s = fSamples[j];
+                Sk4f inside = needRight ? normal_cdf(s.fRight - px) : Sk4f(1.0f);
+                if (needLeft) {
+                    inside = inside - normal_cdf(s.fLeft - px);
+                }
+                coverage = coverage + s.fWeight * inside;
+            }
+            uint8_t a[4];
+            to_alpha(coverage).store(a);
+            memcpy(alpha + i, a, std::min(4, count - i));
+        }
+    }
+
+private:
+    // A band of rows, with its weight and span (in units of sigma).
+    struct Sample {
+        float fWeight;
+        float fLeft;
+        float fRight;
+    };
+
+    // The middle band plus up to two corner bands. Only the part of a corner band within
+    // 3 sigma of the row is sampled, so it takes at most 6 sub-bands of sigma.
+    static constexpr int kMaxSubBands = 6;
+    static constexpr int kMaxSamples = 1 + 2 * kMaxSubBands;
+
+    static Sk4b to_alpha(const Sk4f& coverage) {
+        return SkNx_cast<uint8_t>(Sk4f::Min(Sk4f::Max(coverage, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    void addSample(float weight, float left, float right) {
+        SkASSERT(fSampleCount < kMaxSamples);
+        fSamples[fSampleCount++] = {weight, left * fInvSigma, right * fInvSigma};
+    }
+
+    // Adds samples for the rows [top, bottom) of a band with corners.
+    void addCornerBand(float top, float bottom, float py) {
+        if (!(bottom > top)) {
+            return;
+        }
+        int n = SkTPin(SkScalarCeilToInt((bottom - top) * fInvSigma), 1, kMaxSubBands);
+        float h = (bottom - top) / n;
+        float prev = normal_cdf((top - py) * fInvSigma);
+        for (int i = 0; i < n; ++i) {
+            float y0 = top + i * h;
+            float next = normal_cdf((y0 + h - py) * fInvSigma);
+            float mid = y0 + 0.5f * h;
+            this->addSample(next - prev, this->leftAt(mid), this->rightAt(mid));
+            prev = next;
+        }
+    }
+
+    float leftAt(float y) const {
+        const SkVector& ul = fRadii[SkRRect::kUpperLeft_Corner];
+        const SkVector& ll = fRadii[SkRRect::kLowerLeft_Corner];
+        if (ul.fY > 0 && y < fRect.fTop + ul.fY) {
+            return fRect.fLeft + ul.fX * ellipse_inset((fRect.fTop + ul.fY - y) / ul.fY);
+        }
+        if (ll.fY > 0 && y > fRect.fBottom - ll.fY) {
+            return fRect.fLeft + ll.fX * ellipse_inset((y - fRect.fBottom + ll.fY) / ll.fY);
+        }
+        return fRect.fLeft;
+    }
+
+    float rightAt(float y) const {
+        const SkVector& ur = fRadii[SkRRect::kUpperRight_Corner];
+        const SkVector& lr = fRadii[SkRRect::kLowerRight_Corner];
+        if (ur.fY > 0 && y < fRect.fTop + ur.fY) {
+            return fRect.fRight - ur.fX * ellipse_inset((fRect.fTop + ur.fY - y) / ur.fY);
+        }
+        if (lr.fY > 0 && y > fRect.fBottom - lr.fY) {
+            return fRect.fRight - lr.fX * ellipse_inset((y - fRect.fBottom + lr.fY) / lr.fY);
+        }
+        return fRect.fRight;
+    }
+
+    const SkRect fRect;
+    SkVector     fRadii[4];
+    const float  fInvSigma;
+    const float  fExtent;
+    float        fTopBand;      // the rows with corners are [top, fTopBand) and
+    float        fBottomBand;   // [fBottomBand, bottom)
+
+    // The current row.
+    Sample fSamples[kMaxSamples];
+    int    fSampleCount = 0;
+    float  fMaxLeft;            // in units of sigma
+    float  fMinRight;           // in units of sigma
+    float  fRowCoverage;
+};
+
+static void blit_row(const uint8_t alpha[], int left, int right, int y, SkBlitter* blitter) {
+    if (right > left) {
+        SkMask mask;
+        mask.fImage = const_cast<uint8_t*>(alpha);
+        mask.fBounds.setLTRB(left, y, right, y + 1);
+        mask.fRowBytes = right - left;
+        mask.fFormat = SkMask::kA8_Format;
+        blitter->blitMask(mask, mask.fBounds);
+    }
+}
+
+}  // namespace
+
+void SkDrawAnalyticBlurredRRect(const SkRRect& devRRect, SkScalar sigma, const SkRasterClip& clip,
+                                SkBlitter* blitter) {
+    SkASSERT(sigma > 0 && !devRRect.isEmpty());
+    BlurredRRectEvaluator evaluator(devRRect, sigma);
+
+    SkAAClipBlitterWrapper wrapper(clip, blitter);
+    blitter = wrapper.getBlitter();
+
+    SkAutoSTMalloc<256, uint8_t> alphaStorage;
+    SkAutoSTMalloc<256, float> profileStorage;
+    for (SkRegion::Cliperator clipper(wrapper.getRgn(), evaluator.bounds());
+         !clipper.done(); clipper.next()) {
+        const SkIRect& cr = clipper.rect();
+        uint8_t* alpha = alphaStorage.reset(cr.width());
+        // Rows away from the corners all share one horizontal profile, computed on first use.
+        float* profile = nullptr;
+        for (int y = cr.fTop; y < cr.fBottom; ++y) {
+            int interiorL, interiorR;
+            uint8_t interiorAlpha = evaluator.setRow(y, &interiorL, &interiorR);
+            interiorL = SkTPin(interiorL, cr.fLeft, cr.fRight);
+            interiorR = SkTPin(interiorR, interiorL, cr.fRight);
+            const int leftCount = interiorL - cr.fLeft,
+                      rightCount = cr.fRight - interiorR,
+                      rightOffset = interiorR - cr.fLeft;
+
+            if (evaluator.rowIsSeparable()) {
+                if (!profile) {
+                    profile = profileStorage.reset(cr.width());
+                    evaluator.evalProfile(cr.fLeft, cr.width(), profile);
+                }
+                evaluator.evalSeparableSpan(profile, leftCount, alpha);
+                evaluator.evalSeparableSpan(profile + rightOffset, rightCount,
+                                            alpha + rightOffset);
+            } else {
+                evaluator.evalSpan(cr.fLeft, leftCount, alpha);
+                evaluator.evalSpan(interiorR, rightCount, alpha + rightOffset);
+            }
+
+            if (interiorAlpha == 0xFF) {
+                blit_row(alpha, cr.fLeft, interiorL, y, blitter);
+                if (interiorR > interiorL) {
+                    blitter->blitH(interiorL, y, interiorR - interiorL);
+                }
+                blit_row(alpha + rightOffset, interiorR, cr.fRight, y, blitter);
+            } else {
+                memset(alpha + leftCount, interiorAlpha, interiorR - interiorL);
+                blit_row(alpha, cr.fLeft, cr.fRight, y, blitter);
+            }
+        }
+    }
+}
+
+SkMaskFilterBase::FilterReturn
+SkBlurMaskFilterImpl::filterRRectDirect(const SkRRect& devRRect, const SkMatrix& matrix,
+                                        const SkRasterClip& clip, SkBlitter* blitter) const {
+    if (!gSkUseAnalyticBlurRRect || kNormal_SkBlurStyle != fBlurStyle || devRRect.isEmpty() ||
+        rect_exceeds(devRRect.rect(), SkIntToScalar(32767))) {
+        return kUnimplemented_FilterReturn;
+    }
+    const SkScalar sigma = this->computeXformedSigma(matrix);
+    if (!(sigma > 0)) {
+        return kUnimplemented_FilterReturn;
+    }
+
+    SkDrawAnalyticBlurredRRect(devRRect, sigma, clip, blitter);
+    return kTrue_FilterReturn;
+}
+
 // Use the faster analytic blur approach for ninepatch rects
 static const bool c_analyticBlurNinepatch{true};
 
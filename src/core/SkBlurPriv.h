@@ -11,6 +11,11 @@
 #include "include/core/SkRRect.h"
 #include "include/core/SkSize.h"
 
+#include <atomic>
+
+class SkBlitter;
+class SkRasterClip;
+
 static const int kSkBlurRRectMaxDivisions = 6;
 
 // This method computes all the parameters for drawing a partially occluded nine-patched
@@ -35,4 +40,13 @@ void SkFillIn1DGaussianKernel(float* kernel, float gaussianSigma, int radius);
 
 extern void sk_register_blur_maskfilter_createproc();
 
+// When set (the default), raster draws of normal-style blurred round rects that can't be drawn as
+// a nine patch evaluate the blurred coverage analytically instead of blurring a full-size mask.
+extern std::atomic<bool> gSkUseAnalyticBlurRRect;
+
+// Blits the coverage of a device space round rect blurred by a normal-style Gaussian, evaluated
+// analytically. This is what the blur mask filter draws when gSkUseAnalyticBlurRRect is set.
+void SkDrawAnalyticBlurredRRect(const SkRRect& devRRect, SkScalar sigma, const SkRasterClip&,
+                                SkBlitter*);
+
 #endif
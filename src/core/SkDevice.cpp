@@ -344,8 +344,10 @@ void SkBaseDevice::drawFilteredImage(const skif::Mapping& mapping, SkSpecialImag
     // getImageFilterCache returns a bare image filter cache pointer that must be ref'ed until the
     // filter's filterImage(ctx) function returns.
     sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
+    // Only raster devices split filtering across threads; GPU filters are already parallel.
+    SkExecutor* executor = src->isTextureBacked() ? nullptr : SkImageFilter_Base::Executor();
     skif::Context ctx(mapping, targetOutput, cache.get(), colorType, this->imageInfo().colorSpace(),
-                      skif::FilterResult<For::kInput>(sk_ref_sp(src)));
+                      skif::FilterResult<For::kInput>(sk_ref_sp(src)), executor);
 
     SkIPoint offset;
     sk_sp<SkSpecialImage> result = as_IFB(filter)->filterImage(ctx).imageAndOffset(&offset);
@@ -15,6 +15,7 @@
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/core/SkStrokeRec.h"
+#include "include/private/SkChecksum.h"
 #include "include/private/SkColorData.h"
 #include "include/private/SkMacros.h"
 #include "include/private/SkTemplates.h"
@@ -25,8 +26,10 @@
 #include "src/core/SkBlitter.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawProcs.h"
+#include "src/core/SkMaskCache.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMatrixUtils.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRectPriv.h"
@@ -34,7 +37,9 @@
 #include "src/core/SkStroke.h"
 #include "src/core/SkTLazy.h"
 #include "src/core/SkUtils.h"
+#include "src/utils/SkDashPathPriv.h"
 
+#include <atomic>
 #include <utility>
 
 static SkPaint make_paint_with_image(
@@ -330,6 +335,47 @@ PtProcRec::Proc PtProcRec::chooseProc(SkBlitter** blitterPtr) {
     return proc;
 }
 
+// Anti-aliased hairlines drawn with an opaque src-over paint may be accumulated in a mask and
+// blitted once, rather than blitted segment by segment, when there are at least this many.
+static constexpr int kMinAntiHairBatchSegments = 16;
+
+static bool can_batch_anti_hairlines(const SkPaint& paint, const SkRasterClip& rc) {
+    return paint.isAntiAlias() && !paint.getMaskFilter() && !rc.clipShader() &&
+           paint.getBlendMode() == SkBlendMode::kSrcOver &&
+           SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity);
+}
+
+// The batch clears and scans every pixel of its bounds, so it only pays when the hairlines cover
+// a good part of them. An anti-aliased hairline covers about two pixels per step along its major
+// axis.
+static constexpr int kMaxBatchToHairArea = 4;
+
+static SkScalar hair_area(SkVector devVector) {
+    return 2 * (std::max(SkScalarAbs(devVector.fX), SkScalarAbs(devVector.fY)) + 1);
+}
+
+// Sums the hair areas of the segments between the points of the path's verbs, so of the control
+// polygons of its curves.
+static SkScalar hair_area(const SkPath& devPath) {
+    SkScalar area = 0;
+    for (auto [verb, pts, weights] : SkPathPriv::Iterate(devPath)) {
+        for (int i = 1; i < SkPathPriv::PtsInIter((unsigned)verb); ++i) {
+            area += hair_area(pts[i] - pts[i - 1]);
+        }
+    }
+    return area;
+}
+
+static bool init_anti_hair_batch(SkCoverageBatchBlitter* batch, SkBlitter* blitter,
+                                 SkRect devBounds, SkScalar hairArea, const SkRasterClip& rc) {
+    // Leave room for round and square caps, and for the hairline stepper's own slop.
+    devBounds.outset(3, 3);
+    SkIRect bounds;
+    return devBounds.isFinite() && bounds.intersect(devBounds.roundOut(), rc.getBounds()) &&
+           (SkScalar)bounds.width() * bounds.height() <= kMaxBatchToHairArea * hairArea &&
+           batch->init(blitter, bounds);
+}
+
 // each of these costs 8-bytes of stack space, so don't make it too large
 // must be even for lines/polygon to work
 #define MAX_DEV_PTS     32
@@ -361,6 +407,23 @@ void SkDraw::drawPoints(SkCanvas::PointMode mode, size_t count,
 
         SkPoint             devPts[MAX_DEV_PTS];
         SkBlitter*          bltr = blitter.get();
+        SkCoverageBatchBlitter batch;
+        if (SkCanvas::kPoints_PointMode != mode && 0 == paint.getStrokeWidth() &&
+            count >= kMinAntiHairBatchSegments && !ctm.hasPerspective() &&
+            can_batch_anti_hairlines(paint, *fRC)) {
+            SkRect devBounds;
+            devBounds.setBounds(pts, SkToInt(count));
+            ctm.mapRect(&devBounds);
+            SkScalar hairArea = 0;
+            const size_t step = SkCanvas::kLines_PointMode == mode ? 2 : 1;
+            for (size_t i = 0; i + 1 < count; i += step) {
+                hairArea += hair_area(ctm.mapVector(pts[i + 1].fX - pts[i].fX,
+                                                    pts[i + 1].fY - pts[i].fY));
+            }
+            if (init_anti_hair_batch(&batch, bltr, devBounds, hairArea, *fRC)) {
+                bltr = &batch;
+            }
+        }
         PtProcRec::Proc     proc = rec.chooseProc(&bltr);
         // we have to back up subsequent passes if we're in polygon mode
         const size_t backup = (SkCanvas::kPolygon_PointMode == mode);
@@ -799,6 +862,37 @@ DRAW_PATH:
     this->drawPath(path, paint, nullptr, true);
 }
 
+void SkDraw::drawDRRect(const SkRRect& outer, const SkRRect& inner, const SkPaint& paint) const {
+    SkDEBUGCODE(this->validate());
+
+    if (fRC->isEmpty()) {
+        return;
+    }
+
+    SkMatrix ctm = fMatrixProvider->localToDevice();
+    SkScalar coverage;
+    if (paint.getMaskFilter() && !paint.getPathEffect() &&
+        paint.getStyle() == SkPaint::kFill_Style &&
+        !SkDrawTreatAsHairline(paint, ctm, &coverage)) {
+        // Transform the rrects into device space.
+        SkRRect devOuter, devInner;
+        if (outer.transform(ctm, &devOuter) && inner.transform(ctm, &devInner)) {
+            SkAutoBlitterChoose blitter(*this, nullptr, paint);
+            if (as_MFB(paint.getMaskFilter())->filterDRRect(devOuter, devInner, ctm, *fRC,
+                                                            blitter.get())) {
+                return;  // filterDRRect() called the blitter, so we're done
+            }
+        }
+    }
+
+    SkPath path;
+    path.addRRect(outer);
+    path.addRRect(inner);
+    path.setFillType(SkPathFillType::kEvenOdd);
+    path.setIsVolatile(true);
+    this->drawPath(path, paint, nullptr, true);
+}
+
 SkScalar SkDraw::ComputeResScaleForStroking(const SkMatrix& matrix) {
     // Not sure how to handle perspective differently, so we just don't try (yet)
     SkScalar sx = SkPoint::Length(matrix[SkMatrix::kMScaleX], matrix[SkMatrix::kMSkewY]);
@@ -875,9 +969,181 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
         }
     }
 
+    SkCoverageBatchBlitter batch;
+    if (!doFill && !customBlitter && !drawCoverage &&
+        devPath.countVerbs() >= kMinAntiHairBatchSegments &&
+        can_batch_anti_hairlines(paint, *fRC) &&
+        init_anti_hair_batch(&batch, blitter, devPath.getBounds(), hair_area(devPath), *fRC)) {
+        blitter = &batch;
+    }
     proc(devPath.view(), *fRC, blitter);
 }
 
+std::atomic<bool> gSkUsePathMaskCache{false};
+
+// -1 follows gSkUsePathMaskCache; 0 or 1 is set by an SkAutoPathMaskCacheOverride on this thread.
+static thread_local int gPathMaskCacheOverride = -1;
+
+SkAutoPathMaskCacheOverride::SkAutoPathMaskCacheOverride(bool usePathMaskCache)
+        : fPrevious(gPathMaskCacheOverride) {
+    gPathMaskCacheOverride = usePathMaskCache;
+}
+
+SkAutoPathMaskCacheOverride::~SkAutoPathMaskCacheOverride() {
+    gPathMaskCacheOverride = fPrevious;
+}
+
+static bool use_path_mask_cache() {
+    return gPathMaskCacheOverride < 0 ? gSkUsePathMaskCache.load(std::memory_order_relaxed)
+                                      : gPathMaskCacheOverride != 0;
+}
+
+// Cached path masks are at most this many pixels; larger paths are cheaper to draw directly than
+// to keep around.
+static constexpr int kMaxCachedPathMaskArea = 256 * 256;
+
+// Translations are rounded to this fraction of a pixel, so that draws at nearby subpixel
+// positions can share a mask.
+static constexpr SkScalar kPathMaskSubpixelSteps = 4;
+
+// Remembers the generation IDs of some recently drawn paths, so that we only cache masks for paths
+// drawn more than once. A race just forgets a path, which delays caching it until its next draw.
+static bool path_drawn_recently(uint32_t genID) {
+    static std::atomic<uint32_t> gRecent[256];
+    std::atomic<uint32_t>& slot = gRecent[SkChecksum::CheapMix(genID) & 255];
+    return slot.exchange(genID, std::memory_order_relaxed) == genID;
+}
+
+bool SkDraw::drawCachedPathMask(const SkPath& path, const SkPaint& paint) const {
+    if (!use_path_mask_cache() ||
+        path.isVolatile() || path.isInverseFillType() || path.isEmpty() ||
+        paint.getPathEffect() || paint.getMaskFilter()) {
+        return false;
+    }
+    const SkMatrix& ctm = fMatrixProvider->localToDevice();
+    // Also rejects non-finite translations, and ones too big to turn into whole pixel offsets.
+    constexpr SkScalar kMaxTranslate = 1 << 24;
+    if (ctm.hasPerspective() ||
+        !(SkScalarAbs(ctm.getTranslateX()) < kMaxTranslate) ||
+        !(SkScalarAbs(ctm.getTranslateY()) < kMaxTranslate)) {
+        return false;
+    }
+
+    SkMatrix matrix = ctm;
+    matrix.setTranslateX(SkScalarRoundToScalar(ctm.getTranslateX() * kPathMaskSubpixelSteps) /
+                         kPathMaskSubpixelSteps);
+    matrix.setTranslateY(SkScalarRoundToScalar(ctm.getTranslateY() * kPathMaskSubpixelSteps) /
+                         kPathMaskSubpixelSteps);
+    const SkStrokeRec stroke(paint, ComputeResScaleForStroking(ctm));
+
+    SkMask mask;
+    SkCachedData* data = SkMaskCache::FindAndRef(path, matrix, stroke, paint.isAntiAlias(),
+                                                 &mask);
+    if (!data) {
+        // Masks are always drawn with only the subpixel part of the translation, and then moved
+        // by the whole pixels, so a draw looks the same whether or not its mask was cached.
+        const SkIPoint origin = {SkScalarFloorToInt(matrix.getTranslateX()),
+                                 SkScalarFloorToInt(matrix.getTranslateY())};
+        SkMatrix subpixelMatrix = matrix;
+        subpixelMatrix.setTranslateX(matrix.getTranslateX() - origin.fX);
+        subpixelMatrix.setTranslateY(matrix.getTranslateY() - origin.fY);
+
+        SkRect bounds = path.getBounds();
+        if (paint.getStyle() != SkPaint::kFill_Style) {
+            bounds.outset(stroke.getInflationRadius(), stroke.getInflationRadius());
+        }
+        subpixelMatrix.mapRect(&bounds);
+        // Outset for anti-aliasing and device space hairlines.
+        bounds.outset(SK_Scalar1, SK_Scalar1);
+        if (!SkRectPriv::FitsInFixed(bounds)) {
+            return false;
+        }
+        const SkIRect maskBounds = bounds.roundOut();
+        if (maskBounds.isEmpty() ||
+            (int64_t)maskBounds.width() * maskBounds.height() > kMaxCachedPathMaskArea) {
+            return false;
+        }
+        mask.fBounds = maskBounds.makeOffset(origin.fX, origin.fY);
+        mask.fFormat = SkMask::kA8_Format;
+        mask.fRowBytes = mask.fBounds.width();
+        data = SkResourceCache::NewCachedData(mask.computeImageSize());
+        if (!data) {
+            return false;
+        }
+        mask.fImage = (uint8_t*)data->writable_data();
+        sk_bzero(mask.fImage, mask.computeImageSize());
+
+        SkDraw draw;
+        SkAssertResult(draw.fDst.reset(mask));
+        SkRasterClip clip(SkIRect::MakeWH(mask.fBounds.width(), mask.fBounds.height()));
+        const SkSimpleMatrixProvider matrixProvider(
+                SkMatrix::Concat(SkMatrix::Translate(-maskBounds.fLeft, -maskBounds.fTop),
+                                 subpixelMatrix));
+        draw.fRC = &clip;
+        draw.fMatrixProvider = &matrixProvider;
+
+        SkPaint maskPaint;
+        maskPaint.setAntiAlias(paint.isAntiAlias());
+        maskPaint.setStyle(paint.getStyle());
+        maskPaint.setStrokeWidth(paint.getStrokeWidth());
+        maskPaint.setStrokeMiter(paint.getStrokeMiter());
+        maskPaint.setStrokeCap(paint.getStrokeCap());
+        maskPaint.setStrokeJoin(paint.getStrokeJoin());
+        // Keep the draw into the mask from looking in the cache again.
+        SkPath volatilePath(path);
+        volatilePath.setIsVolatile(true);
+        draw.drawPath(volatilePath, maskPaint);
+
+        // Paths drawn once are drawn through their mask too, but only paths drawn again keep it.
+        if (path_drawn_recently(path.getGenerationID())) {
+            SkMaskCache::Add(path, matrix, stroke, paint.isAntiAlias(), mask, data);
+        }
+    }
+
+    this->drawDevMask(mask, paint);
+    data->unref();
+    return true;
+}
+
+bool SkDraw::drawDashesInBatches(const SkPath& path, const SkPaint& paint, const SkRect* cullRect,
+                                 const SkMatrix& localToDevice, bool drawCoverage,
+                                 SkBlitter* customBlitter) const {
+    // Where dashes overlap, an aliased, opaque src-over paint looks the same drawn once or twice.
+    // Anti-aliased edges would cover their pixels 1-(1-a)^2 where dashes from two batches meet,
+    // and mask filters and translucent paints would show the seams between batches.
+    SkPathEffect::DashInfo info;
+    if (paint.isAntiAlias() || paint.getMaskFilter() ||
+        paint.getBlendMode() != SkBlendMode::kSrcOver ||
+        !SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity) ||
+        !path.isFinite() ||
+        SkPathEffect::kDash_DashType != paint.getPathEffect()->asADash(&info)) {
+        return false;
+    }
+    SkAutoSTMalloc<8, SkScalar> intervals(info.fCount);
+    info.fIntervals = intervals.get();
+    paint.getPathEffect()->asADash(&info);
+
+    SkBlitter* blitter = customBlitter;
+    SkAutoBlitterChoose blitterStorage;
+    if (!blitter) {
+        blitter = blitterStorage.choose(*this, nullptr, paint, drawCoverage);
+    }
+    SkStrokeRec rec(paint, ComputeResScaleForStroking(localToDevice));
+    SkPath stroked, devPath;
+    stroked.setIsVolatile(true);
+    devPath.setIsVolatile(true);
+    return SkDashPath::StreamDashPath(path, &rec, cullRect, info, [&](const SkPath& dashes) {
+        const SkPath* fillPath = &dashes;
+        if (rec.applyToPath(&stroked, dashes)) {
+            fillPath = &stroked;
+        }
+        if (fillPath->isFinite()) {
+            fillPath->transform(localToDevice, &devPath);
+            this->drawDevPath(devPath, paint, drawCoverage, blitter, !rec.isHairlineStyle());
+        }
+    });
+}
+
 void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
                       const SkMatrix* prePathMatrix, bool pathIsMutable,
                       bool drawCoverage, SkBlitter* customBlitter) const {
@@ -895,6 +1161,7 @@ void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
     const SkMatrixProvider*            matrixProvider = fMatrixProvider;
     SkTLazy<SkPreConcatMatrixProvider> preConcatMatrixProvider;
     tmpPath->setIsVolatile(true);
+    const bool canUseMaskCache = !prePathMatrix && !drawCoverage && !customBlitter;
 
     if (prePathMatrix) {
         if (origPaint.getPathEffect() || origPaint.getStyle() != SkPaint::kFill_Style) {
@@ -939,12 +1206,22 @@ void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
         }
     }
 
+    if (canUseMaskCache && this->drawCachedPathMask(*pathPtr, *paint)) {
+        return;
+    }
+
     if (paint->getPathEffect() || paint->getStyle() != SkPaint::kFill_Style) {
         SkRect cullRect;
         const SkRect* cullRectPtr = nullptr;
         if (this->computeConservativeLocalClipBounds(&cullRect)) {
             cullRectPtr = &cullRect;
         }
+        if (paint->getPathEffect() &&
+            this->drawDashesInBatches(*pathPtr, *paint, cullRectPtr,
+                                      matrixProvider->localToDevice(), drawCoverage,
+                                      customBlitter)) {
+            return;
+        }
         doFill = paint->getFillPath(*pathPtr, tmpPath, cullRectPtr,
                                     ComputeResScaleForStroking(fMatrixProvider->localToDevice()));
         pathPtr = tmpPath;
@@ -17,6 +17,24 @@
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkMask.h"
 
+#include <atomic>
+
+// If true, small non-volatile paths are drawn through coverage masks that are cached and reused
+// when the path is drawn again at a whole pixel offset (see SkDraw::drawCachedPathMask). Off by
+// default: translations are rounded to a quarter pixel, which changes output slightly.
+extern std::atomic<bool> gSkUsePathMaskCache;
+
+// Overrides gSkUsePathMaskCache for draws on the calling thread while in scope, so tests can compare
+// drawing with and without the cache without changing it for other threads.
+class SkAutoPathMaskCacheOverride {
+public:
+    explicit SkAutoPathMaskCacheOverride(bool usePathMaskCache);
+    ~SkAutoPathMaskCacheOverride();
+
+private:
+    int fPrevious;
+};
+
 class SkBitmap;
 class SkClipStack;
 class SkBaseDevice;
@@ -43,6 +61,7 @@ public:
         this->drawRect(rect, paint, nullptr, nullptr);
     }
     void    drawRRect(const SkRRect&, const SkPaint&) const;
+    void    drawDRRect(const SkRRect& outer, const SkRRect& inner, const SkPaint&) const;
     /**
      *  To save on mallocs, we allow a flag that tells us that srcPath is
      *  mutable, so that we don't have to make copies of it as we transform it.
@@ -87,6 +106,11 @@ public:
 
     void paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint) const override;
 
+    void paintSDFs(SkDrawableGlyphBuffer* drawables,
+                   SkScalar scale,
+                   SkPoint origin,
+                   const SkPaint& paint) const override;
+
     static bool ComputeMaskBounds(const SkRect& devPathBounds, const SkIRect* clipBounds,
                                   const SkMaskFilter* filter, const SkMatrix* filterMatrix,
                                   SkIRect* bounds);
@@ -144,6 +168,23 @@ private:
                      bool drawCoverage,
                      SkBlitter* customBlitter,
                      bool doFill) const;
+
+    /**
+     *  If gSkUsePathMaskCache is set, draws the path by blitting its coverage mask, drawn with the
+     *  translation rounded to a quarter pixel. The mask is reused if the path has been drawn before
+     *  with the same matrix (apart from a whole pixel translation) and paint geometry, and cached
+     *  for paths seen a second time; either way the pixels are the same. Returns false if the path
+     *  should be drawn normally instead.
+     */
+    bool drawCachedPathMask(const SkPath&, const SkPaint&) const;
+    /**
+     *  If the paint dashes the path, and drawing the dashed stroke in pieces can't change the
+     *  result, dash, stroke and draw it a batch of dashes at a time, without ever holding all of
+     *  it. Returns false if the path should be drawn normally instead.
+     */
+    bool drawDashesInBatches(const SkPath&, const SkPaint&, const SkRect* cullRect,
+                             const SkMatrix& localToDevice, bool drawCoverage,
+                             SkBlitter* customBlitter) const;
     /**
      *  Return the current clip bounds, in local coordinates, with slop to account
      *  for antialiasing or hairlines (i.e. device-bounds outset by 1, and then
@@ -5,11 +5,16 @@
  * found in the LICENSE file.
  */
 
+#include "src/core/SkAutoMalloc.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkGlyphBuffer.h"
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkPaintPriv.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkRasterPipeline.h"
 #include "src/core/SkScalerCache.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkUtils.h"
@@ -34,6 +39,59 @@ static bool check_glyph_position(SkPoint position) {
              lt(position.fY, INT_MIN - (INT16_MIN + 0 /*UINT16_MIN*/)));
 }
 
+// Glyph masks drawn with an opaque src-over shader may be accumulated in one mask and blitted a
+// row at a time, rather than glyph by glyph, when there are at least this many.
+static constexpr size_t kMinGlyphBatch = 16;
+
+static bool can_batch_glyph_masks(const SkPaint& paint, const SkRasterClip& rc) {
+    // A solid color blends each glyph's pixels about as fast as they can be accumulated, so
+    // only shaders, which pay to set up and shade every span, gain from blitting fewer spans.
+    return paint.getShader() && !paint.getMaskFilter() && !rc.clipShader() &&
+           paint.getBlendMode() == SkBlendMode::kSrcOver &&
+           SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity);
+}
+
+// Draws A8 and BW glyphs through one coverage batch. Returns false, having drawn nothing, if
+// some glyph can't be batched, or if the glyphs are too sparse for a batch to pay.
+static bool paint_glyph_batch(SkZip<SkGlyphVariant, SkPoint> drawable,
+                              const SkIRect& clipBounds, SkBlitter* blitter) {
+    SkIRect bounds = SkIRect::MakeEmpty();
+    int64_t glyphArea = 0;
+    for (auto [variant, pos] : drawable) {
+        const SkGlyph* glyph = variant.glyph();
+        if (glyph->maskFormat() != SkMask::kA8_Format &&
+            glyph->maskFormat() != SkMask::kBW_Format) {
+            return false;
+        }
+        if (check_glyph_position(pos)) {
+            bounds.join(glyph->mask(pos).fBounds);
+            glyphArea += (int64_t)glyph->width() * glyph->height();
+        }
+    }
+    if (!bounds.intersect(clipBounds)) {
+        return true;
+    }
+    // The batch shades the short gaps between glyphs on a row too, so it only pays when the
+    // glyphs cover a good part of their bounds.
+    constexpr int kMaxBatchToGlyphArea = 4;
+    SkCoverageBatchBlitter batch;
+    if ((int64_t)bounds.width() * bounds.height() > kMaxBatchToGlyphArea * glyphArea ||
+        !batch.init(blitter, bounds)) {
+        return false;
+    }
+
+    for (auto [variant, pos] : drawable) {
+        if (check_glyph_position(pos)) {
+            SkMask mask = variant.glyph()->mask(pos);
+            SkIRect clipped;
+            if (clipped.intersect(mask.fBounds, bounds)) {
+                batch.blitMask(mask, clipped);
+            }
+        }
+    }
+    return true;
+}
+
 void SkDraw::paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint) const {
 
     // The size used for a typical blitter.
@@ -80,7 +138,13 @@ void SkDraw::paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint)
     } else {
         SkIRect clipBounds = fRC->isBW() ? fRC->bwRgn().getBounds()
                                          : fRC->aaRgn().getBounds();
-        for (auto [variant, pos] : drawables->drawable()) {
+        auto drawable = drawables->drawable();
+        if (!fCoverage && drawable.size() >= kMinGlyphBatch &&
+            can_batch_glyph_masks(paint, *fRC) &&
+            paint_glyph_batch(drawable, clipBounds, blitter)) {
+            return;
+        }
+        for (auto [variant, pos] : drawable) {
             SkGlyph* glyph = variant.glyph();
             if (check_glyph_position(pos)) {
                 SkMask mask = glyph->mask(pos);
@@ -123,6 +187,104 @@ void SkDraw::paintPaths(SkDrawableGlyphBuffer* drawables,
     }
 }
 
+void SkDraw::paintSDFs(SkDrawableGlyphBuffer* drawables,
+                       SkScalar scale,
+                       SkPoint origin,
+                       const SkPaint& paint) const {
+    SkSTArenaAlloc<3308> alloc;
+    SkBlitter* blitter =
+            SkBlitter::Choose(fDst, *fMatrixProvider, paint, &alloc, false, fRC->clipShader());
+    if (fCoverage) {
+        blitter = alloc.make<SkPairBlitter>(
+                blitter,
+                SkBlitter::Choose(
+                        *fCoverage, *fMatrixProvider, SkPaint(), &alloc, true, fRC->clipShader()));
+    }
+
+    SkAAClipBlitterWrapper wrapper{*fRC, blitter};
+    blitter = wrapper.getBlitter();
+
+    bool useRegion = fRC->isBW() && !fRC->isRect();
+    const SkIRect& clipBounds = fRC->getBounds();
+
+    // Each glyph's coverage is resampled from its distance field into a scratch A8 mask, which is
+    // blitted like any glyph mask. One pipeline does the resampling for the whole run; only its
+    // contexts change from glyph to glyph.
+    float* toGlyph = alloc.makeArrayDefault<float>(6);
+    auto sampler  = alloc.make<SkRasterPipeline_SamplerCtx2>();
+    auto coverage = alloc.make<SkRasterPipeline_SDFCoverageCtx>();
+    auto dst      = alloc.make<SkRasterPipeline_MemoryCtx>();
+    sampler->ct = kAlpha_8_SkColorType;
+    sampler->tileX = sampler->tileY = SkTileMode::kClamp;
+
+    SkRasterPipeline p(&alloc);
+    p.append(SkRasterPipeline::seed_shader);
+    p.append(SkRasterPipeline::matrix_2x3, toGlyph);
+    p.append(SkRasterPipeline::bilinear, sampler);
+    p.append(SkRasterPipeline::sdf_coverage, coverage);
+    p.append(SkRasterPipeline::store_a8, dst);
+    auto run = p.compile();
+
+    SkAutoSMalloc<1024> storage;
+    for (auto [variant, pos] : drawables->drawable()) {
+        const SkGlyph* glyph = variant.glyph();
+        SkASSERT(glyph->maskFormat() == SkMask::kSDF_Format);
+
+        SkMatrix glyphToDevice = fMatrixProvider->localToDevice();
+        glyphToDevice.preTranslate(origin.x() + pos.x(), origin.y() + pos.y());
+        glyphToDevice.preScale(scale, scale);
+
+        // The distance field is padded all around; the inset leaves enough of it to bilerp.
+        SkRect glyphRect = SkRect::MakeXYWH(glyph->left(), glyph->top(),
+                                            glyph->width(), glyph->height())
+                                   .makeInset(SK_DistanceFieldInset, SK_DistanceFieldInset);
+        SkMatrix deviceToGlyph;
+        SkIRect bounds = glyphToDevice.mapRect(glyphRect).roundOut();
+        if (!bounds.intersect(clipBounds) || !glyphToDevice.invert(&deviceToGlyph)) {
+            continue;
+        }
+        deviceToGlyph.postTranslate(-glyph->left(), -glyph->top());
+        SkAssertResult(deviceToGlyph.asAffine(toGlyph));
+
+        sampler->pixels    = glyph->image();
+        sampler->stride    = glyph->rowBytes();
+        sampler->width     = glyph->width();
+        sampler->height    = glyph->height();
+        sampler->invWidth  = 1.0f / glyph->width();
+        sampler->invHeight = 1.0f / glyph->height();
+
+        // A distance of d texels covers the pixel by smoothstep(-w, w, d * pixelsPerTexel), with
+        // the edge w just over half a pixel wide; the distances are stored biased as bytes.
+        constexpr float kDistanceMultiplier = 4 * 255 / 128.0f,
+                        kDistanceThreshold  = 128 / 255.0f,
+                        kEdgeHalfWidth      = 0.65f;
+        float pixelsPerTexel =
+                SkScalarSqrt(SkScalarAbs(glyphToDevice.getScaleX() * glyphToDevice.getScaleY() -
+                                         glyphToDevice.getSkewX()  * glyphToDevice.getSkewY()));
+        coverage->mul = kDistanceMultiplier * pixelsPerTexel / (2 * kEdgeHalfWidth);
+        coverage->add = 0.5f - kDistanceThreshold * coverage->mul;
+
+        SkMask mask;
+        mask.fBounds   = bounds;
+        mask.fFormat   = SkMask::kA8_Format;
+        mask.fRowBytes = bounds.width();
+        mask.fImage    = (uint8_t*)storage.reset(mask.computeImageSize());
+        dst->stride = mask.fRowBytes;
+        dst->pixels = (void*)((uintptr_t)mask.fImage - bounds.left()
+                                                     - bounds.top() * (size_t)mask.fRowBytes);
+        run(bounds.left(), bounds.top(), bounds.width(), bounds.height());
+
+        if (useRegion) {
+            for (SkRegion::Cliperator clipper(fRC->bwRgn(), bounds); !clipper.done();
+                 clipper.next()) {
+                blitter->blitMask(mask, clipper.rect());
+            }
+        } else {
+            blitter->blitMask(mask, bounds);
+        }
+    }
+}
+
 void SkDraw::drawGlyphRunList(const SkGlyphRunList& glyphRunList,
                               SkGlyphRunListPainter* glyphPainter) const {
 
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkFlatRTree.h"
+
+#include "include/private/SkNx.h"
+#include "include/private/SkTArray.h"
+#include "src/core/SkMathPriv.h"
+
+#include <algorithm>
+
+void SkFlatRTree::insert(const SkRect boundsArray[], int N) {
+    SkASSERT(0 == fCount);
+
+    std::vector<SkRect> bounds;
+    std::vector<int32_t> indices;
+    bounds.reserve(N);
+    indices.reserve(N);
+    for (int i = 0; i < N; i++) {
+        if (!boundsArray[i].isEmpty()) {
+            bounds.push_back(boundsArray[i]);
+            indices.push_back(i);
+        }
+    }
+
+    fCount = (int)bounds.size();
+    if (0 == fCount) {
+        return;
+    }
+
+    int nodeCount = 0;
+    for (int n = fCount; ; n = (n + kChildren - 1) / kChildren) {
+        nodeCount += (n + kChildren - 1) / kChildren;
+        if (n <= kChildren) {
+            break;
+        }
+    }
+    fNodes.reserve(nodeCount);
+
+    // Pack each level into nodes of kChildren consecutive entries, then pack those nodes, until
+    // one node holds everything.
+    do {
+        int packed = 0;
+        for (int start = 0; start < (int)bounds.size(); start += kChildren) {
+            Node node;
+            SkRect joined = SkRect::MakeEmpty();
+            for (int k = 0; k < kChildren; k++) {
+                if (start + k < (int)bounds.size()) {
+                    const SkRect& r = bounds[start + k];
+                    node.fLeft[k]     = r.fLeft;
+                    node.fTop[k]      = r.fTop;
+                    node.fRight[k]    = r.fRight;
+                    node.fBottom[k]   = r.fBottom;
+                    node.fChildren[k] = indices[start + k];
+                    joined.join(r);
+                } else {
+                    node.fLeft[k]  = node.fTop[k]    = SK_ScalarInfinity;
+                    node.fRight[k] = node.fBottom[k] = SK_ScalarNegativeInfinity;
+                    node.fChildren[k] = -1;
+                }
+            }
+            bounds[packed]  = joined;
+            indices[packed] = (int32_t)fNodes.size();
+            packed++;
+            fNodes.push_back(node);
+        }
+        bounds.resize(packed);
+        indices.resize(packed);
+        if (0 == fDepth) {
+            fLeafCount = (int)fNodes.size();
+        }
+        fDepth++;
+    } while (bounds.size() > 1);
+
+    SkASSERT((int)fNodes.size() == nodeCount);
+    fBounds = bounds[0];
+}
+
+// Returns a bit for each lane of the comparison result that's true.
+static uint32_t lane_bits(const Sk8f& mask) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    return (uint32_t)(_mm_movemask_ps(mask.fLo.fVec) | _mm_movemask_ps(mask.fHi.fVec) << 4);
+#else
+    float lanes[8];
+    mask.thenElse(1.0f, 0.0f).store(lanes);
+    uint32_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= lanes[i] != 0 ? 1u << i : 0;
+    }
+    return bits;
+#endif
+}
+
+// Returns a bit for each of the node's children that intersects the query.
+static uint32_t intersect_children(const float left[], const float top[],
+                                   const float right[], const float bottom[],
+                                   const Sk8f& qLeft, const Sk8f& qTop,
+                                   const Sk8f& qRight, const Sk8f& qBottom) {
+    // Both rects are non-empty, so they intersect exactly when each starts before the other ends.
+    return lane_bits(Sk8f::Load(left) < qRight)
+         & lane_bits(Sk8f::Load(top)  < qBottom)
+         & lane_bits(qLeft < Sk8f::Load(right))
+         & lane_bits(qTop  < Sk8f::Load(bottom));
+}
+
+static bool is_searchable(const SkRect& query) {
+    // Also rejects NaN.
+    return query.fLeft < query.fRight && query.fTop < query.fBottom;
+}
+
+void SkFlatRTree::search(const SkRect& query, std::vector<int>* results) const {
+    if (0 == fCount || !is_searchable(query) || !SkRect::Intersects(fBounds, query)) {
+        return;
+    }
+
+    const Sk8f qLeft(query.fLeft), qTop(query.fTop), qRight(query.fRight), qBottom(query.fBottom);
+
+    // Children are pushed last to first, so they're visited, and their ops found, in order.
+    SkSTArray<64, int, true> stack;
+    stack.push_back((int)fNodes.size() - 1);
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = fNodes[index];
+
+        uint32_t hits = intersect_children(node.fLeft, node.fTop, node.fRight, node.fBottom,
+                                           qLeft, qTop, qRight, qBottom);
+        if (this->isLeaf(index)) {
+            for (; hits; hits &= hits - 1) {
+                results->push_back(node.fChildren[SkCTZ(hits)]);
+            }
+        } else {
+            for (; hits; hits &= ~(0x80000000u >> SkCLZ(hits))) {
+                stack.push_back(node.fChildren[31 - SkCLZ(hits)]);
+            }
+        }
+    }
+}
+
+void SkFlatRTree::search(const SkRect queries[], int N, std::vector<int> results[]) const {
+    if (0 == fCount) {
+        return;
+    }
+
+    // Each node on the stack carries the set of queries that reached it, up to 32 per walk.
+    struct Visit {
+        int      fNode;
+        uint32_t fQueries;
+    };
+    SkSTArray<64, Visit, true> stack;
+    for (int base = 0; base < N; base += 32) {
+        const int count = std::min(N - base, 32);
+        uint32_t active = 0;
+        for (int q = 0; q < count; q++) {
+            const SkRect& query = queries[base + q];
+            if (is_searchable(query) && SkRect::Intersects(fBounds, query)) {
+                active |= 1u << q;
+            }
+        }
+        if (!active) {
+            continue;
+        }
+
+        stack.push_back({(int)fNodes.size() - 1, active});
+        while (!stack.empty()) {
+            const Visit visit = stack.back();
+            stack.pop_back();
+            const Node& node = fNodes[visit.fNode];
+
+            if (this->isLeaf(visit.fNode)) {
+                // Each query's results are in order already, so there's nothing to gather.
+                for (uint32_t pending = visit.fQueries; pending; pending &= pending - 1) {
+                    const int q = base + SkCTZ(pending);
+                    const SkRect& query = queries[q];
+                    uint32_t hits = intersect_children(node.fLeft, node.fTop,
+                                                       node.fRight, node.fBottom,
+                                                       Sk8f(query.fLeft), Sk8f(query.fTop),
+                                                       Sk8f(query.fRight), Sk8f(query.fBottom));
+                    for (; hits; hits &= hits - 1) {
+                        results[q].push_back(node.fChildren[SkCTZ(hits)]);
+                    }
+                }
+                continue;
+            }
+
+            uint32_t childQueries[kChildren] = {},
+                     anyHits = 0;
+            for (uint32_t pending = visit.fQueries; pending; pending &= pending - 1) {
+                const int q = SkCTZ(pending);
+                const SkRect& query = queries[base + q];
+                uint32_t hits = intersect_children(node.fLeft, node.fTop, node.fRight, node.fBottom,
+                                                   Sk8f(query.fLeft), Sk8f(query.fTop),
+                                                   Sk8f(query.fRight), Sk8f(query.fBottom));
+                anyHits |= hits;
+                for (; hits; hits &= hits - 1) {
+                    childQueries[SkCTZ(hits)] |= 1u << q;
+                }
+            }
+            for (; anyHits; anyHits &= ~(0x80000000u >> SkCLZ(anyHits))) {
+                const int k = 31 - SkCLZ(anyHits);
+                stack.push_back({node.fChildren[k], childQueries[k]});
+            }
+        }
+    }
+}
+
+size_t SkFlatRTree::bytesUsed() const {
+    return sizeof(SkFlatRTree) + fNodes.capacity() * sizeof(Node);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFlatRTree_DEFINED
+#define SkFlatRTree_DEFINED
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkRect.h"
+
+#include <vector>
+
+/**
+ * An R-Tree laid out for searching many children at once.
+ *
+ * Like SkRTree, it is bulk-loaded bottom up from the rects in the order they're inserted (which
+ * for pictures is already spatially coherent), so searches return indices in increasing order.
+ * Unlike SkRTree, every node has kChildren slots whose bounds are stored as four arrays of floats,
+ * one per edge, and nodes live in one flat array addressed by index. A search tests all of a
+ * node's children against the query with a few Sk8f compares instead of one SkRect at a time.
+ */
+class SkFlatRTree : public SkBBoxHierarchy {
+public:
+    SkFlatRTree() = default;
+
+    void insert(const SkRect[], int N) override;
+    void search(const SkRect& query, std::vector<int>* results) const override;
+    size_t bytesUsed() const override;
+
+    /**
+     * Searches for several queries in one walk of the tree, so each node is loaded once for all
+     * the queries that reach it, e.g. for the tiles of one frame. results[i] receives the indices
+     * of the rects intersecting queries[i], in increasing order.
+     */
+    void search(const SkRect queries[], int N, std::vector<int> results[]) const;
+
+    // Methods and constants below here are only public for tests.
+
+    int getDepth() const { return fDepth; }
+    int getCount() const { return fCount; }
+
+    static constexpr int kChildren = 8;
+
+private:
+    // Unused slots have inverted, infinite bounds, which intersect nothing.
+    struct Node {
+        float   fLeft[kChildren],
+                fTop[kChildren],
+                fRight[kChildren],
+                fBottom[kChildren];
+        int32_t fChildren[kChildren];  // Op indices in leaves, node indices otherwise.
+    };
+
+    bool isLeaf(int node) const { return node < fLeafCount; }
+
+    int               fCount = 0;
+    int               fDepth = 0;
+    int               fLeafCount = 0;
+    SkRect            fBounds = SkRect::MakeEmpty();
+    std::vector<Node> fNodes;  // Leaves first, then each level above them; the root is last.
+};
+
+#endif
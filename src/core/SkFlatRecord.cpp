@@ -0,0 +1,709 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkFlatRecord.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkPathView.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkWriter32.h"
+
+namespace {
+
+static constexpr uint32_t kMagic   = SkSetFourByteTag('f', 'r', 'e', 'c');
+static constexpr uint32_t kVersion = 1;
+
+struct Header {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint32_t fCount;  // ops
+    uint32_t fSize;   // bytes of ops, following the header
+    SkRect   fCullRect;
+};
+
+// Never renumber these; add new ops at the end.
+enum class OpType : uint16_t {
+    kFlush          = 1,
+    kSave           = 2,
+    kRestore        = 3,
+    kSaveLayer      = 4,
+    kSetMatrix      = 5,
+    kConcat         = 6,
+    kConcat44       = 7,
+    kTranslate      = 8,
+    kScale          = 9,
+    kClipRect       = 10,
+    kClipRRect      = 11,
+    kClipPath       = 12,
+    kDrawPaint      = 13,
+    kDrawRect       = 14,
+    kDrawOval       = 15,
+    kDrawRRect      = 16,
+    kDrawDRRect     = 17,
+    kDrawArc        = 18,
+    kDrawPath       = 19,
+    kDrawPoints     = 20,
+    kDrawEdgeAAQuad = 21,
+};
+
+// Every op starts with this. fSize counts the whole op, this included, and is a multiple of 4.
+struct Op {
+    OpType   fType;
+    uint16_t fFlags;
+    uint32_t fSize;
+};
+
+enum OpFlags : uint16_t {
+    kHasBounds_OpFlag = 1 << 0,  // SaveLayer
+    kHasPaint_OpFlag  = 1 << 1,  // SaveLayer
+    kHasClip_OpFlag   = 1 << 0,  // DrawEdgeAAQuad
+};
+
+// An SkPaint without effects.
+struct Paint {
+    SkColor4f fColor;
+    float     fWidth;
+    float     fMiter;
+    uint32_t  fBits;  // antialias:1, dither:1, cap:2, join:2, style:2, filter quality:2, blend:8
+};
+
+// Followed by fPointCount SkPoints, fWeightCount floats, then fVerbCount verbs, padded to 4.
+struct Path {
+    uint32_t fFillType;
+    uint32_t fVerbCount;
+    uint32_t fPointCount;
+    uint32_t fWeightCount;
+};
+
+// What follows each Op. Arrays and optional fields come after these.
+struct SaveLayerOp      { uint32_t flags; };  // then [SkRect bounds], [Paint]
+struct MatrixOp         { float values[9]; };
+struct Concat44Op       { float values[16]; };  // column major
+struct TranslateOp      { float dx, dy; };      // Scale too
+struct ClipRectOp       { SkRect rect; uint32_t op, aa; };
+struct ClipRRectOp      { SkRRect rrect; uint32_t op, aa; };
+struct ClipPathOp       { uint32_t op, aa; Path path; };
+struct DrawPaintOp      { Paint paint; };
+struct DrawRectOp       { Paint paint; SkRect rect; };  // DrawOval too
+struct DrawRRectOp      { Paint paint; SkRRect rrect; };
+struct DrawDRRectOp     { Paint paint; SkRRect outer, inner; };
+struct DrawArcOp        { Paint paint; SkRect oval; float startAngle, sweepAngle;
+                          uint32_t useCenter; };
+struct DrawPathOp       { Paint paint; Path path; };
+struct DrawPointsOp     { Paint paint; uint32_t mode, count; };  // then SkPoint[count]
+struct DrawEdgeAAQuadOp { SkRect rect; SkColor4f color; uint32_t aa, mode; };  // then [SkPoint[4]]
+
+// SkRRects are copied whole, including their type, so they don't need to be classified again.
+static_assert(sizeof(SkRRect) == SkRRect::kSizeInMemory + 4, "");
+static_assert(sizeof(Op) == 8 && sizeof(Paint) == 28 && sizeof(Path) == 16, "");
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Flattener {
+public:
+    explicit Flattener(SkWriter32* writer) : fWriter(writer) {}
+
+    int count() const { return fCount; }
+
+    // Anything not handled below can't be flattened.
+    template <typename T>
+    bool operator()(const T&) { return false; }
+
+    bool operator()(const SkRecords::NoOp&) { return true; }
+    bool operator()(const SkRecords::Flush&)   { return this->op(OpType::kFlush); }
+    bool operator()(const SkRecords::Save&)    { return this->op(OpType::kSave); }
+    bool operator()(const SkRecords::Restore&) { return this->op(OpType::kRestore); }
+
+    bool operator()(const SkRecords::SaveLayer& r) {
+        if (r.backdrop || (r.paint && !flattenable(*r.paint))) {
+            return false;
+        }
+        uint16_t flags = (r.bounds ? kHasBounds_OpFlag : 0) | (r.paint ? kHasPaint_OpFlag : 0);
+        return this->op(OpType::kSaveLayer, SaveLayerOp{r.saveLayerFlags}, flags, [&] {
+            if (r.bounds) {
+                this->write(*r.bounds);
+            }
+            if (r.paint) {
+                this->write(flatten(*r.paint));
+            }
+        });
+    }
+
+    bool operator()(const SkRecords::SetMatrix& r) {
+        return this->op(OpType::kSetMatrix, flatten(r.matrix));
+    }
+    bool operator()(const SkRecords::Concat& r) {
+        return this->op(OpType::kConcat, flatten(r.matrix));
+    }
+    bool operator()(const SkRecords::Concat44& r) {
+        Concat44Op op;
+        r.matrix.getColMajor(op.values);
+        return this->op(OpType::kConcat44, op);
+    }
+    bool operator()(const SkRecords::Translate& r) {
+        return this->op(OpType::kTranslate, TranslateOp{r.dx, r.dy});
+    }
+    bool operator()(const SkRecords::Scale& r) {
+        return this->op(OpType::kScale, TranslateOp{r.sx, r.sy});
+    }
+
+    bool operator()(const SkRecords::ClipRect& r) {
+        return this->op(OpType::kClipRect,
+                        ClipRectOp{r.rect, (uint32_t)r.opAA.op(), r.opAA.aa()});
+    }
+    bool operator()(const SkRecords::ClipRRect& r) {
+        return this->op(OpType::kClipRRect,
+                        ClipRRectOp{r.rrect, (uint32_t)r.opAA.op(), r.opAA.aa()});
+    }
+    bool operator()(const SkRecords::ClipPath& r) {
+        return this->op(OpType::kClipPath,
+                        ClipPathOp{(uint32_t)r.opAA.op(), r.opAA.aa(), flatten(r.path)}, 0,
+                        [&] { this->writePathArrays(r.path); });
+    }
+
+    bool operator()(const SkRecords::DrawPaint& r) {
+        return flattenable(r.paint) && this->op(OpType::kDrawPaint, DrawPaintOp{flatten(r.paint)});
+    }
+    bool operator()(const SkRecords::DrawRect& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawRect, DrawRectOp{flatten(r.paint), r.rect});
+    }
+    bool operator()(const SkRecords::DrawOval& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawOval, DrawRectOp{flatten(r.paint), r.oval});
+    }
+    bool operator()(const SkRecords::DrawRRect& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawRRect, DrawRRectOp{flatten(r.paint), r.rrect});
+    }
+    bool operator()(const SkRecords::DrawDRRect& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawDRRect, DrawDRRectOp{flatten(r.paint), r.outer, r.inner});
+    }
+    bool operator()(const SkRecords::DrawArc& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawArc, DrawArcOp{flatten(r.paint), r.oval, r.startAngle,
+                                                    r.sweepAngle, r.useCenter ? 1u : 0u});
+    }
+    bool operator()(const SkRecords::DrawPath& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawPath, DrawPathOp{flatten(r.paint), flatten(r.path)}, 0,
+                        [&] { this->writePathArrays(r.path); });
+    }
+    bool operator()(const SkRecords::DrawPoints& r) {
+        return flattenable(r.paint) &&
+               this->op(OpType::kDrawPoints,
+                        DrawPointsOp{flatten(r.paint), (uint32_t)r.mode, r.count}, 0,
+                        [&] { fWriter->write(r.pts, r.count * sizeof(SkPoint)); });
+    }
+    bool operator()(const SkRecords::DrawEdgeAAQuad& r) {
+        return this->op(OpType::kDrawEdgeAAQuad,
+                        DrawEdgeAAQuadOp{r.rect, r.color, (uint32_t)r.aa, (uint32_t)r.mode},
+                        r.clip ? kHasClip_OpFlag : 0,
+                        [&] {
+            if (r.clip) {
+                fWriter->write(r.clip, 4 * sizeof(SkPoint));
+            }
+        });
+    }
+
+private:
+    static bool flattenable(const SkPaint& paint) {
+        return !paint.getShader() && !paint.getColorFilter() && !paint.getMaskFilter() &&
+               !paint.getPathEffect() && !paint.getImageFilter();
+    }
+
+    static Paint flatten(const SkPaint& paint) {
+        SkASSERT(flattenable(paint));
+        return {paint.getColor4f(), paint.getStrokeWidth(), paint.getStrokeMiter(),
+                (uint32_t)paint.isAntiAlias()           << 0 |
+                (uint32_t)paint.isDither()              << 1 |
+                (uint32_t)paint.getStrokeCap()          << 2 |
+                (uint32_t)paint.getStrokeJoin()         << 4 |
+                (uint32_t)paint.getStyle()              << 6 |
+                (uint32_t)paint.getFilterQuality()      << 8 |
+                (uint32_t)paint.getBlendMode()          << 10};
+    }
+
+    static MatrixOp flatten(const SkMatrix& matrix) {
+        MatrixOp op;
+        matrix.get9(op.values);
+        return op;
+    }
+
+    static Path flatten(const SkPath& path) {
+        SkPathView view = path.view();
+        return {(uint32_t)view.fFillType,
+                (uint32_t)view.fVerbs.size(),
+                (uint32_t)view.fPoints.size(),
+                (uint32_t)view.fWeights.size()};
+    }
+
+    void writePathArrays(const SkPath& path) {
+        SkPathView view = path.view();
+        fWriter->write(view.fPoints.data(), view.fPoints.size() * sizeof(SkPoint));
+        fWriter->write(view.fWeights.data(), view.fWeights.size() * sizeof(float));
+        fWriter->writePad(view.fVerbs.data(), view.fVerbs.size());
+    }
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(sizeof(T) % 4 == 0 && alignof(T) <= 4, "");
+        fWriter->write(&value, sizeof(T));
+    }
+
+    bool op(OpType type) {
+        this->write(Op{type, 0, sizeof(Op)});
+        fCount++;
+        return true;
+    }
+
+    template <typename T, typename Fn = void(*)()>
+    bool op(OpType type, const T& fields, uint16_t flags = 0, Fn&& writeMore = []{}) {
+        const size_t start = fWriter->bytesWritten();
+        this->write(Op{type, flags, 0});
+        this->write(fields);
+        writeMore();
+        fWriter->overwriteTAt(start, Op{type, flags, (uint32_t)(fWriter->bytesWritten() - start)});
+        fCount++;
+        return true;
+    }
+
+    SkWriter32* fWriter;
+    int         fCount = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads the arrays and fields after an Op. Only a validating reader checks that they're there.
+template <bool kValidate>
+class Reader {
+public:
+    Reader(const void* data, size_t size)
+        : fCurr(static_cast<const char*>(data)), fStop(fCurr + size) {}
+
+    // Returns the next count Ts, or nullptr if they don't fit. Each read is padded to 4 bytes.
+    template <typename T>
+    const T* read(size_t count = 1) {
+        static_assert(alignof(T) <= 4, "");
+        // Ops are multiples of 4 bytes, so if the Ts fit, so does their padding.
+        if (kValidate && count > (size_t)(fStop - fCurr) / sizeof(T)) {
+            return nullptr;
+        }
+        auto values = reinterpret_cast<const T*>(fCurr);
+        fCurr += SkAlign4(count * sizeof(T));
+        return values;
+    }
+
+    bool empty() const { return fCurr == fStop; }
+
+private:
+    const char* fCurr;
+    const char* fStop;
+};
+
+// The canvas expects finite geometry.
+template <typename T>
+static bool finite(const T* values, size_t count = 1) {
+    static_assert(sizeof(T) % sizeof(float) == 0, "");
+    return SkScalarsAreFinite(reinterpret_cast<const float*>(values),
+                              SkToInt(count * sizeof(T) / sizeof(float)));
+}
+
+static bool valid_color(const SkColor4f& color) {
+    return SkScalarsAreFinite(color.vec(), 4) && 0 <= color.fA && color.fA <= 1;
+}
+
+static bool valid_paint(const Paint& p) {
+    auto bits = [&](int shift, int width) { return (p.fBits >> shift) & ((1 << width) - 1); };
+    return valid_color(p.fColor) &&
+           SkScalarIsFinite(p.fWidth) && p.fWidth >= 0 &&
+           SkScalarIsFinite(p.fMiter) && p.fMiter >= 0 &&
+           bits(2, 2) < SkPaint::kCapCount &&
+           bits(4, 2) < SkPaint::kJoinCount &&
+           bits(6, 2) < SkPaint::kStyleCount &&
+           bits(10, 8) <= (uint32_t)SkBlendMode::kLastMode &&
+           (p.fBits >> 18) == 0;
+}
+
+static SkPaint unflatten(const Paint& p) {
+    SkPaint paint;
+    paint.setColor4f(p.fColor);
+    paint.setStrokeWidth(p.fWidth);
+    paint.setStrokeMiter(p.fMiter);
+    paint.setAntiAlias     (p.fBits >> 0 & 1);
+    paint.setDither        (p.fBits >> 1 & 1);
+    paint.setStrokeCap     ((SkPaint::Cap)        (p.fBits >>  2 & 3));
+    paint.setStrokeJoin    ((SkPaint::Join)       (p.fBits >>  4 & 3));
+    paint.setStyle         ((SkPaint::Style)      (p.fBits >>  6 & 3));
+    paint.setFilterQuality ((SkFilterQuality)     (p.fBits >>  8 & 3));
+    paint.setBlendMode     ((SkBlendMode)         (p.fBits >> 10 & 0xff));
+    return paint;
+}
+
+static bool valid_clip(uint32_t op, uint32_t aa) {
+    return op <= (uint32_t)SkClipOp::kMax_EnumValue && aa <= 1;
+}
+
+static bool valid_rrect(const SkRRect& rrect) {
+    SkRRect copy;
+    memcpy((void*)&copy, &rrect, sizeof(SkRRect));
+    return copy.isValid();
+}
+
+// Checks the path's verbs use exactly the points and weights it has, then skips its arrays.
+static bool valid_path(const Path& path, Reader<true>* r) {
+    const SkPoint* pts     = r->read<SkPoint>(path.fPointCount);
+    const float*   weights = r->read<float>(path.fWeightCount);
+    const uint8_t* verbs   = r->read<uint8_t>(path.fVerbCount);
+    if (path.fFillType > (uint32_t)SkPathFillType::kInverseEvenOdd || !pts || !weights || !verbs ||
+        !finite(pts, path.fPointCount) || !finite(weights, path.fWeightCount)) {
+        return false;
+    }
+    static constexpr uint8_t kPoints[] = {1, 1, 2, 2, 3, 0};
+    uint64_t points = 0,
+             conics = 0;
+    for (uint32_t i = 0; i < path.fVerbCount; i++) {
+        if (verbs[i] > (uint8_t)SkPathVerb::kClose) {
+            return false;
+        }
+        points += kPoints[verbs[i]];
+        conics += verbs[i] == (uint8_t)SkPathVerb::kConic;
+    }
+    return points == path.fPointCount && conics == path.fWeightCount;
+}
+
+// Rebuilds the path in scratch, reusing its storage when nothing else refers to it. Each rebuilt
+// path is new to the caches keyed on generation IDs, so it's marked volatile to stay out of them.
+static const SkPath& unflatten(const Path& path, Reader<false>* r, SkPath* scratch) {
+    const SkPoint* pts     = r->read<SkPoint>(path.fPointCount);
+    const float*   weights = r->read<float>(path.fWeightCount);
+    const uint8_t* verbs   = r->read<uint8_t>(path.fVerbCount);
+
+    scratch->rewind();
+    scratch->setFillType((SkPathFillType)path.fFillType);
+    scratch->setIsVolatile(true);
+    scratch->incReserve(path.fPointCount);
+    for (uint32_t i = 0; i < path.fVerbCount; i++) {
+        switch ((SkPathVerb)verbs[i]) {
+            case SkPathVerb::kMove:  scratch->moveTo(pts[0]);                      pts += 1; break;
+            case SkPathVerb::kLine:  scratch->lineTo(pts[0]);                      pts += 1; break;
+            case SkPathVerb::kQuad:  scratch->quadTo(pts[0], pts[1]);              pts += 2; break;
+            case SkPathVerb::kConic: scratch->conicTo(pts[0], pts[1], *weights++); pts += 2; break;
+            case SkPathVerb::kCubic: scratch->cubicTo(pts[0], pts[1], pts[2]);     pts += 3; break;
+            case SkPathVerb::kClose: scratch->close();                                       break;
+        }
+    }
+    return *scratch;
+}
+
+// Checks that the op's fields and arrays are all there and hold values the canvas accepts.
+static bool validate(const Op& op, Reader<true> r) {
+    #define READ(T, name) const T* name = r.read<T>(); if (!name) { return false; }
+    switch (op.fType) {
+        case OpType::kFlush:
+        case OpType::kSave:
+        case OpType::kRestore:
+            break;
+        case OpType::kSaveLayer: {
+            READ(SaveLayerOp, fields);
+            if (op.fFlags & kHasBounds_OpFlag) {
+                READ(SkRect, bounds);
+                if (!finite(bounds)) {
+                    return false;
+                }
+            }
+            if (op.fFlags & kHasPaint_OpFlag) {
+                READ(Paint, paint);
+                if (!valid_paint(*paint)) {
+                    return false;
+                }
+            }
+            return (op.fFlags & ~(kHasBounds_OpFlag | kHasPaint_OpFlag)) == 0 && r.empty();
+        }
+        case OpType::kSetMatrix:
+        case OpType::kConcat: {
+            READ(MatrixOp, fields);
+            if (!SkScalarsAreFinite(fields->values, 9)) {
+                return false;
+            }
+        } break;
+        case OpType::kConcat44: {
+            READ(Concat44Op, fields);
+            if (!SkScalarsAreFinite(fields->values, 16)) {
+                return false;
+            }
+        } break;
+        case OpType::kTranslate:
+        case OpType::kScale: {
+            READ(TranslateOp, fields);
+            if (!finite(fields)) {
+                return false;
+            }
+        } break;
+        case OpType::kClipRect: {
+            READ(ClipRectOp, fields);
+            if (!valid_clip(fields->op, fields->aa) || !finite(&fields->rect)) {
+                return false;
+            }
+        } break;
+        case OpType::kClipRRect: {
+            READ(ClipRRectOp, fields);
+            if (!valid_clip(fields->op, fields->aa) || !valid_rrect(fields->rrect)) {
+                return false;
+            }
+        } break;
+        case OpType::kClipPath: {
+            READ(ClipPathOp, fields);
+            if (!valid_clip(fields->op, fields->aa) || !valid_path(fields->path, &r)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawPaint: {
+            READ(DrawPaintOp, fields);
+            if (!valid_paint(fields->paint)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawRect:
+        case OpType::kDrawOval: {
+            READ(DrawRectOp, fields);
+            if (!valid_paint(fields->paint) || !finite(&fields->rect)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawRRect: {
+            READ(DrawRRectOp, fields);
+            if (!valid_paint(fields->paint) || !valid_rrect(fields->rrect)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawDRRect: {
+            READ(DrawDRRectOp, fields);
+            if (!valid_paint(fields->paint) ||
+                !valid_rrect(fields->outer) || !valid_rrect(fields->inner)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawArc: {
+            READ(DrawArcOp, fields);
+            if (!valid_paint(fields->paint) || fields->useCenter > 1 || !finite(&fields->oval) ||
+                !SkScalarIsFinite(fields->startAngle) || !SkScalarIsFinite(fields->sweepAngle)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawPath: {
+            READ(DrawPathOp, fields);
+            if (!valid_paint(fields->paint) || !valid_path(fields->path, &r)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawPoints: {
+            READ(DrawPointsOp, fields);
+            const SkPoint* pts = r.read<SkPoint>(fields->count);
+            if (!valid_paint(fields->paint) ||
+                fields->mode > SkCanvas::kPolygon_PointMode ||
+                !pts || !finite(pts, fields->count)) {
+                return false;
+            }
+        } break;
+        case OpType::kDrawEdgeAAQuad: {
+            READ(DrawEdgeAAQuadOp, fields);
+            if (!valid_color(fields->color) || !finite(&fields->rect) ||
+                fields->aa > SkCanvas::kAll_QuadAAFlags ||
+                fields->mode > (uint32_t)SkBlendMode::kLastMode) {
+                return false;
+            }
+            if (op.fFlags & kHasClip_OpFlag) {
+                const SkPoint* clip = r.read<SkPoint>(4);
+                if (!clip || !finite(clip, 4)) {
+                    return false;
+                }
+            }
+            return (op.fFlags & ~kHasClip_OpFlag) == 0 && r.empty();
+        }
+        default:
+            return false;
+    }
+    #undef READ
+    return op.fFlags == 0 && r.empty();
+}
+
+struct Player {
+    SkCanvas*      fCanvas;
+    const SkMatrix fInitialCTM;
+    SkPath         fScratch;
+};
+
+static SkRRect unflatten(const SkRRect& rrect) {
+    SkRRect copy;
+    memcpy((void*)&copy, &rrect, sizeof(SkRRect));
+    return copy;
+}
+
+static SkMatrix unflatten(const MatrixOp& op) {
+    SkMatrix matrix;
+    matrix.set9(op.values);
+    return matrix;
+}
+
+// Draws a validated op.
+static void draw(const Op& op, Reader<false> r, Player* p) {
+    SkCanvas* canvas = p->fCanvas;
+    switch (op.fType) {
+        case OpType::kFlush:   canvas->flush();   break;
+        case OpType::kSave:    canvas->save();    break;
+        case OpType::kRestore: canvas->restore(); break;
+        case OpType::kSaveLayer: {
+            auto fields = r.read<SaveLayerOp>();
+            const SkRect* bounds = (op.fFlags & kHasBounds_OpFlag) ? r.read<SkRect>() : nullptr;
+            SkPaint paint;
+            if (op.fFlags & kHasPaint_OpFlag) {
+                paint = unflatten(*r.read<Paint>());
+            }
+            canvas->saveLayer(SkCanvas::SaveLayerRec(
+                    bounds, (op.fFlags & kHasPaint_OpFlag) ? &paint : nullptr, fields->flags));
+        } break;
+        case OpType::kSetMatrix:
+            canvas->setMatrix(SkMatrix::Concat(p->fInitialCTM, unflatten(*r.read<MatrixOp>())));
+            break;
+        case OpType::kConcat:
+            canvas->concat(unflatten(*r.read<MatrixOp>()));
+            break;
+        case OpType::kConcat44:
+            canvas->concat(SkM44::ColMajor(r.read<Concat44Op>()->values));
+            break;
+        case OpType::kTranslate: {
+            auto fields = r.read<TranslateOp>();
+            canvas->translate(fields->dx, fields->dy);
+        } break;
+        case OpType::kScale: {
+            auto fields = r.read<TranslateOp>();
+            canvas->scale(fields->dx, fields->dy);
+        } break;
+        case OpType::kClipRect: {
+            auto fields = r.read<ClipRectOp>();
+            canvas->clipRect(fields->rect, (SkClipOp)fields->op, fields->aa);
+        } break;
+        case OpType::kClipRRect: {
+            auto fields = r.read<ClipRRectOp>();
+            canvas->clipRRect(unflatten(fields->rrect), (SkClipOp)fields->op, fields->aa);
+        } break;
+        case OpType::kClipPath: {
+            auto fields = r.read<ClipPathOp>();
+            canvas->clipPath(unflatten(fields->path, &r, &p->fScratch),
+                             (SkClipOp)fields->op, fields->aa);
+        } break;
+        case OpType::kDrawPaint:
+            canvas->drawPaint(unflatten(r.read<DrawPaintOp>()->paint));
+            break;
+        case OpType::kDrawRect: {
+            auto fields = r.read<DrawRectOp>();
+            canvas->drawRect(fields->rect, unflatten(fields->paint));
+        } break;
+        case OpType::kDrawOval: {
+            auto fields = r.read<DrawRectOp>();
+            canvas->drawOval(fields->rect, unflatten(fields->paint));
+        } break;
+        case OpType::kDrawRRect: {
+            auto fields = r.read<DrawRRectOp>();
+            canvas->drawRRect(unflatten(fields->rrect), unflatten(fields->paint));
+        } break;
+        case OpType::kDrawDRRect: {
+            auto fields = r.read<DrawDRRectOp>();
+            canvas->drawDRRect(unflatten(fields->outer), unflatten(fields->inner),
+                               unflatten(fields->paint));
+        } break;
+        case OpType::kDrawArc: {
+            auto fields = r.read<DrawArcOp>();
+            canvas->drawArc(fields->oval, fields->startAngle, fields->sweepAngle,
+                            fields->useCenter, unflatten(fields->paint));
+        } break;
+        case OpType::kDrawPath: {
+            auto fields = r.read<DrawPathOp>();
+            canvas->drawPath(unflatten(fields->path, &r, &p->fScratch), unflatten(fields->paint));
+        } break;
+        case OpType::kDrawPoints: {
+            auto fields = r.read<DrawPointsOp>();
+            canvas->drawPoints((SkCanvas::PointMode)fields->mode, fields->count,
+                               r.read<SkPoint>(fields->count), unflatten(fields->paint));
+        } break;
+        case OpType::kDrawEdgeAAQuad: {
+            auto fields = r.read<DrawEdgeAAQuadOp>();
+            const SkPoint* clip = (op.fFlags & kHasClip_OpFlag) ? r.read<SkPoint>(4) : nullptr;
+            canvas->experimental_DrawEdgeAAQuad(fields->rect, clip,
+                                                (SkCanvas::QuadAAFlags)fields->aa,
+                                                fields->color, (SkBlendMode)fields->mode);
+        } break;
+    }
+}
+
+}  // namespace
+
+sk_sp<SkData> SkFlatRecord::Serialize(const SkRecord& record, const SkRect& cullRect) {
+    SkWriter32 writer;
+    writer.reserve(sizeof(Header));  // written last
+
+    Flattener flattener(&writer);
+    for (int i = 0; i < record.count(); i++) {
+        if (!record.visit(i, flattener)) {
+            return nullptr;
+        }
+    }
+    writer.overwriteTAt(0, Header{kMagic, kVersion, (uint32_t)flattener.count(),
+                                  (uint32_t)(writer.bytesWritten() - sizeof(Header)), cullRect});
+    return writer.snapshotAsData();
+}
+
+sk_sp<SkFlatRecord> SkFlatRecord::Make(sk_sp<SkData> data) {
+    if (!data || data->size() < sizeof(Header)) {
+        return nullptr;
+    }
+    if (!SkIsAlign4((uintptr_t)data->data())) {
+        data = SkData::MakeWithCopy(data->data(), data->size());
+    }
+
+    auto header = static_cast<const Header*>(data->data());
+    if (header->fMagic != kMagic || header->fVersion != kVersion ||
+        header->fSize != data->size() - sizeof(Header) ||
+        header->fCount > header->fSize / sizeof(Op) ||
+        !header->fCullRect.isFinite()) {
+        return nullptr;
+    }
+
+    Reader<true> ops(header + 1, header->fSize);
+    for (uint32_t i = 0; i < header->fCount; i++) {
+        const Op* op = ops.read<Op>();
+        if (!op || op->fSize < sizeof(Op) || op->fSize % 4 != 0 ||
+            !ops.read<char>(op->fSize - sizeof(Op)) ||
+            !validate(*op, Reader<true>(op + 1, op->fSize - sizeof(Op)))) {
+            return nullptr;
+        }
+    }
+    if (!ops.empty()) {
+        return nullptr;
+    }
+    return sk_sp<SkFlatRecord>(
+            new SkFlatRecord(std::move(data), (int)header->fCount, header->fCullRect));
+}
+
+void SkFlatRecord::playback(SkCanvas* canvas) const {
+    SkAutoCanvasRestore saveRestore(canvas, true /*save now, restore at exit*/);
+
+    Player player{canvas, canvas->getTotalMatrix(), SkPath()};
+    auto header = static_cast<const Header*>(fData->data());
+    Reader<false> ops(header + 1, header->fSize);
+    for (int i = 0; i < fCount; i++) {
+        const Op* op = ops.read<Op>();
+        ops.read<char>(op->fSize - sizeof(Op));
+        draw(*op, Reader<false>(op + 1, op->fSize - sizeof(Op)), &player);
+    }
+}
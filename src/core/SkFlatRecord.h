@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFlatRecord_DEFINED
+#define SkFlatRecord_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+
+class SkCanvas;
+class SkRecord;
+
+/**
+ * A serialized SkRecord that plays back straight from the bytes it was serialized to.
+ *
+ * Each op is written as one block: a small header with its type and size, the op's fields, then
+ * any arrays it refers to (points, path verbs, ...), all 4-byte aligned and with no pointers, so
+ * the bytes can be read in place wherever they are loaded. Paints are written as their color,
+ * stroke and flags; there is no factory or typeface table to rebuild. Make() checks every op once,
+ * up front, so playback can trust the bytes and reads them in place without allocating anything
+ * but the SkPaths it passes to the canvas.
+ *
+ * Only ops that can be written this way are supported: the matrix, clip, save and restore ops,
+ * and the geometric draws, with paints that have no effects (shaders, filters, path effects...).
+ * Serialize() returns nullptr for records with anything else, e.g. images, text or pictures;
+ * those still need SkPicture::serialize().
+ *
+ * The layout follows the in-memory layout of the types it holds (floats, SkRRect), so it is meant
+ * for passing records between processes of the same build, not for archiving them.
+ */
+class SkFlatRecord : public SkNVRefCnt<SkFlatRecord> {
+public:
+    /** Returns the record serialized with its cull rect, or nullptr if it can't be flattened. */
+    static sk_sp<SkData> Serialize(const SkRecord&, const SkRect& cullRect);
+
+    /**
+     *  Returns a flat record reading from data, or nullptr if data is not a complete, valid
+     *  serialized record. The data is used in place (a copy is made only if it is not 4-byte
+     *  aligned), and kept alive by the flat record.
+     *
+     *  The data is only validated here, so it must not change afterwards: bytes that someone else
+     *  can still write to, e.g. memory shared with another process, must be copied first.
+     */
+    static sk_sp<SkFlatRecord> Make(sk_sp<SkData> data);
+
+    int count() const { return fCount; }
+    const SkRect& cullRect() const { return fCullRect; }
+    size_t approximateBytesUsed() const { return sizeof(*this) + fData->size(); }
+
+    /** Draws the record into the canvas, as SkRecordDraw() would draw the original SkRecord. */
+    void playback(SkCanvas*) const;
+
+private:
+    SkFlatRecord(sk_sp<SkData> data, int count, const SkRect& cullRect)
+        : fData(std::move(data)), fCount(count), fCullRect(cullRect) {}
+
+    sk_sp<SkData> fData;
+    int           fCount;
+    SkRect        fCullRect;
+};
+
+#endif
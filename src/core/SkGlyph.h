@@ -291,6 +291,7 @@ private:
     friend class SkScalerContext_DW;
     friend class SkScalerContext_GDI;
     friend class SkScalerContext_Mac;
+    friend class SkStrikeCacheSnapshot;
     friend class SkStrikeClient;
     friend class SkStrikeServer;
     friend class SkTestScalerContext;
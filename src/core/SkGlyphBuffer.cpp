@@ -6,6 +6,7 @@
  */
 
 #include "src/core/SkGlyphBuffer.h"
+#include "include/private/SkNx.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkStrikeForGPU.h"
 
@@ -58,12 +59,24 @@ void SkDrawableGlyphBuffer::startBitmapDevice(
     // Mask for controlling axis alignment.
     SkIPoint mask = roundingSpec.ignorePositionFieldMask;
 
-    // Convert glyph ids and positions to packed glyph ids.
-    SkZip<const SkGlyphID, const SkPoint> withMappedPos =
-            SkMakeZip(source.get<0>(), fPositions.get());
-    SkGlyphVariant* packedIDCursor = fMultiBuffer;
-    for (auto [glyphID, pos] : withMappedPos) {
-        *packedIDCursor++ = SkPackedGlyphID{glyphID, pos, mask};
+    // Convert glyph ids and positions to packed glyph ids, two at a time. This is the same
+    // arithmetic as SkPackedGlyphID{glyphID, pos, mask}, but it keeps floor() out of libm.
+    const SkGlyphID* glyphIDs = source.get<0>().data();
+    const size_t count = source.size();
+    const Sk4f subPixels{1u << SkPackedGlyphID::kSubPixelPosLen};
+    const Sk4i subMask{mask.x() >> SkPackedGlyphID::kSubPixelX,
+                       mask.y() >> SkPackedGlyphID::kSubPixelY,
+                       mask.x() >> SkPackedGlyphID::kSubPixelX,
+                       mask.y() >> SkPackedGlyphID::kSubPixelY};
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        Sk4f xy = Sk4f::Load(&fPositions[i]);
+        Sk4i sub = SkNx_cast<int>((xy - xy.floor() + 1.0f) * subPixels) & subMask;
+        fMultiBuffer[i]     = SkPackedGlyphID{glyphIDs[i],     (uint32_t)sub[0], (uint32_t)sub[1]};
+        fMultiBuffer[i + 1] = SkPackedGlyphID{glyphIDs[i + 1], (uint32_t)sub[2], (uint32_t)sub[3]};
+    }
+    for (; i < count; ++i) {
+        fMultiBuffer[i] = SkPackedGlyphID{glyphIDs[i], fPositions[i], mask};
     }
     SkDEBUGCODE(fPhase = kInput);
 }
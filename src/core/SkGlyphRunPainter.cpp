@@ -118,6 +118,20 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
 
             bitmapDevice->paintPaths(
                     &fDrawable, strikeSpec.strikeToSourceRatio(), drawOrigin, pathPaint);
+        } else if (SkStrikeSpec::ShouldDrawAsSDF(runPaint, runFont, deviceMatrix, fDeviceProps)) {
+            // The distance fields are independent of the device matrix, so one strike serves
+            // every zoom level of the run's font within a size bucket.
+            SkStrikeSpec strikeSpec = SkStrikeSpec::MakeSDF(
+                    runFont, runPaint, fDeviceProps, deviceMatrix);
+
+            auto strike = strikeSpec.findOrCreateStrike();
+
+            fDrawable.startSource(fRejects.source());
+            strike->prepareForSDFTDrawingCPU(&fDrawable, &fRejects);
+            fRejects.flipRejectsToSource();
+
+            bitmapDevice->paintSDFs(
+                    &fDrawable, strikeSpec.strikeToSourceRatio(), drawOrigin, runPaint);
         }
         if (!fRejects.source().empty()) {
             SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
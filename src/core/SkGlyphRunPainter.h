@@ -74,6 +74,12 @@ public:
                 const SkPaint& paint) const = 0;
 
         virtual void paintMasks(SkDrawableGlyphBuffer* drawables, const SkPaint& paint) const = 0;
+
+        // The drawables are distance field glyphs from a strike scale times the size of the run's
+        // font, positioned in source space; see SkStrikeSpec::MakeSDF.
+        virtual void paintSDFs(
+                SkDrawableGlyphBuffer* drawables, SkScalar scale, SkPoint origin,
+                const SkPaint& paint) const = 0;
     };
 
     void drawForBitmapDevice(
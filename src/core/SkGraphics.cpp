@@ -19,6 +19,7 @@
 #include "src/core/SkBlitter.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
@@ -40,6 +41,7 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+  SkImageFilterCache::DumpMemoryStatistics(dump);
 }
 
 void SkGraphics::PurgeAllCaches() {
@@ -138,3 +140,19 @@ extern bool gSkVMAllowJIT;
 void SkGraphics::AllowJIT() {
     gSkVMAllowJIT = true;
 }
+
+SkExecutor* SkGraphics::SetImageFilterExecutor(SkExecutor* executor) {
+    return SkImageFilter_Base::SetExecutor(executor);
+}
+
+size_t SkGraphics::GetImageFilterCacheByteLimit() {
+    return SkImageFilterCache::Get()->getByteLimit();
+}
+
+size_t SkGraphics::SetImageFilterCacheByteLimit(size_t newLimit) {
+    return SkImageFilterCache::Get()->setByteLimit(newLimit);
+}
+
+bool SkGraphics::SetImageFilterCacheStructuralKeys(bool enabled) {
+    return SkImageFilterCache::SetStructuralKeys(enabled);
+}
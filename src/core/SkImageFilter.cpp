@@ -19,6 +19,7 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkSpecialSurface.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkValidationUtils.h"
 #include "src/core/SkWriteBuffer.h"
 #if SK_SUPPORT_GPU
@@ -165,6 +166,11 @@ SkImageFilter_Base::~SkImageFilter_Base() {
     SkImageFilterCache::Get()->purgeByImageFilter(this);
 }
 
+uint32_t SkImageFilter_Base::structuralID() const {
+    fStructuralIDOnce([this] { fStructuralID = SkImageFilterCache::StructuralID(this); });
+    return fStructuralID;
+}
+
 bool SkImageFilter_Base::Common::unflatten(SkReadBuffer& buffer, int expectedCount) {
     const int count = buffer.readInt();
     if (!buffer.validate(count >= 0)) {
@@ -227,13 +233,25 @@ skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImage(const skif::Con
     const SkIRect srcSubset = fUsesSrcInput ? context.sourceImage()->subset()
                                             : SkIRect::MakeWH(0, 0);
 
-    SkImageFilterCacheKey key(fUniqueID, context.mapping().layerMatrix(), context.clipBounds(),
+    uint32_t filterID = 0;
+    if (context.cache() && context.cache()->usesStructuralKeys()) {
+        filterID = this->structuralID();
+    }
+    if (!filterID) {
+        filterID = fUniqueID;
+    }
+
+    SkImageFilterCacheKey key(filterID, context.mapping().layerMatrix(), context.clipBounds(),
                               srcGenID, srcSubset);
     if (context.cache() && context.cache()->get(key, &result)) {
         return result;
     }
 
-    result = this->onFilterImage(context);
+    if (context.executor() && !context.gpuBacked() && this->canFilterInTiles()) {
+        result = this->filterImageInTiles(context);
+    } else {
+        result = this->onFilterImage(context);
+    }
 
     if (context.gpuBacked()) {
         SkASSERT(!result.image() || result.image()->isTextureBacked());
@@ -246,6 +264,94 @@ skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImage(const skif::Con
     return result;
 }
 
+skif::FilterResult<For::kOutput> SkImageFilter_Base::filterImageInTiles(
+        const skif::Context& context) const {
+    // Tiles are large enough that the extra input each one needs along its edges (e.g. a blur's
+    // kernel margin) stays small relative to its area, and small enough to spread across cores.
+    static constexpr int kTileSize = 512;
+
+    // The tiles' sub-DAGs are evaluated without an executor so the split only happens once, at the
+    // highest node that supports it.
+    const skif::Context tileContext = context.withNewExecutor(nullptr);
+    const SkIRect desiredOutput = context.clipBounds();
+    const int tilesX = (desiredOutput.width()  + kTileSize - 1) / kTileSize;
+    const int tilesY = (desiredOutput.height() + kTileSize - 1) / kTileSize;
+    if (tilesX * tilesY <= 1) {
+        return this->onFilterImage(tileContext);
+    }
+
+    struct Tile {
+        SkIRect               fBounds;
+        sk_sp<SkSpecialImage> fImage;
+        SkIPoint              fOrigin;
+    };
+    SkTArray<Tile> tiles(tilesX * tilesY);
+    for (int y = 0; y < tilesY; ++y) {
+        for (int x = 0; x < tilesX; ++x) {
+            SkIRect bounds = SkIRect::MakeXYWH(desiredOutput.fLeft + x * kTileSize,
+                                               desiredOutput.fTop  + y * kTileSize,
+                                               kTileSize, kTileSize);
+            SkAssertResult(bounds.intersect(desiredOutput));
+            tiles.push_back().fBounds = bounds;
+        }
+    }
+
+    // Each tile only keeps its own output alive; the intermediate images of its sub-DAG are
+    // released as soon as the tile finishes.
+    SkTaskGroup group(*context.executor());
+    group.batch(tiles.count(), [&](int i) {
+        Tile& tile = tiles[i];
+        skif::Context ctx = tileContext.withNewDesiredOutput(
+                skif::LayerSpace<SkIRect>(tile.fBounds));
+        tile.fImage = this->onFilterImage(ctx).imageAndOffset(&tile.fOrigin);
+        if (tile.fImage && !tile.fBounds.intersect(SkIRect::MakeXYWH(tile.fOrigin.fX,
+                                                                     tile.fOrigin.fY,
+                                                                     tile.fImage->width(),
+                                                                     tile.fImage->height()))) {
+            tile.fImage = nullptr;
+        }
+    });
+    group.wait();
+
+    SkIRect resultBounds = SkIRect::MakeEmpty();
+    for (const Tile& tile : tiles) {
+        if (tile.fImage) {
+            resultBounds.join(tile.fBounds);
+        }
+    }
+    if (resultBounds.isEmpty()) {
+        return {};
+    }
+
+    SkBitmap dst;
+    if (!dst.tryAllocPixels(SkImageInfo::Make(resultBounds.size(), context.colorType(),
+                                              kPremul_SkAlphaType, context.refColorSpace()))) {
+        return {};
+    }
+    dst.eraseColor(SK_ColorTRANSPARENT);
+
+    // The clipped tile outputs are disjoint, so they can be copied into place concurrently.
+    group.batch(tiles.count(), [&](int i) {
+        const Tile& tile = tiles[i];
+        if (!tile.fImage) {
+            return;
+        }
+        SkCanvas canvas(dst, *context.surfaceProps());
+        canvas.translate(-resultBounds.fLeft, -resultBounds.fTop);
+        canvas.clipRect(SkRect::Make(tile.fBounds));
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        tile.fImage->draw(&canvas, tile.fOrigin.fX, tile.fOrigin.fY, &paint);
+    });
+    group.wait();
+    dst.setImmutable();
+
+    return skif::FilterResult<For::kOutput>(
+            SkSpecialImage::MakeFromRaster(SkIRect::MakeSize(resultBounds.size()), dst,
+                                           context.surfaceProps()),
+            skif::LayerSpace<SkIPoint>(resultBounds.topLeft()));
+}
+
 skif::LayerSpace<SkIRect> SkImageFilter_Base::getInputBounds(
         const skif::Mapping& mapping, const skif::DeviceSpace<SkRect>& desiredOutput,
         const skif::ParameterSpace<SkRect>* knownContentBounds) const {
@@ -314,6 +420,20 @@ bool SkImageFilter_Base::canHandleComplexCTM() const {
     return true;
 }
 
+bool SkImageFilter_Base::canFilterInTiles() const {
+    if (!this->onCanFilterInTiles()) {
+        return false;
+    }
+    const int count = this->countInputs();
+    for (int i = 0; i < count; ++i) {
+        const SkImageFilter_Base* input = as_IFB(this->getInput(i));
+        if (input && !input->canFilterInTiles()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void SkImageFilter::CropRect::applyTo(const SkIRect& imageBounds, const SkMatrix& ctm,
                                       bool embiggen, SkIRect* cropped) const {
     *cropped = imageBounds;
@@ -650,6 +770,16 @@ void SkImageFilter_Base::PurgeCache() {
     SkImageFilterCache::Get()->purge();
 }
 
+static std::atomic<SkExecutor*> gImageFilterExecutor{nullptr};
+
+SkExecutor* SkImageFilter_Base::Executor() {
+    return gImageFilterExecutor.load(std::memory_order_relaxed);
+}
+
+SkExecutor* SkImageFilter_Base::SetExecutor(SkExecutor* executor) {
+    return gImageFilterExecutor.exchange(executor);
+}
+
 static sk_sp<SkImageFilter> apply_ctm_to_filter(sk_sp<SkImageFilter> input, const SkMatrix& ctm,
                                                 SkMatrix* remainder) {
     if (ctm.isScaleTranslate() || as_IFB(input)->canHandleComplexCTM()) {
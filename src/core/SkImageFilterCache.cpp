@@ -9,16 +9,25 @@
 
 #include <vector>
 
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/SkMutex.h"
 #include "include/private/SkOnce.h"
 #include "include/private/SkTHash.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkTDynamicHash.h"
 #include "src/core/SkTInternalLList.h"
 
+#include <atomic>
+
 #ifdef SK_BUILD_FOR_IOS
   enum { kDefaultCacheSize = 2 * 1024 * 1024 };
 #else
@@ -27,21 +36,25 @@
 
 namespace {
 
+static const char kUnknownTypeName[] = "unknown";
+
 class CacheImpl : public SkImageFilterCache {
 public:
     typedef SkImageFilterCacheKey Key;
-    CacheImpl(size_t maxBytes) : fMaxBytes(maxBytes), fCurrentBytes(0) { }
+    CacheImpl(size_t maxBytes, bool structuralKeys)
+        : fMaxBytes(maxBytes), fCurrentBytes(0), fStructuralKeys(structuralKeys) { }
     ~CacheImpl() override {
         fLookup.foreach([&](Value* v) { delete v; });
     }
     struct Value {
         Value(const Key& key, const skif::FilterResult<For::kOutput>& image,
-              const SkImageFilter* filter)
-            : fKey(key), fImage(image), fFilter(filter) {}
+              const SkImageFilter* filter, const char* typeName)
+            : fKey(key), fImage(image), fFilter(filter), fTypeName(typeName) {}
 
         Key fKey;
         skif::FilterResult<For::kOutput> fImage;
         const SkImageFilter* fFilter;
+        const char* fTypeName;
         static const Key& GetKey(const Value& v) {
             return v.fKey;
         }
@@ -51,6 +64,10 @@ public:
         SK_DECLARE_INTERNAL_LLIST_INTERFACE(Value);
     };
 
+    bool usesStructuralKeys() const override {
+        return fStructuralKeys || SkImageFilterCache::StructuralKeys();
+    }
+
     bool get(const Key& key, skif::FilterResult<For::kOutput>* result) const override {
         SkASSERT(result);
 
@@ -61,6 +78,7 @@ public:
                 fLRU.addToHead(v);
             }
 
+            fTypeStats.find(v->fTypeName)->fHits++;
             *result = v->fImage;
             return true;
         }
@@ -69,28 +87,41 @@ public:
 
     void set(const Key& key, const SkImageFilter* filter,
              const skif::FilterResult<For::kOutput>& result) override {
+        const char* typeName = filter ? filter->getTypeName() : nullptr;
+        if (!typeName) {
+            typeName = kUnknownTypeName;
+        }
+        // Results cached under a structural key are shared by every equivalent filter, so they
+        // are not tied to the lifetime of the one that happened to produce them.
+        if (key.fUniqueID & kStructuralIDBit) {
+            filter = nullptr;
+        }
+
         SkAutoMutexExclusive mutex(fMutex);
         if (Value* v = fLookup.find(key)) {
             this->removeInternal(v);
         }
-        Value* v = new Value(key, result, filter);
+        Value* v = new Value(key, result, filter, typeName);
         fLookup.add(v);
         fLRU.addToHead(v);
-        fCurrentBytes += result.image() ? result.image()->getSize() : 0;
-        if (auto* values = fImageFilterValues.find(filter)) {
-            values->push_back(v);
-        } else {
-            fImageFilterValues.set(filter, {v});
+        size_t bytes = result.image() ? result.image()->getSize() : 0;
+        fCurrentBytes += bytes;
+        Stats* stats = fTypeStats.find(typeName);
+        if (!stats) {
+            stats = fTypeStats.set(typeName, {typeName, 0, 0, 0, 0});
         }
-
-        while (fCurrentBytes > fMaxBytes) {
-            Value* tail = fLRU.tail();
-            SkASSERT(tail);
-            if (tail == v) {
-                break;
+        stats->fInserts++;
+        stats->fCount++;
+        stats->fBytes += bytes;
+        if (filter) {
+            if (auto* values = fImageFilterValues.find(filter)) {
+                values->push_back(v);
+            } else {
+                fImageFilterValues.set(filter, {v});
             }
-            this->removeInternal(tail);
         }
+
+        this->purgeToBudget(v);
     }
 
     void purge() override {
@@ -117,8 +148,43 @@ public:
         fImageFilterValues.remove(filter);
     }
 
+    size_t getTotalBytesUsed() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        return fCurrentBytes;
+    }
+
+    size_t getByteLimit() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        return fMaxBytes;
+    }
+
+    size_t setByteLimit(size_t maxBytes) override {
+        SkAutoMutexExclusive mutex(fMutex);
+        size_t prevLimit = fMaxBytes;
+        fMaxBytes = maxBytes;
+        this->purgeToBudget(nullptr);
+        return prevLimit;
+    }
+
+    void getStats(std::vector<Stats>* stats) const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        fTypeStats.foreach([&](const char*, const Stats* s) { stats->push_back(*s); });
+    }
+
     SkDEBUGCODE(int count() const override { return fLookup.count(); })
 private:
+    // Evicts least recently used entries until the cache fits its budget, but never 'keep'.
+    void purgeToBudget(Value* keep) {
+        while (fCurrentBytes > fMaxBytes) {
+            Value* tail = fLRU.tail();
+            SkASSERT(tail);
+            if (tail == keep) {
+                break;
+            }
+            this->removeInternal(tail);
+        }
+    }
+
     void removeInternal(Value* v) {
         if (v->fFilter) {
             if (auto* values = fImageFilterValues.find(v->fFilter)) {
@@ -134,7 +200,12 @@ private:
                 }
             }
         }
-        fCurrentBytes -= v->fImage.image() ? v->fImage.image()->getSize() : 0;
+        size_t bytes = v->fImage.image() ? v->fImage.image()->getSize() : 0;
+        fCurrentBytes -= bytes;
+        Stats* stats = fTypeStats.find(v->fTypeName);
+        SkASSERT(stats);
+        stats->fCount--;
+        stats->fBytes -= bytes;
         fLRU.remove(v);
         fLookup.remove(v->fKey);
         delete v;
@@ -144,15 +215,18 @@ private:
     mutable SkTInternalLList<Value>                       fLRU;
     // Value* always points to an item in fLookup.
     SkTHashMap<const SkImageFilter*, std::vector<Value*>> fImageFilterValues;
+    // Keyed by the address of the type name, which is unique per registered filter type.
+    mutable SkTHashMap<const char*, Stats>                fTypeStats;
     size_t                                                fMaxBytes;
     size_t                                                fCurrentBytes;
+    const bool                                            fStructuralKeys;
     mutable SkMutex                                       fMutex;
 };
 
 } // namespace
 
-SkImageFilterCache* SkImageFilterCache::Create(size_t maxBytes) {
-    return new CacheImpl(maxBytes);
+SkImageFilterCache* SkImageFilterCache::Create(size_t maxBytes, bool structuralKeys) {
+    return new CacheImpl(maxBytes, structuralKeys);
 }
 
 SkImageFilterCache* SkImageFilterCache::Get() {
@@ -162,3 +236,94 @@ SkImageFilterCache* SkImageFilterCache::Get() {
     once([]{ cache = SkImageFilterCache::Create(kDefaultCacheSize); });
     return cache;
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// A filter's serialized bytes, compared by content.
+struct FlatFilter {
+    sk_sp<SkData> fData;
+
+    bool operator==(const FlatFilter& that) const {
+        return fData->equals(that.fData.get());
+    }
+};
+
+struct FlatFilterHash {
+    uint32_t operator()(const FlatFilter& flat) const {
+        return SkOpts::hash(flat.fData->data(), flat.fData->size());
+    }
+};
+
+// Bounds the memory spent remembering structures. Forgetting one only costs future cache hits:
+// IDs are never reused, so a filter that outlives its entry keeps a valid (if unshared) ID.
+static constexpr int kMaxStructures = 4096;
+
+static std::atomic<bool> gStructuralKeys{false};
+
+}  // namespace
+
+uint32_t SkImageFilterCache::StructuralID(const SkImageFilter* filter) {
+    // Images and pictures are identified by their unique IDs, which are content IDs, instead of
+    // encoding them.
+    SkSerialProcs procs;
+    procs.fImageProc = [](SkImage* image, void*) {
+        uint32_t id = image->uniqueID();
+        return SkData::MakeWithCopy(&id, sizeof(id));
+    };
+    procs.fPictureProc = [](SkPicture* picture, void*) {
+        uint32_t id = picture->uniqueID();
+        return SkData::MakeWithCopy(&id, sizeof(id));
+    };
+    FlatFilter flat{filter->serialize(&procs)};
+    if (!flat.fData) {
+        return 0;
+    }
+
+    static SkMutex mutex;
+    static SkLRUCache<FlatFilter, uint32_t, FlatFilterHash>* structures =
+            new SkLRUCache<FlatFilter, uint32_t, FlatFilterHash>(kMaxStructures);
+    static uint32_t nextID = 0;
+
+    SkAutoMutexExclusive lock(mutex);
+    if (uint32_t* id = structures->find(flat)) {
+        return *id;
+    }
+    // Filters keep their IDs for life, so wrapping around could hand a live filter's ID to a
+    // different structure. Once the 31 bits run out, new structures fall back to unique IDs.
+    if (nextID == ~kStructuralIDBit) {
+        return 0;
+    }
+    return *structures->insert(flat, ++nextID | kStructuralIDBit);
+}
+
+bool SkImageFilterCache::SetStructuralKeys(bool enabled) {
+    return gStructuralKeys.exchange(enabled);
+}
+
+bool SkImageFilterCache::StructuralKeys() {
+    return gStructuralKeys.load(std::memory_order_relaxed);
+}
+
+void SkImageFilterCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    static const char kDumpName[] = "skia/sk_image_filter_cache";
+
+    SkImageFilterCache* cache = Get();
+    dump->dumpNumericValue(kDumpName, "size", "bytes", cache->getTotalBytesUsed());
+    dump->dumpNumericValue(kDumpName, "budget_size", "bytes", cache->getByteLimit());
+    dump->setMemoryBacking(kDumpName, "malloc", nullptr);
+    if (dump->getRequestedDetails() == SkTraceMemoryDump::kLight_LevelOfDetail) {
+        return;
+    }
+
+    std::vector<Stats> stats;
+    cache->getStats(&stats);
+    for (const Stats& s : stats) {
+        SkString dumpName = SkStringPrintf("%s/%s", kDumpName, s.fTypeName);
+        dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", s.fBytes);
+        dump->dumpNumericValue(dumpName.c_str(), "result_count", "objects", s.fCount);
+        dump->dumpNumericValue(dumpName.c_str(), "hits", "objects", s.fHits);
+        dump->dumpNumericValue(dumpName.c_str(), "inserts", "objects", s.fInserts);
+    }
+}
@@ -12,8 +12,11 @@
 #include "include/core/SkRefCnt.h"
 #include "src/core/SkImageFilterTypes.h"
 
+#include <vector>
+
 struct SkIPoint;
 class SkImageFilter;
+class SkTraceMemoryDump;
 
 struct SkImageFilterCacheKey {
     SkImageFilterCacheKey(const uint32_t uniqueID, const SkMatrix& matrix,
@@ -47,18 +50,52 @@ struct SkImageFilterCacheKey {
 };
 
 // This cache maps from (filter's unique ID + CTM + clipBounds + src bitmap generation ID) to result
-// NOTE: this is the _specific_ unique ID of the image filter, so refiltering the same image with a
-// copy of the image filter (with exactly the same parameters) will not yield a cache hit.
+// NOTE: by default this is the _specific_ unique ID of the image filter, so refiltering the same
+// image with a copy of the image filter (with exactly the same parameters) will not yield a cache
+// hit. When structural keys are enabled, the filter's structural ID is used instead (see
+// StructuralID()), and copies of a filter share cached results.
 class SkImageFilterCache : public SkRefCnt {
 public:
     SK_USE_FLUENT_IMAGE_FILTER_TYPES_IN_CLASS
 
     enum { kDefaultTransientSize = 32 * 1024 * 1024 };
 
+    // Structural IDs have this bit set, so they never collide with filters' unique IDs.
+    static constexpr uint32_t kStructuralIDBit = 0x80000000;
+
+    struct Stats {
+        const char* fTypeName;
+        int         fHits;
+        int         fInserts;   // results set, i.e. misses that were filtered and cached
+        int         fCount;     // number of results currently cached
+        size_t      fBytes;     // bytes of results currently cached
+    };
+
     ~SkImageFilterCache() override {}
-    static SkImageFilterCache* Create(size_t maxBytes);
+    // A cache created with structuralKeys is keyed on structural IDs whatever
+    // SetStructuralKeys() says.
+    static SkImageFilterCache* Create(size_t maxBytes, bool structuralKeys = false);
     static SkImageFilterCache* Get();
 
+    // Returns an ID shared by every filter that serializes to the same bytes, i.e. that has the
+    // same parameters and equivalent inputs. Images and pictures referenced by the filter are
+    // identified by their unique IDs rather than their contents. Returns 0 if the filter can't be
+    // serialized, or once 2^31 - 1 IDs have been handed out. This is relatively expensive;
+    // SkImageFilter_Base computes it once per filter.
+    static uint32_t StructuralID(const SkImageFilter*);
+
+    // Controls whether SkImageFilter_Base keys cached results on structural IDs instead of unique
+    // IDs, for every cache. Results cached under structural keys are not purged when the filter
+    // that produced them is destroyed; they stay until evicted by the cache's byte budget. Returns
+    // the old setting.
+    static bool SetStructuralKeys(bool enabled);
+    static bool StructuralKeys();
+
+    static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
+
+    // Returns true if SkImageFilter_Base should key its results in this cache on structural IDs.
+    virtual bool usesStructuralKeys() const = 0;
+
     // Returns true on cache hit and updates 'result' to be the cached result. Returns false when
     // not in the cache, in which case 'result' is not modified.
     virtual bool get(const SkImageFilterCacheKey& key,
@@ -69,6 +106,14 @@ public:
                      const skif::FilterResult<For::kOutput>& result) = 0;
     virtual void purge() = 0;
     virtual void purgeByImageFilter(const SkImageFilter*) = 0;
+
+    virtual size_t getTotalBytesUsed() const = 0;
+    virtual size_t getByteLimit() const = 0;
+    // Returns the previous limit. Lowering the limit purges entries until the cache fits.
+    virtual size_t setByteLimit(size_t maxBytes) = 0;
+    // Appends one entry per filter type the cache has seen, with its hits, inserts and current
+    // usage. Results set without a filter are reported under the type name "unknown".
+    virtual void getStats(std::vector<Stats>* stats) const = 0;
     SkDEBUGCODE(virtual int count() const = 0;)
 };
 
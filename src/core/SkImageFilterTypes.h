@@ -13,6 +13,7 @@
 #include "src/core/SkSpecialSurface.h"
 
 class GrRecordingContext;
+class SkExecutor;
 class SkImageFilter;
 class SkImageFilterCache;
 class SkSpecialSurface;
@@ -602,17 +603,19 @@ public:
         , fCache(cache)
         , fColorType(colorType)
         , fColorSpace(colorSpace)
-        , fSource(sk_ref_sp(source), LayerSpace<SkIPoint>({0, 0})) {}
+        , fSource(sk_ref_sp(source), LayerSpace<SkIPoint>({0, 0}))
+        , fExecutor(nullptr) {}
 
     Context(const Mapping& mapping, const LayerSpace<SkIRect>& desiredOutput,
             SkImageFilterCache* cache, SkColorType colorType, SkColorSpace* colorSpace,
-            const FilterResult<For::kInput>& source)
+            const FilterResult<For::kInput>& source, SkExecutor* executor = nullptr)
         : fMapping(mapping)
         , fDesiredOutput(desiredOutput)
         , fCache(cache)
         , fColorType(colorType)
         , fColorSpace(colorSpace)
-        , fSource(source) {}
+        , fSource(source)
+        , fExecutor(executor) {}
 
     // The mapping that defines the transformation from local parameter space of the filters to the
     // layer space where the image filters are evaluated, as well as the remaining transformation
@@ -657,6 +660,11 @@ public:
     // DEPRECATED: Use source() instead to get both the image and its origin.
     const SkSpecialImage* sourceImage() const { return fSource.image(); }
 
+    // When non-null, raster filter DAGs that support it may split the desired output into tiles and
+    // evaluate them concurrently on this executor. Null means all filtering happens on the calling
+    // thread.
+    SkExecutor* executor() const { return fExecutor; }
+
     // True if image filtering should occur on the GPU if possible.
     bool gpuBacked() const { return fSource.image()->isTextureBacked(); }
     // The recording context to use when computing the filter with the GPU.
@@ -683,11 +691,18 @@ public:
 
     // Create a new context that matches this context, but with an overridden layer space.
     Context withNewMapping(const Mapping& mapping) const {
-        return Context(mapping, fDesiredOutput, fCache, fColorType, fColorSpace, fSource);
+        return Context(mapping, fDesiredOutput, fCache, fColorType, fColorSpace, fSource,
+                       fExecutor);
     }
     // Create a new context that matches this context, but with an overridden desired output rect.
     Context withNewDesiredOutput(const LayerSpace<SkIRect>& desiredOutput) const {
-        return Context(fMapping, desiredOutput, fCache, fColorType, fColorSpace, fSource);
+        return Context(fMapping, desiredOutput, fCache, fColorType, fColorSpace, fSource,
+                       fExecutor);
+    }
+    // Create a new context that matches this context, but with an overridden executor.
+    Context withNewExecutor(SkExecutor* executor) const {
+        return Context(fMapping, fDesiredOutput, fCache, fColorType, fColorSpace, fSource,
+                       executor);
     }
 
 private:
@@ -699,6 +714,8 @@ private:
     // is bounded by the device, so this can be a bare pointer.
     SkColorSpace*             fColorSpace;
     FilterResult<For::kInput> fSource;
+    // Not owned, see SkGraphics::SetImageFilterExecutor().
+    SkExecutor*               fExecutor;
 };
 
 } // end namespace skif
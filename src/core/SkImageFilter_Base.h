@@ -11,6 +11,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTArray.h"
 #include "include/private/SkTemplates.h"
 
@@ -130,6 +131,18 @@ public:
      */
     bool canHandleComplexCTM() const;
 
+    /**
+     *  Raster filtering can split the desired output into tiles and evaluate each tile's sub-DAG
+     *  independently, since every node maps the tile back to the input it requires through
+     *  onFilterNodeBounds(). This returns true iff the filter and all of its (non-null) inputs
+     *  produce identical pixels when evaluated that way.
+     */
+    bool canFilterInTiles() const;
+
+    // The executor that devices should provide to raster filter Contexts, or null if filtering
+    // should stay on the calling thread. See SkGraphics::SetImageFilterExecutor().
+    static SkExecutor* Executor();
+
     /**
      * Return an image filter representing this filter applied with the given ctm. This will modify
      * the DAG as needed if this filter does not support complex CTMs and 'ctm' is not simple. The
@@ -150,6 +163,10 @@ public:
 
     uint32_t uniqueID() const { return fUniqueID; }
 
+    // Shared by all filters with the same parameters and inputs; see
+    // SkImageFilterCache::StructuralID(). Computed on first use. Returns 0 if unavailable.
+    uint32_t structuralID() const;
+
 protected:
     class Common {
     public:
@@ -311,11 +328,14 @@ protected:
 
 private:
     friend class SkImageFilter;
-    // For PurgeCache()
+    // For PurgeCache() and SetExecutor()
     friend class SkGraphics;
 
     static void PurgeCache();
 
+    // The executor installed by SkGraphics::SetImageFilterExecutor(), returning the previous one.
+    static SkExecutor* SetExecutor(SkExecutor*);
+
     void init(sk_sp<SkImageFilter> const* inputs, int inputCount, const CropRect* cropRect);
 
     // Configuration points for the filter implementation, marked private since they should not
@@ -335,6 +355,14 @@ private:
      */
     virtual bool onCanHandleComplexCTM() const { return false; }
 
+    /**
+     *  Return true if the output of this node, restricted to any sub-rectangle of the desired
+     *  output, is identical to the same region of the output computed for the full desired
+     *  output. This holds when every output pixel depends only on input pixels within the bounds
+     *  returned by onFilterNodeBounds(kReverse), and not on where the input image's edges are.
+     */
+    virtual bool onCanFilterInTiles() const { return false; }
+
     /**
      *  Return true if this filter would transform transparent black pixels to a color other than
      *  transparent black. When false, optimizations can be taken to discard regions known to be
@@ -408,11 +436,17 @@ private:
     template<skif::Usage kU>
     skif::FilterResult<kU> filterInput(int index, const skif::Context& ctx) const;
 
+    // Splits the context's desired output into tiles, evaluates onFilterImage() for each of them on
+    // the context's executor, and stitches the results back into a single image.
+    skif::FilterResult<For::kOutput> filterImageInTiles(const skif::Context& ctx) const;
+
     SkAutoSTArray<2, sk_sp<SkImageFilter>> fInputs;
 
     bool fUsesSrcInput;
     CropRect fCropRect;
     uint32_t fUniqueID; // Globally unique
+    mutable SkOnce fStructuralIDOnce;
+    mutable uint32_t fStructuralID = 0;
 
     using INHERITED = SkImageFilter;
 };
@@ -69,6 +69,13 @@ public:
         return fMap.count();
     }
 
+    // Removes the least recently used entry, if there is one.
+    void removeLeastRecentlyUsed() {
+        if (Entry* tail = fLRU.tail()) {
+            this->remove(tail->fKey);
+        }
+    }
+
     template <typename Fn>  // f(K*, V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkLazyPicture.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "include/private/SkTo.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPicturePlayback.h"
+#include "src/core/SkTraceEvent.h"
+
+SkLazyPicture::SkLazyPicture(const SkRect& cull, std::unique_ptr<const SkPictureData> data)
+    : fCullRect(cull)
+    , fData(std::move(data))
+{
+    SkASSERT(fData && fData->opData());
+}
+
+SkLazyPicture::~SkLazyPicture() = default;
+
+void SkLazyPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    SkASSERT(canvas);
+    TRACE_EVENT0("skia", "SkLazyPicture::playback");
+
+    SkPicturePlayback playback(fData.get());
+    playback.draw(canvas, callback, nullptr);
+}
+
+int SkLazyPicture::approximateOpCount(bool) const {
+    // Counting the ops would read all of them, and sub-pictures aren't read until drawn.
+    // Every op takes at least a uint32_t, so this is an upper bound for this picture's ops.
+    return SkToInt(fData->opData()->size() / sizeof(uint32_t));
+}
+
+size_t SkLazyPicture::approximateBytesUsed() const {
+    return sizeof(*this) + sizeof(SkPictureData) + fData->opData()->size();
+}
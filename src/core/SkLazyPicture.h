@@ -0,0 +1,37 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkLazyPicture_DEFINED
+#define SkLazyPicture_DEFINED
+
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+
+#include <memory>
+
+class SkPictureData;
+
+// An SkPicture played back straight from the SkPictureData it was serialized as, which reads the
+// paths, images and sub-pictures it refers to the first time they're drawn (see
+// SkPicture::MakeLazyFromData()).
+class SkLazyPicture final : public SkPicture {
+public:
+    SkLazyPicture(const SkRect& cull, std::unique_ptr<const SkPictureData>);
+    ~SkLazyPicture() override;
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override { return fCullRect; }
+    int approximateOpCount(bool nested) const override;
+    size_t approximateBytesUsed() const override;
+
+private:
+    const SkRect                               fCullRect;
+    const std::unique_ptr<const SkPictureData> fData;
+};
+
+#endif//SkLazyPicture_DEFINED
@@ -7,6 +7,10 @@
 
 #include "src/core/SkMaskCache.h"
 
+#include "include/core/SkPath.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkPathPriv.h"
+
 #define CHECK_LOCAL(localCache, localName, globalName, ...) \
     ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
 
@@ -15,6 +19,15 @@ struct MaskValue {
     SkCachedData*   fData;
 };
 
+// Counted per thread, so that tests running in parallel don't see each other's lookups.
+static thread_local uint32_t gHits[SkMaskCache::kLast_Kind + 1];
+static thread_local uint32_t gMisses[SkMaskCache::kLast_Kind + 1];
+
+static SkCachedData* count_find(SkMaskCache::Kind kind, SkCachedData* data) {
+    (data ? gHits : gMisses)[kind]++;
+    return data;
+}
+
 namespace {
 static unsigned gRRectBlurKeyNamespaceLabel;
 
@@ -77,12 +90,12 @@ SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style,
     MaskValue result;
     RRectBlurKey key(sigma, rrect, style);
     if (!CHECK_LOCAL(localCache, find, Find, key, RRectBlurRec::Visitor, &result)) {
-        return nullptr;
+        return count_find(kRRect_Kind, nullptr);
     }
 
     *mask = result.fMask;
     mask->fImage = (uint8_t*)(result.fData->data());
-    return result.fData;
+    return count_find(kRRect_Kind, result.fData);
 }
 
 void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
@@ -169,12 +182,12 @@ SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style,
     MaskValue result;
     RectsBlurKey key(sigma, style, rects, count);
     if (!CHECK_LOCAL(localCache, find, Find, key, RectsBlurRec::Visitor, &result)) {
-        return nullptr;
+        return count_find(kRects_Kind, nullptr);
     }
 
     *mask = result.fMask;
     mask->fImage = (uint8_t*)(result.fData->data());
-    return result.fData;
+    return count_find(kRects_Kind, result.fData);
 }
 
 void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
@@ -183,3 +196,224 @@ void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
     RectsBlurKey key(sigma, style, rects, count);
     return CHECK_LOCAL(localCache, add, Add, new RectsBlurRec(key, mask, data));
 }
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gDRRectBlurKeyNamespaceLabel;
+
+struct DRRectBlurKey : public SkResourceCache::Key {
+public:
+    DRRectBlurKey(SkScalar sigma, SkBlurStyle style, const SkRRect& outer, const SkRRect& inner)
+        : fSigma(sigma)
+        , fStyle(style)
+        , fOuter(outer)
+        , fInner(inner)
+    {
+        this->init(&gDRRectBlurKeyNamespaceLabel, 0,
+                   sizeof(fSigma) + sizeof(fStyle) + sizeof(fOuter) + sizeof(fInner));
+    }
+
+    SkScalar   fSigma;
+    int32_t    fStyle;
+    SkRRect    fOuter;
+    SkRRect    fInner;
+};
+
+struct DRRectBlurRec : public SkResourceCache::Rec {
+    DRRectBlurRec(DRRectBlurKey key, const SkMask& mask, SkCachedData* data)
+        : fKey(key)
+    {
+        fValue.fMask = mask;
+        fValue.fData = data;
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~DRRectBlurRec() override {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    DRRectBlurKey  fKey;
+    MaskValue      fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+    const char* getCategory() const override { return "drrect-blur"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fValue.fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const DRRectBlurRec& rec = static_cast<const DRRectBlurRec&>(baseRec);
+        MaskValue* result = static_cast<MaskValue*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = rec.fValue;
+        return true;
+    }
+};
+} // namespace
+
+SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style,
+                                      const SkRRect& outer, const SkRRect& inner, SkMask* mask,
+                                      SkResourceCache* localCache) {
+    MaskValue result;
+    DRRectBlurKey key(sigma, style, outer, inner);
+    if (!CHECK_LOCAL(localCache, find, Find, key, DRRectBlurRec::Visitor, &result)) {
+        return count_find(kDRRect_Kind, nullptr);
+    }
+
+    *mask = result.fMask;
+    mask->fImage = (uint8_t*)(result.fData->data());
+    return count_find(kDRRect_Kind, result.fData);
+}
+
+void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
+                      const SkRRect& outer, const SkRRect& inner, const SkMask& mask,
+                      SkCachedData* data, SkResourceCache* localCache) {
+    DRRectBlurKey key(sigma, style, outer, inner);
+    return CHECK_LOCAL(localCache, add, Add, new DRRectBlurRec(key, mask, data));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gPathMaskKeyNamespaceLabel;
+
+static uint64_t make_shared_id_for_path(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('p', 'a', 't', 'h');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct PathMaskKey : public SkResourceCache::Key {
+public:
+    // Sets 'origin' to the whole pixel part of the matrix's translation, which the key leaves out.
+    PathMaskKey(const SkPath& path, const SkMatrix& matrix, const SkStrokeRec& stroke,
+                bool antiAlias, SkIPoint* origin) {
+        const SkScalar tx = SkScalarFloorToScalar(matrix.getTranslateX()),
+                       ty = SkScalarFloorToScalar(matrix.getTranslateY());
+        origin->set(SkScalarFloorToInt(tx), SkScalarFloorToInt(ty));
+
+        fMatrix[0] = matrix.getScaleX();
+        fMatrix[1] = matrix.getSkewX();
+        fMatrix[2] = matrix.getSkewY();
+        fMatrix[3] = matrix.getScaleY();
+        fMatrix[4] = matrix.getTranslateX() - tx;
+        fMatrix[5] = matrix.getTranslateY() - ty;
+
+        // The stroke's resolution scale follows from the matrix.
+        const SkStrokeRec::Style style = stroke.getStyle();
+        const bool stroked = style == SkStrokeRec::kStroke_Style ||
+                             style == SkStrokeRec::kStrokeAndFill_Style;
+        fStrokeWidth = stroked ? stroke.getWidth() : 0;
+        fMiterLimit  = stroked ? stroke.getMiter() : 0;
+        fFlags = (uint32_t)path.getFillType()
+               | (uint32_t)style << 4
+               | (uint32_t)(style == SkStrokeRec::kFill_Style ? 0 : stroke.getCap())  << 8
+               | (uint32_t)(stroked ? stroke.getJoin() : 0) << 12
+               | (uint32_t)antiAlias << 16;
+
+        this->init(&gPathMaskKeyNamespaceLabel, make_shared_id_for_path(path.getGenerationID()),
+                   sizeof(fMatrix) + sizeof(fStrokeWidth) + sizeof(fMiterLimit) + sizeof(fFlags));
+    }
+
+    SkScalar   fMatrix[6];
+    SkScalar   fStrokeWidth;
+    SkScalar   fMiterLimit;
+    uint32_t   fFlags;
+};
+
+// Purges a path's masks when its generation ID changes.
+class PathMaskPurgeListener : public SkIDChangeListener {
+public:
+    explicit PathMaskPurgeListener(uint32_t pathGenID) : fGenID(pathGenID) {}
+
+    void changed() override {
+        SkResourceCache::PostPurgeSharedID(make_shared_id_for_path(fGenID));
+    }
+
+private:
+    uint32_t fGenID;
+};
+
+struct PathMaskRec : public SkResourceCache::Rec {
+    PathMaskRec(PathMaskKey key, const SkMask& mask, SkCachedData* data,
+                sk_sp<SkIDChangeListener> listener)
+        : fKey(key)
+        , fListener(std::move(listener))
+    {
+        fValue.fMask = mask;
+        fValue.fData = data;
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~PathMaskRec() override {
+        fValue.fData->detachFromCacheAndUnref();
+        fListener->markShouldDeregister();
+    }
+
+    PathMaskKey               fKey;
+    MaskValue                 fValue;
+    sk_sp<SkIDChangeListener> fListener;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+    const char* getCategory() const override { return "path-mask"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fValue.fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PathMaskRec& rec = static_cast<const PathMaskRec&>(baseRec);
+        MaskValue* result = static_cast<MaskValue*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = rec.fValue;
+        return true;
+    }
+};
+} // namespace
+
+SkCachedData* SkMaskCache::FindAndRef(const SkPath& path, const SkMatrix& matrix,
+                                      const SkStrokeRec& stroke, bool antiAlias, SkMask* mask,
+                                      SkResourceCache* localCache) {
+    MaskValue result;
+    SkIPoint origin;
+    PathMaskKey key(path, matrix, stroke, antiAlias, &origin);
+    if (!CHECK_LOCAL(localCache, find, Find, key, PathMaskRec::Visitor, &result)) {
+        return count_find(kPath_Kind, nullptr);
+    }
+
+    *mask = result.fMask;
+    mask->fBounds.offset(origin);
+    mask->fImage = (uint8_t*)(result.fData->data());
+    return count_find(kPath_Kind, result.fData);
+}
+
+void SkMaskCache::Add(const SkPath& path, const SkMatrix& matrix, const SkStrokeRec& stroke,
+                      bool antiAlias, const SkMask& mask, SkCachedData* data,
+                      SkResourceCache* localCache) {
+    SkIPoint origin;
+    PathMaskKey key(path, matrix, stroke, antiAlias, &origin);
+    SkMask relativeMask = mask;
+    relativeMask.fBounds.offset(-origin.fX, -origin.fY);
+
+    auto listener = sk_make_sp<PathMaskPurgeListener>(path.getGenerationID());
+    SkPathPriv::AddGenIDChangeListener(path, listener);
+    return CHECK_LOCAL(localCache, add, Add,
+                       new PathMaskRec(key, relativeMask, data, std::move(listener)));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+SkMaskCache::Stats SkMaskCache::GetStats(Kind kind) {
+    return { gHits[kind], gMisses[kind] };
+}
@@ -11,6 +11,7 @@
 #include "include/core/SkBlurTypes.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkStrokeRec.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkResourceCache.h"
@@ -29,6 +30,9 @@ public:
     static SkCachedData* FindAndRef(SkScalar sigma, SkBlurStyle style,
                                     const SkRect rects[], int count, SkMask* mask,
                                     SkResourceCache* localCache = nullptr);
+    static SkCachedData* FindAndRef(SkScalar sigma, SkBlurStyle style,
+                                    const SkRRect& outer, const SkRRect& inner, SkMask* mask,
+                                    SkResourceCache* localCache = nullptr);
 
     /**
      * Add a mask and its pixel-data to the cache.
@@ -39,6 +43,45 @@ public:
     static void Add(SkScalar sigma, SkBlurStyle style,
                     const SkRect rects[], int count, const SkMask& mask, SkCachedData* data,
                     SkResourceCache* localCache = nullptr);
+    static void Add(SkScalar sigma, SkBlurStyle style,
+                    const SkRRect& outer, const SkRRect& inner, const SkMask& mask,
+                    SkCachedData* data, SkResourceCache* localCache = nullptr);
+
+    /**
+     * Coverage masks of paths, keyed by the path's generation ID and fill type, the matrix apart
+     * from the whole pixel part of its translation, the stroke, and anti-aliasing. A path drawn
+     * again with a translation that differs by whole pixels finds the same mask, with its bounds
+     * moved to match. Callers that want nearby subpixel translations to share masks should round
+     * the translation themselves, and draw the mask with that rounded matrix.
+     *
+     * Masks are purged when the path's generation ID changes, or the path is deleted.
+     */
+    static SkCachedData* FindAndRef(const SkPath& path, const SkMatrix& matrix,
+                                    const SkStrokeRec& stroke, bool antiAlias, SkMask* mask,
+                                    SkResourceCache* localCache = nullptr);
+    static void Add(const SkPath& path, const SkMatrix& matrix, const SkStrokeRec& stroke,
+                    bool antiAlias, const SkMask& mask, SkCachedData* data,
+                    SkResourceCache* localCache = nullptr);
+
+    enum Kind {
+        kRRect_Kind,
+        kRects_Kind,
+        kDRRect_Kind,
+        kPath_Kind,
+
+        kLast_Kind = kPath_Kind
+    };
+
+    struct Stats {
+        uint32_t fHits;
+        uint32_t fMisses;
+    };
+
+    /**
+     * Returns how many FindAndRef() calls on this thread for the given kind of mask found (or
+     * didn't find) a cached mask. Compare two snapshots to count the lookups in between.
+     */
+    static Stats GetStats(Kind);
 };
 
 #endif
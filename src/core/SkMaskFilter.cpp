@@ -17,12 +17,12 @@
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkSDFMaskFilter.h"
 #include "src/core/SkWriteBuffer.h"
 
 #if SK_SUPPORT_GPU
 #include "src/gpu/GrFragmentProcessor.h"
 #include "src/gpu/GrTextureProxy.h"
-#include "src/gpu/text/GrSDFMaskFilter.h"
 #endif
 
 SkMaskFilterBase::NinePatch::~NinePatch() {
@@ -216,17 +216,36 @@ static int countNestedRects(const SkPath& path, SkRect rects[2]) {
 bool SkMaskFilterBase::filterRRect(const SkRRect& devRRect, const SkMatrix& matrix,
                                    const SkRasterClip& clip, SkBlitter* blitter) const {
     // Attempt to speed up drawing by creating a nine patch. If a nine patch
-    // cannot be used, return false to allow our caller to recover and perform
-    // the drawing another way.
+    // cannot be used, try computing the coverage directly, and failing that
+    // return false to allow our caller to recover and perform the drawing
+    // another way.
     NinePatch patch;
     patch.fMask.fImage = nullptr;
-    if (kTrue_FilterReturn != this->filterRRectToNine(devRRect, matrix,
-                                                      clip.getBounds(),
-                                                      &patch)) {
+    switch (this->filterRRectToNine(devRRect, matrix, clip.getBounds(), &patch)) {
+        case kFalse_FilterReturn:
+            SkASSERT(nullptr == patch.fMask.fImage);
+            return false;
+        case kTrue_FilterReturn:
+            break;
+        case kUnimplemented_FilterReturn:
+            SkASSERT(nullptr == patch.fMask.fImage);
+            return kTrue_FilterReturn == this->filterRRectDirect(devRRect, matrix, clip, blitter);
+    }
+    draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, true, clip, blitter);
+    return true;
+}
+
+bool SkMaskFilterBase::filterDRRect(const SkRRect& devOuter, const SkRRect& devInner,
+                                    const SkMatrix& matrix, const SkRasterClip& clip,
+                                    SkBlitter* blitter) const {
+    NinePatch patch;
+    patch.fMask.fImage = nullptr;
+    if (kTrue_FilterReturn != this->filterDRRectToNine(devOuter, devInner, matrix,
+                                                       clip.getBounds(), &patch)) {
         SkASSERT(nullptr == patch.fMask.fImage);
         return false;
     }
-    draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, true, clip, blitter);
+    draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, false, clip, blitter);
     return true;
 }
 
@@ -300,6 +319,18 @@ SkMaskFilterBase::filterRRectToNine(const SkRRect&, const SkMatrix&,
     return kUnimplemented_FilterReturn;
 }
 
+SkMaskFilterBase::FilterReturn
+SkMaskFilterBase::filterDRRectToNine(const SkRRect&, const SkRRect&, const SkMatrix&,
+                                     const SkIRect& clipBounds, NinePatch*) const {
+    return kUnimplemented_FilterReturn;
+}
+
+SkMaskFilterBase::FilterReturn
+SkMaskFilterBase::filterRRectDirect(const SkRRect&, const SkMatrix&, const SkRasterClip&,
+                                    SkBlitter*) const {
+    return kUnimplemented_FilterReturn;
+}
+
 SkMaskFilterBase::FilterReturn
 SkMaskFilterBase::filterRectsToNine(const SkRect[], int count, const SkMatrix&,
                                     const SkIRect& clipBounds, NinePatch*) const {
@@ -371,7 +402,5 @@ void SkMaskFilterBase::computeFastBounds(const SkRect& src, SkRect* dst) const {
 
 void SkMaskFilter::RegisterFlattenables() {
     sk_register_blur_maskfilter_createproc();
-#if SK_SUPPORT_GPU
-    gr_register_sdf_maskfilter_createproc();
-#endif
+    sk_register_sdf_maskfilter_createproc();
 }
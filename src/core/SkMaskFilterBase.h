@@ -209,6 +209,21 @@ protected:
     virtual FilterReturn filterRRectToNine(const SkRRect&, const SkMatrix&,
                                            const SkIRect& clipBounds,
                                            NinePatch*) const;
+    /**
+     *  Similar to filterRectsToNine, except it performs the work on the region between two
+     *  nested round rects. The center of the returned mask is not drawn.
+     */
+    virtual FilterReturn filterDRRectToNine(const SkRRect& outer, const SkRRect& inner,
+                                            const SkMatrix&, const SkIRect& clipBounds,
+                                            NinePatch*) const;
+    /**
+     *  Override if your subclass can compute the filtered coverage of a device space round rect
+     *  directly, without rendering a mask first. This is tried when filterRRectToNine() returns
+     *  kUnimplemented_FilterReturn. On success, blit the coverage through the blitter
+     *  (respecting the clip) and return kTrue_FilterReturn.
+     */
+    virtual FilterReturn filterRRectDirect(const SkRRect& devRRect, const SkMatrix&,
+                                           const SkRasterClip&, SkBlitter*) const;
 
 private:
     friend class SkDraw;
@@ -228,6 +243,13 @@ private:
     bool filterRRect(const SkRRect& devRRect, const SkMatrix& ctm, const SkRasterClip&,
                      SkBlitter*) const;
 
+    /** Helper method that, given two nested roundRects in device space, will draw the filtered
+     region between them as a nine patch. Returns false if that isn't possible, in which case
+     the caller should draw them as a path.
+     */
+    bool filterDRRect(const SkRRect& devOuter, const SkRRect& devInner, const SkMatrix& ctm,
+                      const SkRasterClip&, SkBlitter*) const;
+
     using INHERITED = SkFlattenable;
 };
 
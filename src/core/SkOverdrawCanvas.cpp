@@ -61,6 +61,16 @@ public:
         }
     }
 
+    void paintSDFs(SkDrawableGlyphBuffer* drawables, SkScalar scale, SkPoint origin,
+                   const SkPaint&) const override {
+        for (auto [variant, pos] : drawables->drawable()) {
+            const SkGlyph* glyph = variant.glyph();
+            SkRect rect = SkRect::MakeXYWH(glyph->left() * scale, glyph->top() * scale,
+                                           glyph->width() * scale, glyph->height() * scale);
+            fOverdrawCanvas->drawRect(rect.makeOffset(origin + pos), SkPaint());
+        }
+    }
+
 protected:
     void drawGlyphRunList(const SkGlyphRunList& glyphRunList) override {
         fPainter.drawForBitmapDevice(glyphRunList, fOverdrawCanvas->getTotalMatrix(), this);
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPackedPath.h"
+
+#include "include/private/SkMalloc.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkPathPriv.h"
+
+#include <cmath>
+#include <new>
+
+static constexpr int kQuantizedSteps = 65535;
+
+static uint16_t quantize(SkScalar value, SkScalar origin, SkScalar extent) {
+    if (extent <= 0) {
+        return 0;
+    }
+    double q = std::round(((double)value - origin) * kQuantizedSteps / extent);
+    return (uint16_t)std::min(std::max(q, 0.0), (double)kQuantizedSteps);
+}
+
+sk_sp<SkPackedPath> SkPackedPath::Make(const SkPath& path, Precision precision) {
+    if (!path.isFinite()) {
+        precision = Precision::kFloat;
+    }
+    const int pointCount = path.countPoints(),
+              verbCount = path.countVerbs(),
+              weightCount = SkPathPriv::ConicWeightCnt(path);
+    const size_t pointSize = Precision::kQuantized16 == precision ? 2 * sizeof(uint16_t)
+                                                                  : sizeof(SkPoint);
+    const size_t size = sizeof(SkPackedPath) + pointCount * pointSize
+                      + weightCount * sizeof(SkScalar) + verbCount;
+
+    SkPackedPath* packed = new (sk_malloc_throw(size)) SkPackedPath;
+    packed->fBounds = path.getBounds();
+    packed->fOrigin = {packed->fBounds.fLeft, packed->fBounds.fTop};
+    packed->fStep = {packed->fBounds.width() / kQuantizedSteps,
+                     packed->fBounds.height() / kQuantizedSteps};
+    packed->fPointCount = pointCount;
+    packed->fVerbCount = verbCount;
+    packed->fWeightCount = weightCount;
+    packed->fFillType = path.getFillType();
+    packed->fConvexity = SkPathConvexity::kUnknown;
+    packed->fSegmentMask = SkToU8(path.getSegmentMasks());
+    packed->fPrecision = precision;
+    packed->fIsFinite = path.isFinite();
+
+    const SkPoint* pts = SkPathPriv::PointData(path);
+    if (Precision::kQuantized16 == precision) {
+        uint16_t* dst = const_cast<uint16_t*>(packed->quantizedPoints());
+        for (int i = 0; i < pointCount; ++i) {
+            *dst++ = quantize(pts[i].fX, packed->fBounds.fLeft, packed->fBounds.width());
+            *dst++ = quantize(pts[i].fY, packed->fBounds.fTop, packed->fBounds.height());
+        }
+    } else {
+        sk_careful_memcpy(const_cast<SkPoint*>(packed->floatPoints()), pts,
+                          pointCount * sizeof(SkPoint));
+    }
+    sk_careful_memcpy(const_cast<SkScalar*>(packed->weights()),
+                      SkPathPriv::ConicWeightData(path), weightCount * sizeof(SkScalar));
+    sk_careful_memcpy(const_cast<uint8_t*>(packed->verbs()), SkPathPriv::VerbData(path),
+                      verbCount);
+
+    if (Precision::kQuantized16 == precision) {
+        // Quantizing moves the points, so the bounds and convexity come from the decoded path.
+        SkPath decoded = packed->toPath();
+        packed->fBounds = decoded.getBounds();
+        packed->fConvexity = SkPathPriv::GetConvexity(decoded);
+    } else {
+        packed->fConvexity = SkPathPriv::GetConvexity(path);
+    }
+    return sk_sp<SkPackedPath>(packed);
+}
+
+size_t SkPackedPath::pointBytes() const {
+    return fPointCount * (Precision::kQuantized16 == fPrecision ? 2 * sizeof(uint16_t)
+                                                                : sizeof(SkPoint));
+}
+
+size_t SkPackedPath::approximateBytesUsed() const {
+    return sizeof(SkPackedPath) + this->pointBytes() + fWeightCount * sizeof(SkScalar)
+         + fVerbCount;
+}
+
+void SkPackedPath::getPoints(SkPoint dst[]) const {
+    if (Precision::kQuantized16 == fPrecision) {
+        const uint16_t* src = this->quantizedPoints();
+        for (int i = 0; i < fPointCount; ++i, src += 2) {
+            dst[i] = {fOrigin.fX + src[0] * fStep.fX, fOrigin.fY + src[1] * fStep.fY};
+        }
+    } else {
+        sk_careful_memcpy(dst, this->floatPoints(), fPointCount * sizeof(SkPoint));
+    }
+}
+
+SkPath SkPackedPath::toPath() const {
+    SkPath path;
+    if (Precision::kQuantized16 == fPrecision) {
+        SkAutoSTMalloc<32, SkPoint> pts(fPointCount);
+        this->getPoints(pts.get());
+        path = SkPath::Make(pts.get(), fPointCount, this->verbs(), fVerbCount, this->weights(),
+                            fWeightCount, fFillType);
+    } else {
+        path = SkPath::Make(this->floatPoints(), fPointCount, this->verbs(), fVerbCount,
+                            this->weights(), fWeightCount, fFillType);
+    }
+    if (fConvexity != SkPathConvexity::kUnknown) {
+        SkPathPriv::SetConvexity(path, fConvexity);
+    }
+    return path;
+}
+
+SkPathView SkPackedPath::view(SkTDArray<SkPoint>* storage) const {
+    const SkPoint* pts = this->floatPoints();
+    if (Precision::kQuantized16 == fPrecision) {
+        storage->setCount(fPointCount);
+        this->getPoints(storage->begin());
+        pts = storage->begin();
+    }
+    return SkPathView({pts, SkToSizeT(fPointCount)}, {this->verbs(), SkToSizeT(fVerbCount)},
+                      {this->weights(), SkToSizeT(fWeightCount)}, fFillType, fConvexity, fBounds,
+                      fSegmentMask, fIsFinite);
+}
+
+void SkPackedPath::operator delete(void* p) {
+    sk_free(p);
+}
+
+void* SkPackedPath::operator new(size_t) {
+    SK_ABORT("All packed paths are created by placement new.");
+}
+
+void* SkPackedPath::operator new(size_t, void* p) {
+    return p;
+}
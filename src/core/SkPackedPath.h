@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPackedPath_DEFINED
+#define SkPackedPath_DEFINED
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/SkTDArray.h"
+#include "src/core/SkPathView.h"
+
+/**
+ *  An immutable path stored in a single allocation: the header, then the points, conic weights
+ *  and verbs, with no growth slack. This is meant for holding very many small paths, e.g. the
+ *  contents of map tiles, where SkPath's three separately allocated arrays and SkPathRef's
+ *  bookkeeping cost more than the geometry itself.
+ *
+ *  Points may be quantized to 16 bits per coordinate, relative to the path's bounds. That
+ *  halves their size, at the cost of moving each point by up to 1/131070 of the bounds' width
+ *  or height.
+ */
+class SkPackedPath : public SkNVRefCnt<SkPackedPath> {
+public:
+    enum class Precision : uint8_t {
+        kFloat,
+        kQuantized16,
+    };
+
+    /**
+     *  Packs the path. Non-finite paths can't be quantized, and are always stored as floats.
+     */
+    static sk_sp<SkPackedPath> Make(const SkPath&, Precision = Precision::kFloat);
+
+    /** Returns a new SkPath with the (decoded) points, verbs, weights and fill type. */
+    SkPath toPath() const;
+
+    /**
+     *  Returns a view of the path, for drawing or iterating. Quantized points are decoded into
+     *  'storage', which must outlive the view; float points are viewed in place.
+     */
+    SkPathView view(SkTDArray<SkPoint>* storage) const;
+
+    /** Copies the points, decoding them if they're quantized. */
+    void getPoints(SkPoint dst[]) const;
+
+    const SkRect& getBounds() const { return fBounds; }
+    SkPathFillType getFillType() const { return fFillType; }
+    Precision precision() const { return fPrecision; }
+    int countPoints() const { return fPointCount; }
+    int countVerbs() const { return fVerbCount; }
+
+    /** Returns the size of the single allocation holding the path. */
+    size_t approximateBytesUsed() const;
+
+    // Memory for objects of this class is created with sk_malloc rather than operator new and must
+    // be freed with sk_free.
+    void operator delete(void* p);
+    void* operator new(size_t);
+    void* operator new(size_t, void* p);
+
+private:
+    SkPackedPath() = default;
+
+    const SkPoint* floatPoints() const { return reinterpret_cast<const SkPoint*>(this + 1); }
+    const uint16_t* quantizedPoints() const { return reinterpret_cast<const uint16_t*>(this + 1); }
+    size_t pointBytes() const;
+    const SkScalar* weights() const {
+        return reinterpret_cast<const SkScalar*>(reinterpret_cast<const char*>(this + 1)
+                                                 + this->pointBytes());
+    }
+    const uint8_t* verbs() const {
+        return reinterpret_cast<const uint8_t*>(this->weights() + fWeightCount);
+    }
+
+    SkRect          fBounds;
+    SkPoint         fOrigin;  // quantized points are fOrigin + q * fStep
+    SkPoint         fStep;
+    int32_t         fPointCount;
+    int32_t         fVerbCount;
+    int32_t         fWeightCount;
+    SkPathFillType  fFillType;
+    SkPathConvexity fConvexity;
+    uint8_t         fSegmentMask;
+    Precision       fPrecision;
+    bool            fIsFinite;
+
+    // The points, weights and verbs follow.
+};
+
+#endif
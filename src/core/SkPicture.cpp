@@ -12,6 +12,7 @@
 #include "include/core/SkSerialProcs.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkCanvasPriv.h"
+#include "src/core/SkLazyPicture.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkPictureCommon.h"
 #include "src/core/SkPictureData.h"
@@ -148,6 +149,10 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeLazyFromData(sk_sp<SkData> data, const SkDeserialProcs* procs) {
+    return SkPicturePriv::MakeLazy(std::move(data), procs ? *procs : SkDeserialProcs());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
                                            SkTypefacePlayback* typefaces) {
     SkPictInfo info;
@@ -209,6 +214,35 @@ sk_sp<SkPicture> SkPicturePriv::MakeFromBuffer(SkReadBuffer& buffer) {
     return SkPicture::Forwardport(info, data.get(), &buffer);
 }
 
+sk_sp<SkPicture> SkPicturePriv::MakeLazy(sk_sp<SkData> data, const SkDeserialProcs& procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    SkPictInfo info;
+    if (!SkPicture::StreamIsSKP(&stream, &info)) {
+        return nullptr;
+    }
+
+    uint8_t trailingStreamByteAfterPictInfo;
+    if (!stream.readU8(&trailingStreamByteAfterPictInfo)) { return nullptr; }
+    if (trailingStreamByteAfterPictInfo != kPictureData_TrailingStreamByteAfterPictInfo) {
+        // There's nothing to read lazily in custom pictures.
+        stream.rewind();
+        return SkPicture::MakeFromStream(&stream, &procs, nullptr);
+    }
+
+    std::unique_ptr<const SkPictureData> pictureData(
+            SkPictureData::CreateLazy(std::move(data), stream.getPosition(), info, procs));
+    if (!pictureData) {
+        return nullptr;
+    }
+    if (!pictureData->isLazy()) {
+        return SkPicture::Forwardport(info, pictureData.get(), nullptr);
+    }
+    return sk_make_sp<SkLazyPicture>(info.fCullRect, std::move(pictureData));
+}
+
 SkPictureData* SkPicture::backport() const {
     SkPictInfo info = this->createHeader();
     SkPictureRecord rec(info.fCullRect.roundOut(), 0/*flags*/);
@@ -18,6 +18,7 @@
 #include "src/core/SkVerticesPriv.h"
 #include "src/core/SkWriteBuffer.h"
 
+#include <algorithm>
 #include <new>
 
 template <typename T> int SafeCount(const T* obj) {
@@ -140,9 +141,31 @@ void SkPictureData::WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec,
     }
 }
 
-void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer, bool textBlobsOnly) const {
+void SkPictureData::WriteOffsets(SkWStream* stream, const Offsets& offsets) {
+    const SkTDArray<uint32_t>* arrays[] = {&offsets.fPaths, &offsets.fImages, &offsets.fPictures};
+    size_t size = 0;
+    for (const SkTDArray<uint32_t>* array : arrays) {
+        size += sizeof(uint32_t) * (1 + array->count());
+    }
+
+    write_tag_size(stream, SK_PICT_OFFSETS_TAG, size);
+    for (const SkTDArray<uint32_t>* array : arrays) {
+        stream->write32(array->count());
+        stream->write(array->begin(), array->bytes());
+    }
+}
+
+void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer, bool textBlobsOnly,
+                                    Offsets* offsets) const {
     int i, n;
 
+    // Offsets are only asked for by serialize(), which flattens to an SkBinaryWriteBuffer.
+    auto recordOffset = [&buffer](SkTDArray<uint32_t>* array) {
+        if (array) {
+            array->push_back(SkToU32(static_cast<SkBinaryWriteBuffer&>(buffer).bytesWritten()));
+        }
+    };
+
     if (!textBlobsOnly) {
         if ((n = fPaints.count()) > 0) {
             write_tag_size(buffer, SK_PICT_PAINT_BUFFER_TAG, n);
@@ -155,8 +178,10 @@ void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer, bool textBlobsOnly) c
             write_tag_size(buffer, SK_PICT_PATH_BUFFER_TAG, n);
             buffer.writeInt(n);
             for (int i = 0; i < n; i++) {
+                recordOffset(offsets ? &offsets->fPaths : nullptr);
                 buffer.writePath(fPaths[i]);
             }
+            recordOffset(offsets ? &offsets->fPaths : nullptr);
         }
     }
 
@@ -178,8 +203,10 @@ void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer, bool textBlobsOnly) c
         if (!fImages.empty()) {
             write_tag_size(buffer, SK_PICT_IMAGE_BUFFER_TAG, fImages.count());
             for (const auto& img : fImages) {
+                recordOffset(offsets ? &offsets->fImages : nullptr);
                 buffer.writeImage(img.get());
             }
+            recordOffset(offsets ? &offsets->fImages : nullptr);
         }
     }
 }
@@ -218,7 +245,8 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     buffer.setFactoryRecorder(sk_ref_sp(&factSet));
     buffer.setSerialProcs(skip_typeface_proc(procs));
     buffer.setTypefaceRecorder(sk_ref_sp(typefaceSet));
-    this->flattenToBuffer(buffer, textBlobsOnly);
+    Offsets offsets;
+    this->flattenToBuffer(buffer, textBlobsOnly, &offsets);
 
     // Pretend to serialize our sub-pictures for the side effect of filling typefaceSet
     // with typefaces from sub-pictures.
@@ -233,6 +261,17 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     }
     if (textBlobsOnly) { return; } // return early from fake serialize
 
+    // Serialize sub-pictures by calling serialize again, into memory first so the offset table
+    // can say where each one starts.
+    SkDynamicMemoryWStream pictures;
+    for (const auto& pic : fPictures) {
+        offsets.fPictures.push_back(SkToU32(pictures.bytesWritten()));
+        pic->serialize(&pictures, &procs, typefaceSet, /*textBlobsOnly=*/ false);
+    }
+    if (!fPictures.empty()) {
+        offsets.fPictures.push_back(SkToU32(pictures.bytesWritten()));
+    }
+
     // We need to write factories before we write the buffer.
     // We need to write typefaces before we write the buffer or any sub-picture.
     WriteFactories(stream, factSet);
@@ -240,17 +279,17 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     // typefaces. We skipped this proc before, when we were serializing paints, so that the
     // paints would just write indices into our typeface set.
     WriteTypefaces(stream, *typefaceSet, procs);
+    // The offset table goes before everything it points into.
+    WriteOffsets(stream, offsets);
 
     // Write the buffer.
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
     buffer.writeToStream(stream);
 
-    // Write sub-pictures by calling serialize again.
+    // Write sub-pictures.
     if (!fPictures.empty()) {
         write_tag_size(stream, SK_PICT_PICTURE_TAG, fPictures.count());
-        for (const auto& pic : fPictures) {
-            pic->serialize(stream, &procs, typefaceSet, /*textBlobsOnly=*/ false);
-        }
+        pictures.writeToAndReset(stream);
     }
 
     stream->write32(SK_PICT_EOF_TAG);
@@ -295,7 +334,9 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
             break;
         case SK_PICT_FACTORY_TAG: {
-            if (!stream->readU32(&size)) { return false; }
+            // Each factory name takes at least a byte of the tag's size.
+            const uint32_t bytes = size;
+            if (!stream->readU32(&size) || size > bytes) { return false; }
             fFactoryPlayback = std::make_unique<SkFactoryPlayback>(size);
             for (size_t i = 0; i < size; i++) {
                 SkString str;
@@ -325,6 +366,12 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                 fTFPlayback[i] = std::move(tf);
             }
         } break;
+        case SK_PICT_OFFSETS_TAG:
+            // Only needed to read lazily.
+            if (stream->skip(size) != size) {
+                return false;
+            }
+            break;
         case SK_PICT_PICTURE_TAG: {
             SkASSERT(fPictures.empty());
             fPictures.reserve(SkToInt(size));
@@ -532,6 +579,274 @@ bool SkPictureData::parseBuffer(SkReadBuffer& buffer) {
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// SkReadBuffer needs 4-byte aligned memory, which the serialized picture doesn't promise.
+static sk_sp<SkData> aligned_subset(const SkData* data, size_t offset, size_t size) {
+    sk_sp<SkData> subset = SkData::MakeSubset(data, offset, size);
+    if (subset && !SkIsAlign4(reinterpret_cast<uintptr_t>(subset->data()))) {
+        subset = SkData::MakeWithCopy(subset->data(), subset->size());
+    }
+    return subset;
+}
+
+// Reads one array of the offset table: none, or one more offset than there are entries, all of
+// them in order and at most end.
+static bool read_offsets(SkStream* stream, uint32_t* size, uint32_t end,
+                         SkTDArray<uint32_t>* offsets) {
+    uint32_t count;
+    if (*size < sizeof(count) || !stream->readU32(&count) ||
+        count == 1 || count > (*size - sizeof(count)) / sizeof(uint32_t)) {
+        return false;
+    }
+    *size -= sizeof(count) + count * sizeof(uint32_t);
+    offsets->setCount(count);
+    if (stream->read(offsets->begin(), offsets->bytes()) != offsets->bytes()) {
+        return false;
+    }
+    for (int i = 0; i < offsets->count(); ++i) {
+        if ((*offsets)[i] > end || (i > 0 && (*offsets)[i] < (*offsets)[i - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SkPictureData* SkPictureData::CreateLazy(sk_sp<SkData> data, size_t offset,
+                                         const SkPictInfo& info,
+                                         const SkDeserialProcs& procs) {
+    std::unique_ptr<SkPictureData> pictureData(new SkPictureData(info));
+    pictureData->fLazy = std::make_unique<Lazy>();
+    pictureData->fLazy->fData = std::move(data);
+    pictureData->fLazy->fProcs = procs;
+
+    if (!pictureData->parseLazily(offset)) {
+        return nullptr;
+    }
+    return pictureData.release();
+}
+
+bool SkPictureData::parseLazily(size_t offset) {
+    const SkData* data = fLazy->fData.get();
+    SkMemoryStream stream(fLazy->fData);
+    if (offset > data->size() || !stream.seek(offset)) {
+        return false;
+    }
+
+    // Without an offset table (from before V80), everything is read now, as by parseStream().
+    bool hasOffsets = false;
+    for (;;) {
+        uint32_t tag;
+        if (!stream.readU32(&tag)) { return false; }
+        if (SK_PICT_EOF_TAG == tag) {
+            break;
+        }
+
+        // Every tag's size is a size in bytes, or a count of things that take at least a byte.
+        uint32_t size;
+        if (!stream.readU32(&size)) { return false; }
+        const size_t position = stream.getPosition();
+        if (size > data->size() - position) {
+            return false;
+        }
+        switch (tag) {
+            case SK_PICT_READER_TAG:
+                if (fOpData) {
+                    return false;
+                }
+                fOpData = aligned_subset(data, position, size);
+                stream.skip(size);
+                break;
+            case SK_PICT_OFFSETS_TAG: {
+                uint32_t remaining = size;
+                const uint32_t maxOffset = SkToU32(std::min<size_t>(data->size() - position,
+                                                                    UINT32_MAX));
+                if (hasOffsets ||
+                    !read_offsets(&stream, &remaining, maxOffset, &fLazy->fOffsets.fPaths) ||
+                    !read_offsets(&stream, &remaining, maxOffset, &fLazy->fOffsets.fImages) ||
+                    !read_offsets(&stream, &remaining, maxOffset, &fLazy->fOffsets.fPictures) ||
+                    remaining != 0) {
+                    return false;
+                }
+                hasOffsets = true;
+            } break;
+            case SK_PICT_BUFFER_SIZE_TAG:
+                if (!hasOffsets) {
+                    if (!this->parseStreamTag(&stream, tag, size, fLazy->fProcs, &fTFPlayback)) {
+                        return false;
+                    }
+                    break;
+                }
+                if (stream.skip(size) != size || !this->parseLazyBuffer(position, size)) {
+                    return false;
+                }
+                break;
+            case SK_PICT_PICTURE_TAG: {
+                if (!hasOffsets) {
+                    if (!this->parseStreamTag(&stream, tag, size, fLazy->fProcs, &fTFPlayback)) {
+                        return false;
+                    }
+                    break;
+                }
+                SkTDArray<uint32_t>& offsets = fLazy->fOffsets.fPictures;
+                if (!fPictures.empty() || offsets.count() != SkToInt(size) + 1 || size == 0 ||
+                    stream.skip(offsets.back()) != offsets.back()) {
+                    return false;
+                }
+                for (uint32_t& pictureOffset : offsets) {
+                    pictureOffset += SkToU32(position);
+                }
+                fPictures.push_back_n(size);
+                fLazy->fPictureOnce.reset(new SkOnce[size]);
+            } break;
+            default:
+                if (!this->parseStreamTag(&stream, tag, size, fLazy->fProcs, &fTFPlayback)) {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    if (!fOpData) {
+        return false;
+    }
+    if (!hasOffsets) {
+        fLazy = nullptr;
+        this->initForPlayback();
+    }
+    return true;
+}
+
+bool SkPictureData::parseLazyBuffer(size_t offset, size_t size) {
+    // The paths and images are left in place, and everything else is read now, from a copy of
+    // the buffer without them.
+    SkTDArray<uint32_t>& pathOffsets  = fLazy->fOffsets.fPaths;
+    SkTDArray<uint32_t>& imageOffsets = fLazy->fOffsets.fImages;
+    struct Range { uint32_t fStart, fEnd; };
+    SkSTArray<2, Range, true> skipped;
+    for (const SkTDArray<uint32_t>* offsets : {&pathOffsets, &imageOffsets}) {
+        if (!offsets->empty()) {
+            if (offsets->back() > size) {
+                return false;
+            }
+            skipped.push_back({(*offsets)[0], offsets->back()});
+        }
+    }
+    if (skipped.count() == 2) {
+        if (skipped[1].fStart < skipped[0].fStart) {
+            std::swap(skipped[0], skipped[1]);
+        }
+        if (skipped[0].fEnd > skipped[1].fStart) {
+            return false;
+        }
+    }
+
+    const uint8_t* bytes = fLazy->fData->bytes() + offset;
+    SkAutoMalloc storage(size);
+    uint8_t* copy = static_cast<uint8_t*>(storage.get());
+    size_t copied = 0, start = 0;
+    for (const Range& range : skipped) {
+        memcpy(copy + copied, bytes + start, range.fStart - start);
+        copied += range.fStart - start;
+        start = range.fEnd;
+    }
+    memcpy(copy + copied, bytes + start, size - start);
+    copied += size - start;
+
+    SkReadBuffer buffer(copy, copied);
+    buffer.setVersion(fInfo.getVersion());
+    if (!fFactoryPlayback) {
+        return false;
+    }
+    this->setupLazyBuffer(buffer);
+
+    while (!buffer.eof() && buffer.isValid()) {
+        uint32_t tag = buffer.readUInt();
+        uint32_t tagSize = buffer.readUInt();
+        switch (tag) {
+            case SK_PICT_PATH_BUFFER_TAG: {
+                const int count = pathOffsets.count() - 1;
+                if (buffer.validate(fPaths.empty() && count > 0 && tagSize == SkToU32(count)) &&
+                    buffer.validate(buffer.readInt() == count)) {
+                    fPaths.push_back_n(count);
+                    fLazy->fPathOnce.reset(new SkOnce[count]);
+                }
+            } break;
+            case SK_PICT_IMAGE_BUFFER_TAG: {
+                const int count = imageOffsets.count() - 1;
+                if (buffer.validate(fImages.empty() && count > 0 && tagSize == SkToU32(count))) {
+                    fImages.push_back_n(count);
+                    fLazy->fImageOnce.reset(new SkOnce[count]);
+                }
+            } break;
+            default:
+                this->parseBufferTag(buffer, tag, tagSize);
+                break;
+        }
+    }
+    if (!buffer.isValid()) {
+        return false;
+    }
+
+    for (SkTDArray<uint32_t>* offsets : {&pathOffsets, &imageOffsets}) {
+        for (uint32_t& entryOffset : *offsets) {
+            entryOffset += SkToU32(offset);
+        }
+    }
+    return true;
+}
+
+void SkPictureData::setupLazyBuffer(SkReadBuffer& buffer) const {
+    buffer.setVersion(fInfo.getVersion());
+    if (fFactoryPlayback) {
+        fFactoryPlayback->setupBuffer(buffer);
+    }
+    buffer.setDeserialProcs(fLazy->fProcs);
+    fTFPlayback.setupBuffer(buffer);
+}
+
+void SkPictureData::readLazyPath(int index) const {
+    fLazy->fPathOnce[index]([this, index] {
+        const SkTDArray<uint32_t>& offsets = fLazy->fOffsets.fPaths;
+        SkPath& path = fPaths[index];
+        if (auto data = aligned_subset(fLazy->fData.get(), offsets[index],
+                                       offsets[index + 1] - offsets[index])) {
+            SkReadBuffer buffer(data->data(), data->size());
+            this->setupLazyBuffer(buffer);
+            buffer.readPath(&path);
+            if (!buffer.isValid()) {
+                path.reset();
+            }
+        }
+        path.updateBoundsCache();
+    });
+}
+
+void SkPictureData::readLazyImage(int index) const {
+    fLazy->fImageOnce[index]([this, index] {
+        const SkTDArray<uint32_t>& offsets = fLazy->fOffsets.fImages;
+        if (auto data = aligned_subset(fLazy->fData.get(), offsets[index],
+                                       offsets[index + 1] - offsets[index])) {
+            SkReadBuffer buffer(data->data(), data->size());
+            this->setupLazyBuffer(buffer);
+            auto image = buffer.readImage();
+            if (buffer.isValid()) {
+                fImages[index] = std::move(image);
+            }
+        }
+    });
+}
+
+void SkPictureData::readLazyPicture(int index) const {
+    fLazy->fPictureOnce[index]([this, index] {
+        const SkTDArray<uint32_t>& offsets = fLazy->fOffsets.fPictures;
+        fPictures[index] = SkPicturePriv::MakeLazy(
+                SkData::MakeSubset(fLazy->fData.get(), offsets[index],
+                                   offsets[index + 1] - offsets[index]),
+                fLazy->fProcs);
+    });
+}
+
 const SkPaint* SkPictureData::optionalPaint(SkReadBuffer* reader) const {
     int index = reader->readInt();
     if (index == 0) {
@@ -11,7 +11,10 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkDrawable.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTArray.h"
+#include "include/private/SkTDArray.h"
 #include "src/core/SkPictureFlat.h"
 
 #include <memory>
@@ -55,6 +58,10 @@ public:
 #define SK_PICT_PICTURE_TAG    SkSetFourByteTag('p', 'c', 't', 'r')
 #define SK_PICT_DRAWABLE_TAG   SkSetFourByteTag('d', 'r', 'a', 'w')
 
+// Where each path and image starts in the ReadBuffer, and each sub-picture in the PICTURE tag,
+// so they can be read when they're first drawn. Written before those tags, since V80.
+#define SK_PICT_OFFSETS_TAG    SkSetFourByteTag('o', 'f', 's', 't')
+
 // This tag specifies the size of the ReadBuffer, needed for the following tags
 #define SK_PICT_BUFFER_SIZE_TAG     SkSetFourByteTag('a', 'r', 'a', 'y')
 // these are all inside the ARRAYS tag
@@ -82,12 +89,20 @@ public:
                                            const SkDeserialProcs&,
                                            SkTypefacePlayback*);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
+    // Reads the SkPictureData serialized into data from offset, keeping data to read its paths,
+    // images and sub-pictures from when they're first used, if it has an offset table for them.
+    static SkPictureData* CreateLazy(sk_sp<SkData> data, size_t offset,
+                                     const SkPictInfo&,
+                                     const SkDeserialProcs&);
 
     void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*, bool textBlobsOnly=false) const;
     void flatten(SkWriteBuffer&) const;
 
     const sk_sp<SkData>& opData() const { return fOpData; }
 
+    // True if paths, images or sub-pictures are read on first use.
+    bool isLazy() const { return fLazy != nullptr; }
+
 protected:
     explicit SkPictureData(const SkPictInfo& info);
 
@@ -99,17 +114,35 @@ public:
     const SkImage* getImage(SkReadBuffer* reader) const {
         // images are written base-0, unlike paths, pictures, drawables, etc.
         const int index = reader->readInt();
-        return reader->validateIndex(index, fImages.count()) ? fImages[index].get() : nullptr;
+        if (!reader->validateIndex(index, fImages.count())) {
+            return nullptr;
+        }
+        if (fLazy) {
+            this->readLazyImage(index);
+        }
+        return fImages[index].get();
     }
 
     const SkPath& getPath(SkReadBuffer* reader) const {
         int index = reader->readInt();
-        return reader->validate(index > 0 && index <= fPaths.count()) ?
-                fPaths[index - 1] : fEmptyPath;
+        if (!reader->validate(index > 0 && index <= fPaths.count())) {
+            return fEmptyPath;
+        }
+        if (fLazy) {
+            this->readLazyPath(index - 1);
+        }
+        return fPaths[index - 1];
     }
 
     const SkPicture* getPicture(SkReadBuffer* reader) const {
-        return read_index_base_1_or_null(reader, fPictures);
+        int index = reader->readInt();
+        if (!reader->validate(index > 0 && index <= fPictures.count())) {
+            return nullptr;
+        }
+        if (fLazy) {
+            this->readLazyPicture(index - 1);
+        }
+        return fPictures[index - 1].get();
     }
 
     SkDrawable* getDrawable(SkReadBuffer* reader) const {
@@ -132,26 +165,53 @@ public:
     }
 
 private:
+    // Where each path, image and sub-picture is in the stream, see SK_PICT_OFFSETS_TAG.
+    // Each array has one more offset than there are entries: each entry ends where the next one
+    // starts. Arrays for no entries are empty.
+    struct Offsets {
+        SkTDArray<uint32_t> fPaths;
+        SkTDArray<uint32_t> fImages;
+        SkTDArray<uint32_t> fPictures;
+    };
+
+    // What a lazily read SkPictureData reads its paths, images and sub-pictures from. The
+    // offsets are into fData, and each entry is read once, the first time it's used.
+    struct Lazy {
+        sk_sp<SkData>             fData;
+        SkDeserialProcs           fProcs;
+        Offsets                   fOffsets;
+        std::unique_ptr<SkOnce[]> fPathOnce,
+                                  fImageOnce,
+                                  fPictureOnce;
+    };
+
     // these help us with reading/writing
     // Does not affect ownership of SkStream.
     bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size,
                         const SkDeserialProcs&, SkTypefacePlayback*);
     void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
-    void flattenToBuffer(SkWriteBuffer&, bool textBlobsOnly) const;
+    void flattenToBuffer(SkWriteBuffer&, bool textBlobsOnly, Offsets* = nullptr) const;
+
+    bool parseLazily(size_t offset);
+    bool parseLazyBuffer(size_t offset, size_t size);
+    void setupLazyBuffer(SkReadBuffer&) const;
+    void readLazyPath(int index) const;
+    void readLazyImage(int index) const;
+    void readLazyPicture(int index) const;
 
     SkTArray<SkPaint>  fPaints;
-    SkTArray<SkPath>   fPaths;
+    mutable SkTArray<SkPath> fPaths;    // mutable to be read lazily
 
     sk_sp<SkData>   fOpData;    // opcodes and parameters
 
     const SkPath    fEmptyPath;
     const SkBitmap  fEmptyBitmap;
 
-    SkTArray<sk_sp<const SkPicture>>   fPictures;
+    mutable SkTArray<sk_sp<const SkPicture>> fPictures;  // mutable to be read lazily
     SkTArray<sk_sp<SkDrawable>>        fDrawables;
     SkTArray<sk_sp<const SkTextBlob>>  fTextBlobs;
     SkTArray<sk_sp<const SkVertices>>  fVertices;
-    SkTArray<sk_sp<const SkImage>>     fImages;
+    mutable SkTArray<sk_sp<const SkImage>> fImages;     // mutable to be read lazily
 
     SkTypefacePlayback                 fTFPlayback;
     std::unique_ptr<SkFactoryPlayback> fFactoryPlayback;
@@ -160,6 +220,9 @@ private:
 
     static void WriteFactories(SkWStream* stream, const SkFactorySet& rec);
     static void WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec, const SkSerialProcs&);
+    static void WriteOffsets(SkWStream* stream, const Offsets&);
+
+    std::unique_ptr<Lazy> fLazy;
 
     void initForPlayback() const;
 };
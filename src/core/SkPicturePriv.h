@@ -10,8 +10,10 @@
 
 #include "include/core/SkPicture.h"
 
+class SkData;
 class SkReadBuffer;
 class SkWriteBuffer;
+struct SkDeserialProcs;
 
 class SkPicturePriv {
 public:
@@ -25,6 +27,14 @@ public:
      */
     static sk_sp<SkPicture> MakeFromBuffer(SkReadBuffer& buffer);
 
+    /**
+     *  Recreate a picture that was serialized into data, reading its paths, images and
+     *  sub-pictures only when they are first drawn if the data has an offset table for them.
+     *  Otherwise this reads the whole picture, like SkPicture::MakeFromStream().
+     *  The picture keeps a ref on data, and procs are copied.
+     */
+    static sk_sp<SkPicture> MakeLazy(sk_sp<SkData> data, const SkDeserialProcs& procs);
+
     /**
      *  Serialize to a buffer.
      */
@@ -80,6 +90,7 @@ public:
     // V77: Explicit filtering options on imageshaders
     // V78: Serialize skmipmap data for images that have it
     // V79: Cubic Resampler option on imageshader
+    // V80: Offset table for the paths, images and sub-pictures of a picture
 
     enum Version {
         kMorphologyTakesScalar_Version      = 74,
@@ -88,10 +99,11 @@ public:
         kFilterOptionsInImageShader_Version = 77,
         kSerializeMipmaps_Version           = 78,
         kCubicResamplerImageShader_Version  = 79,
+        kPictureOffsetTable_Version         = 80,
 
         // Only SKPs within the min/current picture version range (inclusive) can be read.
         kMin_Version     = kMorphologyTakesScalar_Version,
-        kCurrent_Version = kCubicResamplerImageShader_Version
+        kCurrent_Version = kPictureOffsetTable_Version
     };
 
     static_assert(SkPicturePriv::kMin_Version <= SkPicturePriv::kCubicResamplerImageShader_Version,
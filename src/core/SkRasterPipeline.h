@@ -105,6 +105,7 @@ class SkData;
     M(byte_tables)                                                 \
     M(rgb_to_hsl) M(hsl_to_rgb)                                    \
     M(gauss_a_to_rgba)                                             \
+    M(sdf_coverage)                                                \
     M(emboss)                                                      \
     M(swizzle)
 
@@ -196,6 +197,11 @@ struct SkRasterPipeline_EmbossCtx {
                                add;
 };
 
+struct SkRasterPipeline_SDFCoverageCtx {
+    float mul,
+          add;
+};
+
 class SkRasterPipeline {
 public:
     explicit SkRasterPipeline(SkArenaAlloc*);
@@ -7,6 +7,7 @@
 
 #include "src/core/SkRemoteGlyphCache.h"
 
+#include <algorithm>
 #include <bitset>
 #include <iterator>
 #include <memory>
@@ -14,6 +15,7 @@
 #include <string>
 #include <tuple>
 
+#include "include/core/SkStream.h"
 #include "include/private/SkChecksum.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDraw.h"
@@ -228,8 +230,10 @@ private:
 class SkStrikeServer::RemoteStrike final : public SkStrikeForGPU {
 public:
     // N.B. RemoteStrike is not valid until ensureScalerContext is called.
+    // Glyphs are made by either context, or sharedStrike if the server shares its strikes.
     RemoteStrike(const SkDescriptor& descriptor,
                  std::unique_ptr<SkScalerContext> context,
+                 sk_sp<SkStrike> sharedStrike,
                  SkDiscardableHandleId discardableHandleId);
     ~RemoteStrike() override;
 
@@ -258,6 +262,7 @@ public:
     void onAboutToExitScope() override {}
 
     bool hasPendingGlyphs() const {
+        SkAutoMutexExclusive lock{fMu};
         return !fMasksToSend.empty() || !fPathsToSend.empty();
     }
 
@@ -311,19 +316,33 @@ private:
 
     void writeGlyphPath(const SkGlyph& glyph, Serializer* serializer) const;
     void ensureScalerContext();
+    SkScalerContext* context() const {
+        return fSharedStrike ? fSharedStrike->getScalerContext() : fContext.get();
+    }
+
+    // Fill in the glyph's metrics, or its path, from the shared strike or the scaler context.
+    void makeMetrics(SkGlyph* glyph);
+    void makePath(SkGlyph* glyph);
 
-    const int fNumberOfGlyphs;
     const SkAutoDescriptor fDescriptor;
     const SkDiscardableHandleId fDiscardableHandleId;
 
     const SkGlyphPositionRoundingSpec fRoundingSpec;
 
-    // The context built using fDescriptor
+    // The strike cache shared by the servers of several clients, if any.
+    SkStrikeCache* const fSharedStrikes;
+
+    // Guards everything below. Several SkTextBlobCacheDiffCanvases may draw with this strike at
+    // once.
+    mutable SkMutex fMu;
+
+    // The context built using fDescriptor, or the strike with fDescriptor in fSharedStrikes.
     std::unique_ptr<SkScalerContext> fContext;
+    sk_sp<SkStrike> fSharedStrike;
 
     // These fields are set every time getOrCreateCache. This allows the code to maintain the
     // fContext as lazy as possible.
-    const SkTypeface* fTypeface{nullptr};
+    sk_sp<SkTypeface> fTypeface;
     SkScalerContextEffects fEffects;
 
     // Have the metrics been sent for this strike. Only send them once.
@@ -347,16 +366,21 @@ private:
 SkStrikeServer::RemoteStrike::RemoteStrike(
         const SkDescriptor& descriptor,
         std::unique_ptr<SkScalerContext> context,
+        sk_sp<SkStrike> sharedStrike,
         uint32_t discardableHandleId)
-        : fNumberOfGlyphs(context->getGlyphCount())
-        , fDescriptor{descriptor}
+        : fDescriptor{descriptor}
         , fDiscardableHandleId(discardableHandleId)
-        , fRoundingSpec{context->isSubpixel(), context->computeAxisAlignmentForHText()}
-        // N.B. context must come last because it is used above.
+        , fRoundingSpec{sharedStrike ? sharedStrike->roundingSpec()
+                                     : SkGlyphPositionRoundingSpec{
+                                             context->isSubpixel(),
+                                             context->computeAxisAlignmentForHText()}}
+        , fSharedStrikes{sharedStrike ? sharedStrike->fStrikeCache : nullptr}
+        // N.B. context and sharedStrike must come last because they are used above.
         , fContext{std::move(context)}
+        , fSharedStrike{std::move(sharedStrike)}
         , fSentLowGlyphIDs{} {
     SkASSERT(fDescriptor.getDesc() != nullptr);
-    SkASSERT(fContext != nullptr);
+    SkASSERT((fContext != nullptr) != (fSharedStrike != nullptr));
 }
 
 SkStrikeServer::RemoteStrike::~RemoteStrike() = default;
@@ -479,8 +503,10 @@ struct WireTypeface {
 };
 
 // SkStrikeServer ----------------------------------------------------------------------------------
-SkStrikeServer::SkStrikeServer(DiscardableHandleManager* discardableHandleManager)
-        : fDiscardableHandleManager(discardableHandleManager) {
+SkStrikeServer::SkStrikeServer(DiscardableHandleManager* discardableHandleManager,
+                               SkStrikeCache* sharedStrikes)
+        : fDiscardableHandleManager(discardableHandleManager)
+        , fSharedStrikes(sharedStrikes) {
     SkASSERT(fDiscardableHandleManager);
 }
 
@@ -493,6 +519,7 @@ SkStrikeServer::~SkStrikeServer() {
 }
 
 sk_sp<SkData> SkStrikeServer::serializeTypeface(SkTypeface* tf) {
+    SkAutoMutexExclusive lock{fMu};
     auto* data = fSerializedTypefaces.find(SkTypeface::UniqueID(tf));
     if (data) {
         return *data;
@@ -506,6 +533,7 @@ sk_sp<SkData> SkStrikeServer::serializeTypeface(SkTypeface* tf) {
 }
 
 void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
+    SkAutoMutexExclusive lock{fMu};
     size_t strikesToSend = 0;
     fRemoteStrikesToSend.foreach ([&](RemoteStrike* strike) {
         if (strike->hasPendingGlyphs()) {
@@ -530,13 +558,13 @@ void SkStrikeServer::writeStrikeData(std::vector<uint8_t>* memory) {
     serializer.emplace<uint64_t>(SkTo<uint64_t>(strikesToSend));
     fRemoteStrikesToSend.foreach (
 #ifdef SK_DEBUG
-            [&](RemoteStrike* strike) {
+            [&, &descToRemoteStrike = fDescToRemoteStrike](RemoteStrike* strike) {
                 if (strike->hasPendingGlyphs()) {
                     strike->writePendingGlyphs(&serializer);
                     strike->resetScalerContext();
                 }
-                auto it = fDescToRemoteStrike.find(&strike->getDescriptor());
-                SkASSERT(it != fDescToRemoteStrike.end());
+                auto it = descToRemoteStrike.find(&strike->getDescriptor());
+                SkASSERT(it != descToRemoteStrike.end());
                 SkASSERT(it->second.get() == strike);
             }
 
@@ -609,6 +637,7 @@ SkStrikeServer::RemoteStrike* SkStrikeServer::getOrCreateCache(
             )
     );
 
+    SkAutoMutexExclusive lock{fMu};
     auto it = fDescToRemoteStrike.find(&desc);
     if (it != fDescToRemoteStrike.end()) {
         // We have processed the RemoteStrike before. Reuse it.
@@ -638,9 +667,16 @@ SkStrikeServer::RemoteStrike* SkStrikeServer::getOrCreateCache(
                                       typeface.isFixedPitch());
     }
 
-    auto context = typeface.createScalerContext(effects, &desc);
+    std::unique_ptr<SkScalerContext> context;
+    sk_sp<SkStrike> sharedStrike;
+    if (fSharedStrikes != nullptr) {
+        sharedStrike = fSharedStrikes->findOrCreateStrike(desc, effects, typeface);
+    } else {
+        context = typeface.createScalerContext(effects, &desc);
+    }
     auto newHandle = fDiscardableHandleManager->createHandle();  // Locked on creation
-    auto remoteStrike = std::make_unique<RemoteStrike>(desc, std::move(context), newHandle);
+    auto remoteStrike = std::make_unique<RemoteStrike>(
+            desc, std::move(context), std::move(sharedStrike), newHandle);
     remoteStrike->setTypefaceAndEffects(&typeface, effects);
     auto remoteStrikePtr = remoteStrike.get();
     fRemoteStrikesToSend.add(remoteStrikePtr);
@@ -668,17 +704,23 @@ static void writeGlyph(const SkGlyph& glyph, Serializer* serializer) {
 }
 
 void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
-    SkASSERT(this->hasPendingGlyphs());
+    SkAutoMutexExclusive lock{fMu};
+    SkASSERT(!fMasksToSend.empty() || !fPathsToSend.empty());
 
     // Write the desc.
-    serializer->emplace<StrikeSpec>(fContext->getTypeface()->uniqueID(), fDiscardableHandleId);
+    serializer->emplace<StrikeSpec>(this->context()->getTypeface()->uniqueID(),
+                                    fDiscardableHandleId);
     serializer->writeDescriptor(*fDescriptor.getDesc());
 
     serializer->emplace<bool>(fHaveSentFontMetrics);
     if (!fHaveSentFontMetrics) {
         // Write FontMetrics if not sent before.
         SkFontMetrics fontMetrics;
-        fContext->getFontMetrics(&fontMetrics);
+        if (fSharedStrike) {
+            fontMetrics = fSharedStrike->getFontMetrics();
+        } else {
+            fContext->getFontMetrics(&fontMetrics);
+        }
         serializer->write<SkFontMetrics>(fontMetrics);
         fHaveSentFontMetrics = true;
     }
@@ -692,7 +734,16 @@ void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
         auto imageSize = glyph.imageSize();
         if (imageSize > 0 && FitsInAtlas(glyph)) {
             glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
-            fContext->getImage(glyph);
+            if (fSharedStrike) {
+                // Another client may have had this glyph already, so it's only copied.
+                const SkGlyph* shared;
+                SkPackedGlyphID packedID = glyph.getPackedID();
+                fSharedStrike->prepareImages({&packedID, 1}, &shared);
+                SkASSERT(shared->imageSize() == imageSize && shared->image() != nullptr);
+                memcpy(glyph.fImage, shared->image(), imageSize);
+            } else {
+                fContext->getImage(glyph);
+            }
         }
     }
     fMasksToSend.clear();
@@ -710,22 +761,60 @@ void SkStrikeServer::RemoteStrike::writePendingGlyphs(Serializer* serializer) {
 }
 
 void SkStrikeServer::RemoteStrike::ensureScalerContext() {
-    if (fContext == nullptr) {
+    if (fSharedStrikes != nullptr) {
+        if (fSharedStrike == nullptr) {
+            fSharedStrike =
+                    fSharedStrikes->findOrCreateStrike(*fDescriptor.getDesc(), fEffects, *fTypeface);
+        }
+    } else if (fContext == nullptr) {
         fContext = fTypeface->createScalerContext(fEffects, fDescriptor.getDesc());
     }
 }
 
 void SkStrikeServer::RemoteStrike::resetScalerContext() {
+    SkAutoMutexExclusive lock{fMu};
     fContext.reset();
+    fSharedStrike.reset();
     fTypeface = nullptr;
 }
 
 void SkStrikeServer::RemoteStrike::setTypefaceAndEffects(
         const SkTypeface* typeface, SkScalerContextEffects effects) {
-    fTypeface = typeface;
+    SkAutoMutexExclusive lock{fMu};
+    fTypeface = sk_ref_sp(typeface);
     fEffects = effects;
 }
 
+void SkStrikeServer::RemoteStrike::makeMetrics(SkGlyph* glyph) {
+    this->ensureScalerContext();
+    if (fSharedStrike) {
+        const SkGlyph* shared;
+        SkPackedGlyphID packedID = glyph->getPackedID();
+        fSharedStrike->metrics({&packedID, 1}, &shared);
+        glyph->fAdvanceX = shared->fAdvanceX;
+        glyph->fAdvanceY = shared->fAdvanceY;
+        glyph->fWidth = shared->fWidth;
+        glyph->fHeight = shared->fHeight;
+        glyph->fTop = shared->fTop;
+        glyph->fLeft = shared->fLeft;
+        glyph->fMaskFormat = shared->fMaskFormat;
+        glyph->fForceBW = shared->fForceBW;
+    } else {
+        fContext->getMetrics(glyph);
+    }
+}
+
+void SkStrikeServer::RemoteStrike::makePath(SkGlyph* glyph) {
+    if (fSharedStrike) {
+        const SkGlyph* shared;
+        SkGlyphID glyphID = glyph->getGlyphID();
+        fSharedStrike->preparePaths({&glyphID, 1}, &shared);
+        glyph->setPath(&fPathAlloc, shared->path());
+    } else {
+        glyph->setPath(&fPathAlloc, fContext.get());
+    }
+}
+
 void SkStrikeServer::RemoteStrike::writeGlyphPath(
         const SkGlyph& glyph, Serializer* serializer) const {
     if (glyph.isColor() || glyph.isEmpty()) {
@@ -748,6 +837,7 @@ void SkStrikeServer::RemoteStrike::writeGlyphPath(
 template <typename Rejector>
 void SkStrikeServer::RemoteStrike::commonMaskLoop(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects, Rejector&& reject) {
+    SkAutoMutexExclusive lock{fMu};
     drawables->forEachGlyphID(
             [&](size_t i, SkPackedGlyphID packedID, SkPoint position) {
                 MaskSummary* summary = fSentGlyphs.find(packedID);
@@ -757,8 +847,7 @@ void SkStrikeServer::RemoteStrike::commonMaskLoop(
                     SkGlyph* glyph = &fMasksToSend.back();
 
                     // Build the glyph
-                    this->ensureScalerContext();
-                    fContext->getMetrics(glyph);
+                    this->makeMetrics(glyph);
                     MaskSummary newSummary =
                             {packedID.value(), CanDrawAsMask(*glyph), CanDrawAsSDFT(*glyph)};
                     summary = fSentGlyphs.set(newSummary);
@@ -773,6 +862,7 @@ void SkStrikeServer::RemoteStrike::commonMaskLoop(
 
 void SkStrikeServer::RemoteStrike::prepareForMaskDrawing(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+    SkAutoMutexExclusive lock{fMu};
     for (auto [i, variant, _] : SkMakeEnumerate(drawables->input())) {
         SkPackedGlyphID packedID = variant.packedID();
         if (fSentLowGlyphIDs.test(packedID)) {
@@ -791,8 +881,7 @@ void SkStrikeServer::RemoteStrike::prepareForMaskDrawing(
             SkGlyph* glyph = &fMasksToSend.back();
 
             // Build the glyph
-            this->ensureScalerContext();
-            fContext->getMetrics(glyph);
+            this->makeMetrics(glyph);
 
             MaskSummary newSummary =
                     {packedID.value(), CanDrawAsMask(*glyph), CanDrawAsSDFT(*glyph)};
@@ -819,6 +908,7 @@ void SkStrikeServer::RemoteStrike::prepareForSDFTDrawing(
 
 void SkStrikeServer::RemoteStrike::prepareForPathDrawing(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+    SkAutoMutexExclusive lock{fMu};
     drawables->forEachGlyphID(
         [&](size_t i, SkPackedGlyphID packedID, SkPoint position) {
             SkGlyphID glyphID = packedID.glyphID();
@@ -829,13 +919,12 @@ void SkStrikeServer::RemoteStrike::prepareForPathDrawing(
                 SkGlyph* glyph = &fPathsToSend.back();
 
                 // Build the glyph
-                this->ensureScalerContext();
-                fContext->getMetrics(glyph);
+                this->makeMetrics(glyph);
 
                 uint16_t maxDimensionOrPath = glyph->maxDimension();
                 // Only try to get the path if the glyphs is not color.
                 if (!glyph->isColor() && !glyph->isEmpty()) {
-                    glyph->setPath(&fPathAlloc, fContext.get());
+                    this->makePath(glyph);
                     if (glyph->path() != nullptr) {
                         maxDimensionOrPath = PathSummary::kIsPath;
                     }
@@ -1026,3 +1115,225 @@ sk_sp<SkTypeface> SkStrikeClient::addTypeface(const WireTypeface& wire) {
     fRemoteFontIdToTypeface.set(wire.typefaceID, newTypeface);
     return std::move(newTypeface);
 }
+
+// SkStrikeCacheSnapshot ---------------------------------------------------------------------------
+static constexpr uint32_t kSnapshotMagic   = SkSetFourByteTag('s', 'k', 's', 'c');
+static constexpr uint32_t kSnapshotVersion = 1;
+
+sk_sp<SkData> SkStrikeCacheSnapshot::Make(SkStrikeCache* strikeCache) {
+    if (strikeCache == nullptr) {
+        strikeCache = SkStrikeCache::GlobalStrikeCache();
+    }
+
+    // Take refs to the strikes so they're encoded without holding the strike cache's lock.
+    std::vector<sk_sp<SkStrike>> strikes;
+    strikeCache->forEachStrike([&](const SkStrike& strike) {
+        // An SkStrikeClient's strikes have typeface proxies, which can't be serialized, and
+        // effects would have to be flattened to recreate their scaler contexts.
+        if (strike.fPinner == nullptr &&
+            strike.getDescriptor().findEntry(kEffects_SkDescriptorTag, nullptr) == nullptr) {
+            strikes.push_back(sk_ref_sp(&strike));
+        }
+    });
+    // Preloading adds each strike as the most recently used, so write the least recent first.
+    std::reverse(strikes.begin(), strikes.end());
+
+    std::vector<const SkTypeface*> typefaces;
+    SkTHashMap<SkFontID, uint32_t> typefaceIndex;
+    for (const sk_sp<SkStrike>& strike : strikes) {
+        const SkTypeface* typeface = strike->getScalerContext()->getTypeface();
+        if (!typefaceIndex.find(typeface->uniqueID())) {
+            typefaceIndex.set(typeface->uniqueID(), SkToU32(typefaces.size()));
+            typefaces.push_back(typeface);
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    Serializer serializer(&buffer);
+    serializer.write<uint32_t>(kSnapshotMagic);
+    serializer.write<uint32_t>(kSnapshotVersion);
+
+    serializer.write<uint64_t>(typefaces.size());
+    for (const SkTypeface* typeface : typefaces) {
+        sk_sp<SkData> identity = typeface->serialize(SkTypeface::SerializeBehavior::kDontIncludeData);
+        serializer.write<int32_t>(typeface->countGlyphs());
+        serializer.write<uint64_t>(identity->size());
+        memcpy(serializer.allocate(identity->size(), 1), identity->data(), identity->size());
+    }
+
+    serializer.write<uint64_t>(strikes.size());
+    for (const sk_sp<SkStrike>& strike : strikes) {
+        serializer.write<uint32_t>(
+                *typefaceIndex.find(strike->getScalerContext()->getTypeface()->uniqueID()));
+        serializer.writeDescriptor(strike->getDescriptor());
+        serializer.write<SkFontMetrics>(strike->getFontMetrics());
+
+        // Glyphs can be added until the strike's lock is taken, so patch the count in afterwards.
+        serializer.write<uint64_t>(0u);
+        const size_t countOffset = buffer.size() - sizeof(uint64_t);
+        uint64_t glyphCount = 0;
+        strike->fScalerCache.forEachGlyph([&](const SkGlyph& glyph) {
+            writeGlyph(glyph, &serializer);
+            serializer.write<int8_t>(glyph.fForceBW);
+
+            // A glyph without an image or path yet is made on demand after preloading, too.
+            const bool hasImage = glyph.fImage != nullptr;
+            serializer.write<bool>(hasImage);
+            if (hasImage) {
+                memcpy(serializer.allocate(glyph.imageSize(), glyph.formatAlignment()),
+                       glyph.fImage, glyph.imageSize());
+            }
+
+            serializer.write<bool>(glyph.setPathHasBeenCalled());
+            if (glyph.setPathHasBeenCalled()) {
+                const SkPath* path = glyph.path();
+                size_t pathSize = path != nullptr ? path->writeToMemory(nullptr) : 0u;
+                serializer.write<uint64_t>(pathSize);
+                if (pathSize > 0) {
+                    path->writeToMemory(serializer.allocate(pathSize, kPathAlignment));
+                }
+            }
+            glyphCount++;
+        });
+        memcpy(&buffer[countOffset], &glyphCount, sizeof(glyphCount));
+    }
+
+    return SkData::MakeWithCopy(buffer.data(), buffer.size());
+}
+
+bool SkStrikeCacheSnapshot::WriteToFile(const char path[], SkStrikeCache* strikeCache) {
+    sk_sp<SkData> snapshot = Make(strikeCache);
+    SkFILEWStream stream(path);
+    return stream.isValid() && stream.write(snapshot->data(), snapshot->size());
+}
+
+static bool same_typeface_identity(const SkTypeface& typeface, const void* identity,
+                                   size_t length) {
+    sk_sp<SkData> data = typeface.serialize(SkTypeface::SerializeBehavior::kDontIncludeData);
+    return data->size() == length && 0 == memcmp(data->data(), identity, length);
+}
+
+bool SkStrikeCacheSnapshot::Preload(const void* data, size_t length,
+                                    const std::vector<sk_sp<SkTypeface>>& typefaces,
+                                    SkStrikeCache* strikeCache) {
+    if (strikeCache == nullptr) {
+        strikeCache = SkStrikeCache::GlobalStrikeCache();
+    }
+    Deserializer deserializer(static_cast<const volatile char*>(data), length);
+
+    uint32_t magic, version;
+    if (!deserializer.read<uint32_t>(&magic) || magic != kSnapshotMagic) return false;
+    if (!deserializer.read<uint32_t>(&version) || version != kSnapshotVersion) return false;
+
+    // Typefaces that aren't found stay null, and their strikes are read but not added.
+    uint64_t typefaceCount;
+    if (!deserializer.read<uint64_t>(&typefaceCount)) return false;
+    std::vector<sk_sp<SkTypeface>> localTypefaces;
+    for (uint64_t i = 0; i < typefaceCount; i++) {
+        int32_t glyphCount;
+        uint64_t identitySize;
+        if (!deserializer.read<int32_t>(&glyphCount)) return false;
+        if (!deserializer.read<uint64_t>(&identitySize)) return false;
+        auto* identityData = deserializer.read(identitySize, 1);
+        if (!identityData) return false;
+        sk_sp<SkData> identity = SkData::MakeWithCopy(const_cast<const void*>(identityData),
+                                                      identitySize);
+
+        sk_sp<SkTypeface> local;
+        for (const sk_sp<SkTypeface>& candidate : typefaces) {
+            if (candidate && same_typeface_identity(*candidate, identity->data(),
+                                                    identity->size())) {
+                local = candidate;
+                break;
+            }
+        }
+        if (!local) {
+            // The font manager falls back to another font if it doesn't have this one.
+            SkMemoryStream stream(identity);
+            local = SkTypeface::MakeDeserialize(&stream);
+            if (local && !same_typeface_identity(*local, identity->data(), identity->size())) {
+                local = nullptr;
+            }
+        }
+        if (local && local->countGlyphs() != glyphCount) {
+            local = nullptr;
+        }
+        localTypefaces.push_back(std::move(local));
+    }
+
+    uint64_t strikeCount;
+    if (!deserializer.read<uint64_t>(&strikeCount)) return false;
+    for (uint64_t i = 0; i < strikeCount; i++) {
+        uint32_t typefaceIndex;
+        if (!deserializer.read<uint32_t>(&typefaceIndex)) return false;
+        if (typefaceIndex >= localTypefaces.size()) return false;
+
+        SkAutoDescriptor sourceAd;
+        if (!deserializer.readDescriptor(&sourceAd)) return false;
+        if (!sourceAd.getDesc()->findEntry(kRec_SkDescriptorTag, nullptr)) return false;
+
+        SkFontMetrics fontMetrics;
+        if (!deserializer.read<SkFontMetrics>(&fontMetrics)) return false;
+
+        sk_sp<SkStrike> strike;
+        if (SkTypeface* typeface = localTypefaces[typefaceIndex].get()) {
+            SkAutoDescriptor ad;
+            auto* desc = auto_descriptor_from_desc(sourceAd.getDesc(), typeface->uniqueID(), &ad);
+            if (!strikeCache->findStrike(*desc)) {
+                strike = strikeCache->createStrike(
+                        *desc, typeface->createScalerContext(SkScalerContextEffects{}, desc),
+                        &fontMetrics);
+            }
+        }
+
+        uint64_t glyphCount;
+        if (!deserializer.read<uint64_t>(&glyphCount)) return false;
+        for (uint64_t j = 0; j < glyphCount; j++) {
+            SkTLazy<SkGlyph> glyph;
+            if (!SkStrikeClient::ReadGlyph(glyph, &deserializer)) return false;
+            if (!deserializer.read<int8_t>(&glyph->fForceBW)) return false;
+
+            bool hasImage;
+            if (!deserializer.read<bool>(&hasImage)) return false;
+            if (hasImage) {
+                if (glyph->isEmpty()) return false;
+                auto* image = deserializer.read(glyph->imageSize(), glyph->formatAlignment());
+                if (!image) return false;
+                glyph->fImage = (void*)image;
+            }
+
+            bool hasPath;
+            SkPath path;
+            const SkPath* pathPtr = nullptr;
+            if (!deserializer.read<bool>(&hasPath)) return false;
+            if (hasPath) {
+                uint64_t pathSize;
+                if (!deserializer.read<uint64_t>(&pathSize)) return false;
+                if (pathSize > 0) {
+                    auto* pathData = deserializer.read(pathSize, kPathAlignment);
+                    if (!pathData) return false;
+                    if (!path.readFromMemory(const_cast<const void*>(pathData), pathSize)) {
+                        return false;
+                    }
+                    pathPtr = &path;
+                }
+            }
+
+            if (strike) {
+                SkGlyph* merged = strike->mergeGlyphAndImage(glyph->getPackedID(), *glyph);
+                if (hasPath) {
+                    strike->mergePath(merged, pathPtr);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SkStrikeCacheSnapshot::PreloadFromFile(const char path[],
+                                            const std::vector<sk_sp<SkTypeface>>& typefaces,
+                                            SkStrikeCache* strikeCache) {
+    sk_sp<SkData> snapshot = SkData::MakeFromFileName(path);
+    return snapshot && Preload(snapshot->data(), snapshot->size(), typefaces, strikeCache);
+}
@@ -23,6 +23,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkTHash.h"
 #include "include/utils/SkNoDrawCanvas.h"
 #include "src/core/SkDevice.h"
@@ -70,7 +71,12 @@ private:
 
 using SkDiscardableHandleId = uint32_t;
 
-// This class is not thread-safe.
+// A server tracks which glyphs one client has, and serializes what it lacks. Several
+// SkTextBlobCacheDiffCanvases may draw with one server at once, on different threads, but
+// writeStrikeData must not overlap with drawing that it is meant to include.
+//
+// A process serving several clients gives each its own server. If the servers share an
+// SkStrikeCache, each glyph is made once for all of them, and each server copies it for its client.
 class SkStrikeServer final : public SkStrikeForGPUCacheInterface {
 public:
     // An interface used by the server to create handles for pinning SkStrike
@@ -97,7 +103,8 @@ public:
         SK_SPI virtual bool isHandleDeleted(SkDiscardableHandleId) { return false; }
     };
 
-    SK_SPI explicit SkStrikeServer(DiscardableHandleManager* discardableHandleManager);
+    SK_SPI explicit SkStrikeServer(DiscardableHandleManager* discardableHandleManager,
+                                   SkStrikeCache* sharedStrikes = nullptr);
     SK_SPI ~SkStrikeServer() override;
 
     // Serializes the typeface to be transmitted using this server.
@@ -126,9 +133,13 @@ public:
             RemoteStrike* strike, SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects);
 
     void setMaxEntriesInDescriptorMapForTesting(size_t count) {
+        SkAutoMutexExclusive lock{fMu};
         fMaxEntriesInDescriptorMap = count;
     }
-    size_t remoteStrikeMapSizeForTesting() const { return fDescToRemoteStrike.size(); }
+    size_t remoteStrikeMapSizeForTesting() const {
+        SkAutoMutexExclusive lock{fMu};
+        return fDescToRemoteStrike.size();
+    }
 
     #ifdef SK_CAPTURE_DRAW_TEXT_BLOB
     // DrawTextBlob trace capture.
@@ -138,11 +149,11 @@ public:
 private:
     static constexpr size_t kMaxEntriesInDescriptorMap = 2000u;
 
-    void checkForDeletedEntries();
+    void checkForDeletedEntries() SK_REQUIRES(fMu);
 
     RemoteStrike* getOrCreateCache(const SkDescriptor& desc,
                                    const SkTypeface& typeface,
-                                   SkScalerContextEffects effects);
+                                   SkScalerContextEffects effects) SK_EXCLUDES(fMu);
 
     struct MapOps {
         size_t operator()(const SkDescriptor* key) const;
@@ -150,18 +161,20 @@ private:
     };
     using DescToRemoteStrike =
             std::unordered_map<const SkDescriptor*, std::unique_ptr<RemoteStrike>, MapOps, MapOps>;
-    DescToRemoteStrike fDescToRemoteStrike;
+    mutable SkMutex fMu;
+    DescToRemoteStrike fDescToRemoteStrike SK_GUARDED_BY(fMu);
 
     DiscardableHandleManager* const fDiscardableHandleManager;
-    SkTHashSet<SkFontID> fCachedTypefaces;
-    size_t fMaxEntriesInDescriptorMap = kMaxEntriesInDescriptorMap;
+    SkStrikeCache* const fSharedStrikes;
+    SkTHashSet<SkFontID> fCachedTypefaces SK_GUARDED_BY(fMu);
+    size_t fMaxEntriesInDescriptorMap SK_GUARDED_BY(fMu) = kMaxEntriesInDescriptorMap;
 
     // Cached serialized typefaces.
-    SkTHashMap<SkFontID, sk_sp<SkData>> fSerializedTypefaces;
+    SkTHashMap<SkFontID, sk_sp<SkData>> fSerializedTypefaces SK_GUARDED_BY(fMu);
 
     // State cached until the next serialization.
-    SkTHashSet<RemoteStrike*> fRemoteStrikesToSend;
-    std::vector<WireTypeface> fTypefacesToSend;
+    SkTHashSet<RemoteStrike*> fRemoteStrikesToSend SK_GUARDED_BY(fMu);
+    std::vector<WireTypeface> fTypefacesToSend SK_GUARDED_BY(fMu);
 };
 
 class SkStrikeClient {
@@ -220,6 +233,7 @@ public:
     SK_SPI bool readStrikeData(const volatile void* memory, size_t memorySize);
 
 private:
+    friend class SkStrikeCacheSnapshot;
     class DiscardableStrikePinner;
 
     static bool ReadGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer);
@@ -231,6 +245,29 @@ private:
     const bool fIsLogging;
 };
 
+// Saves the strikes of a local SkStrikeCache, and preloads them into another, so a new process
+// can start with the glyphs an earlier one rasterized instead of with an empty cache. Snapshots
+// use the encoding of the strike data the SkStrikeServer sends, extended with what a local cache
+// keeps: every glyph's image and path, if it has been made, and each strike's typeface identity.
+class SkStrikeCacheSnapshot {
+public:
+    // Encodes each strike's descriptor, typeface and font metrics, and each of its glyphs' metrics,
+    // image and path. Strikes with path effects or mask filters, and strikes that belong to an
+    // SkStrikeClient, are left out.
+    SK_SPI static sk_sp<SkData> Make(SkStrikeCache* strikeCache = nullptr);
+    SK_SPI static bool WriteToFile(const char path[], SkStrikeCache* strikeCache = nullptr);
+
+    // Adds the snapshot's strikes to the cache. Each strike's typeface is looked for in
+    // 'typefaces', and then with SkTypeface::MakeDeserialize; strikes are skipped if that doesn't
+    // find the same font, or if the cache has them already. Returns false if the data is invalid.
+    SK_SPI static bool Preload(const void* data, size_t length,
+                               const std::vector<sk_sp<SkTypeface>>& typefaces = {},
+                               SkStrikeCache* strikeCache = nullptr);
+    SK_SPI static bool PreloadFromFile(const char path[],
+                                       const std::vector<sk_sp<SkTypeface>>& typefaces = {},
+                                       SkStrikeCache* strikeCache = nullptr);
+};
+
 // For exposure to fuzzing only.
 bool SkFuzzDeserializeSkDescriptor(sk_sp<SkData> bytes, SkAutoDescriptor* ad);
 
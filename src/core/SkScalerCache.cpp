@@ -87,6 +87,13 @@ int SkScalerCache::countCachedGlyphs() const {
     return fDigestForPackedGlyphID.count();
 }
 
+void SkScalerCache::forEachGlyph(std::function<void(const SkGlyph&)> visitor) const {
+    SkAutoMutexExclusive lock(fMu);
+    for (const SkGlyph* glyph : fGlyphForIndex) {
+        visitor(*glyph);
+    }
+}
+
 std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::internalPrepare(
         SkSpan<const SkGlyphID> glyphIDs, PathDetail pathDetail, const SkGlyph** results) {
     const SkGlyph** cursor = results;
@@ -138,6 +145,19 @@ std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::metrics(
     return {glyphs, delta};
 }
 
+std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::metrics(
+        SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
+    SkAutoMutexExclusive lock{fMu};
+    const SkGlyph** cursor = results;
+    size_t delta = 0;
+    for (auto glyphID : glyphIDs) {
+        auto [glyph, size] = this->glyph(glyphID);
+        delta += size;
+        *cursor++ = glyph;
+    }
+    return {{results, glyphIDs.size()}, delta};
+}
+
 std::tuple<SkSpan<const SkGlyph*>, size_t> SkScalerCache::preparePaths(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
     SkAutoMutexExclusive lock{fMu};
@@ -192,6 +212,27 @@ size_t SkScalerCache::prepareForDrawingMasksCPU(SkDrawableGlyphBuffer* drawables
     return delta + imageDelta;
 }
 
+size_t SkScalerCache::prepareForSDFTDrawingCPU(
+        SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+    SkAutoMutexExclusive lock{fMu};
+    size_t imageDelta = 0;
+    size_t delta = this->commonFilterLoop(drawables,
+        [&](size_t i, SkGlyphDigest digest, SkPoint pos) SK_REQUIRES(fMu) {
+            if (digest.canDrawAsSDFT()) {
+                SkGlyph* glyph = fGlyphForIndex[digest.index()];
+                auto [image, imageSize] = this->prepareImage(glyph);
+                if (image != nullptr) {
+                    drawables->push_back(glyph, i);
+                    imageDelta += imageSize;
+                }
+            } else {
+                rejects->reject(i);
+            }
+        });
+
+    return delta + imageDelta;
+}
+
 // Note: this does not actually fill out the image. That happens at atlas building time.
 size_t SkScalerCache::prepareForMaskDrawing(
         SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
@@ -17,6 +17,7 @@
 #include "src/core/SkGlyph.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkStrikeForGPU.h"
+#include <functional>
 #include <memory>
 
 class SkScalerContext;
@@ -70,6 +71,9 @@ public:
     /** Return the number of glyphs currently cached. */
     int countCachedGlyphs() const SK_EXCLUDES(fMu);
 
+    /** Call visitor with each cached glyph, holding the cache's lock. */
+    void forEachGlyph(std::function<void(const SkGlyph&)> visitor) const SK_EXCLUDES(fMu);
+
     /** If the advance axis intersects the glyph's path, append the positions scaled and offset
         to the array (if non-null), and set the count to the updated array length.
     */
@@ -83,6 +87,10 @@ public:
     std::tuple<SkSpan<const SkGlyph*>, size_t> metrics(
             SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fMu);
 
+    // Like metrics() above, but for glyphs at subpixel positions.
+    std::tuple<SkSpan<const SkGlyph*>, size_t> metrics(
+            SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fMu);
+
     std::tuple<SkSpan<const SkGlyph*>, size_t> preparePaths(
             SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fMu);
 
@@ -91,6 +99,11 @@ public:
 
     size_t prepareForDrawingMasksCPU(SkDrawableGlyphBuffer* drawables) SK_EXCLUDES(fMu);
 
+    // Like prepareForSDFTDrawing, but also renders the distance fields of the accepted glyphs,
+    // which the raster device samples directly.
+    size_t prepareForSDFTDrawingCPU(
+            SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) SK_EXCLUDES(fMu);
+
     // SkStrikeForGPU APIs
     const SkGlyphPositionRoundingSpec& roundingSpec() const {
         return fRoundingSpec;
@@ -26,6 +26,8 @@ typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
+extern std::atomic<bool> gSkUseSparseStripsAA;
+extern std::atomic<bool> gSkForceSparseStripsAA;
 
 class AdditiveBlitter;
 
@@ -71,6 +73,11 @@ public:
     // Needed by do_fill_path in SkScanPriv.h
     static void FillPath(const SkPathView&, const SkRegion& clip, SkBlitter*);
 
+    // Anti-aliases a non-inverse path with sparse strips, whatever gSkUseSparseStripsAA says.
+    // Tests call this directly to check sparse strips without changing the process wide flags.
+    static void SparseStripsFillPath(const SkPathView& path, SkBlitter* blitter,
+                                     const SkIRect& pathIR, const SkIRect& clipBounds);
+
 private:
     friend class SkAAClip;
     friend class SkRegion;
@@ -598,6 +598,7 @@ static SkIRect safeRoundOut(const SkRect& src) {
 }
 
 constexpr int kSampleSize = 8;
+constexpr int kSparseStripsMinPoints = 256;
 #if !defined(SK_DISABLE_AAA)
     constexpr SkScalar kComplexityThreshold = 0.25;
 #endif
@@ -671,6 +672,21 @@ static bool ShouldUseAAA(const SkPathView& path, SkScalar avgLength, SkScalar co
 #endif
 }
 
+static bool ShouldUseSparseStrips(const SkPathView& path, bool forceRLE) {
+    // Sparse strips only draw inside the path's bounds, and blit whole strips out of order.
+    if (path.isInverseFillType() || forceRLE) {
+        return false;
+    }
+    if (gSkForceSparseStripsAA) {
+        return true;
+    }
+    if (!gSkUseSparseStripsAA) {
+        return false;
+    }
+    // Sorting pieces by tile only pays off once there are many edges on each scan line.
+    return path.fPoints.count() >= kSparseStripsMinPoints;
+}
+
 void SkScan::SAAFillPath(const SkPathView& path, SkBlitter* blitter, const SkIRect& ir,
                   const SkIRect& clipBounds, bool forceRLE) {
     bool containedInClip = clipBounds.contains(ir);
@@ -785,7 +801,9 @@ void SkScan::AntiFillPath(const SkPathView& path, const SkRegion& origClip,
     SkScalar avgLength, complexity;
     compute_complexity(path, avgLength, complexity);
 
-    if (ShouldUseAAA(path, avgLength, complexity)) {
+    if (ShouldUseSparseStrips(path, forceRLE)) {
+        SkScan::SparseStripsFillPath(path, blitter, ir, clipRgn->getBounds());
+    } else if (ShouldUseAAA(path, avgLength, complexity)) {
         // Do not use AAA if path is too complicated:
         // there won't be any speedup or significant visual improvement.
         SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
@@ -67,7 +67,8 @@ static inline int SmallDot6Scale(int value, int dot6) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static void call_hline_blitter(SkBlitter* blitter, int x, int y, int count,
+template <typename Blitter>
+static void call_hline_blitter(Blitter* blitter, int x, int y, int count,
                                U8CPU alpha) {
     SkASSERT(count > 0);
 
@@ -112,7 +113,16 @@ private:
     SkBlitter*  fBlitter;
 };
 
-class HLine_SkAntiHairBlitter : public SkAntiHairBlitter {
+// The hairline steppers are instantiated for SkBlitter, and for SkCoverageBatchBlitter, whose
+// calls are direct (and mostly inlined) since the class is final.
+template <typename Blitter>
+class SkTAntiHairBlitter : public SkAntiHairBlitter {
+protected:
+    Blitter* blitter() const { return static_cast<Blitter*>(this->getBlitter()); }
+};
+
+template <typename Blitter>
+class HLine_SkAntiHairBlitter : public SkTAntiHairBlitter<Blitter> {
 public:
     SkFixed drawCap(int x, SkFixed fy, SkFixed slope, int mod64) override {
         fy += SK_Fixed1/2;
@@ -123,13 +133,13 @@ public:
         // lower line
         unsigned ma = SmallDot6Scale(a, mod64);
         if (ma) {
-            call_hline_blitter(this->getBlitter(), x, y, 1, ma);
+            call_hline_blitter(this->blitter(), x, y, 1, ma);
         }
 
         // upper line
         ma = SmallDot6Scale(255 - a, mod64);
         if (ma) {
-            call_hline_blitter(this->getBlitter(), x, y - 1, 1, ma);
+            call_hline_blitter(this->blitter(), x, y - 1, 1, ma);
         }
 
         return fy - SK_Fixed1/2;
@@ -145,20 +155,21 @@ public:
 
         // lower line
         if (a) {
-            call_hline_blitter(this->getBlitter(), x, y, count, a);
+            call_hline_blitter(this->blitter(), x, y, count, a);
         }
 
         // upper line
         a = 255 - a;
         if (a) {
-            call_hline_blitter(this->getBlitter(), x, y - 1, count, a);
+            call_hline_blitter(this->blitter(), x, y - 1, count, a);
         }
 
         return fy - SK_Fixed1/2;
     }
 };
 
-class Horish_SkAntiHairBlitter : public SkAntiHairBlitter {
+template <typename Blitter>
+class Horish_SkAntiHairBlitter : public SkTAntiHairBlitter<Blitter> {
 public:
     SkFixed drawCap(int x, SkFixed fy, SkFixed dy, int mod64) override {
         fy += SK_Fixed1/2;
@@ -167,7 +178,7 @@ public:
         uint8_t  a = (uint8_t)((fy >> 8) & 0xFF);
         unsigned a0 = SmallDot6Scale(255 - a, mod64);
         unsigned a1 = SmallDot6Scale(a, mod64);
-        this->getBlitter()->blitAntiV2(x, lower_y - 1, a0, a1);
+        this->blitter()->blitAntiV2(x, lower_y - 1, a0, a1);
 
         return fy + dy - SK_Fixed1/2;
     }
@@ -176,7 +187,7 @@ public:
         SkASSERT(x < stopx);
 
         fy += SK_Fixed1/2;
-        SkBlitter* blitter = this->getBlitter();
+        Blitter* blitter = this->blitter();
         do {
             int lower_y = fy >> 16;
             uint8_t  a = (uint8_t)((fy >> 8) & 0xFF);
@@ -188,7 +199,8 @@ public:
     }
 };
 
-class VLine_SkAntiHairBlitter : public SkAntiHairBlitter {
+template <typename Blitter>
+class VLine_SkAntiHairBlitter : public SkTAntiHairBlitter<Blitter> {
 public:
     SkFixed drawCap(int y, SkFixed fx, SkFixed dx, int mod64) override {
         SkASSERT(0 == dx);
@@ -199,11 +211,11 @@ public:
 
         unsigned ma = SmallDot6Scale(a, mod64);
         if (ma) {
-            this->getBlitter()->blitV(x, y, 1, ma);
+            this->blitter()->blitV(x, y, 1, ma);
         }
         ma = SmallDot6Scale(255 - a, mod64);
         if (ma) {
-            this->getBlitter()->blitV(x - 1, y, 1, ma);
+            this->blitter()->blitV(x - 1, y, 1, ma);
         }
 
         return fx - SK_Fixed1/2;
@@ -218,25 +230,26 @@ public:
         int a = (uint8_t)((fx >> 8) & 0xFF);
 
         if (a) {
-            this->getBlitter()->blitV(x, y, stopy - y, a);
+            this->blitter()->blitV(x, y, stopy - y, a);
         }
         a = 255 - a;
         if (a) {
-            this->getBlitter()->blitV(x - 1, y, stopy - y, a);
+            this->blitter()->blitV(x - 1, y, stopy - y, a);
         }
 
         return fx - SK_Fixed1/2;
     }
 };
 
-class Vertish_SkAntiHairBlitter : public SkAntiHairBlitter {
+template <typename Blitter>
+class Vertish_SkAntiHairBlitter : public SkTAntiHairBlitter<Blitter> {
 public:
     SkFixed drawCap(int y, SkFixed fx, SkFixed dx, int mod64) override {
         fx += SK_Fixed1/2;
 
         int x = fx >> 16;
         uint8_t a = (uint8_t)((fx >> 8) & 0xFF);
-        this->getBlitter()->blitAntiH2(x - 1, y,
+        this->blitter()->blitAntiH2(x - 1, y,
                                        SmallDot6Scale(255 - a, mod64), SmallDot6Scale(a, mod64));
 
         return fx + dx - SK_Fixed1/2;
@@ -248,7 +261,7 @@ public:
         do {
             int x = fx >> 16;
             uint8_t a = (uint8_t)((fx >> 8) & 0xFF);
-            this->getBlitter()->blitAntiH2(x - 1, y, 255 - a, a);
+            this->blitter()->blitAntiH2(x - 1, y, 255 - a, a);
             fx += dx;
         } while (++y < stopy);
 
@@ -343,11 +356,28 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     int         istart, istop;
     SkFixed     fstart, slope;
 
-    HLine_SkAntiHairBlitter     hline_blitter;
-    Horish_SkAntiHairBlitter    horish_blitter;
-    VLine_SkAntiHairBlitter     vline_blitter;
-    Vertish_SkAntiHairBlitter   vertish_blitter;
-    SkAntiHairBlitter*          hairBlitter = nullptr;
+    HLine_SkAntiHairBlitter<SkBlitter>     hline_blitter;
+    Horish_SkAntiHairBlitter<SkBlitter>    horish_blitter;
+    VLine_SkAntiHairBlitter<SkBlitter>     vline_blitter;
+    Vertish_SkAntiHairBlitter<SkBlitter>   vertish_blitter;
+    SkAntiHairBlitter*                     hairBlitter = nullptr;
+
+    // If the whole line lands inside a batch, it can be stepped straight into the batch's mask.
+    SkCoverageBatchBlitter* batch = blitter->asCoverageBatch();
+    if (batch) {
+        SkIRect ir = SkIRect::MakeLTRB(SkFDot6Floor(std::min(x0, x1)) - 1,
+                                       SkFDot6Floor(std::min(y0, y1)) - 1,
+                                       SkFDot6Ceil(std::max(x0, x1)) + 1,
+                                       SkFDot6Ceil(std::max(y0, y1)) + 1);
+        if (!batch->bounds().contains(ir)) {
+            batch = nullptr;
+        }
+    }
+    HLine_SkAntiHairBlitter<SkCoverageBatchBlitter>     batch_hline_blitter;
+    Horish_SkAntiHairBlitter<SkCoverageBatchBlitter>    batch_horish_blitter;
+    VLine_SkAntiHairBlitter<SkCoverageBatchBlitter>     batch_vline_blitter;
+    Vertish_SkAntiHairBlitter<SkCoverageBatchBlitter>   batch_vertish_blitter;
+    SkAntiHairBlitter*                                  batchHairBlitter = nullptr;
 
     if (SkAbs32(x1 - x0) > SkAbs32(y1 - y0)) {   // mostly horizontal
         if (x0 > x1) {    // we want to go left-to-right
@@ -362,11 +392,13 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
         if (y0 == y1) {   // completely horizontal, take fast case
             slope = 0;
             hairBlitter = &hline_blitter;
+            batchHairBlitter = &batch_hline_blitter;
         } else {
             slope = fastfixdiv(y1 - y0, x1 - x0);
             SkASSERT(slope >= -SK_Fixed1 && slope <= SK_Fixed1);
             fstart += (slope * (32 - (x0 & 63)) + 32) >> 6;
             hairBlitter = &horish_blitter;
+            batchHairBlitter = &batch_horish_blitter;
         }
 
         SkASSERT(istop > istart);
@@ -439,11 +471,13 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
             }
             slope = 0;
             hairBlitter = &vline_blitter;
+            batchHairBlitter = &batch_vline_blitter;
         } else {
             slope = fastfixdiv(x1 - x0, y1 - y0);
             SkASSERT(slope <= SK_Fixed1 && slope >= -SK_Fixed1);
             fstart += (slope * (32 - (y0 & 63)) + 32) >> 6;
             hairBlitter = &vertish_blitter;
+            batchHairBlitter = &batch_vertish_blitter;
         }
 
         SkASSERT(istop > istart);
@@ -506,6 +540,8 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     if (clip) {
         rectClipper.init(blitter, *clip);
         blitter = &rectClipper;
+    } else if (batch) {
+        hairBlitter = batchHairBlitter;
     }
 
     SkASSERT(hairBlitter);
@@ -0,0 +1,410 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/SkNx.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkLineClipper.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkScan.h"
+
+#include <algorithm>
+#include <vector>
+
+/*
+
+A "sparse strips" coverage rasterizer for paths with many edges.
+
+Rather than walking a sorted list of active edges one scan line at a time (as the analytic and
+supersampling fillers do), we cut every line of the flattened path into pieces that each lie in
+a single 16x16 tile, and sort the pieces by tile. Each tile row is then resolved from left to
+right:
+
+  - The pieces of a tile accumulate signed area into a small buffer, exactly like a dense
+    accumulation rasterizer would (each piece adds the area to the left of it in every pixel it
+    crosses, and its remaining height to the pixel just after it).
+  - A running prefix sum across the tile turns that into winding per pixel, which the fill rule
+    turns into coverage. The prefix sums run over all 16 rows of the tile at once.
+  - What's left at the tile's right edge is the winding of each of its rows, carried to the next
+    tile. Columns between touched tiles have that constant winding, so they are either skipped,
+    blitted as a solid rect, or (rarely, when a vertex lands inside a row) filled with a
+    constant partial coverage.
+
+Consecutive touched tiles are collected into one A8 strip and handed to the blitter with a
+single blitMask(), so the blitter sees a handful of calls per 16 rows instead of one per row.
+Work is proportional to the number of tiles the outline crosses, not to the number of active
+edges on each scan line.
+
+Like other accumulation rasterizers this computes winding per pixel from summed area, so it is
+exact for edges that don't cross inside a pixel, and a close approximation where they do.
+
+*/
+
+namespace {
+
+constexpr int kTileSize = 16;
+
+// A tile accumulates into two more columns than it has: they receive the area of pieces at (or
+// rounding past) the tile's right edge, and only contribute to the carry.
+constexpr int kAccColumns = kTileSize + 2;
+
+// The largest number of lines we flatten a single curve into.
+constexpr int kMaxCurveLines = 100;
+
+// How far (in pixels) a flattened curve may stray from the real one.
+constexpr float kFlattenTolerance = 0.05f;
+
+// A piece of a line that lies within a single tile, in that tile's coordinates.
+struct Piece {
+    uint32_t fKey;  // tile row << 16 | tile column, so sorting by key groups pieces by tile
+    float    fX0, fY0, fX1, fY1;
+};
+
+class SparseStripsRasterizer {
+public:
+    explicit SparseStripsRasterizer(const SkIRect& bounds)
+            : fBounds(bounds)
+            , fClip(SkRect::Make(bounds))
+            , fColumns((bounds.width() + kTileSize - 1) / kTileSize) {}
+
+    void addPath(const SkPathView& path) {
+        fPieces.reserve(2 * path.fPoints.size());
+
+        SkAutoConicToQuads quadder;
+        SkPathEdgeIter iter(path);
+        while (auto e = iter.next()) {
+            switch (e.fEdge) {
+                case SkPathEdgeIter::Edge::kLine:
+                    this->addLine(e.fPts[0], e.fPts[1]);
+                    break;
+                case SkPathEdgeIter::Edge::kQuad:
+                    this->addQuad(e.fPts);
+                    break;
+                case SkPathEdgeIter::Edge::kConic: {
+                    const SkPoint* quadPts = quadder.computeQuads(e.fPts, iter.conicWeight(),
+                                                                  kFlattenTolerance);
+                    for (int i = 0; i < quadder.countQuads(); ++i) {
+                        this->addQuad(quadPts + 2 * i);
+                    }
+                } break;
+                case SkPathEdgeIter::Edge::kCubic:
+                    this->addCubic(e.fPts);
+                    break;
+            }
+        }
+    }
+
+    void resolve(SkBlitter* blitter, bool evenOdd);
+
+private:
+    void addQuad(const SkPoint pts[3]) {
+        // The distance from a quad to its chords is at most |p0 - 2p1 + p2| / (4n^2).
+        SkVector dd = pts[0] - pts[1] * 2 + pts[2];
+        int n = num_lines(dd.length() / (4 * kFlattenTolerance));
+
+        SkPoint prev = pts[0];
+        for (int i = 1; i < n; ++i) {
+            float t = (float)i / n, s = 1 - t;
+            SkPoint p = pts[0] * (s * s) + pts[1] * (2 * s * t) + pts[2] * (t * t);
+            this->addLine(prev, p);
+            prev = p;
+        }
+        this->addLine(prev, pts[2]);
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        // The distance from a cubic to its chords is at most 3 max|p_i - 2p_i+1 + p_i+2| / (4n^2).
+        SkVector dd0 = pts[0] - pts[1] * 2 + pts[2],
+                 dd1 = pts[1] - pts[2] * 2 + pts[3];
+        int n = num_lines(3 * std::max(dd0.length(), dd1.length()) / (4 * kFlattenTolerance));
+
+        SkPoint prev = pts[0];
+        for (int i = 1; i < n; ++i) {
+            float t = (float)i / n, s = 1 - t;
+            SkPoint p = pts[0] * (s * s * s) + pts[1] * (3 * s * s * t) +
+                        pts[2] * (3 * s * t * t) + pts[3] * (t * t * t);
+            this->addLine(prev, p);
+            prev = p;
+        }
+        this->addLine(prev, pts[3]);
+    }
+
+    static int num_lines(float nSquared) {
+        // Written so that NaN ends up as a single line.
+        return nSquared > 1 ? (int)std::min(std::ceil(std::sqrt(nSquared)),
+                                            (float)kMaxCurveLines)
+                            : 1;
+    }
+
+    void addLine(const SkPoint& p0, const SkPoint& p1) {
+        // Lines to the right of the clip can't affect it. Lines to its left are replaced with
+        // vertical lines along its left edge, which contribute the same winding.
+        const SkPoint pts[2] = {p0, p1};
+        SkPoint lines[SkLineClipper::kMaxPoints];
+        int count = SkLineClipper::ClipLine(pts, fClip, lines, true);
+        for (int i = 0; i < count; ++i) {
+            this->binLine(lines[i].fX - fBounds.fLeft, lines[i].fY - fBounds.fTop,
+                          lines[i + 1].fX - fBounds.fLeft, lines[i + 1].fY - fBounds.fTop);
+        }
+    }
+
+    // Cuts a line (relative to fBounds) into the pieces that lie within each tile.
+    void binLine(float x0, float y0, float x1, float y1) {
+        if (!(y0 != y1)) {
+            return;
+        }
+        const bool down = y0 < y1;
+        if (!down) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+        const float dxdy = (x1 - x0) / (y1 - y0);
+        const float maxX = (float)(fColumns * kTileSize);
+
+        for (int row = (int)(y0 * (1.0f / kTileSize)); row * kTileSize < y1; ++row) {
+            const float rowTop = (float)(row * kTileSize);
+            const float ya = std::max(y0, rowTop),
+                        yb = std::min(y1, rowTop + kTileSize);
+            if (!(ya < yb)) {
+                continue;
+            }
+            const float xa = SkTPin(x0 + (ya - y0) * dxdy, 0.0f, maxX),
+                        xb = SkTPin(x0 + (yb - y0) * dxdy, 0.0f, maxX);
+
+            const int c0 = std::min((int)(std::min(xa, xb) * (1.0f / kTileSize)), fColumns - 1),
+                      c1 = std::min((int)(std::max(xa, xb) * (1.0f / kTileSize)), fColumns - 1);
+            if (c0 == c1) {
+                this->addPiece(row, c0, xa, ya, xb, yb, down);
+                continue;
+            }
+
+            // Split at each tile column we cross, walking from xa to xb.
+            const float dydx = (yb - ya) / (xb - xa);
+            const int step = xa < xb ? 1 : -1;
+            float px = xa, py = ya;
+            for (int c = xa < xb ? c0 : c1; ; c += step) {
+                if (c == (xa < xb ? c1 : c0)) {
+                    this->addPiece(row, c, px, py, xb, yb, down);
+                    break;
+                }
+                const float edge = (float)((step > 0 ? c + 1 : c) * kTileSize);
+                const float ey = std::min(ya + (edge - xa) * dydx, yb);
+                this->addPiece(row, c, px, py, edge, ey, down);
+                px = edge;
+                py = ey;
+            }
+        }
+    }
+
+    void addPiece(int row, int column, float x0, float y0, float x1, float y1, bool down) {
+        if (y0 == y1) {
+            return;
+        }
+        const float left = (float)(column * kTileSize),
+                    top  = (float)(row * kTileSize);
+        Piece piece = {(uint32_t)row << 16 | (uint32_t)column,
+                       x0 - left, y0 - top, x1 - left, y1 - top};
+        if (!down) {
+            std::swap(piece.fX0, piece.fX1);
+            std::swap(piece.fY0, piece.fY1);
+        }
+        fPieces.push_back(piece);
+    }
+
+    const SkIRect      fBounds;
+    const SkRect       fClip;
+    const int          fColumns;
+    std::vector<Piece> fPieces;
+};
+
+// Adds a piece's signed area to a tile's accumulation buffer, which is stored column-major:
+// acc[x * kTileSize + y].
+void accumulate(const Piece& piece, float* acc) {
+    float x0 = piece.fX0, y0 = piece.fY0,
+          x1 = piece.fX1, y1 = piece.fY1;
+    float dir = 1.0f;
+    if (y0 > y1) {
+        dir = -1.0f;
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    y0 = SkTPin(y0, 0.0f, (float)kTileSize);
+    y1 = SkTPin(y1, 0.0f, (float)kTileSize);
+    if (!(y0 < y1)) {
+        return;
+    }
+
+    auto at = [acc](int x, int y) -> float& { return acc[x * kTileSize + y]; };
+    const float dxdy = (x1 - x0) / (y1 - y0);
+    const int yEnd = std::min(kTileSize, (int)std::ceil(y1));
+    float x = x0;
+    for (int y = (int)y0; y < yEnd; ++y) {
+        const float dy = std::min((float)(y + 1), y1) - std::max((float)y, y0);
+        const float xNext = SkTPin(x + dxdy * dy, 0.0f, (float)kTileSize);
+        const float d = dy * dir;
+        const float xa = std::min(x, xNext),
+                    xb = std::max(x, xNext);
+        const float xaFloor = std::floor(xa),
+                    xbCeil  = std::ceil(xb);
+        const int xai = (int)xaFloor,
+                  xbi = (int)xbCeil;
+        if (xbi <= xai + 1) {
+            // Within a single pixel.
+            const float xMid = 0.5f * (x + xNext) - xaFloor;
+            at(xai, y)     += d - d * xMid;
+            at(xai + 1, y) += d * xMid;
+        } else {
+            const float s = 1.0f / (xb - xa);
+            const float xaFrac = xa - xaFloor;
+            const float a0 = 0.5f * s * (1 - xaFrac) * (1 - xaFrac);
+            const float xbFrac = xb - xbCeil + 1;
+            const float am = 0.5f * s * xbFrac * xbFrac;
+            at(xai, y) += d * a0;
+            if (xbi == xai + 2) {
+                at(xai + 1, y) += d * (1 - a0 - am);
+            } else {
+                const float a1 = s * (1.5f - xaFrac);
+                at(xai + 1, y) += d * (a1 - a0);
+                for (int xi = xai + 2; xi < xbi - 1; ++xi) {
+                    at(xi, y) += d * s;
+                }
+                const float a2 = a1 + (xbi - xai - 3) * s;
+                at(xbi - 1, y) += d * (1 - a2 - am);
+            }
+            at(xbi, y) += d * am;
+        }
+        x = xNext;
+    }
+}
+
+// Turns winding (for 16 rows) into alpha with the path's fill rule.
+Sk16b winding_to_alpha(const Sk16f& winding, bool evenOdd) {
+    Sk16f w = winding.abs();
+    if (evenOdd) {
+        w = w - 2.0f * (0.5f * w).floor();
+        w = Sk16f::Min(w, 2.0f - w);
+    }
+    return SkNx_cast<uint8_t>(Sk16f::Min(w, 1.0f) * 255.0f + 0.5f);
+}
+
+void SparseStripsRasterizer::resolve(SkBlitter* blitter, bool evenOdd) {
+    std::sort(fPieces.begin(), fPieces.end(),
+              [](const Piece& a, const Piece& b) { return a.fKey < b.fKey; });
+
+    // One tile row's worth of alpha; we blit runs of touched tiles out of it as strips.
+    const size_t rowBytes = fColumns * kTileSize;
+    SkAutoTMalloc<uint8_t> strip(rowBytes * kTileSize);
+    float acc[kAccColumns * kTileSize];
+
+    const Piece* piece = fPieces.data();
+    const Piece* end = piece + fPieces.size();
+    while (piece < end) {
+        const int row = piece->fKey >> 16;
+        const int top = fBounds.fTop + row * kTileSize;
+        const int rows = std::min(kTileSize, fBounds.fBottom - top);
+
+        Sk16f carry(0.0f);
+        int stripStart = -1,  // first tile column of the pending strip, if any
+            column = 0;       // first tile column we haven't resolved yet
+
+        auto flushStrip = [&]() {
+            if (stripStart >= 0) {
+                SkMask mask;
+                mask.fImage = strip.get() + stripStart * kTileSize;
+                mask.fBounds = SkIRect::MakeLTRB(fBounds.fLeft + stripStart * kTileSize, top,
+                                                 fBounds.fLeft + column * kTileSize,
+                                                 top + kTileSize);
+                mask.fRowBytes = SkToU32(rowBytes);
+                mask.fFormat = SkMask::kA8_Format;
+                SkIRect clip = mask.fBounds;
+                if (clip.intersect(fBounds)) {
+                    blitter->blitMask(mask, clip);
+                }
+                stripStart = -1;
+            }
+        };
+
+        // Resolves the columns up to 'next', which no piece touches, from the carried winding.
+        auto fillGap = [&](int next) {
+            if (column >= next) {
+                return;
+            }
+            uint8_t alpha[kTileSize];
+            winding_to_alpha(carry, evenOdd).store(alpha);
+            bool transparent = true,
+                 opaque = true;
+            for (int i = 0; i < rows; ++i) {
+                transparent &= alpha[i] == 0;
+                opaque &= alpha[i] == 0xFF;
+            }
+            if (transparent || opaque) {
+                flushStrip();
+                if (opaque) {
+                    const int left = fBounds.fLeft + column * kTileSize,
+                              right = std::min(fBounds.fLeft + next * kTileSize, fBounds.fRight);
+                    blitter->blitRect(left, top, right - left, rows);
+                }
+            } else {
+                if (stripStart < 0) {
+                    stripStart = column;
+                }
+                for (int i = 0; i < kTileSize; ++i) {
+                    memset(strip.get() + i * rowBytes + column * kTileSize, alpha[i],
+                           (next - column) * kTileSize);
+                }
+            }
+            column = next;
+        };
+
+        for (; piece < end && (int)(piece->fKey >> 16) == row; ) {
+            const int tile = piece->fKey & 0xFFFF;
+            fillGap(tile);
+
+            sk_bzero(acc, sizeof(acc));
+            for (; piece < end && piece->fKey == ((uint32_t)row << 16 | (uint32_t)tile);
+                 ++piece) {
+                accumulate(*piece, acc);
+            }
+
+            // Sum across the tile, all 16 rows at a time.
+            if (stripStart < 0) {
+                stripStart = tile;
+            }
+            uint8_t* dst = strip.get() + tile * kTileSize;
+            Sk16f winding = carry;
+            for (int x = 0; x < kTileSize; ++x) {
+                winding = winding + Sk16f::Load(acc + x * kTileSize);
+                uint8_t alpha[kTileSize];
+                winding_to_alpha(winding, evenOdd).store(alpha);
+                for (int i = 0; i < kTileSize; ++i) {
+                    dst[i * rowBytes + x] = alpha[i];
+                }
+            }
+            carry = winding + Sk16f::Load(acc + kTileSize * kTileSize)
+                            + Sk16f::Load(acc + (kTileSize + 1) * kTileSize);
+            column = tile + 1;
+        }
+        fillGap(fColumns);
+        flushStrip();
+    }
+}
+
+}  // namespace
+
+void SkScan::SparseStripsFillPath(const SkPathView& path, SkBlitter* blitter, const SkIRect& ir,
+                                  const SkIRect& clipBounds) {
+    SkASSERT(!path.isInverseFillType());
+
+    SkIRect bounds;
+    if (!bounds.intersect(ir, clipBounds)) {
+        return;
+    }
+    SparseStripsRasterizer rasterizer(bounds);
+    rasterizer.addPath(path);
+    rasterizer.resolve(blitter, path.fFillType == SkPathFillType::kEvenOdd);
+}
@@ -85,6 +85,13 @@ public:
             return glyphs;
         }
 
+        SkSpan<const SkGlyph*> metrics(SkSpan<const SkPackedGlyphID> glyphIDs,
+                                       const SkGlyph* results[]) {
+            auto [glyphs, increase] = fScalerCache.metrics(glyphIDs, results);
+            this->updateDelta(increase);
+            return glyphs;
+        }
+
         SkSpan<const SkGlyph*> preparePaths(SkSpan<const SkGlyphID> glyphIDs,
                                             const SkGlyph* results[]) {
             auto [glyphs, increase] = fScalerCache.preparePaths(glyphIDs, results);
@@ -104,6 +111,12 @@ public:
             this->updateDelta(increase);
         }
 
+        void prepareForSDFTDrawingCPU(
+                SkDrawableGlyphBuffer* drawables, SkSourceGlyphBuffer* rejects) {
+            size_t increase = fScalerCache.prepareForSDFTDrawingCPU(drawables, rejects);
+            this->updateDelta(increase);
+        }
+
         const SkGlyphPositionRoundingSpec& roundingSpec() const override {
             return fScalerCache.roundingSpec();
         }
@@ -185,6 +198,9 @@ public:
     int  getCachePointSizeLimit() const SK_EXCLUDES(fLock);
     int  setCachePointSizeLimit(int limit) SK_EXCLUDES(fLock);
 
+    // Call visitor with each strike, most recently used first, holding the cache's lock.
+    void forEachStrike(std::function<void(const Strike&)> visitor) const SK_EXCLUDES(fLock);
+
 private:
     sk_sp<Strike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
     sk_sp<Strike> internalCreateStrike(
@@ -205,8 +221,6 @@ private:
     // A simple accounting of what each glyph cache reports and the strike cache total.
     void validate() const SK_REQUIRES(fLock);
 
-    void forEachStrike(std::function<void(const Strike&)> visitor) const SK_EXCLUDES(fLock);
-
     mutable SkSpinlock fLock;
     Strike* fHead SK_GUARDED_BY(fLock) {nullptr};
     Strike* fTail SK_GUARDED_BY(fLock) {nullptr};
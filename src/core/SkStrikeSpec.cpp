@@ -10,11 +10,11 @@
 #include "include/core/SkGraphics.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkSDFMaskFilter.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTLazy.h"
 
 #if SK_SUPPORT_GPU
-#include "src/gpu/text/GrSDFMaskFilter.h"
 #include "src/gpu/text/GrSDFTOptions.h"
 #include "src/gpu/text/GrStrikeCache.h"
 #endif
@@ -159,6 +159,59 @@ bool SkStrikeSpec::ShouldDrawAsPath(
         || distance(SkMatrix::kMSkewX,  SkMatrix::kMScaleY) > maxSizeSquared;
 }
 
+// The reference sizes of raster distance field strikes, and the device text sizes they cover. They
+// match the sizes GrSDFTOptions uses for the GPU.
+static constexpr SkScalar kMinSDFTextSize    = 18;
+static constexpr SkScalar kSmallSDFTextSize  = 32;
+static constexpr SkScalar kMediumSDFTextSize = 72;
+static constexpr SkScalar kLargeSDFTextSize  = 162;
+static constexpr SkScalar kMaxSDFTextSize    = 324;
+
+bool SkStrikeSpec::ShouldDrawAsSDF(const SkPaint& paint, const SkFont& font,
+                                   const SkMatrix& viewMatrix, const SkSurfaceProps& surfaceProps) {
+    // Mask filters modify alpha, which doesn't translate well to distance, and there's no stroking.
+    if (!surfaceProps.isUseDeviceIndependentFonts() ||
+        paint.getMaskFilter() || paint.getStyle() != SkPaint::kFill_Style) {
+        return false;
+    }
+
+    // Paths look better in perspective, and hinted masks look better at small sizes.
+    if (viewMatrix.hasPerspective()) {
+        return false;
+    }
+    SkScalar scaledTextSize = viewMatrix.getMaxScale() * font.getSize();
+    return kMinSDFTextSize <= scaledTextSize && scaledTextSize <= kMaxSDFTextSize;
+}
+
+SkStrikeSpec SkStrikeSpec::MakeSDF(const SkFont& font, const SkPaint& paint,
+                                   const SkSurfaceProps& surfaceProps,
+                                   const SkMatrix& deviceMatrix) {
+    SkStrikeSpec storage;
+
+    SkScalar textSize = font.getSize(),
+             scaledTextSize = deviceMatrix.getMaxScale() * textSize;
+    SkScalar referenceSize = scaledTextSize <= kSmallSDFTextSize  ? kSmallSDFTextSize
+                           : scaledTextSize <= kMediumSDFTextSize ? kMediumSDFTextSize
+                                                                  : kLargeSDFTextSize;
+    storage.fStrikeToSourceRatio = textSize / referenceSize;
+
+    SkFont dfFont{font};
+    dfFont.setSize(referenceSize);
+    dfFont.setEdging(SkFont::Edging::kAntiAlias);
+    dfFont.setForceAutoHinting(false);
+    dfFont.setHinting(SkFontHinting::kNormal);
+    // The glyphs are positioned exactly when they're mapped to the device.
+    dfFont.setSubpixel(false);
+
+    SkPaint dfPaint{paint};
+    dfPaint.setMaskFilter(SkSDFMaskFilter::Make());
+
+    // Fake gamma and contrast boost make no sense for distances.
+    storage.commonSetup(dfFont, dfPaint, surfaceProps, SkScalerContextFlags::kNone, SkMatrix::I());
+
+    return storage;
+}
+
 SkStrikeSpec SkStrikeSpec::MakePDFVector(const SkTypeface& typeface, int* size) {
     SkFont font;
     font.setHinting(SkFontHinting::kNone);
@@ -191,7 +244,7 @@ SkStrikeSpec::MakeSDFT(const SkFont& font, const SkPaint& paint,
     SkStrikeSpec storage;
 
     SkPaint dfPaint{paint};
-    dfPaint.setMaskFilter(GrSDFMaskFilter::Make());
+    dfPaint.setMaskFilter(SkSDFMaskFilter::Make());
     SkFont dfFont = options.getSDFFont(font, deviceMatrix, &storage.fStrikeToSourceRatio);
 
     // Fake-gamma and subpixel antialiasing are applied in the shader, so we ignore the
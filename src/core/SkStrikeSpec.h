@@ -60,6 +60,15 @@ public:
     // Make a strike spec for PDF Vector strikes
     static SkStrikeSpec MakePDFVector(const SkTypeface& typeface, int* size);
 
+    // Create a strike spec for distance field text drawn by a raster device. The glyphs are made
+    // at one of a few reference sizes, so every size and scale of the font that falls in the same
+    // bucket shares the strike; strikeToSourceRatio() maps the reference size back to the font's.
+    static SkStrikeSpec MakeSDF(
+            const SkFont& font,
+            const SkPaint& paint,
+            const SkSurfaceProps& surfaceProps,
+            const SkMatrix& deviceMatrix);
+
 #if SK_SUPPORT_GPU
     // Create a strike spec for scaled distance field text.
     static std::tuple<SkStrikeSpec, SkScalar, SkScalar> MakeSDFT(
@@ -81,6 +90,10 @@ public:
     bool isEmpty() const { return SkScalarNearlyZero(fStrikeToSourceRatio); }
     const SkDescriptor& descriptor() const { return *fAutoDescriptor.getDesc(); }
     static bool ShouldDrawAsPath(const SkPaint& paint, const SkFont& font, const SkMatrix& matrix);
+    // Whether a raster device should draw the text from a distance field strike (see MakeSDF).
+    // Only done when the surface asks for device independent fonts.
+    static bool ShouldDrawAsSDF(const SkPaint& paint, const SkFont& font, const SkMatrix& matrix,
+                                const SkSurfaceProps& surfaceProps);
 
 private:
     void commonSetup(
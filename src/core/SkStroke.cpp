@@ -158,7 +158,8 @@ struct SkQuadConstruct {    // The state of the quad stroke under construction.
 
 class SkPathStroker {
 public:
-    SkPathStroker(const SkPath& src,
+    // srcPointCount is the number of points to be stroked, to guess how big the result will be.
+    SkPathStroker(int srcPointCount,
                   SkScalar radius, SkScalar miterLimit, SkPaint::Cap,
                   SkPaint::Join, SkScalar resScale,
                   bool canIgnoreCenter);
@@ -173,6 +174,19 @@ public:
     void cubicTo(const SkPoint&, const SkPoint&, const SkPoint&);
     void close(bool isLine) { this->finishContour(true, isLine); }
 
+    // Starts a contour at pt, joined to a segment that arrives there with 'tangent' but isn't
+    // stroked itself. The stroke starts cut square across that tangent.
+    void moveToAfter(const SkPoint& pt, const SkVector& tangent);
+    // Joins the last segment to one that leaves with 'tangent' but isn't stroked, and ends the
+    // contour cut square across that tangent.
+    void finishBefore(const SkVector& tangent);
+    // Cuts the ends of the current contour square, where it continues past what's stroked.
+    void cutStart() { fStartCapper = SkStrokerPriv::CapFactory(SkPaint::kButt_Cap); }
+    void cutEnd() { fEndCapper = SkStrokerPriv::CapFactory(SkPaint::kButt_Cap); }
+    // strokePath() caps the start of an open contour according to whether its last segment is a
+    // line. Where the contour continues past what's stroked, this supplies that instead.
+    void setStartCapIsLine(bool isLine) { fStartCapIsLine = isLine; }
+
     void done(SkPath* dst, bool isLine) {
         this->finishContour(false, isLine);
         dst->swap(fOuter);
@@ -198,9 +212,11 @@ private:
     int         fFirstOuterPtIndexInContour;
     int         fSegmentCount;
     bool        fPrevIsLine;
+    int         fStartCapIsLine;  // -1 to use fPrevIsLine, see setStartCapIsLine()
     bool        fCanIgnoreCenter;
 
     SkStrokerPriv::CapProc  fCapper;
+    SkStrokerPriv::CapProc  fStartCapper, fEndCapper;  // the current contour's
     SkStrokerPriv::JoinProc fJoiner;
 
     SkPath  fInner, fOuter, fCusper; // outer is our working answer, inner is temp
@@ -352,12 +368,13 @@ void SkPathStroker::finishContour(bool close, bool currIsLine) {
         } else {    // add caps to start and end
             // cap the end
             fInner.getLastPt(&pt);
-            fCapper(&fOuter, fPrevPt, fPrevNormal, pt,
-                    currIsLine ? &fInner : nullptr);
+            fEndCapper(&fOuter, fPrevPt, fPrevNormal, pt,
+                       currIsLine ? &fInner : nullptr);
             fOuter.reversePathTo(fInner);
             // cap the start
-            fCapper(&fOuter, fFirstPt, -fFirstNormal, fFirstOuterPt,
-                    fPrevIsLine ? &fInner : nullptr);
+            bool startCapIsLine = fStartCapIsLine < 0 ? fPrevIsLine : fStartCapIsLine != 0;
+            fStartCapper(&fOuter, fFirstPt, -fFirstNormal, fFirstOuterPt,
+                         startCapIsLine ? &fInner : nullptr);
             fOuter.close();
         }
         if (!fCusper.isEmpty()) {
@@ -374,7 +391,7 @@ void SkPathStroker::finishContour(bool close, bool currIsLine) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SkPathStroker::SkPathStroker(const SkPath& src,
+SkPathStroker::SkPathStroker(int srcPointCount,
                              SkScalar radius, SkScalar miterLimit,
                              SkPaint::Cap cap, SkPaint::Join join, SkScalar resScale,
                              bool canIgnoreCenter)
@@ -394,11 +411,12 @@ SkPathStroker::SkPathStroker(const SkPath& src,
             fInvMiterLimit = SkScalarInvert(miterLimit);
         }
     }
-    fCapper = SkStrokerPriv::CapFactory(cap);
+    fCapper = fStartCapper = fEndCapper = SkStrokerPriv::CapFactory(cap);
     fJoiner = SkStrokerPriv::JoinFactory(join);
     fSegmentCount = -1;
     fFirstOuterPtIndexInContour = 0;
     fPrevIsLine = false;
+    fStartCapIsLine = -1;
 
     // Need some estimate of how large our final result (fOuter)
     // and our per-contour temp (fInner) will be, so we don't spend
@@ -406,9 +424,9 @@ SkPathStroker::SkPathStroker(const SkPath& src,
     //
     // 3x for result == inner + outer + join (swag)
     // 1x for inner == 'wag' (worst contour length would be better guess)
-    fOuter.incReserve(src.countPoints() * 3);
+    fOuter.incReserve(srcPointCount * 3);
     fOuter.setIsVolatile(true);
-    fInner.incReserve(src.countPoints());
+    fInner.incReserve(srcPointCount);
     fInner.setIsVolatile(true);
     // TODO : write a common error function used by stroking and filling
     // The '4' below matches the fill scan converter's error term
@@ -424,6 +442,39 @@ void SkPathStroker::moveTo(const SkPoint& pt) {
     fSegmentCount = 0;
     fFirstPt = fPrevPt = pt;
     fJoinCompleted = false;
+    fStartCapper = fEndCapper = fCapper;
+    fStartCapIsLine = -1;
+}
+
+void SkPathStroker::moveToAfter(const SkPoint& pt, const SkVector& tangent) {
+    this->moveTo(pt);
+    this->cutStart();
+    SkVector normal, unitNormal;
+    if (!set_normal_unitnormal(tangent, fRadius, &normal, &unitNormal)) {
+        return;
+    }
+    // Start as if the segment before had just been stroked, so the next one joins to it. That
+    // segment isn't a line here, so joins add their own points rather than moving its end.
+    fFirstNormal = fPrevNormal = normal;
+    fFirstUnitNormal = fPrevUnitNormal = unitNormal;
+    fFirstOuterPt = pt + normal;
+    fOuter.moveTo(fFirstOuterPt);
+    fInner.moveTo(pt - normal);
+    fPrevIsLine = false;
+    fJoinCompleted = true;
+    fSegmentCount = 1;
+}
+
+void SkPathStroker::finishBefore(const SkVector& tangent) {
+    SkVector normal, unitNormal;
+    if (fSegmentCount > 0 && set_normal_unitnormal(tangent, fRadius, &normal, &unitNormal)) {
+        fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt, unitNormal, fRadius, fInvMiterLimit,
+                fPrevIsLine, false);
+        fPrevNormal = normal;
+        fPrevUnitNormal = unitNormal;
+    }
+    this->cutEnd();
+    this->finishContour(false, false);
 }
 
 void SkPathStroker::line_to(const SkPoint& currPt, const SkVector& normal) {
@@ -1448,7 +1499,7 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
     bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
                         src.isLastContourClosed() && src.isConvex();
 
-    SkPathStroker   stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
+    SkPathStroker   stroker(src.countPoints(), radius, fMiterLimit, this->getCap(), this->getJoin(),
                             fResScale, ignoreCenter);
     SkPath::Iter    iter(src, false);
     SkPath::Verb    lastSegment = SkPath::kMove_Verb;
@@ -1538,6 +1589,186 @@ DONE:
     }
 }
 
+// The direction a segment leaves its first point in, or zero if the segment has no length.
+static SkVector start_tangent(const SkPoint pts[], int count) {
+    for (int i = 1; i < count; ++i) {
+        if (pts[i] != pts[0]) {
+            return pts[i] - pts[0];
+        }
+    }
+    return {0, 0};
+}
+
+// The direction a segment arrives at its last point in, or zero if the segment has no length.
+static SkVector end_tangent(const SkPoint pts[], int count) {
+    for (int i = count - 2; i >= 0; --i) {
+        if (pts[i] != pts[count - 1]) {
+            return pts[count - 1] - pts[i];
+        }
+    }
+    return {0, 0};
+}
+
+void SkStroke::strokePathRange(const SkPath& src, int verbBegin, int verbEnd, SkPath* dst) const {
+    SkASSERT(dst);
+    dst->reset();
+
+    const int verbCount = src.countVerbs();
+    verbBegin = std::max(verbBegin, 0);
+    verbEnd = std::min(verbEnd, verbCount);
+    SkScalar radius = SkScalarHalf(fWidth);
+    if (radius <= 0 || verbBegin >= verbEnd || !src.isFinite()) {
+        return;
+    }
+
+    const uint8_t* verbs = SkPathPriv::VerbData(src);
+    const SkPoint* pts = SkPathPriv::PointData(src);
+    const SkScalar* weights = SkPathPriv::ConicWeightData(src);
+
+    // Where the contour continues outside the range, we need to know whether it's closed, and
+    // which way its first segment leaves, to join the close to it. If it's open, its start cap
+    // depends on whether its last segment (with any length) is a line.
+    struct Contour {
+        SkPoint  fStart;
+        SkVector fStartTangent;
+        bool     fClosed;
+        int      fCloseVerb;
+        bool     fLastIsLine;
+    } contour = {{0, 0}, {0, 0}, false, verbCount, false};
+    auto findContour = [&](int moveVerb, int movePt) {
+        contour = {pts[movePt], {0, 0}, false, verbCount, false};
+        int ptIndex = movePt + 1;
+        for (int i = moveVerb + 1; i < verbCount; ++i) {
+            const unsigned verb = verbs[i];
+            if (SkPath::kMove_Verb == verb) {
+                break;
+            }
+            if (SkPath::kClose_Verb == verb) {
+                contour.fClosed = true;
+                contour.fCloseVerb = i;
+                break;
+            }
+            const int count = SkPathPriv::PtsInVerb(verb);
+            if (contour.fStartTangent.isZero()) {
+                contour.fStartTangent = start_tangent(pts + ptIndex - 1, count + 1);
+            }
+            if (!end_tangent(pts + ptIndex - 1, count + 1).isZero()) {
+                contour.fLastIsLine = SkPath::kLine_Verb == verb;
+            }
+            ptIndex += count;
+        }
+    };
+
+    // Find the points and weights of the first verb, and whether it continues a contour.
+    int ptIndex = 0, weightIndex = 0;
+    int moveVerb = -1, movePt = 0;
+    SkVector prevTangent = {0, 0};
+    for (int i = 0; i < verbBegin; ++i) {
+        const unsigned verb = verbs[i];
+        const int count = SkPathPriv::PtsInVerb(verb);
+        if (SkPath::kMove_Verb == verb) {
+            moveVerb = i;
+            movePt = ptIndex;
+            prevTangent = {0, 0};
+        } else if (SkPath::kClose_Verb == verb) {
+            moveVerb = -1;
+        } else {
+            SkVector tangent = end_tangent(pts + ptIndex - 1, count + 1);
+            if (!tangent.isZero()) {
+                prevTangent = tangent;
+            }
+        }
+        ptIndex += count;
+        weightIndex += SkPath::kConic_Verb == verb;
+    }
+
+    int rangePointCount = 0;
+    for (int i = verbBegin; i < verbEnd; ++i) {
+        rangePointCount += SkPathPriv::PtsInVerb(verbs[i]);
+    }
+    SkPathStroker stroker(rangePointCount, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                          fResScale, false);
+    SkPath::Verb lastSegment = SkPath::kLine_Verb;
+    // Whether the current contour starts inside the range, so its close can be stroked normally.
+    bool startInRange = true;
+    if (moveVerb >= 0 && SkPath::kMove_Verb != verbs[verbBegin]) {
+        findContour(moveVerb, movePt);
+        const SkPoint& lastPt = pts[ptIndex - 1];
+        if (!prevTangent.isZero()) {
+            stroker.moveToAfter(lastPt, prevTangent);
+            startInRange = false;
+        } else {
+            // Everything before the range has no length, so this is where the stroke starts.
+            stroker.moveTo(lastPt);
+            if (contour.fClosed && contour.fCloseVerb >= verbEnd) {
+                stroker.cutStart();
+            }
+        }
+    }
+
+    for (int i = verbBegin; i < verbEnd; ++i) {
+        const unsigned verb = verbs[i];
+        const SkPoint* p = pts + ptIndex - 1;
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                stroker.moveTo(p[1]);
+                findContour(i, ptIndex);
+                startInRange = true;
+                if (contour.fClosed && contour.fCloseVerb >= verbEnd) {
+                    stroker.cutStart();
+                }
+                break;
+            case SkPath::kLine_Verb:
+                stroker.lineTo(p[1]);
+                lastSegment = SkPath::kLine_Verb;
+                break;
+            case SkPath::kQuad_Verb:
+                stroker.quadTo(p[1], p[2]);
+                lastSegment = SkPath::kQuad_Verb;
+                break;
+            case SkPath::kConic_Verb:
+                stroker.conicTo(p[1], p[2], weights[weightIndex]);
+                lastSegment = SkPath::kConic_Verb;
+                break;
+            case SkPath::kCubic_Verb:
+                stroker.cubicTo(p[1], p[2], p[3]);
+                lastSegment = SkPath::kCubic_Verb;
+                break;
+            case SkPath::kClose_Verb:
+                if (p[0] != contour.fStart) {
+                    stroker.lineTo(contour.fStart);
+                    lastSegment = SkPath::kLine_Verb;
+                }
+                if (!startInRange) {
+                    stroker.finishBefore(contour.fStartTangent);
+                    break;
+                }
+                // As in strokePath(), a contour with no length still gets its caps.
+                if (SkPaint::kButt_Cap != this->getCap() &&
+                        (stroker.hasOnlyMoveTo() || stroker.isCurrentContourEmpty())) {
+                    if (stroker.hasOnlyMoveTo()) {
+                        stroker.lineTo(stroker.moveToPt());
+                    }
+                    lastSegment = SkPath::kLine_Verb;
+                    break;
+                }
+                stroker.close(lastSegment == SkPath::kLine_Verb);
+                break;
+        }
+        const int count = SkPathPriv::PtsInVerb(verb);
+        ptIndex += count;
+        weightIndex += SkPath::kConic_Verb == verb;
+    }
+    // The contour goes on past the range.
+    if (verbEnd < verbCount && SkPath::kMove_Verb != verbs[verbEnd]) {
+        stroker.cutEnd();
+        if (!contour.fClosed) {
+            stroker.setStartCapIsLine(contour.fLastIsLine);
+        }
+    }
+    stroker.done(dst, lastSegment == SkPath::kLine_Verb);
+}
+
 static SkPathDirection reverse_direction(SkPathDirection dir) {
     static const SkPathDirection gOpposite[] = { SkPathDirection::kCCW, SkPathDirection::kCW };
     return gOpposite[(int)dir];
@@ -65,6 +65,21 @@ public:
                        SkPathDirection = SkPathDirection::kCW) const;
     void    strokePath(const SkPath& path, SkPath*) const;
 
+    /**
+     *  Strokes only the verbs [verbBegin, verbEnd) of the path, replacing dst. Where the range
+     *  starts or ends in the middle of a contour, the stroke is cut square across the path, and
+     *  the join with the segment outside the range belongs to the range that comes after it. So
+     *  the strokes of ranges that tile a path fill the same area as strokePath() would, and a
+     *  path can be stroked in chunks on several threads, or just the verbs appended since it was
+     *  last stroked. The fill (see setDoFill) and inverse fill types are left to the caller.
+     *
+     *  strokePath() draws a square start cap differently depending on whether the contour's last
+     *  segment is a line. Where the contour ends outside the range, that is decided from its last
+     *  verb with any length, so a final curve that strokePath() reduces to a line (or a final line
+     *  too short for it to stroke) can still change the pixels next to that cap.
+     */
+    void    strokePathRange(const SkPath& path, int verbBegin, int verbEnd, SkPath*) const;
+
     ////////////////////////////////////////////////////////////////
 
 private:
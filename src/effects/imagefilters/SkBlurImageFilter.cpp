@@ -45,6 +45,8 @@ protected:
     sk_sp<SkSpecialImage> onFilterImage(const Context&, SkIPoint* offset) const override;
     SkIRect onFilterNodeBounds(const SkIRect& src, const SkMatrix& ctm,
                                MapDirection, const SkIRect* inputRect) const override;
+    // The other tile modes sample relative to the input image's edges.
+    bool onCanFilterInTiles() const override { return fTileMode == SkTileMode::kDecal; }
 
 private:
     friend void SkBlurImageFilter::RegisterFlattenables();
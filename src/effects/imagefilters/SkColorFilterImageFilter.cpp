@@ -31,6 +31,7 @@ protected:
     bool onIsColorFilterNode(SkColorFilter**) const override;
     bool onCanHandleComplexCTM() const override { return true; }
     bool affectsTransparentBlack() const override;
+    bool onCanFilterInTiles() const override { return true; }
 
 private:
     friend void SkColorFilterImageFilter::RegisterFlattenables();
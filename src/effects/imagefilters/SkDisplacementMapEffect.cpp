@@ -50,6 +50,7 @@ public:
 
 protected:
     sk_sp<SkSpecialImage> onFilterImage(const Context&, SkIPoint* offset) const override;
+    bool onCanFilterInTiles() const override { return true; }
 
     void flatten(SkWriteBuffer&) const override;
 
@@ -11,11 +11,14 @@
 #include "include/core/SkPoint3.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkNx.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkWriteBuffer.h"
 
+#include <type_traits>
+
 #if SK_SUPPORT_GPU
 #include "include/gpu/GrRecordingContext.h"
 #include "src/gpu/GrCaps.h"
@@ -67,23 +70,56 @@ static inline void shiftMatrixLeft(int m[9]) {
     m[7] = m[8];
 }
 
-static inline void fast_normalize(SkPoint3* vector) {
-    // add a tiny bit so we don't have to worry about divide-by-zero
-    SkScalar magSq = vector->dot(*vector) + SK_ScalarNearlyZero;
+static inline SkScalar fast_rsqrt(SkScalar magSq) {
 #if defined(_MSC_VER) && _MSC_VER >= 1920
     // Visual Studio 2019 has some kind of code-generation bug in release builds involving the
     // lighting math in this file. Using the portable rsqrt avoids the issue. This issue appears
     // to be specific to the collection of (inline) functions in this file that call into this
     // function, not with sk_float_rsqrt itself.
-    SkScalar scale = sk_float_rsqrt_portable(magSq);
+    return sk_float_rsqrt_portable(magSq);
 #else
-    SkScalar scale = sk_float_rsqrt(magSq);
+    return sk_float_rsqrt(magSq);
 #endif
+}
+
+static inline void fast_normalize(SkPoint3* vector) {
+    // add a tiny bit so we don't have to worry about divide-by-zero
+    SkScalar scale = fast_rsqrt(vector->dot(*vector) + SK_ScalarNearlyZero);
     vector->fX *= scale;
     vector->fY *= scale;
     vector->fZ *= scale;
 }
 
+// Four points or vectors in SoA form, so the raster interior can light four pixels at a time.
+struct SkPoint3x4 {
+    Sk4f fX, fY, fZ;
+
+    Sk4f dot(const SkPoint3x4& o) const { return fX * o.fX + fY * o.fY + fZ * o.fZ; }
+
+    SkPoint3 lane(int i) const { return SkPoint3::Make(fX[i], fY[i], fZ[i]); }
+    void setLane(int i, const SkPoint3& p) {
+        // SkNx has no lane setter, so round-trip through memory; this is only used on the
+        // per-lane fallbacks.
+        float x[4], y[4], z[4];
+        fX.store(x); fY.store(y); fZ.store(z);
+        x[i] = p.fX; y[i] = p.fY; z[i] = p.fZ;
+        fX = Sk4f::Load(x); fY = Sk4f::Load(y); fZ = Sk4f::Load(z);
+    }
+};
+
+static inline void fast_normalize(SkPoint3x4* vector) {
+    // Matches fast_normalize(SkPoint3*) lane for lane. Sk4f::rsqrt() is not the same estimate as
+    // sk_float_rsqrt() on every platform (e.g. portable builds compute 1/sqrt), so use the scalar
+    // estimate for each lane.
+    float magSq[4];
+    (vector->dot(*vector) + SK_ScalarNearlyZero).store(magSq);
+    Sk4f scale = {fast_rsqrt(magSq[0]), fast_rsqrt(magSq[1]),
+                  fast_rsqrt(magSq[2]), fast_rsqrt(magSq[3])};
+    vector->fX = vector->fX * scale;
+    vector->fY = vector->fY * scale;
+    vector->fZ = vector->fZ * scale;
+}
+
 static SkPoint3 read_point3(SkReadBuffer& buffer) {
     SkPoint3 point;
     point.fX = buffer.readScalar();
@@ -126,6 +162,23 @@ public:
     virtual SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const = 0;
     virtual SkPoint3 lightColor(const SkPoint3& surfaceToLight) const = 0;
 
+    // Four pixel versions of the above, for the pixels (x, y) through (x + 3, y) whose heights
+    // are 'z'. The defaults evaluate the single pixel versions for each lane.
+    virtual SkPoint3x4 surfaceToLight4(int x, int y, const Sk4i& z, SkScalar surfaceScale) const {
+        SkPoint3x4 result;
+        for (int i = 0; i < 4; ++i) {
+            result.setLane(i, this->surfaceToLight(x + i, y, z[i], surfaceScale));
+        }
+        return result;
+    }
+    virtual SkPoint3x4 lightColor4(const SkPoint3x4& surfaceToLight) const {
+        SkPoint3x4 result;
+        for (int i = 0; i < 4; ++i) {
+            result.setLane(i, this->lightColor(surfaceToLight.lane(i)));
+        }
+        return result;
+    }
+
 protected:
     SkImageFilterLight(SkColor color) {
         fColor = SkPoint3::Make(SkIntToScalar(SkColorGetR(color)),
@@ -153,8 +206,23 @@ public:
 
     virtual SkPMColor light(const SkPoint3& normal, const SkPoint3& surfaceTolight,
                             const SkPoint3& lightColor) const= 0;
+    // Lights four pixels at once, writing them to dst[0..3].
+    virtual void light4(const SkPoint3x4& normal, const SkPoint3x4& surfaceTolight,
+                        const SkPoint3x4& lightColor, SkPMColor dst[4]) const = 0;
 };
 
+// Rounds, pins and packs four colors the same way as the single pixel light() functions.
+static inline void pack_light4(const Sk4f& a, const SkPoint3x4& color, SkPMColor dst[4]) {
+    auto round_pin = [](const Sk4f& v) {
+        return SkNx_cast<int>(Sk4f::Min(Sk4f::Max((v + 0.5f).floor(), 0.0f), 255.0f));
+    };
+    Sk4i pm = (round_pin(a)       << SK_A32_SHIFT) |
+              (round_pin(color.fX) << SK_R32_SHIFT) |
+              (round_pin(color.fY) << SK_G32_SHIFT) |
+              (round_pin(color.fZ) << SK_B32_SHIFT);
+    pm.store(dst);
+}
+
 class DiffuseLightingType : public BaseLightingType {
 public:
     DiffuseLightingType(SkScalar kd)
@@ -169,6 +237,14 @@ public:
                             SkTPin(SkScalarRoundToInt(color.fY), 0, 255),
                             SkTPin(SkScalarRoundToInt(color.fZ), 0, 255));
     }
+    void light4(const SkPoint3x4& normal, const SkPoint3x4& surfaceTolight,
+                const SkPoint3x4& lightColor, SkPMColor dst[4]) const override {
+        Sk4f colorScale = Sk4f::Min(Sk4f::Max(fKD * normal.dot(surfaceTolight), 0.0f), 1.0f);
+        SkPoint3x4 color = {lightColor.fX * colorScale,
+                            lightColor.fY * colorScale,
+                            lightColor.fZ * colorScale};
+        pack_light4(255.0f, color, dst);
+    }
 private:
     SkScalar fKD;
 };
@@ -194,6 +270,24 @@ public:
                             SkTPin(SkScalarRoundToInt(color.fY), 0, 255),
                             SkTPin(SkScalarRoundToInt(color.fZ), 0, 255));
     }
+    void light4(const SkPoint3x4& normal, const SkPoint3x4& surfaceTolight,
+                const SkPoint3x4& lightColor, SkPMColor dst[4]) const override {
+        SkPoint3x4 halfDir = surfaceTolight;
+        halfDir.fZ = halfDir.fZ + SK_Scalar1;   // eye position is always (0, 0, 1)
+        fast_normalize(&halfDir);
+        // There is no vector pow, so the exponentiation is done per lane. The pin stays with it
+        // so that a NaN from a negative base pins to 1 exactly like the scalar path.
+        float scale[4];
+        normal.dot(halfDir).store(scale);
+        for (float& v : scale) {
+            v = SkTPin(fKS * SkScalarPow(v, fShininess), 0.0f, SK_Scalar1);
+        }
+        Sk4f colorScale = Sk4f::Load(scale);
+        SkPoint3x4 color = {lightColor.fX * colorScale,
+                            lightColor.fY * colorScale,
+                            lightColor.fZ * colorScale};
+        pack_light4(Sk4f::Max(Sk4f::Max(color.fX, color.fY), color.fZ), color, dst);
+    }
 private:
     SkScalar fKS;
     SkScalar fShininess;
@@ -284,6 +378,40 @@ public:
     }
 };
 
+// Lights the interior pixels [x, xEnd) of row y four at a time, reading the heights directly from
+// 'src', which must contain every neighbor. Returns the first pixel that was not lit, which is
+// left for the single pixel loop.
+static int lightInterior4(const BaseLightingType& lightingType,
+                          const SkImageFilterLight* l,
+                          const SkBitmap& src,
+                          SkScalar surfaceScale,
+                          int x, int xEnd, int y,
+                          SkPMColor*& dptr) {
+    const SkPMColor* row0 = src.getAddr32(0, y - 1);
+    const SkPMColor* row1 = src.getAddr32(0, y);
+    const SkPMColor* row2 = src.getAddr32(0, y + 1);
+    auto alpha = [](const SkPMColor* p) {
+        return (Sk4i::Load(p) >> SK_A32_SHIFT) & 0xFF;
+    };
+    for (; x + 4 <= xEnd; x += 4) {
+        // The 3x3 neighborhoods of the four pixels, named like m[] in the single pixel path.
+        Sk4i m0 = alpha(row0 + x - 1), m1 = alpha(row0 + x), m2 = alpha(row0 + x + 1),
+             m3 = alpha(row1 + x - 1), m4 = alpha(row1 + x), m5 = alpha(row1 + x + 1),
+             m6 = alpha(row2 + x - 1), m7 = alpha(row2 + x), m8 = alpha(row2 + x + 1);
+
+        // interiorNormal() and pointToNormal()
+        Sk4f nx = SkNx_cast<float>(Sk4i(0) - m0 + m2 - m3 - m3 + m5 + m5 - m6 + m8) * gOneQuarter;
+        Sk4f ny = SkNx_cast<float>(Sk4i(0) - m0 + m6 - m1 - m1 + m7 + m7 - m2 + m8) * gOneQuarter;
+        SkPoint3x4 normal = {nx * -surfaceScale, ny * -surfaceScale, 1.0f};
+        fast_normalize(&normal);
+
+        SkPoint3x4 surfaceToLight = l->surfaceToLight4(x, y, m4, surfaceScale);
+        lightingType.light4(normal, surfaceToLight, l->lightColor4(surfaceToLight), dptr);
+        dptr += 4;
+    }
+    return x;
+}
+
 template <class PixelFetcher>
 static void lightBitmap(const BaseLightingType& lightingType,
                  const SkImageFilterLight* l,
@@ -334,7 +462,18 @@ static void lightBitmap(const BaseLightingType& lightingType,
         SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
         *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
                                      l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
+        ++x;
+        if (std::is_same<PixelFetcher, UncheckedPixelFetcher>::value) {
+            x = lightInterior4(lightingType, l, src, surfaceScale, x, right - 1, y, dptr);
+            // Reload the neighborhood of pixel x - 1, as if the loop below had just lit it.
+            m[1] = PixelFetcher::Fetch(src, x - 1, y - 1, srcBounds);
+            m[2] = PixelFetcher::Fetch(src, x,     y - 1, srcBounds);
+            m[4] = PixelFetcher::Fetch(src, x - 1, y,     srcBounds);
+            m[5] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
+            m[7] = PixelFetcher::Fetch(src, x - 1, y + 1, srcBounds);
+            m[8] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
+        }
+        for (; x < right - 1; ++x) {
             shiftMatrixLeft(m);
             m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
             m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
@@ -855,6 +994,12 @@ public:
         return fDirection;
     }
     SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
+    SkPoint3x4 surfaceToLight4(int, int, const Sk4i&, SkScalar) const override {
+        return {fDirection.fX, fDirection.fY, fDirection.fZ};
+    }
+    SkPoint3x4 lightColor4(const SkPoint3x4&) const override {
+        return {this->color().fX, this->color().fY, this->color().fZ};
+    }
     LightType type() const override { return kDistant_LightType; }
     const SkPoint3& direction() const { return fDirection; }
     GrGLLight* createGLLight() const override {
@@ -911,7 +1056,18 @@ public:
         fast_normalize(&direction);
         return direction;
     }
+    SkPoint3x4 surfaceToLight4(int x, int y, const Sk4i& z,
+                               SkScalar surfaceScale) const override {
+        SkPoint3x4 direction = {fLocation.fX - (SkIntToScalar(x) + Sk4f(0, 1, 2, 3)),
+                                fLocation.fY - SkIntToScalar(y),
+                                fLocation.fZ - SkNx_cast<float>(z) * surfaceScale};
+        fast_normalize(&direction);
+        return direction;
+    }
     SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
+    SkPoint3x4 lightColor4(const SkPoint3x4&) const override {
+        return {this->color().fX, this->color().fY, this->color().fZ};
+    }
     LightType type() const override { return kPoint_LightType; }
     const SkPoint3& location() const { return fLocation; }
     GrGLLight* createGLLight() const override {
@@ -1015,6 +1171,14 @@ public:
         fast_normalize(&direction);
         return direction;
     }
+    SkPoint3x4 surfaceToLight4(int x, int y, const Sk4i& z,
+                               SkScalar surfaceScale) const override {
+        SkPoint3x4 direction = {fLocation.fX - (SkIntToScalar(x) + Sk4f(0, 1, 2, 3)),
+                                fLocation.fY - SkIntToScalar(y),
+                                fLocation.fZ - SkNx_cast<float>(z) * surfaceScale};
+        fast_normalize(&direction);
+        return direction;
+    }
     SkPoint3 lightColor(const SkPoint3& surfaceToLight) const override {
         SkScalar cosAngle = -surfaceToLight.dot(fS);
         SkScalar scale = 0;
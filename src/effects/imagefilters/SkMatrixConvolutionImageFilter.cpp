@@ -12,6 +12,7 @@
 #include "include/core/SkTileMode.h"
 #include "include/core/SkUnPreMultiply.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkNx.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
@@ -59,6 +60,8 @@ protected:
     SkIRect onFilterNodeBounds(const SkIRect&, const SkMatrix& ctm,
                                MapDirection, const SkIRect* inputRect) const override;
     bool affectsTransparentBlack() const override;
+    // The other tile modes sample relative to the input image's edges.
+    bool onCanFilterInTiles() const override { return fTileMode == SkTileMode::kDecal; }
 
 private:
     friend void SkMatrixConvolutionImageFilter::RegisterFlattenables();
@@ -84,6 +87,12 @@ private:
                       SkIVector& offset,
                       const SkIRect& rect,
                       const SkIRect& bounds) const;
+    template <bool convolveAlpha>
+    void filterUncheckedPixels(const SkBitmap& src,
+                               SkBitmap* result,
+                               SkIVector& offset,
+                               const SkIRect& rect,
+                               const SkIRect& bounds) const;
     void filterInteriorPixels(const SkBitmap& src,
                               SkBitmap* result,
                               SkIVector& offset,
@@ -315,6 +324,48 @@ void SkMatrixConvolutionImageFilterImpl::filterPixels(const SkBitmap& src,
     }
 }
 
+// Same as filterPixels<UncheckedPixelFetcher, convolveAlpha>, but accumulates all four channels
+// of a tap at once. Every lane sees the same sequence of float operations as the scalar loop, but
+// the compiler may fuse the scalar multiply-adds where the vector ones are not, so results can
+// differ from filterPixels() by one in a channel (see ImageFilterInteriorMatchesScalar).
+template<bool convolveAlpha>
+void SkMatrixConvolutionImageFilterImpl::filterUncheckedPixels(const SkBitmap& src,
+                                                               SkBitmap* result,
+                                                               SkIVector& offset,
+                                                               const SkIRect& r,
+                                                               const SkIRect& bounds) const {
+    SkIRect rect(r);
+    if (!rect.intersect(bounds)) {
+        return;
+    }
+    const Sk4f gain(fGain), bias(fBias);
+    for (int y = rect.fTop; y < rect.fBottom; ++y) {
+        SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
+        for (int x = rect.fLeft; x < rect.fRight; ++x) {
+            Sk4f sum(0.0f);
+            const SkScalar* k = fKernel;
+            for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
+                const SkPMColor* row = src.getAddr32(x - fKernelOffset.fX,
+                                                     y + cy - fKernelOffset.fY);
+                for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
+                    sum = sum + SkNx_cast<float>(Sk4b::Load(row + cx)) * Sk4f(*k++);
+                }
+            }
+            Sk4i v = SkNx_cast<int>(Sk4f::Max(0.0f, Sk4f::Min(sum * gain + bias, 255.0f)).floor());
+            int a = convolveAlpha ? v[SK_A32_SHIFT / 8] : 255;
+            int r = std::min(v[SK_R32_SHIFT / 8], a);
+            int g = std::min(v[SK_G32_SHIFT / 8], a);
+            int b = std::min(v[SK_B32_SHIFT / 8], a);
+            if (!convolveAlpha) {
+                a = SkGetPackedA32(*src.getAddr32(x, y));
+                *dptr++ = SkPreMultiplyARGB(a, r, g, b);
+            } else {
+                *dptr++ = SkPackARGB32(a, r, g, b);
+            }
+        }
+    }
+}
+
 void SkMatrixConvolutionImageFilterImpl::filterInteriorPixels(const SkBitmap& src,
                                                               SkBitmap* result,
                                                               SkIVector& offset,
@@ -330,7 +381,11 @@ void SkMatrixConvolutionImageFilterImpl::filterInteriorPixels(const SkBitmap& sr
         case SkTileMode::kClamp:
             // Fall through
         case SkTileMode::kDecal:
-            filterPixels<UncheckedPixelFetcher>(src, result, offset, rect, bounds);
+            if (fConvolveAlpha) {
+                filterUncheckedPixels<true>(src, result, offset, rect, bounds);
+            } else {
+                filterUncheckedPixels<false>(src, result, offset, rect, bounds);
+            }
             break;
     }
 }
@@ -28,6 +28,7 @@ public:
 protected:
     sk_sp<SkSpecialImage> onFilterImage(const Context&, SkIPoint* offset) const override;
     bool onCanHandleComplexCTM() const override { return true; }
+    bool onCanFilterInTiles() const override { return true; }
 
 private:
     friend void SkMergeImageFilter::RegisterFlattenables();
@@ -34,6 +34,7 @@ protected:
     sk_sp<SkSpecialImage> onFilterImage(const Context&, SkIPoint* offset) const override;
     SkIRect onFilterNodeBounds(const SkIRect&, const SkMatrix& ctm,
                                MapDirection, const SkIRect* inputRect) const override;
+    bool onCanFilterInTiles() const override { return true; }
 
 private:
     friend void SkOffsetImageFilter::RegisterFlattenables();
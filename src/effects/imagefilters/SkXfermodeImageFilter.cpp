@@ -41,6 +41,7 @@ protected:
 
     SkIRect onFilterBounds(const SkIRect&, const SkMatrix& ctm,
                            MapDirection, const SkIRect* inputRect) const override;
+    bool onCanFilterInTiles() const override { return true; }
 
 #if SK_SUPPORT_GPU
     sk_sp<SkSpecialImage> filterImageGPU(const Context& ctx,
@@ -418,6 +418,9 @@ sk_sp<SkImage> SkImage::makeWithFilter(GrRecordingContext* rContext, const SkIma
                                         clipBounds.makeOffset(-subset.topLeft()),
                                         cache.get(), fInfo.colorType(), fInfo.colorSpace(),
                                         srcSpecialImage.get());
+    if (!context.gpuBacked()) {
+        context = context.withNewExecutor(SkImageFilter_Base::Executor());
+    }
 
     sk_sp<SkSpecialImage> result = as_IFB(filter)->filterImage(context).imageAndOffset(offset);
     if (!result) {
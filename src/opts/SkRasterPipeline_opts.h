@@ -2661,6 +2661,14 @@ STAGE(callback, SkRasterPipeline_CallbackCtx* c) {
     load4(c->read_from,0, &r,&g,&b,&a);
 }
 
+// Turns a distance sampled from a signed distance field glyph into coverage: alpha is the distance
+// scaled by ctx->mul and biased by ctx->add so that [0,1] spans the anti-aliased edge, then smoothed.
+STAGE(sdf_coverage, const SkRasterPipeline_SDFCoverageCtx* ctx) {
+    F t = clamp_01(mad(a, ctx->mul, ctx->add));
+    a = t*t*(3.0f - 2.0f*t);
+    r = g = b = 0;
+}
+
 STAGE(gauss_a_to_rgba, Ctx::None) {
     // x = 1 - x;
     // exp(-x * x * 4) - 0.018f;
@@ -2698,6 +2706,13 @@ SI void sample(const SkRasterPipeline_SamplerCtx2* ctx, F x, F y,
         default: *r = *g = *b = *a = 0;  // TODO
                  break;
 
+        case kAlpha_8_SkColorType: {
+            const uint8_t* ptr;
+            U32 ix = ix_and_ptr(&ptr, ctx, x,y);
+            *r = *g = *b = 0.0f;
+            *a = from_byte(gather(ptr, ix));
+        } break;
+
         case kRGBA_8888_SkColorType:
         case kBGRA_8888_SkColorType: {
             const uint32_t* ptr;
@@ -3835,6 +3850,13 @@ STAGE_PP(emboss, const SkRasterPipeline_EmbossCtx* ctx) {
     b = min(div255(b*mul) + add, a);
 }
 
+STAGE_PP(sdf_coverage, const SkRasterPipeline_SDFCoverageCtx* ctx) {
+    F t = cast<F>(a) * (ctx->mul * (1/255.0f)) + ctx->add;
+    t = min(max(0, t), 1);
+    a = cast<U16>(t*t*(3.0f - 2.0f*t) * 255.0f + 0.5f);
+    r = g = b = 0;
+}
+
 
 // ~~~~~~ Gradient stages ~~~~~~ //
 
@@ -4086,6 +4108,13 @@ SI void sample(const SkRasterPipeline_SamplerCtx2* ctx, F x, F y,
         default: *r = *g = *b = *a = 0;  // TODO
                  break;
 
+        case kAlpha_8_SkColorType: {
+            const uint8_t* ptr;
+            U32 ix = ix_and_ptr(&ptr, ctx, x,y);
+            *r = *g = *b = 0;
+            *a = cast<U16>(gather<U8>(ptr, ix));
+        } break;
+
         case kRGBA_8888_SkColorType:
         case kBGRA_8888_SkColorType: {
             const uint32_t* ptr;
@@ -5,13 +5,20 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkMatrix.h"
 #include "include/pathops/SkPathOps.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
 #include "src/pathops/SkPathOpsCommon.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <utility>
+
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
     int verbCount = path.countVerbs();
@@ -122,44 +129,115 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
-/* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
-   paths with union ops could be locally resolved and still improve over doing the
-   ops one at a time. */
-bool SkOpBuilder::resolve(SkPath* result) {
-    SkPath original = *result;
-    int count = fOps.count();
-    bool allUnion = true;
-    SkPathFirstDirection firstDir = SkPathFirstDirection::kUnknown;
-    for (int index = 0; index < count; ++index) {
-        SkPath* test = &fPathRefs[index];
-        if (kUnion_SkPathOp != fOps[index] || test->isInverseFillType()) {
-            allUnion = false;
-            break;
+// Runs fn(0) ... fn(count - 1), on the executor's threads if there is one.
+static void run_batch(SkExecutor* executor, int count, std::function<void(int)> fn) {
+    if (executor && count > 1) {
+        SkTaskGroup(*executor).batch(count, std::move(fn));
+    } else {
+        for (int index = 0; index < count; ++index) {
+            fn(index);
+        }
+    }
+}
+
+// Splits the non-empty paths into groups: paths whose bounds touch, even at an edge, are in the
+// same group (as are any paths they touch, and so on). Different groups can't overlap, so they
+// can be unioned separately and concatenated.
+static SkTArray<SkTDArray<int>> group_by_bounds(const SkTArray<SkPath>& paths) {
+    SkTDArray<int> order;
+    for (int index = 0; index < paths.count(); ++index) {
+        if (!paths[index].isEmpty()) {
+            *order.append() = index;
+        }
+    }
+    std::sort(order.begin(), order.end(), [&paths](int a, int b) {
+        return paths[a].getBounds().fLeft < paths[b].getBounds().fLeft;
+    });
+
+    SkAutoTMalloc<int> parent(paths.count());
+    for (int index = 0; index < paths.count(); ++index) {
+        parent[index] = index;
+    }
+    auto find = [&parent](int index) {
+        while (parent[index] != index) {
+            index = parent[index] = parent[parent[index]];
         }
+        return index;
+    };
+
+    // Sweep left to right, keeping the paths whose bounds reach the sweep line.
+    SkTDArray<int> active;
+    for (int index : order) {
+        const SkRect& bounds = paths[index].getBounds();
+        for (int a = active.count(); a-- > 0; ) {
+            const SkRect& other = paths[active[a]].getBounds();
+            if (other.fRight < bounds.fLeft) {
+                active.removeShuffle(a);
+            } else if (other.fTop <= bounds.fBottom && bounds.fTop <= other.fBottom) {
+                parent[find(index)] = find(active[a]);
+            }
+        }
+        *active.append() = index;
+    }
+
+    SkTArray<SkTDArray<int>> groups;
+    SkAutoTMalloc<int> groupOf(paths.count());
+    for (int index : order) {
+        int root = find(index);
+        if (root == index) {
+            groupOf[root] = groups.count();
+            groups.push_back();
+        }
+    }
+    for (int index : order) {
+        *groups[groupOf[find(index)]].append() = index;
+    }
+    return groups;
+}
+
+// Paths can be unioned by simplifying each one, fixing its winding, and simplifying their sum,
+// when they are convex, or don't intersect each other. Convex paths must wind the same way; the
+// ones that need to be reversed are appended to 'reverse'.
+static bool can_union_by_sum(const SkTArray<SkPath>& paths, const SkTDArray<int>& group,
+                             SkTDArray<int>* reverse) {
+    SkPathFirstDirection firstDir = SkPathFirstDirection::kUnknown;
+    for (int index = 0; index < group.count(); ++index) {
+        const SkPath& test = paths[group[index]];
         // If all paths are convex, track direction, reversing as needed.
-        if (test->isConvex()) {
-            SkPathFirstDirection dir = SkPathPriv::ComputeFirstDirection(*test);
+        if (test.isConvex()) {
+            SkPathFirstDirection dir = SkPathPriv::ComputeFirstDirection(test);
             if (dir == SkPathFirstDirection::kUnknown) {
-                allUnion = false;
-                break;
+                return false;
             }
             if (firstDir == SkPathFirstDirection::kUnknown) {
                 firstDir = dir;
             } else if (firstDir != dir) {
-                ReversePath(test);
+                *reverse->append() = group[index];
             }
             continue;
         }
         // If the path is not convex but its bounds do not intersect the others, simplify is enough.
-        const SkRect& testBounds = test->getBounds();
+        const SkRect& testBounds = test.getBounds();
         for (int inner = 0; inner < index; ++inner) {
             // OPTIMIZE: check to see if the contour bounds do not intersect other contour bounds?
-            if (SkRect::Intersects(fPathRefs[inner].getBounds(), testBounds)) {
-                allUnion = false;
-                break;
+            if (SkRect::Intersects(paths[group[inner]].getBounds(), testBounds)) {
+                return false;
             }
         }
     }
+    return true;
+}
+
+bool SkOpBuilder::resolve(SkPath* result) {
+    SkPath original = *result;
+    int count = fOps.count();
+    bool allUnion = true;
+    for (int index = 0; index < count; ++index) {
+        if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+            allUnion = false;
+            break;
+        }
+    }
     if (!allUnion) {
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
@@ -172,26 +250,86 @@ bool SkOpBuilder::resolve(SkPath* result) {
         reset();
         return true;
     }
-    SkPath sum;
-    for (int index = 0; index < count; ++index) {
-        if (!Simplify(fPathRefs[index], &fPathRefs[index])) {
-            reset();
-            *result = original;
-            return false;
+
+    // Paths whose bounds don't touch any others only need to be simplified on their own, and
+    // groups of touching paths can be unioned independently of each other.
+    SkTArray<SkTDArray<int>> groups = group_by_bounds(fPathRefs);
+    std::atomic<bool> failed{false};
+    run_batch(fExecutor, groups.count(), [&](int g) {
+        SkTDArray<int>& group = groups[g];
+        SkTDArray<int> reverse;
+        if (!can_union_by_sum(fPathRefs, group, &reverse)) {
+            return;
         }
-        if (!fPathRefs[index].isEmpty()) {
-            // convert the even odd result back to winding form before accumulating it
-            if (!FixWinding(&fPathRefs[index])) {
-                *result = original;
-                return false;
+        for (int index : reverse) {
+            ReversePath(&fPathRefs[index]);
+        }
+        SkPath sum;
+        for (int index : group) {
+            SkPath& test = fPathRefs[index];
+            if (!Simplify(test, &test)) {
+                failed = true;
+                return;
+            }
+            if (!test.isEmpty()) {
+                // convert the even odd result back to winding form before accumulating it
+                if (!FixWinding(&test)) {
+                    failed = true;
+                    return;
+                }
+                sum.addPath(test);
             }
-            sum.addPath(fPathRefs[index]);
         }
+        if (!Simplify(sum, &fPathRefs[group[0]])) {
+            failed = true;
+        }
+        group.setCount(1);
+    });
+
+    // Union the rest of each group's paths with Op(), pairing up neighbors (the groups are
+    // sorted left to right) so that each level of pairs halves the number of paths.
+    // SkTDArray moves its elements with memcpy, so hold the indices in a POD struct.
+    struct IndexPair { int fA, fB; };
+    SkTDArray<IndexPair> pairs;
+    for (;;) {
+        pairs.rewind();
+        for (SkTDArray<int>& group : groups) {
+            int kept = 0;
+            for (int index = 0; index + 1 < group.count(); index += 2) {
+                *pairs.append() = {group[index], group[index + 1]};
+                group[kept++] = group[index];
+            }
+            if (group.count() & 1) {
+                group[kept++] = group.back();
+            }
+            group.setCount(kept);
+        }
+        if (pairs.isEmpty() || failed) {
+            break;
+        }
+        run_batch(fExecutor, pairs.count(), [&](int index) {
+            SkPath& path = fPathRefs[pairs[index].fA];
+            if (!Op(path, fPathRefs[pairs[index].fB], kUnion_SkPathOp, &path)) {
+                failed = true;
+            }
+        });
     }
-    reset();
-    bool success = Simplify(sum, result);
-    if (!success) {
+    if (failed) {
+        reset();
         *result = original;
+        return false;
+    }
+
+    if (groups.count() == 1) {
+        *result = fPathRefs[groups[0][0]];
+    } else {
+        SkPath sum;
+        sum.setFillType(SkPathFillType::kEvenOdd);
+        for (const SkTDArray<int>& group : groups) {
+            sum.addPath(fPathRefs[group[0]]);
+        }
+        *result = sum;
     }
-    return success;
+    reset();
+    return true;
 }
@@ -10,6 +10,8 @@
 #include "include/private/SkTDArray.h"
 #include "src/pathops/SkOpAngle.h"
 
+#include <atomic>
+
 class SkOpCoincidence;
 class SkOpContour;
 class SkPathWriter;
@@ -26,5 +28,30 @@ bool HandleCoincidence(SkOpContourHead* , SkOpCoincidence* );
 bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
              SkDEBUGPARAMS(bool skipAssert)
              SkDEBUGPARAMS(const char* testName));
+// Returns the op on the insides of the paths' fills that gives op on the paths, which may have
+// inverse fills, and sets the fill type of its result.
+SkPathOp MapInverseOp(const SkPath& one, const SkPath& two, SkPathOp op,
+                      SkPathFillType* fillType);
+// Computes op for paths with only lines. Returns false if it can't; op must not be
+// kReverseDifference_SkPathOp.
+bool OpPolygons(const SkPath& one, const SkPath& two, SkPathOp op, SkPathFillType fillType,
+                SkPath* result);
+
+// Set to false to send paths with only lines through the general code in Op().
+extern std::atomic<bool> gPathOpsUsePolygonOp;
+
+// Overrides gPathOpsUsePolygonOp for ops on the calling thread while in scope, so tests can
+// compare OpPolygons() with the general code without changing it for other threads.
+class SkAutoPathOpsPolygonOpOverride {
+public:
+    explicit SkAutoPathOpsPolygonOpOverride(bool usePolygonOp);
+    ~SkAutoPathOpsPolygonOpOverride();
+
+private:
+    int fPrevious;
+};
+
+// Returns whether Op() on this thread should try OpPolygons() first.
+bool PathOpsUsePolygonOp();
 
 #endif
@@ -222,6 +222,14 @@ static const bool gOutInverse[kReverseDifference_SkPathOp + 1][2][2] = {
     {{ false, true }, { false, false }},  // rev diff
 };
 
+SkPathOp MapInverseOp(const SkPath& one, const SkPath& two, SkPathOp op,
+                      SkPathFillType* fillType) {
+    op = gOpInverse[op][one.isInverseFillType()][two.isInverseFillType()];
+    bool inverseFill = gOutInverse[op][one.isInverseFillType()][two.isInverseFillType()];
+    *fillType = inverseFill ? SkPathFillType::kInverseEvenOdd : SkPathFillType::kEvenOdd;
+    return op;
+}
+
 #if DEBUG_T_SECT_LOOP_COUNT
 
 #include "include/private/SkMutex.h"
@@ -246,10 +254,9 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         SkPathOpsDebug::DumpOp(one, two, op, testName);
     }
 #endif
-    op = gOpInverse[op][one.isInverseFillType()][two.isInverseFillType()];
-    bool inverseFill = gOutInverse[op][one.isInverseFillType()][two.isInverseFillType()];
-    SkPathFillType fillType = inverseFill ? SkPathFillType::kInverseEvenOdd :
-            SkPathFillType::kEvenOdd;
+    SkPathFillType fillType;
+    op = MapInverseOp(one, two, op, &fillType);
+    bool inverseFill = SkPathFillType_IsInverse(fillType);
     SkRect rect1, rect2;
     if (kIntersect_SkPathOp == op && one.isRect(&rect1) && two.isRect(&rect2)) {
         result->reset();
@@ -299,6 +306,11 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         swap(minuend, subtrahend);
         op = kDifference_SkPathOp;
     }
+    if (PathOpsUsePolygonOp()
+            && SkPath::kLine_SegmentMask == (one.getSegmentMasks() | two.getSegmentMasks())
+            && OpPolygons(*minuend, *subtrahend, op, fillType, result)) {
+        return true;
+    }
 #if DEBUG_SORT
     SkPathOpsDebug::gSortCount = SkPathOpsDebug::gSortCountDefault;
 #endif
@@ -0,0 +1,648 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/private/SkTDArray.h"
+#include "include/private/SkTHash.h"
+#include "src/pathops/SkPathOpsCommon.h"
+#include "src/pathops/SkPathOpsPoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+std::atomic<bool> gPathOpsUsePolygonOp{true};
+
+// -1 follows gPathOpsUsePolygonOp; 0 or 1 is set by an SkAutoPathOpsPolygonOpOverride on this
+// thread.
+static thread_local int gPolygonOpOverride = -1;
+
+SkAutoPathOpsPolygonOpOverride::SkAutoPathOpsPolygonOpOverride(bool usePolygonOp)
+        : fPrevious(gPolygonOpOverride) {
+    gPolygonOpOverride = usePolygonOp;
+}
+
+SkAutoPathOpsPolygonOpOverride::~SkAutoPathOpsPolygonOpOverride() {
+    gPolygonOpOverride = fPrevious;
+}
+
+bool PathOpsUsePolygonOp() {
+    return gPolygonOpOverride < 0 ? gPathOpsUsePolygonOp.load(std::memory_order_relaxed)
+                                  : gPolygonOpOverride != 0;
+}
+
+/* OpPolygons() computes Op() for paths made only of lines, without the machinery the general
+   code needs to intersect curves. It splits every edge where it crosses or touches another edge,
+   merges pieces that coincide, and finds each operand's winding on either side of every piece
+   by counting the pieces to its left. A piece with the result inside on one side and outside on
+   the other is an edge of the result; those are linked into contours vertex by vertex.
+
+   All math is in doubles, starting from the paths' float points. Intersections that land within
+   a tiny distance of another vertex are snapped to it, so that three or more edges meeting at a
+   point share one vertex. If that moves an edge across another, the pieces don't link up into
+   closed contours, or a winding can't be decided, OpPolygons() gives up and Op() falls back to
+   the general code.
+*/
+
+namespace {
+
+// An edge of an input path, from fStart to fEnd.
+struct Segment {
+    int fStart;
+    int fEnd;
+    int fOperand;
+    double fMinX, fMaxX, fMinY, fMaxY;
+};
+
+// A vertex inside a segment, fParam along it.
+struct Split {
+    int fSegment;
+    double fParam;
+    int fVertex;
+};
+
+// A piece of one or more segments, from fTop to fBottom; ordered by y, then by x.
+struct Edge {
+    int fTop;
+    int fBottom;
+    int fWind[2];    // each operand's winding; positive where its segments run from top to bottom
+    int fBefore[2];  // the windings left of the edge, or above it if it's horizontal
+    int fAfter[2];   // the windings right of the edge, or below it
+};
+
+// An edge of the result, from vertex fFrom to vertex fTo, with the inside on its right.
+struct BoundaryEdge {
+    int fFrom;
+    int fTo;
+};
+
+class PolygonOp {
+public:
+    PolygonOp(SkPathOp op, bool evenOdd, bool oppEvenOdd) : fOp(op) {
+        fEvenOdd[0] = evenOdd;
+        fEvenOdd[1] = oppEvenOdd;
+    }
+
+    bool addPath(const SkPath& path, int operand) {
+        SkPath::Iter iter(path, true);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+            if (SkPath::kLine_Verb == verb) {
+                if (pts[0] != pts[1]) {
+                    this->addSegment(pts[0], pts[1], operand);
+                }
+            } else if (SkPath::kMove_Verb != verb && SkPath::kClose_Verb != verb) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool resolve(SkPath* result) {
+        fPathPointCount = fPts.count();
+        this->findIntersections();
+        this->snapVertices();
+        this->buildEdges();
+        if (!this->edgesMeetOnlyAtEnds()) {
+            return false;
+        }
+        SkTDArray<BoundaryEdge> boundary;
+        return this->findBoundary(&boundary) && this->linkBoundary(boundary, result);
+    }
+
+private:
+    int addVertex(const SkDPoint& pt) {
+        *fPts.append() = pt;
+        return fPts.count() - 1;
+    }
+
+    void addSegment(const SkPoint& start, const SkPoint& end, int operand) {
+        SkDPoint s = {start.fX, start.fY},
+                 e = {end.fX, end.fY};
+        fMaxCoord = std::max({fMaxCoord, fabs(s.fX), fabs(s.fY), fabs(e.fX), fabs(e.fY)});
+        *fSegments.append() = {this->addVertex(s), this->addVertex(e), operand,
+                               std::min(s.fX, e.fX), std::max(s.fX, e.fX),
+                               std::min(s.fY, e.fY), std::max(s.fY, e.fY)};
+    }
+
+    // Splits the segment at the vertex if it lies strictly between the segment's ends.
+    void splitIfInside(int segIndex, int vertex) {
+        const Segment& seg = fSegments[segIndex];
+        const SkDPoint& start = fPts[seg.fStart];
+        SkDVector along = fPts[seg.fEnd] - start;
+        double param = (fPts[vertex] - start).dot(along);
+        if (0 < param && param < along.dot(along) && fPts[vertex] != start
+                && fPts[vertex] != fPts[seg.fEnd]) {
+            *fSplits.append() = {segIndex, param, vertex};
+        }
+    }
+
+    void intersect(int i, int j) {
+        const Segment& a = fSegments[i];
+        const Segment& b = fSegments[j];
+        // Copies, since adding a vertex may move the others.
+        const SkDPoint a0 = fPts[a.fStart];
+        const SkDPoint b0 = fPts[b.fStart];
+        SkDVector da = fPts[a.fEnd] - a0,
+                  db = fPts[b.fEnd] - b0;
+        double o1 = da.cross(b0 - a0),
+               o2 = da.cross(fPts[b.fEnd] - a0),
+               o3 = db.cross(a0 - b0),
+               o4 = db.cross(fPts[a.fEnd] - b0);
+        if ((o1 < 0 && o2 > 0) || (o1 > 0 && o2 < 0)) {
+            if ((o3 < 0 && o4 > 0) || (o3 > 0 && o4 < 0)) {
+                double t = o3 / (o3 - o4);
+                SkDPoint pt = {a0.fX + da.fX * t, a0.fY + da.fY * t};
+                int vertex = this->addVertex(pt);
+                *fSplits.append() = {i, (pt - a0).dot(da), vertex};
+                *fSplits.append() = {j, (pt - b0).dot(db), vertex};
+                return;
+            }
+        }
+        // An end of one segment may touch the other; if they're collinear, several may.
+        if (0 == o1) {
+            this->splitIfInside(i, b.fStart);
+        }
+        if (0 == o2) {
+            this->splitIfInside(i, b.fEnd);
+        }
+        if (0 == o3) {
+            this->splitIfInside(j, a.fStart);
+        }
+        if (0 == o4) {
+            this->splitIfInside(j, a.fEnd);
+        }
+    }
+
+    // Sweeps the segments left to right, intersecting those whose bounds overlap.
+    void findIntersections() {
+        SkTDArray<int> order;
+        order.setCount(fSegments.count());
+        for (int index = 0; index < order.count(); ++index) {
+            order[index] = index;
+        }
+        std::sort(order.begin(), order.end(), [this](int a, int b) {
+            return fSegments[a].fMinX < fSegments[b].fMinX;
+        });
+        SkTDArray<int> active;
+        for (int index : order) {
+            const Segment& seg = fSegments[index];
+            for (int a = active.count(); a-- > 0; ) {
+                const Segment& other = fSegments[active[a]];
+                if (other.fMaxX < seg.fMinX) {
+                    active.removeShuffle(a);
+                } else if (other.fMinY <= seg.fMaxY && seg.fMinY <= other.fMaxY) {
+                    this->intersect(active[a], index);
+                }
+            }
+            *active.append() = index;
+        }
+    }
+
+    // Merges vertices that are within a tiny distance of each other. The vertex of each cluster
+    // with the lowest index survives, so the paths' own points are preferred to intersections.
+    void snapVertices() {
+        const double epsilon = ldexp(fMaxCoord, -32);
+        fSnap.setCount(fPts.count());
+        SkTDArray<int> order;
+        order.setCount(fPts.count());
+        for (int index = 0; index < order.count(); ++index) {
+            order[index] = index;
+        }
+        std::sort(order.begin(), order.end(), [this](int a, int b) {
+            return fPts[a].fX < fPts[b].fX || (fPts[a].fX == fPts[b].fX && fPts[a].fY < fPts[b].fY);
+        });
+        // Chain vertices whose x's are close, then within each of those, whose y's are close.
+        int columnStart = 0;
+        for (int index = 1; index <= order.count(); ++index) {
+            if (index < order.count()
+                    && fPts[order[index]].fX - fPts[order[index - 1]].fX <= epsilon) {
+                continue;
+            }
+            int* column = order.begin() + columnStart;
+            int* columnEnd = order.begin() + index;
+            if (index - columnStart > 1) {
+                std::sort(column, columnEnd, [this](int a, int b) {
+                    return fPts[a].fY < fPts[b].fY;
+                });
+            }
+            for (int* run = column; run < columnEnd; ) {
+                int* runEnd = run + 1;
+                int survivor = *run;
+                while (runEnd < columnEnd && fPts[*runEnd].fY - fPts[runEnd[-1]].fY <= epsilon) {
+                    survivor = std::min(survivor, *runEnd++);
+                }
+                for (int* member = run; member < runEnd; ++member) {
+                    fSnap[*member] = survivor;
+                }
+                run = runEnd;
+            }
+            columnStart = index;
+        }
+    }
+
+    void addPiece(int from, int to, int operand) {
+        const SkDPoint& f = fPts[from];
+        const SkDPoint& t = fPts[to];
+        bool down = f.fY < t.fY || (f.fY == t.fY && f.fX < t.fX);
+        int top = down ? from : to;
+        int bottom = down ? to : from;
+        uint64_t key = (uint64_t) top << 32 | (uint32_t) bottom;
+        int* edgeIndex = fEdgeMap.find(key);
+        if (!edgeIndex) {
+            edgeIndex = fEdgeMap.set(key, fEdges.count());
+            *fEdges.append() = {top, bottom, {0, 0}, {0, 0}, {0, 0}};
+        }
+        fEdges[*edgeIndex].fWind[operand] += down ? 1 : -1;
+    }
+
+    // Cuts the segments at their splits into pieces, merging pieces that coincide.
+    void buildEdges() {
+        std::sort(fSplits.begin(), fSplits.end(), [](const Split& a, const Split& b) {
+            return a.fSegment < b.fSegment || (a.fSegment == b.fSegment && a.fParam < b.fParam);
+        });
+        const Split* split = fSplits.begin();
+        for (int index = 0; index < fSegments.count(); ++index) {
+            const Segment& seg = fSegments[index];
+            int from = fSnap[seg.fStart];
+            for (; split < fSplits.end() && split->fSegment == index; ++split) {
+                int to = fSnap[split->fVertex];
+                if (to != from) {
+                    this->addPiece(from, to, seg.fOperand);
+                    from = to;
+                }
+            }
+            int to = fSnap[seg.fEnd];
+            if (to != from) {
+                this->addPiece(from, to, seg.fOperand);
+            }
+        }
+        // Pieces whose windings cancel out don't affect the result.
+        int kept = 0;
+        for (const Edge& edge : fEdges) {
+            if (edge.fWind[0] || edge.fWind[1]) {
+                fEdges[kept++] = edge;
+            }
+        }
+        fEdges.setCount(kept);
+    }
+
+    // Returns true if the edges cross, or an end of one lies inside the other.
+    bool edgesCross(const Edge& a, const Edge& b) const {
+        const SkDPoint& a0 = fPts[a.fTop];
+        const SkDPoint& b0 = fPts[b.fTop];
+        SkDVector da = fPts[a.fBottom] - a0,
+                  db = fPts[b.fBottom] - b0;
+        double o1 = da.cross(b0 - a0),
+               o2 = da.cross(fPts[b.fBottom] - a0),
+               o3 = db.cross(a0 - b0),
+               o4 = db.cross(fPts[a.fBottom] - b0);
+        if (((o1 < 0 && o2 > 0) || (o1 > 0 && o2 < 0))
+                && ((o3 < 0 && o4 > 0) || (o3 > 0 && o4 < 0))) {
+            return true;
+        }
+        auto inside = [this](int vertex, const Edge& edge) {
+            if (vertex == edge.fTop || vertex == edge.fBottom) {
+                return false;
+            }
+            const SkDPoint& top = fPts[edge.fTop];
+            SkDVector along = fPts[edge.fBottom] - top;
+            double param = (fPts[vertex] - top).dot(along);
+            return 0 < param && param < along.dot(along);
+        };
+        return (0 == o1 && inside(b.fTop, a)) || (0 == o2 && inside(b.fBottom, a))
+            || (0 == o3 && inside(a.fTop, b)) || (0 == o4 && inside(a.fBottom, b));
+    }
+
+    // The segments were cut wherever they met, so the edges should only meet at their ends. But
+    // snapping moves rounded intersections, and may move an edge across another one nearby. The
+    // windings can't be found then, so check with another sweep like findIntersections().
+    bool edgesMeetOnlyAtEnds() const {
+        auto minX = [this](const Edge& edge) {
+            return std::min(fPts[edge.fTop].fX, fPts[edge.fBottom].fX);
+        };
+        auto maxX = [this](const Edge& edge) {
+            return std::max(fPts[edge.fTop].fX, fPts[edge.fBottom].fX);
+        };
+        SkTDArray<int> order;
+        order.setCount(fEdges.count());
+        for (int index = 0; index < order.count(); ++index) {
+            order[index] = index;
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return minX(fEdges[a]) < minX(fEdges[b]);
+        });
+        SkTDArray<int> active;
+        for (int index : order) {
+            const Edge& edge = fEdges[index];
+            // Edges are ordered by y, so the top is the least y and the bottom the greatest.
+            double top = fPts[edge.fTop].fY,
+                   bottom = fPts[edge.fBottom].fY;
+            for (int a = active.count(); a-- > 0; ) {
+                const Edge& other = fEdges[active[a]];
+                if (maxX(other) < minX(edge)) {
+                    active.removeShuffle(a);
+                } else if (fPts[other.fTop].fY <= bottom && top <= fPts[other.fBottom].fY
+                        && this->edgesCross(other, edge)) {
+                    return false;
+                }
+            }
+            *active.append() = index;
+        }
+        return true;
+    }
+
+    bool isHorizontal(const Edge& edge) const {
+        return fPts[edge.fTop].fY == fPts[edge.fBottom].fY;
+    }
+
+    // Returns how many of the sorted edges are left of pt, or -1 if pt is on one of them.
+    int findPosition(const SkTDArray<int>& sorted, const SkDPoint& pt) const {
+        int lo = 0;
+        int hi = sorted.count();
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            const Edge& edge = fEdges[sorted[mid]];
+            const SkDPoint& top = fPts[edge.fTop];
+            double cross = (fPts[edge.fBottom] - top).cross(pt - top);
+            if (0 == cross) {
+                return -1;
+            }
+            if (cross < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // Copies the winding just right of the edge before 'position' in the sorted edges.
+    void windingBefore(const SkTDArray<int>& sorted, int position, int wind[2]) const {
+        if (position) {
+            const Edge& left = fEdges[sorted[position - 1]];
+            wind[0] = left.fAfter[0];
+            wind[1] = left.fAfter[1];
+        } else {
+            wind[0] = wind[1] = 0;
+        }
+    }
+
+    // Sweeps down through the edges, keeping the ones that cross the sweep line sorted from left
+    // to right. Since edges only meet at their ends, the winding along an edge's left side is the
+    // same from top to bottom: it's the winding on the right of the edge to its left when the
+    // sweep reaches its top. A horizontal edge's windings are found at its midpoint just before
+    // and just after the sweep passes it.
+    bool findWindings() {
+        SkTDArray<int> starts, horizontals;
+        for (int index = 0; index < fEdges.count(); ++index) {
+            *(this->isHorizontal(fEdges[index]) ? horizontals : starts).append() = index;
+        }
+        std::sort(starts.begin(), starts.end(), [this](int a, int b) {
+            const SkDPoint& topA = fPts[fEdges[a].fTop];
+            const SkDPoint& topB = fPts[fEdges[b].fTop];
+            if (topA.fY != topB.fY) {
+                return topA.fY < topB.fY;
+            }
+            if (topA.fX != topB.fX) {
+                return topA.fX < topB.fX;
+            }
+            return (fPts[fEdges[a].fBottom] - topA).cross(fPts[fEdges[b].fBottom] - topA) < 0;
+        });
+        std::sort(horizontals.begin(), horizontals.end(), [this](int a, int b) {
+            return fPts[fEdges[a].fTop].fY < fPts[fEdges[b].fTop].fY;
+        });
+
+        SkTDArray<int> active, merged;
+        const int* start = starts.begin();
+        const int* horizontal = horizontals.begin();
+        auto midpoint = [this](const Edge& edge) {
+            const SkDPoint& top = fPts[edge.fTop];
+            return SkDPoint{(top.fX + fPts[edge.fBottom].fX) / 2, top.fY};
+        };
+        auto removeEndingAbove = [&](double y, bool orAt) {
+            int kept = 0;
+            for (int index : active) {
+                double bottom = fPts[fEdges[index].fBottom].fY;
+                if (bottom > y || (bottom == y && !orAt)) {
+                    active[kept++] = index;
+                }
+            }
+            active.setCount(kept);
+        };
+        while (start < starts.end() || horizontal < horizontals.end()) {
+            double y = std::min(start < starts.end() ? fPts[fEdges[*start].fTop].fY : INFINITY,
+                    horizontal < horizontals.end() ? fPts[fEdges[*horizontal].fTop].fY : INFINITY);
+            removeEndingAbove(y, false);
+            const int* horizontalEnd = horizontal;
+            for (; horizontalEnd < horizontals.end()
+                    && fPts[fEdges[*horizontalEnd].fTop].fY == y; ++horizontalEnd) {
+                Edge& edge = fEdges[*horizontalEnd];
+                int position = this->findPosition(active, midpoint(edge));
+                if (position < 0) {
+                    return false;
+                }
+                this->windingBefore(active, position, edge.fBefore);
+            }
+            removeEndingAbove(y, true);
+            if (start < starts.end() && fPts[fEdges[*start].fTop].fY == y) {
+                merged.rewind();
+                int copied = 0;
+                for (; start < starts.end() && fPts[fEdges[*start].fTop].fY == y; ++start) {
+                    Edge& edge = fEdges[*start];
+                    int position = this->findPosition(active, fPts[edge.fTop]);
+                    if (position < copied) {
+                        return false;
+                    }
+                    merged.append(position - copied, active.begin() + copied);
+                    copied = position;
+                    this->windingBefore(merged, merged.count(), edge.fBefore);
+                    edge.fAfter[0] = edge.fBefore[0] + edge.fWind[0];
+                    edge.fAfter[1] = edge.fBefore[1] + edge.fWind[1];
+                    *merged.append() = *start;
+                }
+                merged.append(active.count() - copied, active.begin() + copied);
+                std::swap(active, merged);
+            }
+            for (; horizontal < horizontalEnd; ++horizontal) {
+                Edge& edge = fEdges[*horizontal];
+                int position = this->findPosition(active, midpoint(edge));
+                if (position < 0) {
+                    return false;
+                }
+                this->windingBefore(active, position, edge.fAfter);
+            }
+        }
+        return true;
+    }
+
+    bool inside(const int wind[2]) const {
+        bool one = fEvenOdd[0] ? wind[0] & 1 : wind[0] != 0;
+        bool two = fEvenOdd[1] ? wind[1] & 1 : wind[1] != 0;
+        switch (fOp) {
+            case kDifference_SkPathOp: return one && !two;
+            case kIntersect_SkPathOp: return one && two;
+            case kUnion_SkPathOp: return one || two;
+            case kXOR_SkPathOp: return one != two;
+            default: SkASSERT(0); return false;
+        }
+    }
+
+    // Finds the edges with the result inside on one side and outside on the other, oriented so
+    // that the inside is on their right.
+    bool findBoundary(SkTDArray<BoundaryEdge>* boundary) {
+        if (!this->findWindings()) {
+            return false;
+        }
+        for (const Edge& edge : fEdges) {
+            bool insideBefore = this->inside(edge.fBefore);
+            if (insideBefore == this->inside(edge.fAfter)) {
+                continue;
+            }
+            // Left of an edge that isn't horizontal is on the right of the edge running from top
+            // to bottom; above a horizontal edge is on the right of it running from right to left.
+            if (insideBefore == this->isHorizontal(edge)) {
+                *boundary->append() = {edge.fBottom, edge.fTop};
+            } else {
+                *boundary->append() = {edge.fTop, edge.fBottom};
+            }
+        }
+        return true;
+    }
+
+    // Returns true for an intersection in the middle of a straight run, allowing for the error in
+    // computing it. The paths' own points are kept, since the line between their rounded
+    // neighbors may not pass exactly through them.
+    bool isRedundant(int prev, int cur, int next) const {
+        if (cur < fPathPointCount) {
+            return false;
+        }
+        SkDVector in = fPts[cur] - fPts[prev],
+                  out = fPts[next] - fPts[cur];
+        return fabs(in.cross(out)) <= ldexp(in.length() * out.length(), -40) && in.dot(out) > 0;
+    }
+
+    // Walks the boundary edges from vertex to vertex into closed contours.
+    bool linkBoundary(const SkTDArray<BoundaryEdge>& boundary, SkPath* result) {
+        SkTDArray<int> starts;
+        starts.setCount(fPts.count() + 1);
+        sk_bzero(starts.begin(), starts.count() * sizeof(int));
+        for (const auto& edge : boundary) {
+            ++starts[edge.fFrom + 1];
+        }
+        for (int index = 0; index < fPts.count(); ++index) {
+            starts[index + 1] += starts[index];
+        }
+        SkTDArray<int> outgoing, fill;
+        outgoing.setCount(boundary.count());
+        fill.append(fPts.count(), starts.begin());
+        for (int index = 0; index < boundary.count(); ++index) {
+            outgoing[fill[boundary[index].fFrom]++] = index;
+        }
+        SkTDArray<bool> used;
+        used.setCount(boundary.count());
+        sk_bzero(used.begin(), used.count() * sizeof(bool));
+
+        SkTDArray<int> contour, kept;
+        for (int first = 0; first < boundary.count(); ++first) {
+            if (used[first]) {
+                continue;
+            }
+            contour.rewind();
+            int startVertex = boundary[first].fFrom;
+            int current = first;
+            do {
+                used[current] = true;
+                int from = boundary[current].fFrom;
+                int vertex = boundary[current].fTo;
+                *contour.append() = from;
+                if (vertex == startVertex) {
+                    break;
+                }
+                // Where contours touch, take the sharpest right turn to keep them apart.
+                SkDVector in = fPts[vertex] - fPts[from];
+                int next = -1;
+                double bestTurn = 0;
+                for (int i = starts[vertex]; i < starts[vertex + 1]; ++i) {
+                    int candidate = outgoing[i];
+                    if (used[candidate]) {
+                        continue;
+                    }
+                    SkDVector out = fPts[boundary[candidate].fTo] - fPts[vertex];
+                    double turn = atan2(in.cross(out), in.dot(out));
+                    if (next < 0 || turn > bestTurn) {
+                        next = candidate;
+                        bestTurn = turn;
+                    }
+                }
+                if (next < 0) {
+                    return false;
+                }
+                current = next;
+            } while (true);
+
+            // Leave out intersections in the middle of straight runs.
+            kept.rewind();
+            int count = contour.count();
+            for (int index = 0; index < count; ++index) {
+                int prev = kept.isEmpty() ? contour[count - 1] : kept.back();
+                if (!this->isRedundant(prev, contour[index], contour[(index + 1) % count])) {
+                    *kept.append() = contour[index];
+                }
+            }
+            if (kept.count() < 3) {
+                continue;
+            }
+            SkPoint last = {0, 0};
+            for (int index = 0; index < kept.count(); ++index) {
+                const SkDPoint& pt = fPts[kept[index]];
+                SkPoint point = {SkDoubleToScalar(pt.fX), SkDoubleToScalar(pt.fY)};
+                if (!index) {
+                    result->moveTo(point);
+                } else if (point != last) {
+                    result->lineTo(point);
+                }
+                last = point;
+            }
+            result->close();
+        }
+        return true;
+    }
+
+    SkPathOp fOp;
+    bool fEvenOdd[2];
+    double fMaxCoord = 0;
+    int fPathPointCount = 0;  // fPts before this are points of the paths, after, intersections
+    SkTDArray<SkDPoint> fPts;
+    SkTDArray<int> fSnap;
+    SkTDArray<Segment> fSegments;
+    SkTDArray<Split> fSplits;
+    SkTDArray<Edge> fEdges;
+    SkTHashMap<uint64_t, int> fEdgeMap;
+};
+
+}  // namespace
+
+bool OpPolygons(const SkPath& one, const SkPath& two, SkPathOp op, SkPathFillType fillType,
+                SkPath* result) {
+    SkASSERT(kReverseDifference_SkPathOp != op);
+    if (!one.isFinite() || !two.isFinite()) {
+        return false;
+    }
+    PolygonOp polygonOp(op, SkPathFillType_IsEvenOdd(one.getFillType()),
+                        SkPathFillType_IsEvenOdd(two.getFillType()));
+    if (!polygonOp.addPath(one, 0) || !polygonOp.addPath(two, 1)) {
+        return false;
+    }
+    SkPath output;
+    output.setFillType(fillType);
+    if (!polygonOp.resolve(&output)) {
+        return false;
+    }
+    *result = std::move(output);
+    return true;
+}
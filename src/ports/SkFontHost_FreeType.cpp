@@ -393,22 +393,13 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
     }
 }
 
+// Opens a new face for the typeface, which is not shared through gFaceRecHead.
 // Will return nullptr on failure
 // Caller must lock f_t_mutex() before calling this function.
-static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
+static std::unique_ptr<SkFaceRec> open_ft_face(const SkTypeface_FreeType* typeface) {
     f_t_mutex().assertHeld();
 
     const SkFontID fontID = typeface->uniqueID();
-    SkFaceRec* cachedRec = gFaceRecHead;
-    while (cachedRec) {
-        if (cachedRec->fFontID == fontID) {
-            SkASSERT(cachedRec->fFace);
-            cachedRec->fRefCnt += 1;
-            return cachedRec;
-        }
-        cachedRec = cachedRec->fNext;
-    }
-
     std::unique_ptr<SkFontData> data = typeface->makeFontData();
     if (nullptr == data || !data->hasStream()) {
         return nullptr;
@@ -450,15 +441,36 @@ static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
     if (!rec->fFace->charmap) {
         FT_Select_Charmap(rec->fFace.get(), FT_ENCODING_MS_SYMBOL);
     }
+    return rec;
+}
 
+// Will return nullptr on failure
+// Caller must lock f_t_mutex() before calling this function.
+static SkFaceRec* ref_ft_face(const SkTypeface_FreeType* typeface) {
+    f_t_mutex().assertHeld();
+
+    const SkFontID fontID = typeface->uniqueID();
+    SkFaceRec* cachedRec = gFaceRecHead;
+    while (cachedRec) {
+        if (cachedRec->fFontID == fontID) {
+            SkASSERT(cachedRec->fFace);
+            cachedRec->fRefCnt += 1;
+            return cachedRec;
+        }
+        cachedRec = cachedRec->fNext;
+    }
+
+    std::unique_ptr<SkFaceRec> rec = open_ft_face(typeface);
+    if (!rec) {
+        return nullptr;
+    }
     rec->fNext = gFaceRecHead;
     gFaceRecHead = rec.get();
     return rec.release();
 }
 
 // Caller must lock f_t_mutex() before calling this function.
-// Marked extern because vc++ does not support internal linkage template parameters.
-extern /*static*/ void unref_ft_face(SkFaceRec* faceRec) {
+static void unref_ft_face(SkFaceRec* faceRec) {
     f_t_mutex().assertHeld();
 
     SkFaceRec*  rec = gFaceRecHead;
@@ -531,10 +543,13 @@ protected:
     void generateFontMetrics(SkFontMetrics*) override;
 
 private:
-    using UnrefFTFace = SkFunctionWrapper<decltype(unref_ft_face), unref_ft_face>;
-    std::unique_ptr<SkFaceRec, UnrefFTFace> fFaceRec;
+    // Each scaler context owns its face, so loading and rendering glyphs needs no lock; a
+    // context is only used by one thread at a time. Only opening and closing faces touches the
+    // shared FT_Library, so only that is done under f_t_mutex().
+    // The face must be destroyed with f_t_mutex() held.
+    std::unique_ptr<SkFaceRec> fFaceRec;
 
-    FT_Face   fFace;  // Borrowed face from gFaceRecHead.
+    FT_Face   fFace;  // Borrowed face from fFaceRec.
     FT_Size   fFTSize;  // The size on the fFace for this scaler.
     FT_Int    fStrikeIndex;
 
@@ -556,9 +571,7 @@ private:
     void getBBoxForCurrentGlyph(const SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
-    // Caller must lock f_t_mutex() before calling this function.
     void updateGlyphIfLCD(SkGlyph* glyph);
-    // Caller must lock f_t_mutex() before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -866,10 +879,11 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-    SkASSERT_RELEASE(ref_ft_library());
-
-    fFaceRec.reset(ref_ft_face(static_cast<SkTypeface_FreeType*>(this->getTypeface())));
+    {
+        SkAutoMutexExclusive  ac(f_t_mutex());
+        SkASSERT_RELEASE(ref_ft_library());
+        fFaceRec = open_ft_face(static_cast<SkTypeface_FreeType*>(this->getTypeface()));
+    }
 
     // load the font file
     if (nullptr == fFaceRec) {
@@ -1055,11 +1069,9 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     unref_ft_library();
 }
 
-/*  We call this before each use of the fFace, since we may be sharing
-    this face with other context (at different sizes).
+/*  We call this before each use of the fFace, to select this scaler's size and transform.
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    f_t_mutex().assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1080,8 +1092,6 @@ bool SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
         return false;
     }
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (this->setupSize()) {
         glyph->zeroMetrics();
         return true;
@@ -1185,8 +1195,6 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     glyph->fMaskFormat = fRec.fMaskFormat;
 
     if (this->setupSize()) {
@@ -1337,8 +1345,6 @@ void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (this->setupSize()) {
         sk_bzero(glyph.fImage, glyph.imageSize());
         return;
@@ -1370,8 +1376,6 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 bool SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
     if (!FT_IS_SCALABLE(fFace) || this->setupSize()) {
         path->reset();
@@ -1411,8 +1415,6 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexExclusive ac(f_t_mutex());
-
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
         return;
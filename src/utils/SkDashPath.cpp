@@ -216,10 +216,14 @@ static bool cull_path(const SkPath& srcPath, const SkStrokeRec& rec,
     return false;
 }
 
+// Dashes are handed to a DashBatchProc this many at a time.
+static constexpr int kDashesPerBatch = 64;
+
 class SpecialLineRec {
 public:
+    // dst is reserved for up to maxDashes dashes.
     bool init(const SkPath& src, SkPath* dst, SkStrokeRec* rec,
-              int intervalCount, SkScalar intervalLength) {
+              int intervalCount, SkScalar intervalLength, SkScalar maxDashes) {
         if (rec->isHairlineStyle() || !src.isLine(fPts)) {
             return false;
         }
@@ -246,7 +250,7 @@ public:
         //     resulting points = 4 * segments
 
         SkScalar ptCount = pathLength * intervalCount / (float)intervalLength;
-        ptCount = std::min(ptCount, SkDashPath::kMaxDashCount);
+        ptCount = std::min(ptCount, maxDashes);
         int n = SkScalarCeilToInt(ptCount) << 2;
         dst->incReserve(n);
 
@@ -284,11 +288,16 @@ private:
 };
 
 
-bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
-                                const SkRect* cullRect, const SkScalar aIntervals[],
-                                int32_t count, SkScalar initialDashLength, int32_t initialDashIndex,
-                                SkScalar intervalLength,
-                                StrokeRecApplication strokeRecApplication) {
+// With a batchProc, dashes are handed off in batches instead of collected in dst, and ones that
+// miss the cullRect are dropped.
+static bool dash_path(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
+                      const SkRect* cullRect, const SkScalar aIntervals[],
+                      int32_t count, SkScalar initialDashLength, int32_t initialDashIndex,
+                      SkScalar intervalLength,
+                      SkDashPath::StrokeRecApplication strokeRecApplication,
+                      const SkDashPath::DashBatchProc* batchProc) {
+    using namespace SkDashPath;
+
     // we must always have an even number of intervals
     SkASSERT(is_even(count));
 
@@ -353,12 +362,40 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         srcPtr = &cullPathStorage;
     }
 
+    if (batchProc) {
+        // Apply the dash count limit up front: failing after handing off some batches would
+        // leave them drawn under whatever the caller draws instead.
+        SkPathMeasure counter(*srcPtr, false, rec->getResScale());
+        do {
+            dashCount += counter.getLength() * (count >> 1) / intervalLength;
+            if (dashCount > kMaxDashCount) {
+                return false;
+            }
+        } while (counter.nextContour());
+        dashCount = 0;
+    }
+
     SpecialLineRec lineRec;
     bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
-                       lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
+                       lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength,
+                                    batchProc ? kDashesPerBatch : kMaxDashCount);
 
     SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
 
+    SkRect cullBounds;
+    const bool cullDashes = batchProc && cullRect && !specialLine;
+    if (cullDashes) {
+        cullBounds = *cullRect;
+        outset_for_stroke(&cullBounds, *rec);
+        if (SkPaint::kSquare_Cap == rec->getCap()) {
+            // Square caps reach out diagonally from the ends of the dash.
+            SkScalar radius = SkScalarHalf(rec->getWidth());
+            cullBounds.outset(radius * (SK_ScalarSqrt2 - 1), radius * (SK_ScalarSqrt2 - 1));
+        }
+    }
+    SkPath dash;
+    int batchCount = 0;
+
     do {
         bool        skipFirstSegment = meas.isClosed();
         bool        addedSegment = false;
@@ -373,6 +410,8 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         // 90 million dash segments and crashing the memory allocator. A limit of 1 million
         // segments seems reasonable: at 2 verbs per segment * 9 bytes per verb, this caps the
         // maximum dash memory overhead at roughly 17MB per path.
+        // Batches don't build up memory, but the limit still bounds the time spent measuring.
+        // They were counted before the first one was handed off, so this won't fail for them.
         dashCount += length * (count >> 1) / intervalLength;
         if (dashCount > kMaxDashCount) {
             dst->reset();
@@ -391,10 +430,26 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                 addedSegment = true;
                 ++segCount;
 
+                if (batchProc && batchCount >= kDashesPerBatch) {
+                    (*batchProc)(*dst);
+                    dst->rewind();
+                    batchCount = 0;
+                }
+                ++batchCount;
                 if (specialLine) {
                     lineRec.addSegment(SkDoubleToScalar(distance),
                                        SkDoubleToScalar(distance + dlen),
                                        dst);
+                } else if (cullDashes) {
+                    dash.rewind();
+                    meas.getSegment(SkDoubleToScalar(distance),
+                                    SkDoubleToScalar(distance + dlen),
+                                    &dash, true);
+                    if (SkRect::Intersects(dash.getBounds(), cullBounds)) {
+                        dst->addPath(dash);
+                    } else {
+                        addedSegment = false;
+                    }
                 } else {
                     meas.getSegment(SkDoubleToScalar(distance),
                                     SkDoubleToScalar(distance + dlen),
@@ -425,6 +480,14 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         }
     } while (meas.nextContour());
 
+    if (batchProc) {
+        if (!dst->isEmpty()) {
+            (*batchProc)(*dst);
+        }
+        dst->reset();
+        return true;
+    }
+
     // TODO: do we still need this?
     if (segCount > 1) {
         SkPathPriv::SetConvexity(*dst, SkPathConvexity::kConcave);
@@ -433,6 +496,15 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
     return true;
 }
 
+bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
+                                const SkRect* cullRect, const SkScalar aIntervals[],
+                                int32_t count, SkScalar initialDashLength, int32_t initialDashIndex,
+                                SkScalar intervalLength,
+                                StrokeRecApplication strokeRecApplication) {
+    return dash_path(dst, src, rec, cullRect, aIntervals, count, initialDashLength,
+                     initialDashIndex, intervalLength, strokeRecApplication, nullptr);
+}
+
 bool SkDashPath::FilterDashPath(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
                                 const SkRect* cullRect, const SkPathEffect::DashInfo& info) {
     if (!ValidDashPath(info.fPhase, info.fIntervals, info.fCount)) {
@@ -447,6 +519,23 @@ bool SkDashPath::FilterDashPath(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                           initialDashIndex, intervalLength);
 }
 
+bool SkDashPath::StreamDashPath(const SkPath& src, SkStrokeRec* rec, const SkRect* cullRect,
+                                const SkPathEffect::DashInfo& info,
+                                const DashBatchProc& batchProc) {
+    if (!ValidDashPath(info.fPhase, info.fIntervals, info.fCount)) {
+        return false;
+    }
+    SkScalar initialDashLength = 0;
+    int32_t initialDashIndex = 0;
+    SkScalar intervalLength = 0;
+    SkScalar phase = 0;
+    CalcDashParameters(info.fPhase, info.fIntervals, info.fCount,
+                       &initialDashLength, &initialDashIndex, &intervalLength, &phase);
+    SkPath batch;
+    return dash_path(&batch, src, rec, cullRect, info.fIntervals, info.fCount, initialDashLength,
+                     initialDashIndex, intervalLength, StrokeRecApplication::kAllow, &batchProc);
+}
+
 bool SkDashPath::ValidDashPath(SkScalar phase, const SkScalar intervals[], int32_t count) {
     if (count < 2 || !SkIsAlign2(count)) {
         return false;
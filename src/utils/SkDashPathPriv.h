@@ -10,6 +10,8 @@
 
 #include "include/core/SkPathEffect.h"
 
+#include <functional>
+
 namespace SkDashPath {
     /**
      * Calculates the initialDashLength, initialDashIndex, and intervalLength based on the
@@ -46,6 +48,19 @@ namespace SkDashPath {
                         SkScalar intervalLength,
                         StrokeRecApplication = StrokeRecApplication::kAllow);
 
+    using DashBatchProc = std::function<void(const SkPath&)>;
+
+    /**
+     * Like FilterDashPath(), but rather than collecting every dash in one path, hands them to
+     * batchProc a few at a time, so dashing a long path doesn't build a huge one. With a cullRect,
+     * dashes that can't reach it once stroked are dropped. As with InternalFilter(), simple shapes
+     * may be stroked here, in which case the strokeRec is set to fill before the first batch.
+     * Like FilterDashPath(), this fails if there would be too many dashes, and then it does so
+     * before handing off any batches.
+     */
+    bool StreamDashPath(const SkPath& src, SkStrokeRec*, const SkRect* cullRect,
+                        const SkPathEffect::DashInfo& info, const DashBatchProc& batchProc);
+
     bool ValidDashPath(SkScalar phase, const SkScalar intervals[], int32_t count);
 }  // namespace SkDashPath
 
@@ -176,21 +176,14 @@ struct PagerCanvas : public SkNWayCanvas {
 };
 }  // namespace
 
-bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
-                                SkDocumentPage* dstArray,
-                                int dstArrayCount,
-                                const SkDeserialProcs* procs) {
-    if (!SkMultiPictureDocumentReadPageSizes(stream, dstArray, dstArrayCount)) {
-        return false;
-    }
+// Splits the picture of all the pages into dstArray, whose sizes have been read.
+static void read_pages(const SkPicture* picture, SkDocumentPage* dstArray, int dstArrayCount) {
     SkSize joined = {0.0f, 0.0f};
     for (int i = 0; i < dstArrayCount; ++i) {
         joined = SkSize{std::max(joined.width(), dstArray[i].fSize.width()),
                         std::max(joined.height(), dstArray[i].fSize.height())};
     }
 
-    auto picture = SkPicture::MakeFromStream(stream, procs);
-
     PagerCanvas canvas(joined.toCeil(), dstArray, dstArrayCount);
     // Must call playback(), not drawPicture() to reach
     // PagerCanvas::onDrawAnnotation().
@@ -199,5 +192,42 @@ bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
         SkDEBUGF("Malformed SkMultiPictureDocument: canvas.fIndex=%d dstArrayCount=%d\n",
             canvas.fIndex, dstArrayCount);
     }
+}
+
+bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
+                                SkDocumentPage* dstArray,
+                                int dstArrayCount,
+                                const SkDeserialProcs* procs) {
+    if (!SkMultiPictureDocumentReadPageSizes(stream, dstArray, dstArrayCount)) {
+        return false;
+    }
+    auto picture = SkPicture::MakeFromStream(stream, procs);
+    if (!picture) {
+        return false;
+    }
+    read_pages(picture.get(), dstArray, dstArrayCount);
+    return true;
+}
+
+bool SkMultiPictureDocumentReadLazily(sk_sp<SkData> src,
+                                      SkDocumentPage* dstArray,
+                                      int dstArrayCount,
+                                      const SkDeserialProcs* procs) {
+    if (!src) {
+        return false;
+    }
+    SkMemoryStream stream(src);
+    if (!SkMultiPictureDocumentReadPageSizes(&stream, dstArray, dstArrayCount)) {
+        return false;
+    }
+    // The pages are drawn into the pictures read_pages() records by reference, so they stay
+    // unread until they're drawn.
+    const size_t offset = stream.getPosition();
+    auto picture = SkPicture::MakeLazyFromData(
+            SkData::MakeSubset(src.get(), offset, src->size() - offset), procs);
+    if (!picture) {
+        return false;
+    }
+    read_pages(picture.get(), dstArray, dstArrayCount);
     return true;
 }
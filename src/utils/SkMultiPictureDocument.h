@@ -12,6 +12,7 @@
 #include "include/core/SkPicture.h"
 #include "include/core/SkSize.h"
 
+class SkData;
 struct SkDeserialProcs;
 struct SkSerialProcs;
 class SkStreamSeekable;
@@ -41,4 +42,13 @@ SK_SPI bool SkMultiPictureDocumentRead(SkStreamSeekable* src,
                                        int dstArrayCount,
                                        const SkDeserialProcs* = nullptr);
 
+/**
+ *  Like SkMultiPictureDocumentRead(), but each page is read from src only when it is first
+ *  drawn (see SkPicture::MakeLazyFromData()), and the pages keep a ref on src.
+ */
+SK_SPI bool SkMultiPictureDocumentReadLazily(sk_sp<SkData> src,
+                                             SkDocumentPage* dstArray,
+                                             int dstArrayCount,
+                                             const SkDeserialProcs* = nullptr);
+
 #endif  // SkMultiPictureDocument_DEFINED
@@ -34,9 +34,12 @@
 #include "include/private/SkFloatBits.h"
 #include "src/core/SkBlurMask.h"
 #include "src/core/SkBlurPriv.h"
+#include "src/core/SkCoreBlitters.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkMaskCache.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMathPriv.h"
+#include "src/core/SkRasterClip.h"
 #include "src/effects/SkEmbossMaskFilter.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
@@ -576,6 +579,142 @@ DEF_TEST(BlurredRRectNinePatchComputation, reporter) {
     }
 }
 
+// Blurred nested round rects are drawn as a nine patch whose mask only depends on the blur, the
+// radii and the insets between the two round rects, so growing them reuses the cached mask.
+DEF_TEST(BlurredDRRectNinePatch, reporter) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 3));
+
+    const SkVector radii[4] = {{12, 12}, {20, 10}, {4, 4}, {0, 0}};
+    auto surf = SkSurface::MakeRasterN32Premul(300, 300);
+    auto pathSurf = SkSurface::MakeRasterN32Premul(300, 300);
+    for (int i = 0; i < 4; ++i) {
+        SkRRect outer, inner;
+        outer.setRectRadii(SkRect::MakeXYWH(20, 20, 150 + 20 * i, 120 + 30 * i), radii);
+        outer.inset(8, 8, &inner);
+
+        SkMaskCache::Stats before = SkMaskCache::GetStats(SkMaskCache::kDRRect_Kind);
+        surf->getCanvas()->clear(SK_ColorWHITE);
+        surf->getCanvas()->drawDRRect(outer, inner, paint);
+        SkMaskCache::Stats after = SkMaskCache::GetStats(SkMaskCache::kDRRect_Kind);
+        if (i > 0) {
+            REPORTER_ASSERT(reporter, after.fHits - before.fHits == 1);
+            REPORTER_ASSERT(reporter, after.fMisses == before.fMisses);
+        }
+
+        // It should look like the same shape drawn as a path.
+        SkPath path;
+        path.addRRect(outer);
+        path.addRRect(inner);
+        path.setFillType(SkPathFillType::kEvenOdd);
+        pathSurf->getCanvas()->clear(SK_ColorWHITE);
+        pathSurf->getCanvas()->drawPath(path, paint);
+
+        SkBitmap a, b;
+        a.allocPixels(surf->imageInfo());
+        b.allocPixels(surf->imageInfo());
+        surf->readPixels(a, 0, 0);
+        pathSurf->readPixels(b, 0, 0);
+        int maxDiff = 0;
+        for (int y = 0; y < a.height(); ++y) {
+            for (int x = 0; x < a.width(); ++x) {
+                maxDiff = std::max(maxDiff, abs((int)SkColorGetR(a.getColor(x, y)) -
+                                                (int)SkColorGetR(b.getColor(x, y))));
+            }
+        }
+        // Not exact: the first size is off by 1/255 in places.
+        REPORTER_ASSERT(reporter, maxDiff <= 1, "maxDiff %d", maxDiff);
+    }
+}
+
+static SkBitmap draw_analytic_blurred_rrect(const SkRRect& rrect, SkScalar sigma) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeA8(128, 128));
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkA8_Coverage_Blitter blitter(bm.pixmap(), SkPaint());
+    SkDrawAnalyticBlurredRRect(rrect, sigma, SkRasterClip(bm.bounds()), &blitter);
+    return bm;
+}
+
+// A blurred rect has a closed form: the product of differences of normal CDFs in x and y. The
+// analytic blur samples it at pixel centers, so compare it to the blur averaged over each pixel
+// (from 4x4 samples). Center sampling is off by at most 7/255 at sigma 0.75, and 3/255 from 1.5.
+DEF_TEST(BlurredRRectAnalytic_ExactForRects, reporter) {
+    auto cdf = [](double t) { return 0.5 * erfc(-t * SK_ScalarRoot2Over2); };
+    const SkRect r = SkRect::MakeXYWH(40.3f, 50.6f, 47.5f, 29.25f);
+    for (SkScalar sigma : {0.75f, 1.5f, 3.0f, 6.0f, 12.0f}) {
+        SkBitmap actual = draw_analytic_blurred_rrect(SkRRect::MakeRect(r), sigma);
+        double maxDiff = 0;
+        for (int y = 0; y < actual.height(); ++y) {
+            for (int x = 0; x < actual.width(); ++x) {
+                double expected = 0;
+                for (int j = 0; j < 4; ++j) {
+                    for (int i = 0; i < 4; ++i) {
+                        double px = x + (i + 0.5) / 4,
+                               py = y + (j + 0.5) / 4;
+                        expected += (cdf((r.fRight  - px) / sigma) - cdf((r.fLeft - px) / sigma)) *
+                                    (cdf((r.fBottom - py) / sigma) - cdf((r.fTop  - py) / sigma));
+                    }
+                }
+                expected *= 255.0 / 16;
+                maxDiff = std::max(maxDiff, fabs(expected - *actual.getAddr8(x, y)));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= (sigma < 1 ? 7 : 3), "sigma %g maxDiff %g",
+                        sigma, maxDiff);
+    }
+}
+
+// The analytic blur of any kind of round rect should look like blurring the round rect's rendered
+// mask, which is what drawing it as a path does. The mask's box blurs only approximate a Gaussian,
+// and are far off for small sigmas (by up to 74/255 for the rect above at sigma 0.75), so the
+// largest difference is only checked from sigma 3, where it is at most 20/255. On average they
+// differ by less than 1.25/255 at every sigma. The last round rect's tall upper left and lower
+// right corners share rows, which the nine patch doesn't handle.
+DEF_TEST(BlurredRRectAnalytic_MatchesMask, reporter) {
+    const SkVector radii[4] = {{12, 12}, {20, 10}, {4, 4}, {0, 0}};
+    const SkVector skewedRadii[4] = {{20, 40}, {15, 5}, {25, 45}, {10, 10}};
+    const SkRect r = SkRect::MakeXYWH(40.3f, 50.6f, 47.5f, 29.25f);
+    SkRRect rrects[7];
+    rrects[0].setRect(r);
+    rrects[1].setOval(r);
+    rrects[2].setRectXY(r, 8, 8);
+    rrects[3].setRectXY(r, 16, 6);
+    rrects[4].setNinePatch(r, 3, 9, 12, 5);
+    rrects[5].setRectRadii(r, radii);
+    rrects[6].setRectRadii(SkRect::MakeXYWH(30.3f, 40.6f, 60.5f, 50), skewedRadii);
+
+    for (const SkRRect& rrect : rrects) {
+        for (SkScalar sigma : {0.75f, 1.5f, 3.0f, 6.0f, 12.0f}) {
+            SkBitmap expected;
+            expected.allocPixels(SkImageInfo::MakeA8(128, 128));
+            expected.eraseColor(SK_ColorTRANSPARENT);
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma));
+            SkPath path = SkPath::RRect(rrect);
+            path.setIsVolatile(true);
+            SkCanvas(expected).drawPath(path, paint);
+
+            SkBitmap actual = draw_analytic_blurred_rrect(rrect, sigma);
+            int maxDiff = 0,
+                sumDiff = 0;
+            for (int y = 0; y < expected.height(); ++y) {
+                for (int x = 0; x < expected.width(); ++x) {
+                    int diff = abs(*expected.getAddr8(x, y) - *actual.getAddr8(x, y));
+                    maxDiff = std::max(maxDiff, diff);
+                    sumDiff += diff;
+                }
+            }
+            REPORTER_ASSERT(reporter, sigma < 3 || maxDiff <= 20, "type %d sigma %g maxDiff %d",
+                            rrect.getType(), sigma, maxDiff);
+            REPORTER_ASSERT(reporter, sumDiff * 4 < expected.width() * expected.height() * 5,
+                            "type %d sigma %g sumDiff %d", rrect.getType(), sigma, sumDiff);
+        }
+    }
+}
+
 // https://crbugs.com/787712
 DEF_TEST(EmbossPerlinCrash, reporter) {
     SkPaint p;
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -19,6 +20,7 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
+#include "src/utils/SkDashPathPriv.h"
 #include "tests/Test.h"
 
 // crbug.com/348821 was rooted in SkDashPathEffect refusing to flatten and unflatten itself when
@@ -140,3 +142,117 @@ DEF_TEST(DashCrazy_crbug_875494, r) {
     paint.setPathEffect(SkDashPathEffect::Make(vals, N, 222));
     paint.getFillPath(path, &path2, &cull);
 }
+
+// Without a cull rect, the batches hold the same dashes as the whole dashed path.
+DEF_TEST(DashPath_StreamBatches, r) {
+    SkPath path;
+    path.moveTo(10, 10);
+    for (int i = 1; i < 200; ++i) {
+        path.lineTo(10 + i * 5, i & 1 ? 40 : 10);
+    }
+    path.addCircle(100, 100, 50);
+
+    const SkScalar intervals[] = { 3, 2 };
+    SkPathEffect::DashInfo info;
+    info.fIntervals = const_cast<SkScalar*>(intervals);
+    info.fCount = 2;
+    info.fPhase = 1;
+
+    SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+    SkPath whole;
+    REPORTER_ASSERT(r, SkDashPath::FilterDashPath(&whole, path, &rec, nullptr, info));
+
+    SkPath streamed;
+    int batches = 0;
+    REPORTER_ASSERT(r, SkDashPath::StreamDashPath(path, &rec, nullptr, info,
+                                                  [&](const SkPath& batch) {
+        streamed.addPath(batch);
+        ++batches;
+    }));
+    REPORTER_ASSERT(r, batches > 1);
+    REPORTER_ASSERT(r, streamed.countVerbs() == whole.countVerbs());
+    REPORTER_ASSERT(r, streamed.countPoints() == whole.countPoints());
+    REPORTER_ASSERT(r, streamed.getBounds() == whole.getBounds());
+
+    // Past the dash count limit nothing is handed off, so the caller can draw something else.
+    SkPath longLines;
+    longLines.moveTo(0, 10);
+    longLines.lineTo(100, 10);
+    longLines.moveTo(0, 0);
+    longLines.lineTo(10 * SkDashPath::kMaxDashCount, 0);
+    batches = 0;
+    REPORTER_ASSERT(r, !SkDashPath::StreamDashPath(longLines, &rec, nullptr, info,
+                                                   [&](const SkPath&) { ++batches; }));
+    REPORTER_ASSERT(r, batches == 0);
+
+    // The same for a single stroked line, which is dashed without measuring it.
+    SkPath longLine;
+    longLine.moveTo(0, 0);
+    longLine.lineTo(10 * SkDashPath::kMaxDashCount, 0);
+    SkStrokeRec strokeRec(SkStrokeRec::kFill_InitStyle);
+    strokeRec.setStrokeStyle(2);
+    REPORTER_ASSERT(r, !SkDashPath::StreamDashPath(longLine, &strokeRec, nullptr, info,
+                                                   [&](const SkPath&) { ++batches; }));
+    REPORTER_ASSERT(r, batches == 0);
+}
+
+// Aliased, opaque dashed strokes are drawn a batch of dashes at a time, culled to the clip. That
+// should touch exactly the pixels that filling the whole dashed stroke does. Anti-aliased ones are
+// drawn whole, since their overlapping edges would darken if drawn in separate batches.
+DEF_TEST(DashPath_StreamedDraw, r) {
+    SkPath path;
+    path.moveTo(-300, 20);
+    for (int i = 1; i < 400; ++i) {
+        path.lineTo(-300 + i * 3.3f, 20 + 60 * SkScalarSin(i * 0.05f) + (i % 7));
+    }
+    path.moveTo(60, 60);
+    path.cubicTo(200, -40, 250, 250, 30, 120);
+    path.close();
+    // A single line is dashed without measuring it.
+    SkPath line;
+    line.moveTo(-500, 70);
+    line.lineTo(1000, 95);
+
+    const SkScalar intervals[] = { 6, 3, 1, 3 };
+    for (const SkPath* src : {&path, &line}) {
+        for (bool aa : {false, true}) {
+            for (SkPaint::Cap cap : {SkPaint::kButt_Cap, SkPaint::kSquare_Cap,
+                                     SkPaint::kRound_Cap}) {
+                SkPaint paint;
+                paint.setAntiAlias(aa);
+                paint.setStyle(SkPaint::kStroke_Style);
+                paint.setStrokeWidth(3);
+                paint.setStrokeCap(cap);
+                paint.setPathEffect(SkDashPathEffect::Make(intervals, SK_ARRAY_COUNT(intervals),
+                                                           2));
+
+                SkPath filled;
+                paint.getFillPath(*src, &filled);
+
+                SkBitmap expected, actual;
+                for (SkBitmap* bm : {&expected, &actual}) {
+                    bm->allocN32Pixels(160, 140);
+                    bm->eraseColor(SK_ColorWHITE);
+                    SkCanvas canvas(*bm);
+                    canvas.clipRect({10, 5, 150, 130});
+                    canvas.translate(3, 2);
+                    if (bm == &expected) {
+                        SkPaint fill;
+                        fill.setAntiAlias(aa);
+                        canvas.drawPath(filled, fill);
+                    } else {
+                        canvas.drawPath(*src, paint);
+                    }
+                }
+                int diffs = 0;
+                for (int y = 0; y < expected.height(); ++y) {
+                    for (int x = 0; x < expected.width(); ++x) {
+                        diffs += *expected.getAddr32(x, y) != *actual.getAddr32(x, y);
+                    }
+                }
+                REPORTER_ASSERT(r, diffs == 0, "line %d aa %d cap %d diffs %d",
+                                src == &line, aa, cap, diffs);
+            }
+        }
+    }
+}
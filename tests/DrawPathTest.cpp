@@ -22,6 +22,7 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
+#include "include/utils/SkRandom.h"
 #include "tests/Test.h"
 
 // test that we can draw an aa-rect at coordinates > 32K (bigger than fixedpoint)
@@ -371,3 +372,97 @@ DEF_TEST(DrawPath, reporter) {
     test_big_aa_rect(reporter);
     test_halfway();
 }
+
+// Many anti-aliased hairlines drawn with an opaque paint are accumulated in a mask and blitted
+// once. That should match drawing them one at a time, give or take rounding.
+DEF_TEST(DrawPath_AntiHairBatch, reporter) {
+    SkRandom rand;
+    SkPoint pts[200];
+    const int count = SK_ARRAY_COUNT(pts);
+    for (SkPoint& pt : pts) {
+        pt.set(rand.nextRangeScalar(-20, 120), rand.nextRangeScalar(-20, 120));
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setColor(0xFF336699);
+
+    // Each draw is checked on its own, since the rounding of drawing one segment at a time adds up.
+    enum { kLines, kPolygon, kPath };
+    for (int draw : {kLines, kPolygon, kPath}) {
+        for (int clip = 0; clip < 3; ++clip) {
+            SkBitmap expected, actual;
+            for (SkBitmap* bm : {&expected, &actual}) {
+                bm->allocN32Pixels(100, 100);
+                bm->eraseColor(SK_ColorWHITE);
+                SkCanvas canvas(*bm);
+                if (1 == clip) {
+                    canvas.clipRect({10.5f, 10, 90, 80.5f});
+                } else if (2 == clip) {
+                    canvas.clipRRect(SkRRect::MakeRectXY({5, 5, 95, 95}, 30, 30), true);
+                }
+                // Drawn a segment at a time, there are too few to be batched.
+                const bool batch = bm == &actual;
+                switch (draw) {
+                    case kLines:
+                        if (batch) {
+                            canvas.drawPoints(SkCanvas::kLines_PointMode, count, pts, paint);
+                        } else {
+                            for (int i = 0; i + 1 < count; i += 2) {
+                                canvas.drawLine(pts[i], pts[i + 1], paint);
+                            }
+                        }
+                        break;
+                    case kPolygon:
+                        if (batch) {
+                            canvas.drawPoints(SkCanvas::kPolygon_PointMode, count, pts, paint);
+                        } else {
+                            for (int i = 0; i + 1 < count; ++i) {
+                                canvas.drawLine(pts[i], pts[i + 1], paint);
+                            }
+                        }
+                        break;
+                    case kPath: {
+                        SkPath path;
+                        path.moveTo(pts[0]);
+                        for (int i = 1; i + 1 < count; i += 2) {
+                            SkPath segment;
+                            segment.moveTo(path.getPoint(path.countPoints() - 1));
+                            if (i % 3) {
+                                path.lineTo(pts[i]);
+                                segment.lineTo(pts[i]);
+                            } else {
+                                path.quadTo(pts[i], pts[i + 1]);
+                                segment.quadTo(pts[i], pts[i + 1]);
+                            }
+                            if (!batch) {
+                                canvas.drawPath(segment, paint);
+                            }
+                        }
+                        if (batch) {
+                            canvas.drawPath(path, paint);
+                        }
+                        break;
+                    }
+                }
+            }
+
+            int maxDiff = 0, drawn = 0;
+            for (int y = 0; y < 100; ++y) {
+                for (int x = 0; x < 100; ++x) {
+                    SkColor e = expected.getColor(x, y),
+                            a = actual.getColor(x, y);
+                    drawn += e != SK_ColorWHITE;
+                    maxDiff = std::max({maxDiff,
+                                        SkTAbs((int)SkColorGetR(e) - (int)SkColorGetR(a)),
+                                        SkTAbs((int)SkColorGetG(e) - (int)SkColorGetG(a)),
+                                        SkTAbs((int)SkColorGetB(e) - (int)SkColorGetB(a))});
+                }
+            }
+            REPORTER_ASSERT(reporter, drawn > 1000);
+            REPORTER_ASSERT(reporter, maxDiff <= 3, "draw %d clip %d max diff %d",
+                            draw, clip, maxDiff);
+        }
+    }
+}
@@ -9,6 +9,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPathEffect.h"
@@ -17,11 +18,15 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
+#include "include/effects/SkGradientShader.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
 
 static const SkColor bgColor = SK_ColorWHITE;
@@ -161,3 +166,136 @@ DEF_TEST(DrawText_weirdMatricies, r) {
         canvas->drawString("Hamburgefons", 10, 10, font, SkPaint());
     }
 }
+
+// Dense runs of glyphs drawn with an opaque shader are accumulated in one mask and blitted once.
+// That should match drawing the glyphs one at a time, give or take rounding.
+DEF_TEST(DrawText_glyphBatch, reporter) {
+    SkFont font(nullptr, 9);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+
+    const char text[] = "The quick brown fox jumps over the lazy dog.";
+    SkGlyphID glyphs[SK_ARRAY_COUNT(text) - 1];
+    const int glyphsPerLine = font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8,
+                                                glyphs, SK_ARRAY_COUNT(glyphs));
+    SkScalar widths[SK_ARRAY_COUNT(glyphs)];
+    font.getWidths(glyphs, glyphsPerLine, widths);
+
+    constexpr int kLines = 12;
+    SkTextBlobBuilder builder;
+    const auto& run = builder.allocRunPos(font, glyphsPerLine * kLines);
+    for (int line = 0; line < kLines; line++) {
+        // Shift each line by a fraction of a pixel, so every sub-pixel position is drawn.
+        SkScalar x = 2 + line * 0.3f;
+        for (int i = 0; i < glyphsPerLine; i++) {
+            run.glyphs[line * glyphsPerLine + i] = glyphs[i];
+            run.points()[line * glyphsPerLine + i] = {x, 10.5f + line * 10.25f};
+            x += widths[i];
+        }
+    }
+    sk_sp<SkTextBlob> blob = builder.make();
+
+    SkPaint gradient;
+    SkPoint pts[] = {{0, 0}, {250, 130}};
+    SkColor colors[] = {SK_ColorBLUE, SK_ColorRED};
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+
+    for (const SkPaint& paint : {SkPaint(), gradient}) {
+        SkBitmap batched, separate;
+        batched.allocN32Pixels(250, 130);
+        separate.allocN32Pixels(250, 130);
+        SkCanvas batchedCanvas(batched),
+                 separateCanvas(separate);
+        batchedCanvas.clear(SK_ColorWHITE);
+        separateCanvas.clear(SK_ColorWHITE);
+
+        batchedCanvas.drawTextBlob(blob, 0, 0, paint);
+        for (int i = 0; i < glyphsPerLine * kLines; i++) {
+            separateCanvas.drawSimpleText(&run.glyphs[i], sizeof(SkGlyphID),
+                                          SkTextEncoding::kGlyphID,
+                                          run.points()[i].fX, run.points()[i].fY, font, paint);
+        }
+
+        int maxDiff = 0,
+            drawn = 0;
+        for (int y = 0; y < batched.height(); y++) {
+            for (int x = 0; x < batched.width(); x++) {
+                SkColor a = batched.getColor(x, y),
+                        b = separate.getColor(x, y);
+                maxDiff = std::max({maxDiff,
+                                    abs((int)SkColorGetR(a) - (int)SkColorGetR(b)),
+                                    abs((int)SkColorGetG(a) - (int)SkColorGetG(b)),
+                                    abs((int)SkColorGetB(a) - (int)SkColorGetB(b))});
+                drawn += b != SK_ColorWHITE;
+            }
+        }
+        REPORTER_ASSERT(reporter, drawn > 1000, "%d", drawn);
+        REPORTER_ASSERT(reporter, maxDiff <= 2, "%d", maxDiff);
+    }
+}
+
+DEF_TEST(DrawText_distanceFields, reporter) {
+    // Unhinted, so the masks have the outlines the distance fields have.
+    SkFont font(nullptr, 24);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setHinting(SkFontHinting::kNone);
+    font.setSubpixel(true);
+    sk_sp<SkTextBlob> blob = SkTextBlob::MakeFromString("Hamburgefons", font);
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(400, 120);
+    const SkSurfaceProps dfProps(SkSurfaceProps::kUseDeviceIndependentFonts_Flag,
+                                 kUnknown_SkPixelGeometry);
+    sk_sp<SkSurface> dfSurface   = SkSurface::MakeRaster(info, &dfProps),
+                     maskSurface = SkSurface::MakeRaster(info);
+
+    // Scales within one distance field size bucket share one strike, where masks need one each.
+    const SkScalar scales[] = {1.1f, 1.2f, 1.25f, 1.3f};
+    for (SkSurface* surface : {dfSurface.get(), maskSurface.get()}) {
+        SkGraphics::PurgeFontCache();
+        for (SkScalar scale : scales) {
+            surface->getCanvas()->save();
+            surface->getCanvas()->scale(scale, scale);
+            surface->getCanvas()->drawTextBlob(blob, 10, 40, SkPaint());
+            surface->getCanvas()->restore();
+        }
+        int strikes = SkGraphics::GetFontCacheCountUsed();
+        if (surface == dfSurface.get()) {
+            REPORTER_ASSERT(reporter, strikes == 1, "%d", strikes);
+        } else {
+            REPORTER_ASSERT(reporter, strikes == (int)SK_ARRAY_COUNT(scales), "%d", strikes);
+        }
+    }
+
+    // Both draw the same text, to within the anti-aliasing of its edges.
+    for (SkScalar scale : {1.0f, 2.0f, 3.5f}) {
+        SkBitmap df, mask;
+        for (auto [surface, bitmap] : {std::make_pair(dfSurface.get(), &df),
+                                       std::make_pair(maskSurface.get(), &mask)}) {
+            SkCanvas* canvas = surface->getCanvas();
+            canvas->clear(SK_ColorWHITE);
+            canvas->save();
+            canvas->scale(scale, scale);
+            canvas->drawTextBlob(blob, 4, 24, SkPaint());
+            canvas->restore();
+            bitmap->allocPixels(info);
+            surface->readPixels(*bitmap, 0, 0);
+        }
+
+        int dfInk = 0,
+            maskInk = 0,
+            far = 0;
+        for (int y = 0; y < info.height(); y++) {
+            for (int x = 0; x < info.width(); x++) {
+                int a = 255 - SkColorGetG(df.getColor(x, y)),
+                    b = 255 - SkColorGetG(mask.getColor(x, y));
+                dfInk += a;
+                maskInk += b;
+                far += abs(a - b) > 160;
+            }
+        }
+        REPORTER_ASSERT(reporter, maskInk > 0);
+        REPORTER_ASSERT(reporter, abs(dfInk - maskInk) < maskInk / 10,
+                        "scale %g: %d vs %d", scale, dfInk, maskInk);
+        REPORTER_ASSERT(reporter, far < 20, "scale %g: %d", scale, far);
+    }
+}
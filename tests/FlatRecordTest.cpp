@@ -0,0 +1,215 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/utils/SkRandom.h"
+#include "src/core/SkFlatRecord.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "tests/Test.h"
+
+static constexpr int W = 64, H = 64;
+
+// Uses every op the flat format supports.
+static void draw_supported(SkCanvas* canvas) {
+    SkPaint fill;
+    fill.setColor(SK_ColorRED);
+    fill.setAntiAlias(true);
+    SkPaint stroke;
+    stroke.setColor4f({0, 0.5f, 1, 0.75f});
+    stroke.setStyle(SkPaint::kStroke_Style);
+    stroke.setStrokeWidth(3);
+    stroke.setStrokeCap(SkPaint::kRound_Cap);
+    stroke.setStrokeJoin(SkPaint::kBevel_Join);
+    stroke.setBlendMode(SkBlendMode::kMultiply);
+
+    SkPath path;
+    path.moveTo(4, 4);
+    path.quadTo(30, 0, 40, 20);
+    path.conicTo(50, 40, 20, 50, 0.6f);
+    path.cubicTo(10, 60, 0, 30, 8, 20);
+    path.close();
+    path.moveTo(50, 50);
+    path.lineTo(60, 52);
+    path.setFillType(SkPathFillType::kEvenOdd);
+    // Flat records play back volatile paths; keep the SkRecord's from being drawn from cached masks.
+    path.setIsVolatile(true);
+
+    canvas->drawPaint(SkPaint(SkColors::kWhite));
+    canvas->save();
+        canvas->translate(2, 3);
+        canvas->scale(0.9f, 1.1f);
+        canvas->drawRect({5, 5, 30, 20}, fill);
+        canvas->drawOval({30, 5, 60, 25}, stroke);
+        canvas->clipRect({0, 0, 60, 60}, true);
+    canvas->restore();
+    canvas->save();
+        canvas->concat(SkMatrix::RotateDeg(10));
+        canvas->clipRRect(SkRRect::MakeRectXY({2, 2, 62, 62}, 10, 10), true);
+        canvas->drawRRect(SkRRect::MakeRectXY({10, 30, 40, 60}, 5, 8), fill);
+        canvas->drawDRRect(SkRRect::MakeOval({20, 20, 60, 60}),
+                           SkRRect::MakeRect({30, 30, 50, 50}), stroke);
+    canvas->restore();
+
+    SkPaint layer;
+    layer.setAlphaf(0.5f);
+    SkRect bounds = {0, 0, 40, 40};
+    canvas->saveLayer(&bounds, &layer);
+        canvas->setMatrix(SkMatrix::Translate(1, 1));
+        canvas->drawArc({0, 0, 40, 40}, 30, 200, true, fill);
+        canvas->drawPath(path, stroke);
+    canvas->restore();
+    canvas->saveLayer(nullptr, nullptr);
+        canvas->concat(SkM44::Scale(1.2f, 1.2f));
+        canvas->clipPath(path, SkClipOp::kDifference, true);
+        canvas->drawPath(path, fill);
+        SkPoint pts[] = {{1, 60}, {20, 40}, {40, 62}, {62, 30}};
+        canvas->drawPoints(SkCanvas::kPolygon_PointMode, 4, pts, stroke);
+        SkPoint clip[] = {{40, 40}, {60, 42}, {58, 60}, {42, 58}};
+        canvas->experimental_DrawEdgeAAQuad({40, 40, 60, 60}, clip, SkCanvas::kAll_QuadAAFlags,
+                                            SkColors::kGreen, SkBlendMode::kSrcOver);
+        canvas->experimental_DrawEdgeAAQuad({0, 0, 10, 10}, nullptr, SkCanvas::kNone_QuadAAFlags,
+                                            SkColors::kBlue, SkBlendMode::kSrc);
+    canvas->restore();
+    canvas->flush();
+}
+
+static sk_sp<SkData> flatten(void (*draw)(SkCanvas*), int* count = nullptr) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+    draw(&recorder);
+    if (count) {
+        *count = record.count();
+    }
+    return SkFlatRecord::Serialize(record, SkRect::MakeWH(W, H));
+}
+
+static SkBitmap draw_record(void (*draw)(SkCanvas*)) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+    draw(&recorder);
+
+    SkBitmap bm;
+    bm.allocN32Pixels(W, H);
+    SkCanvas canvas(bm);
+    canvas.translate(3, -2);  // SetMatrix is relative to the matrix playback starts with.
+    SkRecordDraw(record, &canvas, nullptr, nullptr, 0, nullptr, nullptr);
+    return bm;
+}
+
+static SkBitmap draw_flat(const SkFlatRecord& flat) {
+    SkBitmap bm;
+    bm.allocN32Pixels(W, H);
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bm);
+    canvas.translate(3, -2);
+    flat.playback(&canvas);
+    return bm;
+}
+
+DEF_TEST(FlatRecord_Playback, r) {
+    int count;
+    sk_sp<SkData> data = flatten(draw_supported, &count);
+    REPORTER_ASSERT(r, data);
+    REPORTER_ASSERT(r, SkIsAlign4(data->size()));
+
+    sk_sp<SkFlatRecord> flat = SkFlatRecord::Make(data);
+    REPORTER_ASSERT(r, flat);
+    REPORTER_ASSERT(r, flat->count() == count);
+    REPORTER_ASSERT(r, flat->cullRect() == SkRect::MakeWH(W, H));
+
+    SkBitmap expected = draw_record(draw_supported),
+             actual   = draw_flat(*flat);
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+
+    // Data that isn't 4-byte aligned is copied.
+    sk_sp<SkData> shifted = SkData::MakeUninitialized(data->size() + 1);
+    memcpy((char*)shifted->writable_data() + 1, data->data(), data->size());
+    flat = SkFlatRecord::Make(SkData::MakeSubset(shifted.get(), 1, data->size()));
+    REPORTER_ASSERT(r, flat);
+    actual = draw_flat(*flat);
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+}
+
+DEF_TEST(FlatRecord_Unsupported, r) {
+    REPORTER_ASSERT(r, !flatten([](SkCanvas* canvas) {
+        SkPoint pts[] = {{0, 0}, {10, 10}};
+        SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                     SkTileMode::kClamp));
+        canvas->drawRect({0, 0, 10, 10}, paint);
+    }));
+    REPORTER_ASSERT(r, !flatten([](SkCanvas* canvas) {
+        SkBitmap bm;
+        bm.allocN32Pixels(4, 4);
+        bm.eraseColor(SK_ColorRED);
+        canvas->drawImage(SkImage::MakeFromBitmap(bm), 0, 0);
+    }));
+
+    // Nothing at all is fine.
+    sk_sp<SkFlatRecord> flat = SkFlatRecord::Make(flatten([](SkCanvas*) {}));
+    REPORTER_ASSERT(r, flat && flat->count() == 0);
+}
+
+DEF_TEST(FlatRecord_Invalid, r) {
+    sk_sp<SkData> data = flatten(draw_supported);
+    REPORTER_ASSERT(r, SkFlatRecord::Make(data));
+    REPORTER_ASSERT(r, !SkFlatRecord::Make(nullptr));
+
+    for (size_t size = 0; size < data->size(); size++) {
+        REPORTER_ASSERT(r, !SkFlatRecord::Make(SkData::MakeSubset(data.get(), 0, size)));
+    }
+
+    // Infinite stroke widths and miter limits are rejected, like NaN and negative ones.
+    sk_sp<SkData> stroked = flatten([](SkCanvas* canvas) {
+        SkPaint paint;
+        paint.setStyle(SkPaint::kStroke_Style);
+        paint.setStrokeWidth(1234.5f);
+        paint.setStrokeMiter(6789.5f);
+        canvas->drawRect({1, 1, 9, 9}, paint);
+    });
+    REPORTER_ASSERT(r, SkFlatRecord::Make(stroked));
+    for (float value : {1234.5f, 6789.5f}) {
+        for (float bad : {SK_ScalarInfinity, SK_ScalarNaN, -1.0f}) {
+            sk_sp<SkData> corrupt = SkData::MakeWithCopy(stroked->data(), stroked->size());
+            auto floats = static_cast<float*>(corrupt->writable_data());
+            int replaced = 0;
+            for (size_t j = 0; j < corrupt->size() / sizeof(float); j++) {
+                if (floats[j] == value) {
+                    floats[j] = bad;
+                    replaced++;
+                }
+            }
+            REPORTER_ASSERT(r, replaced == 1);
+            REPORTER_ASSERT(r, !SkFlatRecord::Make(corrupt), "%g -> %g", value, bad);
+        }
+    }
+
+    // Whatever gets through validation must be safe to play back.
+    SkRandom rand;
+    int accepted = 0;
+    for (int i = 0; i < 2000; i++) {
+        sk_sp<SkData> corrupt = SkData::MakeWithCopy(data->data(), data->size());
+        auto bytes = static_cast<uint8_t*>(corrupt->writable_data());
+        bytes[rand.nextULessThan((uint32_t)corrupt->size())] = (uint8_t)rand.nextU();
+        if (sk_sp<SkFlatRecord> flat = SkFlatRecord::Make(corrupt)) {
+            draw_flat(*flat);
+            accepted++;
+        }
+    }
+    REPORTER_ASSERT(r, accepted < 2000);
+}
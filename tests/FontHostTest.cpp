@@ -9,10 +9,15 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
+#include "include/core/SkExecutor.h"
+#include "src/core/SkArenaAlloc.h"
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkEndian.h"
 #include "src/core/SkFontStream.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkScalerContext.h"
+#include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
@@ -272,4 +277,86 @@ DEF_TEST(FontHost, reporter) {
     test_symbolfont(reporter);
 }
 
+// Everything a scaler context produced for the first glyphs of a typeface.
+struct ScalerResults {
+    SkFontMetrics        fFontMetrics;
+    SkTArray<SkIRect>    fBounds;
+    SkTArray<SkVector>   fAdvances;
+    SkTDArray<uint8_t>   fImages;
+    SkTArray<SkPath>     fPaths;
+};
+
+static void scale_glyphs(SkScalerContext* ctx, int glyphCount, ScalerResults* results) {
+    ctx->getFontMetrics(&results->fFontMetrics);
+    SkArenaAlloc alloc(4096);
+    for (int id = 0; id < glyphCount; ++id) {
+        SkGlyph glyph{SkPackedGlyphID(SkTo<SkGlyphID>(id))};
+        ctx->getMetrics(&glyph);
+        results->fBounds.push_back(glyph.iRect());
+        results->fAdvances.push_back(glyph.advanceVector());
+        if (glyph.setImage(&alloc, ctx) && glyph.image()) {
+            results->fImages.append(SkToInt(glyph.imageSize()),
+                                    static_cast<const uint8_t*>(glyph.image()));
+        }
+        glyph.setPath(&alloc, ctx);
+        results->fPaths.push_back(glyph.path() ? *glyph.path() : SkPath());
+    }
+}
+
+static bool operator==(const ScalerResults& a, const ScalerResults& b) {
+    return SkFontMetrics(a.fFontMetrics) == b.fFontMetrics &&
+           a.fBounds == b.fBounds && a.fAdvances == b.fAdvances && a.fPaths == b.fPaths &&
+           a.fImages.count() == b.fImages.count() &&
+           !memcmp(a.fImages.begin(), b.fImages.begin(), a.fImages.count());
+}
+
+// Each FreeType scaler context has its own FT_Face, so several contexts for one typeface can scale
+// glyphs at the same time. They must produce what a single context does on its own.
+DEF_TEST(FontHostScalerContextsInParallel, reporter) {
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        return;
+    }
+    const int glyphCount = std::min(typeface->countGlyphs(), 96);
+    static constexpr int kContextCount = 4;
+
+    SkFont font(typeface);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    for (SkScalar size : {11.0f, 24.5f}) {
+        for (SkFontHinting hinting : {SkFontHinting::kNone, SkFontHinting::kNormal}) {
+            font.setSize(size);
+            font.setHinting(hinting);
+            SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                    font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                    SkScalerContextFlags::kNone, SkMatrix::I());
+
+            ScalerResults expected;
+            {
+                auto ctx = typeface->createScalerContext(SkScalerContextEffects(),
+                                                         &strikeSpec.descriptor());
+                scale_glyphs(ctx.get(), glyphCount, &expected);
+            }
+
+            // Open every context before using any of them, so their faces are all live at once.
+            std::unique_ptr<SkScalerContext> contexts[kContextCount];
+            for (auto& ctx : contexts) {
+                ctx = typeface->createScalerContext(SkScalerContextEffects(),
+                                                    &strikeSpec.descriptor());
+            }
+            ScalerResults actual[kContextCount];
+            auto executor = SkExecutor::MakeFIFOThreadPool(kContextCount);
+            SkTaskGroup tasks(*executor);
+            tasks.batch(kContextCount, [&](int i) {
+                scale_glyphs(contexts[i].get(), glyphCount, &actual[i]);
+            });
+            tasks.wait();
+
+            for (const ScalerResults& results : actual) {
+                REPORTER_ASSERT(reporter, results == expected, "size %g hinting %d",
+                                size, (int)hinting);
+            }
+        }
+    }
+}
+
 // need tests for SkStrSearch
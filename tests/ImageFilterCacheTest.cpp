@@ -8,12 +8,14 @@
 #include "tests/Test.h"
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkMatrix.h"
 #include "include/effects/SkImageFilters.h"
 #include "src/core/SkImageFilterCache.h"
+#include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkSpecialImage.h"
 
 SK_USE_FLUENT_IMAGE_FILTER_TYPES
@@ -198,6 +200,88 @@ DEF_TEST(ImageFilterCache_ImageBackedRaster, reporter) {
     test_image_backed(reporter, nullptr, srcImage);
 }
 
+static const SkImageFilterCache::Stats* find_stats(
+        const std::vector<SkImageFilterCache::Stats>& stats, const char* typeName) {
+    for (const SkImageFilterCache::Stats& s : stats) {
+        if (!strcmp(s.fTypeName, typeName)) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+DEF_TEST(ImageFilterCache_StructuralKeys, reporter) {
+    auto filter1 = make_filter();
+    auto filter2 = make_filter();
+    auto other = SkImageFilters::ColorFilter(
+            SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn), nullptr, nullptr);
+
+    // Equivalent filters share a structural ID, which can't be mistaken for a unique ID.
+    uint32_t id1 = as_IFB(filter1)->structuralID();
+    REPORTER_ASSERT(reporter, id1 & SkImageFilterCache::kStructuralIDBit);
+    REPORTER_ASSERT(reporter, id1 == as_IFB(filter2)->structuralID());
+    REPORTER_ASSERT(reporter, id1 != as_IFB(other)->structuralID());
+    REPORTER_ASSERT(reporter, as_IFB(filter1)->uniqueID() != as_IFB(filter2)->uniqueID());
+
+    SkBitmap srcBM = create_bm();
+    sk_sp<SkSpecialImage> image(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kFullSize,
+                                                                               kFullSize),
+                                                               srcBM));
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(1000000));
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key(id1, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    cache->set(key, filter1.get(),
+               skif::FilterResult<For::kOutput>(image, skif::LayerSpace<SkIPoint>({0, 0})));
+
+    // Structurally keyed results outlive the filter that produced them...
+    cache->purgeByImageFilter(filter1.get());
+    filter1.reset();
+    skif::FilterResult<For::kOutput> found;
+    REPORTER_ASSERT(reporter, cache->get(key, &found));
+
+    std::vector<SkImageFilterCache::Stats> stats;
+    cache->getStats(&stats);
+    const SkImageFilterCache::Stats* s = find_stats(stats, filter2->getTypeName());
+    REPORTER_ASSERT(reporter, s && s->fHits == 1 && s->fInserts == 1 && s->fCount == 1);
+    REPORTER_ASSERT(reporter, s && s->fBytes == image->getSize());
+    REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() == image->getSize());
+
+    // ...until they no longer fit the budget.
+    REPORTER_ASSERT(reporter, 1000000 == cache->setByteLimit(image->getSize() - 1));
+    REPORTER_ASSERT(reporter, !cache->get(key, &found));
+    REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() == 0);
+}
+
+// Rebuilding an equivalent filter for every draw should hit a structurally keyed cache.
+DEF_TEST(ImageFilterCache_StructuralKeysFilter, reporter) {
+    SkBitmap srcBM = create_bm();
+    sk_sp<SkSpecialImage> image(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kFullSize,
+                                                                               kFullSize),
+                                                               srcBM));
+    const char* typeName = make_filter()->getTypeName();
+
+    for (bool structuralKeys : {false, true}) {
+        // Filters are keyed on unique IDs for this cache unless another test enabled structural
+        // keys globally.
+        sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(1000000, structuralKeys));
+        REPORTER_ASSERT(reporter, !structuralKeys || cache->usesStructuralKeys());
+        skif::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kFullSize, kFullSize), cache.get(),
+                          kN32_SkColorType, nullptr, image.get());
+        for (int i = 0; i < 3; ++i) {
+            as_IFB(make_filter())->filterImage(ctx);
+        }
+
+        std::vector<SkImageFilterCache::Stats> stats;
+        cache->getStats(&stats);
+        const SkImageFilterCache::Stats* s = find_stats(stats, typeName);
+        if (cache->usesStructuralKeys()) {
+            REPORTER_ASSERT(reporter, s && s->fHits == 2 && s->fInserts == 1 && s->fCount == 1);
+        } else {
+            REPORTER_ASSERT(reporter, s && s->fHits == 0 && s->fInserts == 3);
+        }
+    }
+}
+
 #include "include/gpu/GrDirectContext.h"
 #include "src/gpu/GrBitmapTextureMaker.h"
 #include "src/gpu/GrContextPriv.h"
@@ -7,6 +7,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
@@ -19,6 +20,7 @@
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/effects/SkTableColorFilter.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkColorFilterBase.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkReadBuffer.h"
@@ -865,6 +867,78 @@ DEF_TEST(ImageFilterDrawMatrixBBH, reporter) {
     }
 }
 
+// Filters 'source' with the executor passed straight to the filter Context, rather than installed
+// with SkGraphics::SetImageFilterExecutor(), so that other tests running in parallel don't pick it
+// up. 'result' is the size of 'source' and holds the output that lands inside it.
+static bool filter_tiled_executor_dag(const sk_sp<SkImageFilter>& filter,
+                                      const sk_sp<SkSpecialImage>& source, SkExecutor* executor,
+                                      SkBitmap* result) {
+    const SkIRect bounds = SkIRect::MakeWH(source->width(), source->height());
+    skif::Context ctx(skif::Mapping(SkMatrix::I(), SkMatrix::I()),
+                      skif::LayerSpace<SkIRect>(bounds), nullptr, kN32_SkColorType, nullptr,
+                      skif::FilterResult<skif::Usage::kInput>(source), executor);
+    SkIPoint offset;
+    sk_sp<SkSpecialImage> image = as_IFB(filter)->filterImage(ctx).imageAndOffset(&offset);
+    SkBitmap imageBM;
+    if (!image || !image->getROPixels(&imageBM)) {
+        return false;
+    }
+    result->allocN32Pixels(bounds.width(), bounds.height());
+    result->eraseColor(SK_ColorTRANSPARENT);
+    result->writePixels(imageBM.pixmap(), offset.fX, offset.fY);
+    return true;
+}
+
+DEF_TEST(ImageFilterTiledExecutor, reporter) {
+    // Check that splitting a raster filter DAG into tiles that are evaluated on an executor
+    // produces exactly the same pixels as evaluating the whole DAG at once.
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(4);
+
+    const int width = 1100, height = 700;
+    SkBitmap sourceBM;
+    sourceBM.allocN32Pixels(width, height);
+    SkCanvas canvas(sourceBM);
+    canvas.clear(SK_ColorTRANSPARENT);
+    SkPaint paint;
+    for (int i = 0; i < 40; ++i) {
+        paint.setColor(SkColorSetARGB(0xFF, (37 * i) & 0xFF, 255 - 5 * i, (91 * i) & 0xFF));
+        canvas.drawCircle(27.f * i, 17.f * i, 13.f + 3 * i, paint);
+    }
+    sk_sp<SkSpecialImage> source = SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(width, height),
+                                                                  sourceBM);
+
+    SkScalar kernel[9] = { 1, 1, 1, 1, -7, 1, 1, 1, 1 };
+    sk_sp<SkImageFilter> blur = SkImageFilters::Blur(6, 9, nullptr);
+    sk_sp<SkImageFilter> filters[] = {
+        blur,
+        SkImageFilters::Dilate(3, 5, blur),
+        SkImageFilters::Erode(4, 2, SkImageFilters::Offset(30, -20, nullptr)),
+        SkImageFilters::MatrixConvolution({3, 3}, kernel, 0.3f, 0.1f, {1, 1},
+                                          SkTileMode::kDecal, true, blur),
+        SkImageFilters::DisplacementMap(SkColorChannel::kR, SkColorChannel::kB, 12,
+                                        blur, SkImageFilters::Dilate(2, 2, nullptr)),
+        SkImageFilters::Merge(blur, SkImageFilters::Xfermode(SkBlendMode::kSrcIn, blur, nullptr)),
+    };
+
+    for (const sk_sp<SkImageFilter>& filter : filters) {
+        REPORTER_ASSERT(reporter, as_IFB(filter)->canFilterInTiles());
+
+        SkBitmap untiledResult, tiledResult;
+        REPORTER_ASSERT(reporter, filter_tiled_executor_dag(filter, source, nullptr,
+                                                            &untiledResult));
+        REPORTER_ASSERT(reporter, filter_tiled_executor_dag(filter, source, threadPool.get(),
+                                                            &tiledResult));
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(untiledResult, tiledResult));
+    }
+
+    // Filters that depend on where their input image's edges are must not be tiled.
+    REPORTER_ASSERT(reporter, !as_IFB(SkImageFilters::Blur(6, 9, SkTileMode::kClamp, nullptr))
+                                       ->canFilterInTiles());
+    REPORTER_ASSERT(reporter, !as_IFB(SkImageFilters::DistantLitDiffuse({1, 1, 1}, SK_ColorWHITE,
+                                                                        1, 1, blur))
+                                       ->canFilterInTiles());
+}
+
 static sk_sp<SkImageFilter> make_blur(sk_sp<SkImageFilter> input) {
     return SkImageFilters::Blur(SK_Scalar1, SK_Scalar1, std::move(input));
 }
@@ -1187,6 +1261,139 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterMatrixConvolutionBigKernel_Gpu,
     test_big_kernel(reporter, ctxInfo.directContext());
 }
 
+// Filters 'src' with clip bounds 'clip' and returns the result in a clip-sized bitmap, with the
+// pixels the filter didn't produce left transparent.
+static SkBitmap filter_to_bitmap(const sk_sp<SkImage>& src, const sk_sp<SkImageFilter>& filter,
+                                 const SkIRect& clip) {
+    SkBitmap bm;
+    bm.allocN32Pixels(clip.width(), clip.height());
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkIRect subset;
+    SkIPoint offset;
+    sk_sp<SkImage> result = src->makeWithFilter(nullptr, filter.get(), src->bounds(), clip,
+                                                &subset, &offset);
+    SkPixmap dst;
+    if (result && bm.pixmap().extractSubset(&dst, SkIRect::MakeXYWH(offset.fX - clip.fLeft,
+                                                                     offset.fY - clip.fTop,
+                                                                     subset.width(),
+                                                                     subset.height()))) {
+        result->readPixels(nullptr, dst, subset.fLeft, subset.fTop);
+    }
+    return bm;
+}
+
+// Returns the largest per-channel difference between 'a' and 'b' over 'area', where 'a' and 'b'
+// hold the pixels of 'aBounds' and 'bBounds' respectively.
+static int max_channel_diff(const SkBitmap& a, const SkIRect& aBounds,
+                            const SkBitmap& b, const SkIRect& bBounds, const SkIRect& area) {
+    int maxDiff = 0;
+    for (int y = area.fTop; y < area.fBottom; ++y) {
+        for (int x = area.fLeft; x < area.fRight; ++x) {
+            SkPMColor pa = *a.getAddr32(x - aBounds.fLeft, y - aBounds.fTop),
+                      pb = *b.getAddr32(x - bBounds.fLeft, y - bBounds.fTop);
+            for (int shift = 0; shift < 32; shift += 8) {
+                maxDiff = std::max(maxDiff, SkTAbs(int((pa >> shift) & 0xFF) -
+                                                   int((pb >> shift) & 0xFF)));
+            }
+        }
+    }
+    return maxDiff;
+}
+
+static sk_sp<SkImage> make_noise_image(int size) {
+    SkBitmap bm;
+    bm.allocN32Pixels(size, size);
+    SkRandom rand;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            *bm.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+        }
+    }
+    return SkImage::MakeFromBitmap(bm);
+}
+
+// The raster lighting and matrix convolution filters light or convolve the interior of the
+// image four pixels (or four channels) at a time. Check those interiors against the scalar
+// loops. The scalar path performs the same float operations, but where the compiler fuses its
+// multiply-adds the rounding can differ, so allow one step in a channel.
+DEF_TEST(ImageFilterInteriorMatchesScalar, reporter) {
+    const int kSize = 64;
+    const int kTolerance = 1;
+    sk_sp<SkImage> src = make_noise_image(kSize);
+    const SkIRect srcBounds = SkIRect::MakeWH(kSize, kSize);
+
+    // A crop rect larger than the source makes the lighting filters use the scalar decal loop
+    // for every pixel; without one they take the vector interior. They agree on every pixel
+    // whose 3x3 neighborhood lies inside the source.
+    {
+        const SkIRect bigBounds = srcBounds.makeOutset(4, 4);
+        using Factory = sk_sp<SkImageFilter> (*)(const SkIRect*);
+        Factory factories[] = {
+            [](const SkIRect* crop) {
+                return SkImageFilters::DistantLitDiffuse(SkPoint3::Make(1, -2, 3), SK_ColorCYAN,
+                                                         2.0f, 0.75f, nullptr, crop);
+            },
+            [](const SkIRect* crop) {
+                return SkImageFilters::PointLitDiffuse(SkPoint3::Make(21, 16, 40), SK_ColorWHITE,
+                                                       1.5f, 1.0f, nullptr, crop);
+            },
+            [](const SkIRect* crop) {
+                return SkImageFilters::SpotLitDiffuse(SkPoint3::Make(21, 16, 40),
+                                                      SkPoint3::Make(32, 32, 0), 2.0f, 30.0f,
+                                                      SK_ColorYELLOW, 1.0f, 1.2f, nullptr, crop);
+            },
+            [](const SkIRect* crop) {
+                return SkImageFilters::DistantLitSpecular(SkPoint3::Make(-1, 1, 2), SK_ColorWHITE,
+                                                          2.0f, 1.0f, 8.0f, nullptr, crop);
+            },
+            [](const SkIRect* crop) {
+                return SkImageFilters::PointLitSpecular(SkPoint3::Make(21, 16, 40), SK_ColorRED,
+                                                        1.5f, 0.8f, 16.0f, nullptr, crop);
+            },
+            [](const SkIRect* crop) {
+                return SkImageFilters::SpotLitSpecular(SkPoint3::Make(21, 16, 40),
+                                                       SkPoint3::Make(32, 32, 0), 1.0f, 45.0f,
+                                                       SK_ColorWHITE, 1.0f, 1.0f, 4.0f, nullptr,
+                                                       crop);
+            },
+        };
+        for (Factory factory : factories) {
+            SkBitmap vector = filter_to_bitmap(src, factory(nullptr), srcBounds);
+            SkBitmap scalar = filter_to_bitmap(src, factory(&bigBounds), bigBounds);
+            int diff = max_channel_diff(vector, srcBounds, scalar, bigBounds,
+                                        srcBounds.makeInset(1, 1));
+            REPORTER_ASSERT(reporter, diff <= kTolerance, "lighting diff %d", diff);
+        }
+    }
+
+    // Repeat tiling convolves the interior with the scalar loop, clamp with the vector one.
+    {
+        SkRandom rand;
+        const SkISize kernelSizes[] = {{3, 3}, {5, 4}};
+        for (SkISize kernelSize : kernelSizes) {
+            SkScalar kernel[20];
+            for (int i = 0; i < kernelSize.area(); ++i) {
+                kernel[i] = rand.nextRangeF(-1.0f, 1.0f);
+            }
+            SkIPoint kernelOffset = {kernelSize.width() / 2, 1};
+            SkIRect interior = SkIRect::MakeLTRB(kernelOffset.fX, kernelOffset.fY,
+                                                 kSize - kernelSize.width() + kernelOffset.fX + 1,
+                                                 kSize - kernelSize.height() + kernelOffset.fY + 1);
+            for (bool convolveAlpha : {false, true}) {
+                auto make = [&](SkTileMode tileMode) {
+                    return SkImageFilters::MatrixConvolution(kernelSize, kernel, 0.75f, 0.1f,
+                                                             kernelOffset, tileMode,
+                                                             convolveAlpha, nullptr);
+                };
+                SkBitmap vector = filter_to_bitmap(src, make(SkTileMode::kClamp), srcBounds);
+                SkBitmap scalar = filter_to_bitmap(src, make(SkTileMode::kRepeat), srcBounds);
+                int diff = max_channel_diff(vector, srcBounds, scalar, srcBounds, interior);
+                REPORTER_ASSERT(reporter, diff <= kTolerance, "convolution diff %d", diff);
+            }
+        }
+    }
+}
+
 DEF_TEST(ImageFilterCropRect, reporter) {
     test_cropRects(reporter, nullptr);
 }
@@ -70,3 +70,24 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheRemoveLeastRecentlyUsed, r) {
+    int instances = 0;
+    {
+        SkLRUCache<int, std::unique_ptr<Value>> test(10);
+        test.removeLeastRecentlyUsed();
+        for (int k = 0; k < 3; k++) {
+            test.insert(k, std::make_unique<Value>(k, &instances));
+        }
+        REPORTER_ASSERT(r, test.find(0));
+        test.removeLeastRecentlyUsed();
+        REPORTER_ASSERT(r, 2 == instances);
+        REPORTER_ASSERT(r, !test.find(1));
+        test.removeLeastRecentlyUsed();
+        REPORTER_ASSERT(r, !test.find(2));
+        REPORTER_ASSERT(r, test.find(0));
+        test.removeLeastRecentlyUsed();
+        REPORTER_ASSERT(r, 0 == test.count());
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
@@ -5,7 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPath.h"
 #include "src/core/SkCachedData.h"
+#include "src/core/SkDraw.h"
 #include "src/core/SkMaskCache.h"
 #include "src/core/SkResourceCache.h"
 #include "tests/Test.h"
@@ -102,3 +106,173 @@ DEF_TEST(RectsMaskCache, reporter) {
     check_data(reporter, data, 1, kNotInCache, kLocked);
     data->unref();
 }
+
+DEF_TEST(DRRectMaskCache, reporter) {
+    SkResourceCache cache(1024);
+
+    SkScalar sigma = 0.8f;
+    SkRRect outer = SkRRect::MakeRectXY(SkRect::MakeWH(100, 100), 30, 30);
+    SkRRect inner = SkRRect::MakeRectXY(SkRect::MakeLTRB(10, 10, 90, 90), 20, 20);
+    SkBlurStyle style = kNormal_SkBlurStyle;
+    SkMask mask;
+
+    SkMaskCache::Stats before = SkMaskCache::GetStats(SkMaskCache::kDRRect_Kind);
+    SkCachedData* data = SkMaskCache::FindAndRef(sigma, style, outer, inner, &mask, &cache);
+    REPORTER_ASSERT(reporter, nullptr == data);
+
+    size_t size = 256;
+    data = cache.newCachedData(size);
+    memset(data->writable_data(), 0xff, size);
+    mask.fBounds.setXYWH(0, 0, 100, 100);
+    mask.fRowBytes = 100;
+    mask.fFormat = SkMask::kBW_Format;
+    SkMaskCache::Add(sigma, style, outer, inner, mask, data, &cache);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    data->unref();
+    check_data(reporter, data, 1, kInCache, kUnlocked);
+
+    // The same outer rrect with a different inner one is a different mask.
+    SkRRect otherInner = SkRRect::MakeRectXY(SkRect::MakeLTRB(20, 20, 80, 80), 20, 20);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(sigma, style, outer, otherInner, &mask,
+                                                       &cache));
+
+    sk_bzero(&mask, sizeof(mask));
+    data = SkMaskCache::FindAndRef(sigma, style, outer, inner, &mask, &cache);
+    REPORTER_ASSERT(reporter, data);
+    REPORTER_ASSERT(reporter, data->size() == size);
+    REPORTER_ASSERT(reporter, mask.fBounds.top() == 0 && mask.fBounds.bottom() == 100);
+    REPORTER_ASSERT(reporter, data->data() == (const void*)mask.fImage);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    SkMaskCache::Stats after = SkMaskCache::GetStats(SkMaskCache::kDRRect_Kind);
+    REPORTER_ASSERT(reporter, after.fHits - before.fHits == 1);
+    REPORTER_ASSERT(reporter, after.fMisses - before.fMisses == 2);
+
+    cache.purgeAll();
+    check_data(reporter, data, 1, kNotInCache, kLocked);
+    data->unref();
+}
+
+DEF_TEST(PathMaskCache, reporter) {
+    SkResourceCache cache(1024);
+
+    SkPath path;
+    path.addCircle(10, 10, 8);
+    SkStrokeRec fill(SkStrokeRec::kFill_InitStyle);
+    SkMatrix matrix = SkMatrix::Translate(100.25f, 50);
+    SkMask mask;
+
+    SkMaskCache::Stats before = SkMaskCache::GetStats(SkMaskCache::kPath_Kind);
+    SkCachedData* data = SkMaskCache::FindAndRef(path, matrix, fill, true, &mask, &cache);
+    REPORTER_ASSERT(reporter, nullptr == data);
+
+    size_t size = 22 * 22;
+    data = cache.newCachedData(size);
+    memset(data->writable_data(), 0xff, size);
+    mask.fBounds.setXYWH(101, 51, 22, 22);
+    mask.fRowBytes = 22;
+    mask.fFormat = SkMask::kA8_Format;
+    SkMaskCache::Add(path, matrix, fill, true, mask, data, &cache);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    data->unref();
+    check_data(reporter, data, 1, kInCache, kUnlocked);
+
+    // A different subpixel translation, stroke, or anti-aliasing is a different mask.
+    SkStrokeRec stroke(SkStrokeRec::kFill_InitStyle);
+    stroke.setStrokeStyle(2);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, SkMatrix::Translate(100.5f, 50),
+                                                       fill, true, &mask, &cache));
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, matrix, stroke, true, &mask, &cache));
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, matrix, fill, false, &mask, &cache));
+
+    // A whole pixel translation finds the same mask, moved to match.
+    sk_bzero(&mask, sizeof(mask));
+    data = SkMaskCache::FindAndRef(path, SkMatrix::Translate(-3.75f, 7), fill, true, &mask,
+                                   &cache);
+    REPORTER_ASSERT(reporter, data);
+    REPORTER_ASSERT(reporter, data->size() == size);
+    REPORTER_ASSERT(reporter, mask.fBounds == SkIRect::MakeXYWH(-3, 8, 22, 22));
+    REPORTER_ASSERT(reporter, data->data() == (const void*)mask.fImage);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    SkMaskCache::Stats after = SkMaskCache::GetStats(SkMaskCache::kPath_Kind);
+    REPORTER_ASSERT(reporter, after.fHits - before.fHits == 1);
+    REPORTER_ASSERT(reporter, after.fMisses - before.fMisses == 4);
+
+    // Editing the path purges its masks.
+    path.lineTo(0, 0);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, matrix, fill, true, &mask, &cache));
+    check_data(reporter, data, 1, kNotInCache, kLocked);
+    data->unref();
+}
+
+static SkBitmap draw_path_at(const SkPath& path, const SkPaint& paint, SkScalar x, SkScalar y) {
+    SkBitmap bm;
+    bm.allocN32Pixels(64, 64);
+    bm.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bm);
+    canvas.translate(x, y);
+    canvas.drawPath(path, paint);
+    return bm;
+}
+
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    return 0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+}
+
+DEF_TEST(PathMaskCache_Draw, reporter) {
+    SkPath path;
+    path.moveTo(2, 20);
+    path.cubicTo(0, 4, 14, -2, 22, 8);
+    path.quadTo(30, 18, 20, 26);
+    path.close();
+    path.addCircle(14, 14, 4);
+
+    SkPaint fill;
+    fill.setAntiAlias(true);
+    SkPaint stroke(fill);
+    stroke.setStyle(SkPaint::kStroke_Style);
+    stroke.setStrokeWidth(1.5f);
+
+    // Quarter pixel translations, and ones the cache rounds to the nearest quarter pixel.
+    const SkScalar kFractions[] = {0, 0.25f, 0.5f, 0.75f, 0.1f, 0.3f, 0.6f, 0.9f};
+    for (const SkPaint& paint : {fill, stroke}) {
+        for (SkScalar fx : kFractions) {
+            const SkScalar fy = 0.75f - fx * 0.5f,
+                           x  = 10 + fx,
+                           y  = 17 + fy,
+                           rx = 10 + SkScalarRoundToScalar(fx * 4) / 4,
+                           ry = 17 + SkScalarRoundToScalar(fy * 4) / 4;
+            SkBitmap direct, rounded;
+            {
+                SkAutoPathMaskCacheOverride noCache(false);
+                direct  = draw_path_at(path, paint, x, y);
+                rounded = draw_path_at(path, paint, rx, ry);
+            }
+
+            SkAutoPathMaskCacheOverride useCache(true);
+            // The first draw draws a mask, the second caches it, and the third finds it.
+            // All of them, and a draw at a whole pixel offset, draw the same pixels.
+            const SkBitmap first = draw_path_at(path, paint, x, y);
+            for (int i = 0; i < 2; i++) {
+                REPORTER_ASSERT(reporter, same_pixels(first, draw_path_at(path, paint, x, y)));
+            }
+            SkBitmap moved = draw_path_at(path, paint, x - 7, y - 9);
+            bool movedMatches = true;
+            for (int j = 9; j < 64; j++) {
+                for (int i = 7; i < 64; i++) {
+                    movedMatches &= first.getColor(i, j) == moved.getColor(i - 7, j - 9);
+                }
+            }
+            REPORTER_ASSERT(reporter, movedMatches);
+
+            // Drawing through the mask looks like drawing the path at the rounded translation.
+            REPORTER_ASSERT(reporter, same_pixels(first, rounded), "%g %g", x, y);
+            if (rx == x && ry == y) {
+                REPORTER_ASSERT(reporter, same_pixels(first, direct), "%g %g", x, y);
+            }
+        }
+    }
+}
@@ -162,3 +162,55 @@ DEF_TEST(Serialize_and_deserialize_multi_skp, reporter) {
         i++;
     }
 }
+
+// Pages read lazily are only read when they're drawn.
+DEF_TEST(Serialize_and_deserialize_multi_skp_lazily, reporter) {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> multipic = SkMakeMultiPictureDocument(&stream);
+
+    static const int NUM_FRAMES = 6;
+    static const int WIDTH = 256;
+    static const int HEIGHT = 256;
+
+    auto surface(SkSurface::MakeRasterN32Premul(100, 100));
+    surface->getCanvas()->clear(SK_ColorGREEN);
+    sk_sp<SkImage> image(surface->makeImageSnapshot());
+
+    for (int i=0; i<NUM_FRAMES; i++) {
+        draw_basic(multipic->beginPage(WIDTH, HEIGHT), i, image);
+        multipic->endPage();
+    }
+    multipic->close();
+    sk_sp<SkData> data = stream.detachAsData();
+
+    // Count the images read, and let them be decoded as usual.
+    int imageReads = 0;
+    SkDeserialProcs dprocs;
+    dprocs.fImageProc = [](const void*, size_t, void* ctx) -> sk_sp<SkImage> {
+        ++*static_cast<int*>(ctx);
+        return nullptr;
+    };
+    dprocs.fImageCtx = &imageReads;
+
+    std::vector<SkDocumentPage> frames(NUM_FRAMES), lazyFrames(NUM_FRAMES);
+    SkMemoryStream memoryStream(data);
+    REPORTER_ASSERT(reporter,
+        SkMultiPictureDocumentRead(&memoryStream, frames.data(), NUM_FRAMES));
+    REPORTER_ASSERT(reporter,
+        SkMultiPictureDocumentReadLazily(data, lazyFrames.data(), NUM_FRAMES, &dprocs));
+    REPORTER_ASSERT(reporter, imageReads == 0, "%d images read", imageReads);
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(WIDTH, HEIGHT);
+    for (int i : {3, 0, 3}) {
+        REPORTER_ASSERT(reporter, lazyFrames[i].fSize == frames[i].fSize);
+
+        auto surf = SkSurface::MakeRaster(info),
+             lazySurf = SkSurface::MakeRaster(info);
+        surf->getCanvas()->drawPicture(frames[i].fPicture);
+        lazySurf->getCanvas()->drawPicture(lazyFrames[i].fPicture);
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(surf->makeImageSnapshot().get(),
+                                                          lazySurf->makeImageSnapshot().get()));
+    }
+    // Each page has one image, and pages 3 and 0 have been drawn.
+    REPORTER_ASSERT(reporter, imageReads == 2, "%d images read", imageReads);
+}
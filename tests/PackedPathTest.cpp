@@ -0,0 +1,104 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPackedPath.h"
+#include "src/core/SkPathPriv.h"
+#include "tests/Test.h"
+
+static SkPath make_test_path() {
+    SkPath path;
+    path.moveTo(10, 20);
+    path.lineTo(30.5f, 22);
+    path.quadTo(40, 60, 12, 70);
+    path.conicTo(0, 90, -20, 50, 0.707f);
+    path.close();
+    path.moveTo(100, 100);
+    path.cubicTo(150, 80, 180, 160, 120, 190);
+    path.lineTo(101, 150);
+    path.setFillType(SkPathFillType::kEvenOdd);
+    return path;
+}
+
+static void check_view(skiatest::Reporter* reporter, const SkPackedPath& packed,
+                       const SkPath& expected) {
+    SkTDArray<SkPoint> storage;
+    SkPathView view = packed.view(&storage);
+    SkPathView expectedView = expected.view();
+    REPORTER_ASSERT(reporter, view.fPoints.size() == expectedView.fPoints.size());
+    REPORTER_ASSERT(reporter, 0 == memcmp(view.fPoints.begin(), expectedView.fPoints.begin(),
+                                          view.fPoints.size() * sizeof(SkPoint)));
+    REPORTER_ASSERT(reporter, view.fVerbs.size() == expectedView.fVerbs.size());
+    REPORTER_ASSERT(reporter, 0 == memcmp(view.fVerbs.begin(), expectedView.fVerbs.begin(),
+                                          view.fVerbs.size()));
+    REPORTER_ASSERT(reporter, view.fWeights.size() == expectedView.fWeights.size());
+    REPORTER_ASSERT(reporter, view.fBounds == expectedView.fBounds);
+    REPORTER_ASSERT(reporter, view.fFillType == expectedView.fFillType);
+    REPORTER_ASSERT(reporter, view.fConvexity == expectedView.fConvexity);
+    REPORTER_ASSERT(reporter, view.fSegmentMask == expectedView.fSegmentMask);
+
+    int verbs = 0;
+    for (auto [verb, pts, w] : SkPathPriv::Iterate(view)) {
+        (void)verb; (void)pts; (void)w;
+        ++verbs;
+    }
+    REPORTER_ASSERT(reporter, verbs == expected.countVerbs());
+}
+
+DEF_TEST(PackedPath_Float, reporter) {
+    for (const SkPath& path : {make_test_path(), SkPath(), SkPath::Rect({1, 2, 3, 4}),
+                               SkPath::Circle(50, 50, 20)}) {
+        sk_sp<SkPackedPath> packed = SkPackedPath::Make(path);
+        REPORTER_ASSERT(reporter, packed->precision() == SkPackedPath::Precision::kFloat);
+        REPORTER_ASSERT(reporter, packed->toPath() == path);
+        REPORTER_ASSERT(reporter, packed->getBounds() == path.getBounds());
+        REPORTER_ASSERT(reporter, packed->toPath().isConvex() == path.isConvex());
+        check_view(reporter, *packed, path);
+    }
+}
+
+DEF_TEST(PackedPath_Quantized, reporter) {
+    const SkPath path = make_test_path();
+    sk_sp<SkPackedPath> packed = SkPackedPath::Make(path, SkPackedPath::Precision::kQuantized16),
+                        floats = SkPackedPath::Make(path);
+    REPORTER_ASSERT(reporter, packed->precision() == SkPackedPath::Precision::kQuantized16);
+    REPORTER_ASSERT(reporter, packed->approximateBytesUsed() < floats->approximateBytesUsed());
+
+    // Each point moves by at most half a step, plus float rounding.
+    SkPath decoded = packed->toPath();
+    REPORTER_ASSERT(reporter, decoded.countPoints() == path.countPoints());
+    const SkRect& bounds = path.getBounds();
+    const SkScalar tolX = bounds.width() / 65535 * 0.51f + 1e-4f,
+                   tolY = bounds.height() / 65535 * 0.51f + 1e-4f;
+    for (int i = 0; i < path.countPoints(); ++i) {
+        SkPoint a = path.getPoint(i),
+                b = decoded.getPoint(i);
+        REPORTER_ASSERT(reporter, SkScalarAbs(a.fX - b.fX) <= tolX, "x %g vs %g", a.fX, b.fX);
+        REPORTER_ASSERT(reporter, SkScalarAbs(a.fY - b.fY) <= tolY, "y %g vs %g", a.fY, b.fY);
+    }
+    REPORTER_ASSERT(reporter, decoded.getFillType() == path.getFillType());
+    REPORTER_ASSERT(reporter, decoded.countVerbs() == path.countVerbs());
+    REPORTER_ASSERT(reporter, decoded.getSegmentMasks() == path.getSegmentMasks());
+    check_view(reporter, *packed, decoded);
+
+    // Degenerate bounds quantize to the single coordinate.
+    SkPath line;
+    line.moveTo(5, 7);
+    line.lineTo(5, 9);
+    decoded = SkPackedPath::Make(line, SkPackedPath::Precision::kQuantized16)->toPath();
+    REPORTER_ASSERT(reporter, decoded == line);
+}
+
+DEF_TEST(PackedPath_NonFinite, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(SK_ScalarInfinity, 1);
+    sk_sp<SkPackedPath> packed = SkPackedPath::Make(path, SkPackedPath::Precision::kQuantized16);
+    REPORTER_ASSERT(reporter, packed->precision() == SkPackedPath::Precision::kFloat);
+    REPORTER_ASSERT(reporter, packed->getBounds().isEmpty());
+    SkTDArray<SkPoint> storage;
+    REPORTER_ASSERT(reporter, !packed->view(&storage).isFinite());
+}
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/PathOpsTestCommon.h"
 #include "tests/Test.h"
@@ -79,6 +80,51 @@ DEF_TEST(PathOpsBuilder, reporter) {
     REPORTER_ASSERT(reporter, pixelDiff == 0);
 }
 
+// Unions clusters of overlapping stars and rects, some of which touch, and clusters that don't
+// touch at all. The builder resolves each cluster separately, optionally on several threads.
+DEF_TEST(PathOpsBuilderManyUnions, reporter) {
+    SkTArray<SkPath> paths;
+    for (int cluster = 0; cluster < 6; ++cluster) {
+        SkScalar left = (cluster % 3) * 40.f, top = (cluster / 3) * 40.f;
+        for (int index = 0; index < 5; ++index) {
+            SkPath& path = paths.push_back();
+            if (index & 1) {
+                path.addRect(left + index * 4, top + index * 2, left + index * 4 + 10, top + 20,
+                             cluster & 1 ? SkPathDirection::kCW : SkPathDirection::kCCW);
+                continue;
+            }
+            for (int point = 0; point < 5; ++point) {
+                SkScalar angle = point * 4 * SK_ScalarPI / 5;
+                SkPoint pt = {left + 10 + index * 3 + 8 * SkScalarCos(angle),
+                              top + 15 + 8 * SkScalarSin(angle)};
+                point ? path.lineTo(pt) : path.moveTo(pt);
+            }
+            path.close();
+        }
+    }
+    // Two more rects that touch along an edge, away from everything else.
+    paths.push_back().addRect(0, 90, 10, 100);
+    paths.push_back().addRect(10, 90, 20, 100);
+
+    SkPath opCompare;
+    for (const SkPath& path : paths) {
+        REPORTER_ASSERT(reporter, Op(opCompare, path, kUnion_SkPathOp, &opCompare));
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkExecutor* exec : {(SkExecutor*) nullptr, executor.get()}) {
+        SkOpBuilder builder;
+        builder.setExecutor(exec);
+        for (const SkPath& path : paths) {
+            builder.add(path, kUnion_SkPathOp);
+        }
+        SkPath result;
+        REPORTER_ASSERT(reporter, builder.resolve(&result));
+        int pixelDiff = comparePaths(reporter, __FUNCTION__, opCompare, result);
+        REPORTER_ASSERT(reporter, pixelDiff == 0);
+    }
+}
+
 DEF_TEST(BuilderIssue3838, reporter) {
     SkPath path;
     path.moveTo(200, 170);
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/pathops/SkPathOpsCommon.h"
+#include "tests/PathOpsExtendedTest.h"
+#include "tests/Test.h"
+
+static SkPath make_polygon(int count, int step, SkScalar cx, SkScalar cy, SkScalar radius) {
+    SkPath path;
+    for (int index = 0; index < count; ++index) {
+        SkScalar angle = index * step * 2 * SK_ScalarPI / count;
+        SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+        index ? path.lineTo(pt) : path.moveTo(pt);
+    }
+    path.close();
+    return path;
+}
+
+static bool op_general(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    SkAutoPathOpsPolygonOpOverride usePolygonOp(false);
+    return Op(one, two, op, result);
+}
+
+// Calls OpPolygons() the way Op() does, but without falling back to the general code.
+static bool op_polygons(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    SkPathFillType fillType;
+    op = MapInverseOp(one, two, op, &fillType);
+    if (kReverseDifference_SkPathOp == op) {
+        return OpPolygons(two, one, kDifference_SkPathOp, fillType, result);
+    }
+    return OpPolygons(one, two, op, fillType, result);
+}
+
+// Polygons that cross, touch at vertices, share edges, and overlap along collinear edges, with
+// every fill type and op, should match the results of the general code.
+DEF_TEST(PathOpsPolygonOp, reporter) {
+    SkPath paths[6];
+    paths[0] = make_polygon(64, 1, 50, 50, 40);
+    paths[1] = make_polygon(31, 15, 60, 45, 45);
+    paths[2].addRect(10, 10, 50, 90);
+    paths[2].addRect(50, 30, 90, 70, SkPathDirection::kCCW);
+    paths[3].addRect(30, 10, 70, 50);
+    paths[3].addRect(30, 50, 70, 90);
+    // A bowtie whose lobes meet at the corner of the rects above.
+    paths[4].moveTo(10, 10);
+    paths[4].lineTo(90, 90);
+    paths[4].lineTo(90, 10);
+    paths[4].lineTo(10, 90);
+    paths[4].close();
+    // Triangles with a vertex on the other's edge, and an edge along the rects' edges.
+    paths[5].moveTo(30, 50);
+    paths[5].lineTo(70, 20);
+    paths[5].lineTo(70, 80);
+    paths[5].close();
+    paths[5].moveTo(50, 10);
+    paths[5].lineTo(50, 90);
+    paths[5].lineTo(20, 50);
+    paths[5].close();
+
+    const SkPathFillType fillTypes[] = { SkPathFillType::kWinding, SkPathFillType::kEvenOdd,
+                                         SkPathFillType::kInverseWinding };
+    for (int a = 0; a < (int) SK_ARRAY_COUNT(paths); ++a) {
+        for (int b = 0; b < (int) SK_ARRAY_COUNT(paths); ++b) {
+            for (SkPathFillType fillA : fillTypes) {
+                for (SkPathFillType fillB : fillTypes) {
+                    SkPath one = paths[a], two = paths[b];
+                    one.setFillType(fillA);
+                    two.setFillType(fillB);
+                    for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+                        SkPath expected, actual;
+                        if (!op_general(one, two, (SkPathOp) op, &expected)) {
+                            continue;
+                        }
+                        if (!op_polygons(one, two, (SkPathOp) op, &actual)) {
+                            ERRORF(reporter, "OpPolygons failed: paths %d %d op %d", a, b, op);
+                            continue;
+                        }
+                        REPORTER_ASSERT(reporter, expected.isInverseFillType()
+                                                  == actual.isInverseFillType());
+                        int pixelDiff = comparePaths(reporter, __FUNCTION__, expected, actual);
+                        REPORTER_ASSERT(reporter, pixelDiff == 0, "paths %d %d op %d", a, b, op);
+                    }
+                }
+            }
+        }
+    }
+
+    // The far corner makes the snapping distance 2^-32 * 1e6, so the tip of the second triangle
+    // snaps to the vertex at the origin, across the edge passing 1e-4 above it. The edges no longer
+    // meet only at their ends, so this is left to the general code.
+    SkPath snapped, tip;
+    snapped.moveTo(-20, 0.4001f);
+    snapped.lineTo(20, -0.3999f);
+    snapped.lineTo(-20, -3);
+    snapped.close();
+    snapped.moveTo(0, 0);
+    snapped.lineTo(1, -2);
+    snapped.lineTo(-1, -2);
+    snapped.close();
+    snapped.moveTo(1e6f, 1e6f);
+    snapped.lineTo(1e6f + 64, 1e6f);
+    snapped.lineTo(1e6f, 1e6f + 64);
+    snapped.close();
+    tip.moveTo(0, 2e-4f);
+    tip.lineTo(5, 1.3f);
+    tip.lineTo(-5, 1.4f);
+    tip.close();
+    for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+        SkPath actual;
+        REPORTER_ASSERT(reporter, !op_polygons(snapped, tip, (SkPathOp) op, &actual), "op %d", op);
+    }
+
+    // Curves are left to the general code.
+    SkPath circle, result;
+    circle.addCircle(50, 50, 30);
+    REPORTER_ASSERT(reporter, !OpPolygons(circle, paths[0], kUnion_SkPathOp,
+                                          SkPathFillType::kEvenOdd, &result));
+}
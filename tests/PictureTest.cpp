@@ -12,6 +12,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -21,6 +22,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
@@ -30,7 +32,9 @@
 #include "src/core/SkClipOpPriv.h"
 #include "src/core/SkMiniRecorder.h"
 #include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecordDraw.h"
 #include "src/core/SkRectPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 
 #include <memory>
@@ -967,6 +971,71 @@ DEF_TEST(Picture_fillsBBH, r) {
     }
 }
 
+DEF_TEST(Picture_lazyBBH, r) {
+    // A grid of cells, recorded without a BBH.
+    auto make_pic = [](int n) {
+        SkPictureRecorder rec;
+        SkCanvas* c = rec.beginRecording({0,0, 10.0f*n, 10.0f*n});
+        SkRandom rand;
+        for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+                SkPaint paint;
+                paint.setColor(rand.nextU() | 0xFF000000);
+                c->drawRect(SkRect::MakeXYWH(10.0f*x + 1, 10.0f*y + 1, 8, 8), paint);
+            }
+        }
+        return rec.finishRecordingAsPicture();
+    };
+
+    // Small pictures aren't worth indexing.
+    sk_sp<SkPicture> small = make_pic(4);
+    REPORTER_ASSERT(r, !SkPicturePriv::AsSkBigPicture(small)->playbackBBH());
+
+    sk_sp<SkPicture> pic = make_pic(32);
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(pic);
+    REPORTER_ASSERT(r, big && !big->bbh());
+
+    // Culled playback draws exactly what drawing every op does.
+    const SkMatrix matrices[] = {
+        SkMatrix::I(),
+        SkMatrix::Translate(-97.5f, -123),
+        SkMatrix::Scale(0.75f, 1.5f) * SkMatrix::RotateDeg(15),
+    };
+    for (const SkMatrix& m : matrices) {
+        SkBitmap culled, full;
+        culled.allocN32Pixels(64, 64);
+        full.allocN32Pixels(64, 64);
+        culled.eraseColor(SK_ColorWHITE);
+        full.eraseColor(SK_ColorWHITE);
+        SkCanvas culledCanvas(culled), fullCanvas(full);
+        culledCanvas.concat(m);
+        fullCanvas.concat(m);
+        pic->playback(&culledCanvas);
+        SkRecordDraw(*big->record(), &fullCanvas, nullptr, nullptr, 0, nullptr, nullptr);
+        for (int y = 0; y < 64; y++) {
+            REPORTER_ASSERT(r, 0 == memcmp(culled.getAddr32(0, y), full.getAddr32(0, y),
+                                           64 * sizeof(SkPMColor)));
+        }
+    }
+
+    // The index is only built once, and culls most of the picture out of a small query.
+    const SkBBoxHierarchy* bbh = big->playbackBBH();
+    REPORTER_ASSERT(r, bbh);
+    std::vector<int> ops;
+    bbh->search({0,0, 64,64}, &ops);
+    REPORTER_ASSERT(r, ops.size() > 0 && (int)ops.size() < big->approximateOpCount(false) / 10);
+
+    // Concurrent first playbacks all get the same index.
+    sk_sp<SkPicture> shared = make_pic(32);
+    const SkBigPicture* sharedBig = SkPicturePriv::AsSkBigPicture(shared);
+    const SkBBoxHierarchy* seen[8];
+    SkTaskGroup().batch(8, [&](int i) { seen[i] = sharedBig->playbackBBH(); });
+    for (const SkBBoxHierarchy* b : seen) {
+        REPORTER_ASSERT(r, b && b == seen[0]);
+    }
+    REPORTER_ASSERT(r, bbh == big->playbackBBH());
+}
+
 DEF_TEST(Picture_nested_op_count, r) {
     auto make_pic = [](int n, sk_sp<SkPicture> pic) {
         SkPictureRecorder rec;
@@ -999,3 +1068,153 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+// Images are serialized as raw N32 pixels, so reading them needs no codecs, and each read counts.
+static sk_sp<SkData> serialize_raw_image(SkImage* image, void*) {
+    SkBitmap bm;
+    bm.allocN32Pixels(image->width(), image->height());
+    if (!image->readPixels(bm.pixmap(), 0, 0)) {
+        return nullptr;
+    }
+    const int32_t size[] = { image->width(), image->height() };
+    auto data = SkData::MakeUninitialized(sizeof(size) + bm.computeByteSize());
+    memcpy(data->writable_data(), size, sizeof(size));
+    memcpy((char*)data->writable_data() + sizeof(size), bm.getPixels(), bm.computeByteSize());
+    return data;
+}
+
+static sk_sp<SkImage> deserialize_raw_image(const void* data, size_t length, void* ctx) {
+    ++*static_cast<int*>(ctx);
+    int32_t size[2];
+    if (length < sizeof(size)) {
+        return nullptr;
+    }
+    memcpy(size, data, sizeof(size));
+    SkImageInfo info = SkImageInfo::MakeN32Premul(size[0], size[1]);
+    if (size[0] <= 0 || size[1] <= 0 || length != sizeof(size) + info.computeMinByteSize()) {
+        return nullptr;
+    }
+    return SkImage::MakeRasterData(info, SkData::MakeWithCopy((const char*)data + sizeof(size),
+                                                              length - sizeof(size)),
+                                   info.minRowBytes());
+}
+
+static sk_sp<SkImage> make_color_image(SkColor color) {
+    SkBitmap bm;
+    make_bm(&bm, 8, 8, color, true);
+    return SkImage::MakeFromBitmap(bm);
+}
+
+static SkBitmap draw_picture(const SkPicture* picture) {
+    SkBitmap bm;
+    bm.allocN32Pixels(100, 100);
+    bm.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bm);
+    canvas.drawPicture(picture);
+    return bm;
+}
+
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    return a.computeByteSize() == b.computeByteSize() &&
+           0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+}
+
+DEF_TEST(Picture_lazy, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(100, 100);
+    canvas->drawImage(make_color_image(SK_ColorBLUE), 60, 60);
+    canvas->drawImage(make_color_image(SK_ColorRED), 80, 60);
+    sk_sp<SkPicture> sub = recorder.finishRecordingAsPicture();
+
+    canvas = recorder.beginRecording(100, 100);
+    SkPaint paint;
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawPath(SkPath::Circle(20, 20, 15), paint);
+    canvas->drawPath(SkPath::Rect({40, 5, 90, 30}), paint);
+    canvas->drawImage(make_color_image(SK_ColorYELLOW), 10, 60);
+    canvas->drawPicture(sub);
+    const SkMatrix below = SkMatrix::Translate(0, 20);
+    canvas->drawPicture(sub, &below, nullptr);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkSerialProcs procs;
+    procs.fImageProc = serialize_raw_image;
+    sk_sp<SkData> data = picture->serialize(&procs);
+
+    int imageReads = 0;
+    SkDeserialProcs dprocs;
+    dprocs.fImageProc = deserialize_raw_image;
+    dprocs.fImageCtx = &imageReads;
+    sk_sp<SkPicture> eager = SkPicture::MakeFromData(data.get(), &dprocs);
+    REPORTER_ASSERT(r, eager && imageReads == 3);
+
+    // Nothing is read until it's drawn, and then only once.
+    imageReads = 0;
+    sk_sp<SkPicture> lazy = SkPicture::MakeLazyFromData(data, &dprocs);
+    REPORTER_ASSERT(r, lazy);
+    REPORTER_ASSERT(r, !SkPicturePriv::AsSkBigPicture(lazy));
+    REPORTER_ASSERT(r, lazy->cullRect() == picture->cullRect());
+    REPORTER_ASSERT(r, imageReads == 0);
+
+    const SkBitmap expected = draw_picture(eager.get());
+    REPORTER_ASSERT(r, same_pixels(draw_picture(lazy.get()), expected));
+    REPORTER_ASSERT(r, imageReads == 3);
+    REPORTER_ASSERT(r, same_pixels(draw_picture(lazy.get()), expected));
+    REPORTER_ASSERT(r, imageReads == 3);
+
+    // A lazy picture serializes like the picture it was read from.
+    imageReads = 0;
+    sk_sp<SkPicture> reread = SkPicture::MakeFromData(lazy->serialize(&procs).get(), &dprocs);
+    REPORTER_ASSERT(r, reread && imageReads == 3);
+    REPORTER_ASSERT(r, same_pixels(draw_picture(reread.get()), expected));
+}
+
+DEF_TEST(Picture_lazy_truncated, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(100, 100);
+    canvas->drawPath(SkPath::Circle(20, 20, 15), SkPaint());
+    canvas->drawImage(make_color_image(SK_ColorYELLOW), 10, 60);
+    sk_sp<SkPicture> sub = recorder.finishRecordingAsPicture();
+    canvas = recorder.beginRecording(100, 100);
+    canvas->drawPicture(sub);
+    canvas->drawPath(SkPath::Rect({40, 5, 90, 30}), SkPaint());
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkSerialProcs procs;
+    procs.fImageProc = serialize_raw_image;
+    sk_sp<SkData> data = picture->serialize(&procs);
+
+    int imageReads = 0;
+    SkDeserialProcs dprocs;
+    dprocs.fImageProc = deserialize_raw_image;
+    dprocs.fImageCtx = &imageReads;
+
+    // Whatever part of the data is lost, reading it lazily and drawing it must be safe.
+    for (size_t size = 0; size < data->size(); size += 3) {
+        sk_sp<SkPicture> lazy = SkPicture::MakeLazyFromData(SkData::MakeSubset(data.get(), 0, size),
+                                                            &dprocs);
+        if (lazy) {
+            draw_picture(lazy.get());
+        }
+    }
+
+    // Neither must it be to read with any offset table, which it only checks against the data.
+    const uint32_t tag = SkSetFourByteTag('o', 'f', 's', 't');
+    SkRandom random;
+    for (size_t i = 0; i + sizeof(tag) <= data->size(); ++i) {
+        if (0 != memcmp(data->bytes() + i, &tag, sizeof(tag))) {
+            continue;
+        }
+        uint32_t size;
+        memcpy(&size, data->bytes() + i + sizeof(tag), sizeof(size));
+        for (int attempt = 0; attempt < 200; ++attempt) {
+            sk_sp<SkData> corrupt = SkData::MakeWithCopy(data->data(), data->size());
+            uint8_t* table = static_cast<uint8_t*>(corrupt->writable_data()) + i + 8;
+            table[random.nextULessThan(size)] = random.nextBool() ? random.nextU() : 0;
+            if (sk_sp<SkPicture> lazy = SkPicture::MakeLazyFromData(corrupt, &dprocs)) {
+                draw_picture(lazy.get());
+            }
+        }
+    }
+    REPORTER_ASSERT(r, SkPicture::MakeLazyFromData(data, &dprocs));
+}
@@ -6,6 +6,7 @@
  */
 
 #include "include/utils/SkRandom.h"
+#include "src/core/SkFlatRTree.h"
 #include "src/core/SkRTree.h"
 #include "tests/Test.h"
 
@@ -25,10 +26,11 @@ static SkRect random_rect(SkRandom& rand) {
     return rect;
 }
 
-static bool verify_query(SkRect query, SkRect rects[], const std::vector<int>& found) {
+static bool verify_query(SkRect query, SkRect rects[], const std::vector<int>& found,
+                         int numRects = NUM_RECTS) {
     std::vector<int> expected;
     // manually intersect with every rectangle
-    for (int i = 0; i < NUM_RECTS; ++i) {
+    for (int i = 0; i < numRects; ++i) {
         if (SkRect::Intersects(query, rects[i])) {
             expected.push_back(i);
         }
@@ -89,3 +91,48 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+DEF_TEST(FlatRTree, reporter) {
+    SkRandom rand;
+    for (int count : {1, 7, 8, 9, 64, 65, NUM_RECTS, 5000}) {
+        SkAutoTMalloc<SkRect> rects(count);
+        for (int j = 0; j < count; j++) {
+            // Some empty rects, which are never found.
+            rects[j] = rand.nextU() % 16 ? random_rect(rand) : SkRect::MakeXYWH(j, j, 0, 5);
+        }
+
+        SkFlatRTree tree;
+        REPORTER_ASSERT(reporter, 0 == tree.getCount());
+        tree.insert(rects.get(), count);
+
+        int nonEmpty = 0;
+        for (int j = 0; j < count; j++) {
+            nonEmpty += !rects[j].isEmpty();
+        }
+        int expectedDepth = nonEmpty ? 1 : 0;
+        for (int n = nonEmpty; n > SkFlatRTree::kChildren; n /= SkFlatRTree::kChildren) {
+            expectedDepth++;
+        }
+        REPORTER_ASSERT(reporter, nonEmpty == tree.getCount());
+        REPORTER_ASSERT(reporter, expectedDepth == tree.getDepth() ||
+                                  expectedDepth + 1 == tree.getDepth());
+
+        // More queries than one batched walk handles, including empty and non-finite ones.
+        SkRect queries[NUM_QUERIES];
+        for (size_t i = 0; i < NUM_QUERIES; ++i) {
+            queries[i] = random_rect(rand);
+        }
+        queries[3] = SkRect::MakeEmpty();
+        queries[4] = {SK_ScalarNaN, 0, 100, 100};
+        queries[5] = SkRect::MakeLTRB(-1e9f, -1e9f, 1e9f, 1e9f);
+
+        std::vector<int> batched[NUM_QUERIES];
+        tree.search(queries, NUM_QUERIES, batched);
+        for (size_t i = 0; i < NUM_QUERIES; ++i) {
+            std::vector<int> hits;
+            tree.search(queries[i], &hits);
+            REPORTER_ASSERT(reporter, verify_query(queries[i], rects, hits, count));
+            REPORTER_ASSERT(reporter, hits == batched[i]);
+        }
+    }
+}
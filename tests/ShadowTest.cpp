@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkVertices.h"
 #include "include/utils/SkShadowUtils.h"
 #include "src/core/SkDrawShadowInfo.h"
@@ -180,3 +182,56 @@ DEF_TEST(ShadowBounds, reporter) {
     path.cubicTo(100, 50, 20, 100, 0, 0);
     check_bounds(reporter, path);
 }
+
+// Copies the path's outline, without what it knows about being a round rect or an oval.
+static SkPath copy_outline(const SkPath& path) {
+    SkPath copy;
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:  copy.moveTo(pts[0]);                              break;
+            case SkPath::kLine_Verb:  copy.lineTo(pts[1]);                              break;
+            case SkPath::kQuad_Verb:  copy.quadTo(pts[1], pts[2]);                      break;
+            case SkPath::kConic_Verb: copy.conicTo(pts[1], pts[2], iter.conicWeight()); break;
+            case SkPath::kCubic_Verb: copy.cubicTo(pts[1], pts[2], pts[3]);             break;
+            case SkPath::kClose_Verb: copy.close();                                     break;
+            case SkPath::kDone_Verb:                                                    break;
+        }
+    }
+    return copy;
+}
+
+// Shadows of round rects and ovals should only depend on their outlines. Some of these (the low
+// occluder with large corners) can't be tessellated and are drawn with a blur instead.
+DEF_TEST(ShadowRRectMatchesPath, reporter) {
+    const SkRect r = SkRect::MakeXYWH(60, 60, 80, 60);
+    SkRRect rrects[3];
+    rrects[0].setRectXY(r, 10, 10);
+    rrects[1].setOval(r);
+    rrects[2].setRectXY(r, 30, 20);
+
+    auto draw = [](const SkPath& path, SkScalar z, uint32_t flags) {
+        SkBitmap bm;
+        bm.allocN32Pixels(200, 200);
+        bm.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bm);
+        SkShadowUtils::DrawShadow(&canvas, path, {0, 0, z}, {100, -50, 600}, 800,
+                                  SK_ColorBLACK, SK_ColorBLACK, flags);
+        return bm;
+    };
+    for (const SkRRect& rrect : rrects) {
+        const SkPath path = SkPath::RRect(rrect);
+        for (SkScalar z : {2.0f, 8.0f, 32.0f}) {
+            for (uint32_t flags : {SkShadowFlags::kNone_ShadowFlag,
+                                   SkShadowFlags::kTransparentOccluder_ShadowFlag}) {
+                SkBitmap expected = draw(copy_outline(path), z, flags),
+                         actual   = draw(path, z, flags);
+                REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                      expected.computeByteSize()),
+                                "z %g flags %u", z, flags);
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/utils/SkRandom.h"
 #include "src/core/SkEnumerate.h"
 #include "src/core/SkGlyphBuffer.h"
 #include "src/core/SkGlyphRunPainter.h"
@@ -193,3 +194,35 @@ DEF_TEST(SkDrawableGlyphBufferBasic, reporter) {
         }
     }
 }
+
+// startBitmapDevice() packs the sub-pixel positions a few glyphs at a time; they must come out
+// the same as packing each glyph on its own.
+DEF_TEST(SkDrawableGlyphBufferPacking, reporter) {
+    SkRandom rand;
+    constexpr int kCount = 37;
+    SkPoint positions[kCount];
+    SkGlyphID glyphIDs[kCount];
+    for (int i = 0; i < kCount; i++) {
+        positions[i] = {rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100)};
+        glyphIDs[i] = SkToU16(rand.nextULessThan(65536));
+    }
+    // A few exact quarter pixels, which sit on the rounding boundaries.
+    positions[3] = {0.125f, 0.375f};
+    positions[4] = {-2.625f, 7.875f};
+    auto source = SkMakeZip(glyphIDs, positions);
+
+    for (SkAxisAlignment axis : {kNone_SkAxisAlignment, kX_SkAxisAlignment, kY_SkAxisAlignment}) {
+        for (bool subpixel : {true, false}) {
+            SkGlyphPositionRoundingSpec rounding{subpixel, axis};
+            SkDrawableGlyphBuffer drawable;
+            drawable.ensureSize(kCount);
+            drawable.startBitmapDevice(source, {3, 4}, SkMatrix::Scale(1.5f, 1.5f), rounding);
+            for (auto [i, packedID, pos] : SkMakeEnumerate(drawable.input())) {
+                SkPackedGlyphID expected{glyphIDs[i], pos, rounding.ignorePositionFieldMask};
+                REPORTER_ASSERT(reporter, packedID.packedID() == expected,
+                                "%s vs %s", packedID.packedID().dump().c_str(),
+                                expected.dump().c_str());
+            }
+        }
+    }
+}
@@ -16,6 +16,7 @@
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkSurfacePriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTypeface_remote.h"
 #include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrRecordingContextPriv.h"
@@ -246,6 +247,62 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_StrikeSerialization, repor
     discardableManager->unlockAndDeleteAll();
 }
 
+// Several renderers, each with its own server and client, record at once on several threads, with
+// their servers sharing one strike set. Each client still gets every glyph it needs.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_SharedStrikesConcurrentClients, reporter,
+                                   ctxInfo) {
+    auto dContext = ctxInfo.directContext();
+    SkStrikeCache sharedStrikes;
+
+    auto serverTf = SkTypeface::MakeFromName("monospace", SkFontStyle());
+    int glyphCount = 10;
+    auto serverBlob = buildTextBlob(serverTf, glyphCount);
+    const SkSurfaceProps props(SkSurfaceProps::kLegacyFontHost_InitType);
+    SkPaint paint;
+
+    // Each renderer's strike data stands in for the shared memory between its server and client.
+    struct Renderer {
+        sk_sp<DiscardableManager> discardableManager;
+        std::unique_ptr<SkStrikeServer> server;
+        sk_sp<SkData> serverTfData;
+        std::vector<uint8_t> strikeData;
+    };
+    constexpr int kRenderers = 4,
+                  kCanvasesPerRenderer = 2;
+    Renderer renderers[kRenderers];
+    for (Renderer& renderer : renderers) {
+        renderer.discardableManager = sk_make_sp<DiscardableManager>();
+        renderer.server = std::make_unique<SkStrikeServer>(renderer.discardableManager.get(),
+                                                           &sharedStrikes);
+        renderer.serverTfData = renderer.server->serializeTypeface(serverTf.get());
+    }
+
+    SkTaskGroup().batch(kRenderers * kCanvasesPerRenderer, [&](int i) {
+        SkTextBlobCacheDiffCanvas cache_diff_canvas(
+                10, 10, props, renderers[i / kCanvasesPerRenderer].server.get(),
+                dContext->supportsDistanceFieldText());
+        cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+    });
+
+    SkBitmap expected = RasterBlob(serverBlob, 10, 10, paint, dContext);
+    for (Renderer& renderer : renderers) {
+        renderer.server->writeStrikeData(&renderer.strikeData);
+        REPORTER_ASSERT(reporter, renderer.strikeData.size() == renderers[0].strikeData.size());
+
+        SkStrikeClient client(renderer.discardableManager, false);
+        auto clientTf = client.deserializeTypeface(renderer.serverTfData->data(),
+                                                   renderer.serverTfData->size());
+        REPORTER_ASSERT(reporter, client.readStrikeData(renderer.strikeData.data(),
+                                                        renderer.strikeData.size()));
+        SkBitmap actual = RasterBlob(buildTextBlob(clientTf, glyphCount), 10, 10, paint, dContext);
+        compare_blobs(expected, actual, reporter);
+        REPORTER_ASSERT(reporter, !renderer.discardableManager->hasCacheMiss());
+
+        // Must unlock everything on termination, otherwise valgrind complains about memory leaks.
+        renderer.discardableManager->unlockAndDeleteAll();
+    }
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_ReleaseTypeFace, reporter, ctxInfo) {
     sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
     SkStrikeServer server(discardableManager.get());
@@ -411,6 +468,76 @@ DEF_TEST(SkRemoteGlyphCache_ClientMemoryAccounting, reporter) {
     discardableManager->unlockAndDeleteAll();
 }
 
+DEF_TEST(SkRemoteGlyphCache_SnapshotPreload, reporter) {
+    auto tf = SkTypeface::MakeFromName("monospace", SkFontStyle());
+    SkFont font(tf, 24);
+    SkGlyphID glyphIDs[8];
+    int glyphCount = font.textToGlyphs("Snapshot", 8, SkTextEncoding::kUTF8, glyphIDs, 8);
+    SkPackedGlyphID packedIDs[8];
+    for (int i = 0; i < glyphCount; i++) {
+        packedIDs[i] = SkPackedGlyphID{glyphIDs[i]};
+    }
+
+    // One strike with images and paths, and one with only metrics.
+    SkStrikeCache source;
+    SkStrikeSpec imageSpec = SkStrikeSpec::MakeWithNoDevice(font);
+    sk_sp<SkStrike> sourceStrike = imageSpec.findOrCreateStrike(&source);
+    const SkGlyph* sourceGlyphs[8];
+    sourceStrike->prepareImages({packedIDs, SkToSizeT(glyphCount)}, sourceGlyphs);
+    sourceStrike->preparePaths({glyphIDs, SkToSizeT(glyphCount)}, sourceGlyphs);
+    SkStrikeSpec metricsSpec = SkStrikeSpec::MakeWithNoDevice(SkFont(tf, 12));
+    const SkGlyph* metricsGlyphs[8];
+    metricsSpec.findOrCreateStrike(&source)->metrics({glyphIDs, SkToSizeT(glyphCount)},
+                                                     metricsGlyphs);
+
+    sk_sp<SkData> snapshot = SkStrikeCacheSnapshot::Make(&source);
+
+    SkStrikeCache cache;
+    REPORTER_ASSERT(reporter,
+                    SkStrikeCacheSnapshot::Preload(snapshot->data(), snapshot->size(), {tf}, &cache));
+    REPORTER_ASSERT(reporter, cache.getCacheCountUsed() == 2);
+    sk_sp<SkStrike> strike = cache.findStrike(imageSpec.descriptor());
+    REPORTER_ASSERT(reporter, strike);
+    REPORTER_ASSERT(reporter, strike->fScalerCache.countCachedGlyphs() ==
+                              sourceStrike->fScalerCache.countCachedGlyphs());
+    REPORTER_ASSERT(reporter, cache.findStrike(metricsSpec.descriptor()));
+
+    // The preloaded glyphs come back without being made again.
+    size_t memoryUsed = cache.getTotalMemoryUsed();
+    const SkGlyph* glyphs[8];
+    strike->prepareImages({packedIDs, SkToSizeT(glyphCount)}, glyphs);
+    strike->preparePaths({glyphIDs, SkToSizeT(glyphCount)}, glyphs);
+    REPORTER_ASSERT(reporter, cache.getTotalMemoryUsed() == memoryUsed);
+    for (int i = 0; i < glyphCount; i++) {
+        const SkGlyph* glyph = glyphs[i];
+        const SkGlyph* expected = sourceGlyphs[i];
+        REPORTER_ASSERT(reporter, glyph->advanceX() == expected->advanceX());
+        REPORTER_ASSERT(reporter, glyph->iRect() == expected->iRect());
+        REPORTER_ASSERT(reporter, glyph->maskFormat() == expected->maskFormat());
+        REPORTER_ASSERT(reporter, (glyph->image() == nullptr) == (expected->image() == nullptr));
+        if (glyph->image() != nullptr) {
+            REPORTER_ASSERT(reporter,
+                            0 == memcmp(glyph->image(), expected->image(), glyph->imageSize()));
+        }
+        REPORTER_ASSERT(reporter, (glyph->path() == nullptr) == (expected->path() == nullptr));
+        if (glyph->path() != nullptr) {
+            REPORTER_ASSERT(reporter, *glyph->path() == *expected->path());
+        }
+    }
+
+    // Strikes the cache already has are left alone.
+    REPORTER_ASSERT(reporter,
+                    SkStrikeCacheSnapshot::Preload(snapshot->data(), snapshot->size(), {tf}, &cache));
+    REPORTER_ASSERT(reporter, cache.getCacheCountUsed() == 2);
+    REPORTER_ASSERT(reporter, cache.getTotalMemoryUsed() == memoryUsed);
+
+    // Truncated snapshots are rejected.
+    SkStrikeCache truncatedCache;
+    REPORTER_ASSERT(reporter, !SkStrikeCacheSnapshot::Preload(snapshot->data(),
+                                                              snapshot->size() - 1,
+                                                              {tf}, &truncatedCache));
+}
+
 DEF_TEST(SkRemoteGlyphCache_PurgesServerEntries, reporter) {
     sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
     SkStrikeServer server(discardableManager.get());
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2020 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPath.h"
+#include "src/core/SkCoreBlitters.h"
+#include "src/core/SkPathView.h"
+#include "src/core/SkScan.h"
+#include "tests/Test.h"
+
+#include <cmath>
+
+// Fills the path with sparse strips directly, rather than through a canvas and the process wide
+// gSkUseSparseStripsAA, which tests running on other threads would see.
+static SkBitmap draw_alpha(const SkPath& path, const SkIRect* clip = nullptr) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeA8(200, 150));
+    bm.eraseColor(SK_ColorTRANSPARENT);
+
+    SkA8_Coverage_Blitter blitter(bm.pixmap(), SkPaint());
+    SkScan::SparseStripsFillPath(path.view(), &blitter, path.getBounds().roundOut(),
+                                 clip ? *clip : bm.bounds());
+    return bm;
+}
+
+// Sparse strips compute exact area coverage wherever edges don't cross inside a pixel.
+DEF_TEST(SparseStrips_ExactCoverage, reporter) {
+    const SkRect r = {10.25f, 20.5f, 130.75f, 140.1f};
+    SkBitmap bm = draw_alpha(SkPath::Rect(r));
+
+    int maxDiff = 0;
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            float cx = std::max(0.0f, std::min(x + 1.0f, r.fRight) - std::max((float)x, r.fLeft)),
+                  cy = std::max(0.0f, std::min(y + 1.0f, r.fBottom) - std::max((float)y, r.fTop));
+            int expected = (int)(cx * cy * 255 + 0.5f);
+            maxDiff = std::max(maxDiff, std::abs(expected - *bm.getAddr8(x, y)));
+        }
+    }
+    REPORTER_ASSERT(reporter, maxDiff <= 1, "maxDiff %d", maxDiff);
+}
+
+DEF_TEST(SparseStrips_FillRules, reporter) {
+    // Two pixel aligned squares, both wound the same way. The inner one is a hole only when
+    // filled even-odd.
+    SkPath path;
+    path.addRect({20, 20, 180, 130});
+    path.addRect({60, 40, 140, 110});
+
+    SkBitmap winding = draw_alpha(path);
+    REPORTER_ASSERT(reporter, *winding.getAddr8(100, 75) == 0xFF);
+    REPORTER_ASSERT(reporter, *winding.getAddr8(30, 75) == 0xFF);
+    REPORTER_ASSERT(reporter, *winding.getAddr8(10, 75) == 0);
+
+    path.setFillType(SkPathFillType::kEvenOdd);
+    SkBitmap evenOdd = draw_alpha(path);
+    REPORTER_ASSERT(reporter, *evenOdd.getAddr8(100, 75) == 0);
+    REPORTER_ASSERT(reporter, *evenOdd.getAddr8(30, 75) == 0xFF);
+    REPORTER_ASSERT(reporter, *evenOdd.getAddr8(10, 75) == 0);
+}
+
+// Draws 'path' aliased at 16x16 samples per pixel, and averages them into coverage.
+static SkBitmap draw_supersampled_alpha(const SkPath& path, const SkIRect* clip) {
+    constexpr int kScale = 16;
+    SkBitmap big;
+    big.allocPixels(SkImageInfo::MakeA8(200 * kScale, 150 * kScale));
+    big.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(big);
+    canvas.scale(kScale, kScale);
+    if (clip) {
+        canvas.clipRect(SkRect::Make(*clip));
+    }
+    canvas.drawPath(path, SkPaint());
+
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeA8(200, 150));
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            int sum = 0;
+            for (int j = 0; j < kScale; ++j) {
+                const uint8_t* row = big.getAddr8(x * kScale, y * kScale + j);
+                for (int i = 0; i < kScale; ++i) {
+                    sum += row[i];
+                }
+            }
+            *bm.getAddr8(x, y) = (sum + kScale * kScale / 2) / (kScale * kScale);
+        }
+    }
+    return bm;
+}
+
+// Curves, paths that run off the left and right of the clip, paths that cover whole tiles, and
+// self-intersecting paths should all have close to their true coverage. The only pixels that
+// may be far off are those where edges cross.
+DEF_TEST(SparseStrips_MatchesSupersampled, reporter) {
+    SkPath paths[4];
+    paths[0].addCircle(100, 75, 61.3f);
+    paths[1].moveTo(5, 140);
+    paths[1].cubicTo(40, -60, 160, 250, 195, 10);
+    paths[1].quadTo(100, 200, 5, 140);
+    paths[2].addCircle(-20, 75, 70);
+    paths[2].addCircle(220, 75, 50);
+    paths[2].addOval({30, -40, 170, 60});
+    for (int i = 0; i < 5; ++i) {
+        float a = i * 4 * SK_ScalarPI / 5;
+        SkPoint p = {100 + 70 * std::cos(a), 75 + 70 * std::sin(a)};
+        i ? paths[3].lineTo(p) : paths[3].moveTo(p);
+    }
+
+    const SkIRect clip = {33, 17, 171, 133};
+    for (const SkIRect* c : {(const SkIRect*)nullptr, &clip}) {
+        for (SkPath path : paths) {
+            for (auto fillType : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd}) {
+                path.setFillType(fillType);
+                SkBitmap expected = draw_supersampled_alpha(path, c),
+                         actual   = draw_alpha(path, c);
+                int sumDiff = 0,
+                    farOff  = 0;
+                for (int y = 0; y < expected.height(); ++y) {
+                    for (int x = 0; x < expected.width(); ++x) {
+                        int diff = std::abs(*expected.getAddr8(x, y) - *actual.getAddr8(x, y));
+                        sumDiff += diff;
+                        farOff  += diff > 32;
+                    }
+                }
+                REPORTER_ASSERT(reporter, sumDiff <= expected.width() * expected.height() / 16,
+                                "sumDiff %d", sumDiff);
+                REPORTER_ASSERT(reporter, farOff <= 8, "farOff %d", farOff);
+            }
+        }
+    }
+}
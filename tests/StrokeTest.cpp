@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRect.h"
@@ -185,3 +187,85 @@ DEF_TEST(Stroke, reporter) {
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
 }
+
+static SkBitmap fill_paths(const SkPath* paths, int count) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeA8(256, 256));
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bm);
+    for (int i = 0; i < count; ++i) {
+        canvas.drawPath(paths[i], SkPaint());
+    }
+    return bm;
+}
+
+// Stroking a path in ranges of verbs should cover the same pixels as stroking it all at once.
+DEF_TEST(StrokeRange, reporter) {
+    SkPath paths[6];
+    paths[0].moveTo(20, 20);
+    for (int i = 1; i < 24; ++i) {
+        paths[0].lineTo(20 + i * 9, i & 1 ? 60 + i * 3 : 30 + i * 5);
+    }
+    paths[1].moveTo(40, 40);
+    paths[1].lineTo(200, 50);
+    paths[1].lineTo(120, 210);
+    paths[1].lineTo(60, 120);
+    paths[1].close();
+    paths[1].moveTo(150, 150);
+    paths[1].lineTo(230, 160);
+    paths[2].moveTo(30, 220);
+    paths[2].lineTo(30, 200);
+    paths[2].quadTo(60, 20, 120, 120);
+    paths[2].cubicTo(150, 180, 250, 30, 200, 30);
+    paths[2].conicTo(100, 0, 60, 90, 0.6f);
+    paths[2].lineTo(40, 230);
+    paths[3].moveTo(128, 20);
+    paths[3].lineTo(230, 128);
+    paths[3].quadTo(128, 240, 20, 128);
+    paths[3].close();
+    // Open contours that start with a curve and end with a line, and the reverse; strokePath()
+    // caps the start according to the last segment.
+    paths[4].moveTo(40, 40);
+    paths[4].quadTo(120, 10, 200, 60);
+    paths[4].lineTo(220, 200);
+    paths[5].moveTo(40, 200);
+    paths[5].lineTo(60, 40);
+    paths[5].cubicTo(100, 10, 180, 250, 220, 60);
+
+    for (const SkPath& path : paths) {
+        for (SkPaint::Join join : {SkPaint::kMiter_Join, SkPaint::kRound_Join,
+                                   SkPaint::kBevel_Join}) {
+            for (SkPaint::Cap cap : {SkPaint::kButt_Cap, SkPaint::kSquare_Cap,
+                                     SkPaint::kRound_Cap}) {
+                SkPaint paint;
+                paint.setStyle(SkPaint::kStroke_Style);
+                paint.setStrokeWidth(9);
+                paint.setStrokeJoin(join);
+                paint.setStrokeCap(cap);
+                SkStroke stroke(paint);
+                stroke.setDoFill(false);
+
+                SkPath full;
+                stroke.strokePath(path, &full);
+                SkBitmap expected = fill_paths(&full, 1);
+
+                const int verbCount = path.countVerbs();
+                for (int step = 1; step < verbCount; ++step) {
+                    SkTArray<SkPath> chunks;
+                    for (int begin = 0; begin < verbCount; begin += step) {
+                        stroke.strokePathRange(path, begin, begin + step, &chunks.push_back());
+                    }
+                    SkBitmap actual = fill_paths(chunks.begin(), chunks.count());
+                    int diffs = 0;
+                    for (int y = 0; y < expected.height(); ++y) {
+                        for (int x = 0; x < expected.width(); ++x) {
+                            diffs += *expected.getAddr8(x, y) != *actual.getAddr8(x, y);
+                        }
+                    }
+                    REPORTER_ASSERT(reporter, !diffs, "join %d cap %d step %d diffs %d",
+                                    join, cap, step, diffs);
+                }
+            }
+        }
+    }
+}
@@ -40,6 +40,8 @@ bool CollectImages(CommandLineFlags::StringArray dir, SkTArray<SkString>* output
 void SetCtxOptionsFromCommonFlags(struct GrContextOptions*);
 
 /**
- *  Enable, disable, or force analytic anti-aliasing using --analyticAA and --forceAnalyticAA.
+ *  Enable, disable, or force analytic anti-aliasing using --analyticAA and --forceAnalyticAA,
+ *  and sparse strips using --sparseStripsAA and --forceSparseStripsAA. Also turns on cached path
+ *  coverage masks with --pathMaskCache.
  */
 void SetAnalyticAAFromCommonFlags();
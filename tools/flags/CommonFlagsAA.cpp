@@ -1,6 +1,7 @@
 // Copyright 2019 Google LLC.
 // Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
 
+#include "src/core/SkDraw.h"
 #include "src/core/SkScan.h"
 #include "tools/flags/CommonFlags.h"
 
@@ -9,8 +10,18 @@ static DEFINE_bool(forceAnalyticAA, false,
             "Force analytic anti-aliasing even if the path is complicated: "
             "whether it's concave or convex, we consider a path complicated"
             "if its number of points is comparable to its resolution.");
+static DEFINE_bool(sparseStripsAA, false,
+            "If true, fill anti-aliased paths with many points using sparse strips.");
+static DEFINE_bool(forceSparseStripsAA, false,
+            "Fill every anti-aliased path with sparse strips, however few points it has.");
+
+static DEFINE_bool(pathMaskCache, false,
+            "Draw small paths drawn again at whole pixel offsets from cached coverage masks.");
 
 void SetAnalyticAAFromCommonFlags() {
     gSkUseAnalyticAA   = FLAGS_analyticAA;
     gSkForceAnalyticAA = FLAGS_forceAnalyticAA;
+    gSkUseSparseStripsAA   = FLAGS_sparseStripsAA;
+    gSkForceSparseStripsAA = FLAGS_forceSparseStripsAA;
+    gSkUsePathMaskCache    = FLAGS_pathMaskCache;
 }